@@ -0,0 +1,156 @@
+#ifndef ECOCIN_BENCH_DATASET_H
+#define ECOCIN_BENCH_DATASET_H
+
+#include "app/Migrations.h"
+#include "domain/core/Uuid.h"
+#include "infra/repositories/sqlite/Helpers.h"
+
+#include <sqlite3.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+// Massa de dados sintética para os benchmarks. Todos os valores são derivados do índice
+// da linha (1..n), então o mesmo tamanho sempre gera o mesmo banco e os benchmarks conseguem
+// sortear chaves existentes (id, CPF, SKU) sem consultar o banco.
+namespace ecocin::bench {
+
+// Embaralhamento bijetor de 64 bits (finalizador do splitmix64)
+inline std::uint64_t mix(std::uint64_t x) {
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+// CPF de 11 dígitos, único por índice
+inline std::string cpfFor(std::uint64_t i) {
+    char buf[16];
+    std::snprintf(buf, sizeof(buf), "%011llu", static_cast<unsigned long long>(i % 100000000000ull));
+    return buf;
+}
+
+inline std::string emailFor(std::uint64_t i) {
+    return "cliente" + std::to_string(i) + "@bench.ecocin";
+}
+
+// SKU no formato UUID v4 canônico, único por índice (mix é bijetor)
+inline ecocin::core::Uuid skuFor(std::uint64_t i) {
+    const std::uint64_t a = mix(i);
+    const std::uint64_t b = mix(i ^ 0x5EED5EED5EED5EEDull) ^ i;
+    ecocin::core::Uuid::Bytes bytes;
+    for (std::size_t k = 0; k < 8; ++k) {
+        bytes[k]     = static_cast<std::uint8_t>(a >> (56 - 8 * k));
+        bytes[8 + k] = static_cast<std::uint8_t>(b >> (56 - 8 * k));
+    }
+    bytes[6] = static_cast<std::uint8_t>((bytes[6] & 0x0F) | 0x40);
+    bytes[8] = static_cast<std::uint8_t>((bytes[8] & 0x3F) | 0x80);
+    // O byte 15 guarda os 8 bits baixos de i, o que evita colisões entre índices próximos
+    bytes[15] = static_cast<std::uint8_t>(i);
+    return ecocin::core::Uuid::fromBytes(bytes);
+}
+
+namespace detail {
+
+inline void exec(sqlite3* db, const char* sql) {
+    char* err = nullptr;
+    if (sqlite3_exec(db, sql, nullptr, nullptr, &err) != SQLITE_OK) {
+        std::string msg = err ? err : "unknown";
+        if (err) sqlite3_free(err);
+        throw std::runtime_error(std::string("bench dataset: ") + msg);
+    }
+}
+
+// Prepara uma instrução, executa fill(st, i) + step para cada i em [1, n] e finaliza
+template <class Fill>
+void insertRows(sqlite3* db, const char* sql, std::uint64_t n, Fill fill) {
+    sqlite3_stmt* st = nullptr;
+    sqlite_check(sqlite3_prepare_v2(db, sql, -1, &st, nullptr), db, "prepare bench insert");
+    for (std::uint64_t i = 1; i <= n; ++i) {
+        fill(st, i);
+        const int rc = sqlite3_step(st);
+        if (rc != SQLITE_DONE) {
+            sqlite3_finalize(st);
+            sqlite_check(rc, db, "step bench insert");
+            throw std::runtime_error("bench dataset: insert failed");
+        }
+        sqlite3_reset(st);
+    }
+    sqlite3_finalize(st);
+}
+
+} // namespace detail
+
+// Cria o esquema e carrega n clientes, n produtos, n endereços (um por cliente) e n pedidos.
+// O id de cada linha é o seu índice; os pedidos apontam para clientes/produtos sorteados de forma
+// determinística. Tudo em uma transação, com instruções preparadas uma vez só.
+inline void seedDataset(sqlite3* db, std::uint64_t n) {
+    ecocin::app::runMigrations(db);
+    const auto epoch = std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+
+    detail::exec(db, "BEGIN");
+    detail::insertRows(db, "INSERT INTO clients(id,name,email,cpf,create_date) VALUES(?,?,?,?,?)", n,
+        [&](sqlite3_stmt* st, std::uint64_t i) {
+            const auto name = "Cliente " + std::to_string(i);
+            const auto email = emailFor(i);
+            const auto cpf = cpfFor(i);
+            sqlite3_bind_int64(st, 1, static_cast<sqlite3_int64>(i));
+            sqlite3_bind_text(st, 2, name.c_str(), -1, SQLITE_TRANSIENT);
+            sqlite3_bind_text(st, 3, email.c_str(), -1, SQLITE_TRANSIENT);
+            sqlite3_bind_text(st, 4, cpf.c_str(), -1, SQLITE_TRANSIENT);
+            sqlite3_bind_int64(st, 5, epoch);
+        });
+    detail::insertRows(db,
+        "INSERT INTO products(id,name,description,sku,price,stock_quantity,is_active,create_date) VALUES(?,?,?,?,?,?,1,?)", n,
+        [&](sqlite3_stmt* st, std::uint64_t i) {
+            const auto name = "Produto " + std::to_string(i);
+            const auto sku = skuFor(i).str();
+            sqlite3_bind_int64(st, 1, static_cast<sqlite3_int64>(i));
+            sqlite3_bind_text(st, 2, name.c_str(), -1, SQLITE_TRANSIENT);
+            sqlite3_bind_text(st, 3, "Produto gerado para benchmark", -1, SQLITE_STATIC);
+            sqlite3_bind_text(st, 4, sku.c_str(), -1, SQLITE_TRANSIENT);
+            sqlite3_bind_double(st, 5, 1.0 + static_cast<double>(mix(i) % 100000) / 100.0);
+            sqlite3_bind_int(st, 6, static_cast<int>(mix(i) % 1000));
+            sqlite3_bind_int64(st, 7, epoch);
+        });
+    detail::insertRows(db,
+        "INSERT INTO addresses(id,client_id,street,number,city,state,zip,address_type,create_date) VALUES(?,?,?,?,?,?,?,?,?)", n,
+        [&](sqlite3_stmt* st, std::uint64_t i) {
+            const auto number = std::to_string(i % 10000);
+            const auto zip = std::to_string(50000000 + mix(i) % 10000000);
+            sqlite3_bind_int64(st, 1, static_cast<sqlite3_int64>(i));
+            sqlite3_bind_int64(st, 2, static_cast<sqlite3_int64>(i));
+            sqlite3_bind_text(st, 3, "Rua do Benchmark", -1, SQLITE_STATIC);
+            sqlite3_bind_text(st, 4, number.c_str(), -1, SQLITE_TRANSIENT);
+            sqlite3_bind_text(st, 5, "Recife", -1, SQLITE_STATIC);
+            sqlite3_bind_text(st, 6, "PE", -1, SQLITE_STATIC);
+            sqlite3_bind_text(st, 7, zip.c_str(), -1, SQLITE_TRANSIENT);
+            sqlite3_bind_text(st, 8, "CASA", -1, SQLITE_STATIC);
+            sqlite3_bind_int64(st, 9, epoch);
+        });
+    detail::insertRows(db,
+        "INSERT INTO orders(id,client_id,product_id,shipping_address_id,quantity,unit_price,total_price,status,create_date)"
+        " VALUES(?,?,?,?,?,?,?,'PENDING',?)", n,
+        [&](sqlite3_stmt* st, std::uint64_t i) {
+            const auto client = 1 + mix(i) % n;
+            const auto product = 1 + mix(i + n) % n;
+            const int quantity = 1 + static_cast<int>(i % 5);
+            const double unit = 10.0 + static_cast<double>(product % 1000);
+            sqlite3_bind_int64(st, 1, static_cast<sqlite3_int64>(i));
+            sqlite3_bind_int64(st, 2, static_cast<sqlite3_int64>(client));
+            sqlite3_bind_int64(st, 3, static_cast<sqlite3_int64>(product));
+            sqlite3_bind_int64(st, 4, static_cast<sqlite3_int64>(client)); // endereço id == cliente id
+            sqlite3_bind_int(st, 5, quantity);
+            sqlite3_bind_double(st, 6, unit);
+            sqlite3_bind_double(st, 7, unit * quantity);
+            sqlite3_bind_int64(st, 8, epoch);
+        });
+    detail::exec(db, "COMMIT");
+    detail::exec(db, "ANALYZE");
+}
+
+} // namespace ecocin::bench
+
+#endif // ECOCIN_BENCH_DATASET_H
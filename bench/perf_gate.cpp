@@ -0,0 +1,283 @@
+// Portão de desempenho registrado no ctest (teste "perf_gate", label "perf") quando o projeto é
+// configurado com -DECOCIN_PERF_GATE=ON: a linha de base só vale na máquina em que foi medida.
+//
+// Roda uma versão curta e fixa dos benchmarks — repo_bench em :memory: e o loadgen contra uma
+// instância do e-cocin iniciada aqui com um banco temporário — extrai as métricas de vazão e p99
+// e compara com a linha de base versionada em bench/perf_baseline.json. Cada métrica diz se
+// "maior é melhor" (vazão) ou "menor é melhor" (latência, erros) e tem uma tolerância relativa;
+// qualquer métrica fora do limite faz o teste falhar com uma tabela das diferenças.
+//
+// Uso (normalmente via ctest):
+//   perf_gate --baseline bench/perf_baseline.json --repo-bench ./repo_bench --loadgen ./loadgen
+//             --server ./e-cocin --collection resources/ECOMMERCE-CIN.postman_collection.json
+//             --work-dir ./perf_gate [--skip-http] [--update-baseline]
+//
+// --update-baseline grava os valores medidos como nova linha de base (mantendo as tolerâncias e
+// acrescentando as métricas que ainda não estão nela); use-o na máquina de referência depois de uma
+// mudança de desempenho intencional. O benchmark HTTP só roda se a linha de base tiver métricas http.*
+// ou com --update-baseline: sem valores medidos para comparar, ele não teria o que conferir.
+
+#include <nlohmann/json.hpp>
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <stdexcept>
+#include <string>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <csignal>
+#include <spawn.h>
+#include <sys/wait.h>
+extern char** environ;
+#endif
+
+namespace fs = std::filesystem;
+using Json = nlohmann::ordered_json;
+
+namespace {
+
+struct Options {
+    std::string baseline;
+    std::string repoBench;
+    std::string loadgen;
+    std::string server;
+    std::string collection;
+    std::string workDir{"perf_gate"};
+    bool skipHttp{false};
+    bool updateBaseline{false};
+};
+
+// Parâmetros fixos da execução curta: mudar qualquer um deles invalida a linha de base
+constexpr const char* kRepoBenchArgs = " --sizes 10000 --storage memory --ops 5000 --max-seconds 1";
+constexpr const char* kLoadgenArgs =
+    " --rate 200 --duration 5 --warmup 1 --connections 8 --setup-clients 20 --setup-products 10 --wait-ready 15";
+constexpr const char* kServerPort = "18080";
+
+Options parseArgs(int argc, char** argv) {
+    Options o;
+    for (int i = 1; i < argc; ++i) {
+        const std::string key = argv[i];
+        auto value = [&]() -> std::string {
+            if (i + 1 >= argc) throw std::invalid_argument("faltou o valor de " + key);
+            return argv[++i];
+        };
+        if (key == "--baseline") o.baseline = value();
+        else if (key == "--repo-bench") o.repoBench = value();
+        else if (key == "--loadgen") o.loadgen = value();
+        else if (key == "--server") o.server = value();
+        else if (key == "--collection") o.collection = value();
+        else if (key == "--work-dir") o.workDir = value();
+        else if (key == "--skip-http") o.skipHttp = true;
+        else if (key == "--update-baseline") o.updateBaseline = true;
+        else throw std::invalid_argument("opção desconhecida: " + key);
+    }
+    if (o.baseline.empty() || o.repoBench.empty()) throw std::invalid_argument("--baseline e --repo-bench são obrigatórios");
+    if (!o.skipHttp && (o.loadgen.empty() || o.server.empty() || o.collection.empty())) {
+        throw std::invalid_argument("--loadgen, --server e --collection são obrigatórios (ou use --skip-http)");
+    }
+    return o;
+}
+
+std::string quote(const std::string& s) { return "\"" + s + "\""; }
+
+void run(const std::string& command) {
+    std::cerr << "$ " << command << '\n';
+    if (std::system(command.c_str()) != 0) throw std::runtime_error("comando falhou: " + command);
+}
+
+Json readJson(const fs::path& file) {
+    std::ifstream in(file);
+    if (!in) throw std::runtime_error("não foi possível ler " + file.string());
+    return Json::parse(in);
+}
+
+void setEnv(const char* name, const std::string& value) {
+#ifdef _WIN32
+    _putenv_s(name, value.c_str());
+#else
+    setenv(name, value.c_str(), 1);
+#endif
+}
+
+// Servidor em segundo plano durante o benchmark HTTP (encerrado no destrutor)
+class ServerProcess {
+private:
+#ifdef _WIN32
+    PROCESS_INFORMATION pi_{};
+#else
+    pid_t pid_{-1};
+#endif
+
+public:
+    explicit ServerProcess(const std::string& exe) {
+#ifdef _WIN32
+        STARTUPINFOA si{};
+        si.cb = sizeof(si);
+        std::string cmd = quote(exe);
+        if (!CreateProcessA(nullptr, cmd.data(), nullptr, nullptr, FALSE, 0, nullptr, nullptr, &si, &pi_)) {
+            throw std::runtime_error("não foi possível iniciar " + exe);
+        }
+#else
+        char* args[] = {const_cast<char*>(exe.c_str()), nullptr};
+        if (posix_spawn(&pid_, exe.c_str(), nullptr, nullptr, args, environ) != 0) {
+            throw std::runtime_error("não foi possível iniciar " + exe);
+        }
+#endif
+    }
+
+    ~ServerProcess() {
+#ifdef _WIN32
+        TerminateProcess(pi_.hProcess, 0);
+        WaitForSingleObject(pi_.hProcess, 5000);
+        CloseHandle(pi_.hProcess);
+        CloseHandle(pi_.hThread);
+#else
+        kill(pid_, SIGTERM);
+        int status = 0;
+        waitpid(pid_, &status, 0);
+#endif
+    }
+
+    ServerProcess(const ServerProcess&) = delete;
+    ServerProcess& operator=(const ServerProcess&) = delete;
+};
+
+// Métricas medidas, pelo nome usado na linha de base (ex.: repo.clients.findById.opsPerSec)
+using Metrics = std::map<std::string, double>;
+
+void collectRepo(const Json& report, Metrics& out) {
+    for (const auto& run : report.at("runs")) {
+        for (const auto& r : run.at("results")) {
+            const auto prefix = "repo." + r.at("repository").get<std::string>() + "." + r.at("operation").get<std::string>();
+            out[prefix + ".opsPerSec"] = r.at("opsPerSec").get<double>();
+            out[prefix + ".p99Us"] = r.at("p99Us").get<double>();
+        }
+    }
+}
+
+void collectHttp(const Json& report, Metrics& out) {
+    for (const auto& r : report.at("routes")) {
+        const auto prefix = "http." + r.at("scenario").get<std::string>();
+        out[prefix + ".p99Ms"] = r.at("p99Ms").get<double>();
+        out[prefix + ".errors"] = r.at("errors").get<double>();
+    }
+    const auto& total = report.at("total");
+    out["http.total.throughputPerSec"] = total.at("throughputPerSec").get<double>();
+    out["http.total.p99Ms"] = total.at("p99Ms").get<double>();
+    out["http.total.errors"] = total.at("errors").get<double>();
+}
+
+// Compara com a linha de base e imprime a tabela; devolve o número de regressões
+int compare(const Json& baseline, const Metrics& actual) {
+    const auto& defaults = baseline.at("defaults");
+    int regressions = 0;
+    // Larguras compensam os bytes extras dos acentos (UTF-8) nos títulos
+    std::printf("%-45s %14s %14s %11s %14s\n", "métrica", "base", "atual", "variação", "limite");
+    for (const auto& [name, spec] : baseline.at("metrics").items()) {
+        const double base = spec.at("value").get<double>();
+        const bool higherIsBetter = spec.at("better").get<std::string>() == "higher";
+        const double tolerance = spec.contains("tolerance")
+            ? spec["tolerance"].get<double>()
+            : defaults.at(higherIsBetter ? "throughputTolerance" : "latencyTolerance").get<double>();
+        const double limit = higherIsBetter ? base * (1.0 - tolerance) : base * (1.0 + tolerance);
+
+        const auto it = actual.find(name);
+        if (it == actual.end()) {
+            std::printf("%-44s %14.3f %14s %9s %14.3f  AUSENTE\n", name.c_str(), base, "-", "-", limit);
+            ++regressions;
+            continue;
+        }
+        const double value = it->second;
+        const bool ok = higherIsBetter ? value >= limit : value <= limit;
+        const double change = base != 0 ? (value - base) / base * 100.0 : 0.0;
+        std::printf("%-44s %14.3f %14.3f %+8.1f%% %14.3f  %s\n", name.c_str(), base, value, change, limit,
+                    ok ? "ok" : "REGRESSÃO");
+        if (!ok) ++regressions;
+    }
+    return regressions;
+}
+
+bool hasHttpMetrics(const Json& baseline) {
+    for (const auto& [name, spec] : baseline.at("metrics").items()) {
+        if (name.rfind("http.", 0) == 0) return true;
+    }
+    return false;
+}
+
+// Grava os valores medidos na linha de base, mantendo direção e tolerâncias das métricas que já
+// existem; as novas entram com a tolerância padrão e a direção pelo nome (vazão: maior é melhor)
+void updateBaseline(const std::string& file, Json baseline, const Metrics& actual) {
+    auto& metrics = baseline["metrics"];
+    for (const auto& [name, value] : actual) {
+        const double rounded = std::round(value * 1000.0) / 1000.0;
+        if (metrics.contains(name)) {
+            metrics[name]["value"] = rounded;
+            continue;
+        }
+        const bool higher = name.find("opsPerSec") != std::string::npos || name.find("throughput") != std::string::npos;
+        metrics[name] = Json{{"value", rounded}, {"better", higher ? "higher" : "lower"}};
+    }
+    std::ofstream(file) << baseline.dump(2) << '\n';
+    std::cerr << "linha de base atualizada: " << file << '\n';
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    try {
+        auto o = parseArgs(argc, argv);
+        fs::create_directories(o.workDir);
+        if (!o.skipHttp && !o.updateBaseline && !hasHttpMetrics(readJson(o.baseline))) {
+            std::cerr << "linha de base sem métricas http.*: benchmark HTTP não executado\n";
+            o.skipHttp = true;
+        }
+        const auto repoOut = fs::path(o.workDir) / "repo_bench.json";
+        const auto httpOut = fs::path(o.workDir) / "loadgen.json";
+
+        Metrics actual;
+        run(quote(o.repoBench) + kRepoBenchArgs + " --out " + quote(repoOut.string()));
+        collectRepo(readJson(repoOut), actual);
+
+        if (!o.skipHttp) {
+            const auto db = fs::path(o.workDir) / "perf_gate.db";
+            fs::remove(db);
+            setEnv("ECOCIN_PORT", kServerPort);
+            setEnv("ECOCIN_HOST", "127.0.0.1");
+            setEnv("ECOCIN_DB_PATH", db.string());
+            ServerProcess server(o.server);
+            run(quote(o.loadgen) + " --port " + kServerPort + " --collection " + quote(o.collection) + kLoadgenArgs +
+                " --out " + quote(httpOut.string()));
+            collectHttp(readJson(httpOut), actual);
+        }
+
+        auto baseline = readJson(o.baseline);
+        if (o.skipHttp) {
+            // Sem o HTTP, só as métricas do repositório entram na comparação
+            for (auto it = baseline["metrics"].begin(); it != baseline["metrics"].end();) {
+                it = it.key().rfind("http.", 0) == 0 ? baseline["metrics"].erase(it) : std::next(it);
+            }
+        }
+        if (o.updateBaseline) {
+            updateBaseline(o.baseline, readJson(o.baseline), actual);
+            return 0;
+        }
+
+        const int regressions = compare(baseline, actual);
+        if (regressions > 0) {
+            std::printf("\n%d métrica(s) fora da tolerância em relação a %s\n", regressions, o.baseline.c_str());
+            return 1;
+        }
+        std::printf("\ndesempenho dentro da linha de base\n");
+    } catch (const std::exception& e) {
+        std::cerr << "perf_gate: " << e.what() << '\n';
+        return 1;
+    }
+    return 0;
+}
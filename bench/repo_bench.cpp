@@ -0,0 +1,316 @@
+// Microbenchmarks da camada de dados: mede as operações dos quatro *RepositorySqlite
+// sobre massas sintéticas de tamanhos diferentes, em arquivo e em memória, e imprime
+// vazão (ops/s) e percentis de latência em JSON, para comparar mudanças de armazenamento.
+// --storage memstore mede os Memory*Repository (infra/repositories/memory) sobre a mesma massa e
+// --storage orderlog troca só os pedidos pelo OrderLogRepository (infra/repositories/orderlog).
+//
+// Uso:
+//   repo_bench [--sizes 10000,100000,1000000] [--storage file,memory,memstore,orderlog] [--ops 20000]
+//              [--max-seconds 5] [--dir .] [--out resultado.json]
+//
+// Cada benchmark executa até --ops operações ou até --max-seconds segundos (o que vier antes);
+// listAll em bases grandes costuma parar pelo tempo.
+
+#include "Dataset.h"
+
+#include "infra/db/SqliteConnection.h"
+#include "infra/metrics/Histogram.h"
+#include "infra/repositories/sqlite/AddressRepositorySqlite.h"
+#include "infra/repositories/sqlite/ClientRepositorySqlite.h"
+#include "infra/repositories/sqlite/OrderRepositorySqlite.h"
+#include "infra/repositories/sqlite/ProductRepositorySqlite.h"
+#include "infra/repositories/memory/MemoryAddressRepository.h"
+#include "infra/repositories/memory/MemoryClientRepository.h"
+#include "infra/repositories/memory/MemoryOrderRepository.h"
+#include "infra/repositories/memory/MemoryProductRepository.h"
+#include "infra/repositories/memory/MemoryStore.h"
+#include "infra/repositories/orderlog/OrderLogRepository.h"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using ecocin::infra::metrics::Histogram;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+// Destino dos resultados calculados nos benchmarks, para o compilador não descartar o laço
+volatile double benchmark_sink = 0.0;
+
+struct Options {
+    std::vector<std::uint64_t> sizes{10000, 100000, 1000000};
+    std::vector<std::string> storages{"file", "memory"};
+    std::uint64_t ops{20000};
+    double maxSeconds{5.0};
+    std::string dir{"."};
+    std::string out;
+};
+
+template <class T, class Parse>
+std::vector<T> splitList(const std::string& s, Parse parse) {
+    std::vector<T> out;
+    std::stringstream ss(s);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        if (!item.empty()) out.push_back(parse(item));
+    }
+    return out;
+}
+
+Options parseArgs(int argc, char** argv) {
+    Options o;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        const std::string key = argv[i];
+        const std::string value = argv[i + 1];
+        if (key == "--sizes") {
+            o.sizes = splitList<std::uint64_t>(value, [](const std::string& v) { return std::stoull(v); });
+        } else if (key == "--storage") {
+            o.storages = splitList<std::string>(value, [](const std::string& v) { return v; });
+        } else if (key == "--ops") {
+            o.ops = std::stoull(value);
+        } else if (key == "--max-seconds") {
+            o.maxSeconds = std::stod(value);
+        } else if (key == "--dir") {
+            o.dir = value;
+        } else if (key == "--out") {
+            o.out = value;
+        } else {
+            throw std::invalid_argument("opção desconhecida: " + key);
+        }
+    }
+    return o;
+}
+
+// Executa op(i) repetidamente e devolve vazão e percentis (latências em microssegundos)
+nlohmann::ordered_json measure(const Options& opts, const std::function<void(std::uint64_t)>& op) {
+    Histogram latency;
+    const auto deadline = Clock::now() + std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>(opts.maxSeconds));
+    const auto start = Clock::now();
+    std::uint64_t done = 0;
+    while (done < opts.ops) {
+        const auto t0 = Clock::now();
+        op(done);
+        const auto t1 = Clock::now();
+        latency.record(static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count()));
+        ++done;
+        if (t1 >= deadline) break;
+    }
+    const double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+    auto us = [&](double q) { return static_cast<double>(latency.quantile(q)) / 1000.0; };
+    return {
+        {"ops", done},
+        {"seconds", elapsed},
+        {"opsPerSec", elapsed > 0 ? static_cast<double>(done) / elapsed : 0.0},
+        {"meanUs", done ? static_cast<double>(latency.sum()) / static_cast<double>(done) / 1000.0 : 0.0},
+        {"p50Us", us(0.50)},
+        {"p90Us", us(0.90)},
+        {"p99Us", us(0.99)},
+        {"p999Us", us(0.999)},
+        {"maxUs", us(1.0)},
+    };
+}
+
+// Roda todos os benchmarks sobre repositórios já populados com n linhas por tabela.
+// columnar: o repositório SQLite de produtos, para scanColumns (só existe no SQLite)
+nlohmann::ordered_json runSuite(const Options& opts,
+                                ecocin::domain::repositories::IClientRepository& clients,
+                                ecocin::domain::repositories::IProductRepository& products,
+                                ecocin::domain::repositories::IAddressRepository& addresses,
+                                ecocin::domain::repositories::IOrderRepository& orders,
+                                ecocin::infra::repositories::sqlite::ProductRepositorySqlite* columnar,
+                                std::uint64_t n) {
+
+    std::mt19937_64 rng(42);
+    auto anyId = [&] { return static_cast<long long>(1 + rng() % n); };
+
+    nlohmann::ordered_json results = nlohmann::ordered_json::array();
+    auto run = [&](const char* repo, const char* op, const std::function<void(std::uint64_t)>& fn) {
+        auto r = measure(opts, fn);
+        r["repository"] = repo;
+        r["operation"] = op;
+        results.push_back(std::move(r));
+        std::cerr << "  " << repo << "." << op << ": " << results.back()["opsPerSec"].get<double>() << " ops/s\n";
+    };
+
+    // Leituras primeiro, sobre a massa original; as inserções ficam por último
+    run("clients", "findById",  [&](std::uint64_t) { clients.findById(anyId()); });
+    run("clients", "findByCpf", [&](std::uint64_t) { clients.findByCpf(ecocin::bench::cpfFor(static_cast<std::uint64_t>(anyId()))); });
+    run("clients", "listAll",   [&](std::uint64_t) { clients.listAll(); });
+
+    run("products", "findById",  [&](std::uint64_t) { products.findById(anyId()); });
+    run("products", "findBySku", [&](std::uint64_t) { products.findBySku(ecocin::bench::skuFor(static_cast<std::uint64_t>(anyId())).str()); });
+    run("products", "findByIds", [&](std::uint64_t) {
+        // Um carrinho de 20 itens numa consulta (compare com 20x findById)
+        std::vector<long long> ids(20);
+        for (auto& id : ids) id = anyId();
+        products.findByIds(ids);
+    });
+    run("products", "listAll",   [&](std::uint64_t) { products.listAll(); });
+    if (columnar) {
+        run("products", "scanColumns", [&](std::uint64_t) {
+            // Valor do estoque do catálogo: a mesma leitura completa de listAll, mas só duas colunas
+            const auto batch = columnar->scanColumns({"price", "stock_quantity"});
+            const auto price = batch.reals("price");
+            const auto stock = batch.ints("stock_quantity");
+            double total = 0.0;
+            for (std::size_t r = 0; r < batch.rows(); ++r) total += price[r] * static_cast<double>(stock[r]);
+            benchmark_sink = total;
+        });
+    }
+
+    run("addresses", "findById",       [&](std::uint64_t) { addresses.findById(anyId()); });
+    run("addresses", "listByClientId", [&](std::uint64_t) { addresses.listByClientId(anyId()); });
+    run("addresses", "listAll",        [&](std::uint64_t) { addresses.listAll(); });
+
+    run("orders", "findById",       [&](std::uint64_t) { orders.findById(anyId()); });
+    run("orders", "listByClientId", [&](std::uint64_t) { orders.listByClientId(anyId()); });
+    run("orders", "listAll",        [&](std::uint64_t) { orders.listAll(); });
+
+    // Inserções: cada uma em sua própria transação implícita, como no servidor
+    run("clients", "create", [&](std::uint64_t i) {
+        const auto k = n + 1 + i;
+        Client c;
+        c.setName("Cliente " + std::to_string(k));
+        c.setEmail(ecocin::bench::emailFor(k));
+        c.setCpf(ecocin::bench::cpfFor(k));
+        clients.create(c);
+    });
+    run("products", "create", [&](std::uint64_t i) {
+        const auto k = n + 1 + i;
+        Product p;
+        p.setName("Produto " + std::to_string(k));
+        p.setDescription("Produto gerado para benchmark");
+        p.setSku(ecocin::bench::skuFor(k));
+        p.setPrice(19.9);
+        p.setStockQuantity(10);
+        p.setIsActive(true);
+        products.create(p);
+    });
+    run("addresses", "create", [&](std::uint64_t) {
+        Address a;
+        a.setClientId(anyId());
+        a.setStreet("Rua do Benchmark");
+        a.setNumber("1");
+        a.setCity("Recife");
+        a.setState("PE");
+        a.setZip("50000000");
+        a.setAddressType("TRABALHO");
+        addresses.create(a);
+    });
+    run("orders", "create", [&](std::uint64_t) {
+        const auto client = anyId();
+        Order o;
+        o.setClientId(client);
+        o.setProductId(anyId());
+        o.setShippingAddressId(client);
+        o.setQuantity(1);
+        o.setUnitPrice(19.9);
+        o.setStatus("PENDING");
+        orders.create(o);
+    });
+    return results;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    try {
+        const auto opts = parseArgs(argc, argv);
+        nlohmann::ordered_json report;
+        report["sqliteVersion"] = sqlite3_libversion();
+        report["opsPerBenchmark"] = opts.ops;
+        report["maxSecondsPerBenchmark"] = opts.maxSeconds;
+        report["runs"] = nlohmann::ordered_json::array();
+
+        for (const auto n : opts.sizes) {
+            for (const auto& storage : opts.storages) {
+                // memstore: a massa é gerada num SQLite em memória e carregada no MemoryStore
+                const bool memstore = storage == "memstore";
+                const bool memory = storage == "memory" || memstore;
+                // orderlog: banco em arquivo, com os pedidos da massa copiados para o log em --dir
+                const bool orderlog = storage == "orderlog";
+                const std::string logDir = opts.dir + "/repo_bench_" + std::to_string(n) + ".orderlog";
+                if (orderlog) std::filesystem::remove_all(logDir);
+                const std::string path = memory ? ":memory:" : opts.dir + "/repo_bench_" + std::to_string(n) + ".db";
+                if (!memory) std::remove(path.c_str());
+
+                std::cerr << "dataset " << n << " (" << storage << ")\n";
+                {
+                    ecocin::infra::db::SqliteConnection cx(path);
+                    if (!memory) cx.enableConcurrentAccess(); // WAL, como no servidor com vários acceptors
+
+                    const auto seedStart = Clock::now();
+                    ecocin::bench::seedDataset(cx.raw(), n);
+                    const double seedSeconds = std::chrono::duration<double>(Clock::now() - seedStart).count();
+
+                    nlohmann::ordered_json results;
+                    if (memstore) {
+                        namespace mem = ecocin::infra::repositories::memory;
+                        mem::MemoryStore store;
+                        store.load(cx);
+                        mem::MemoryClientRepository clients(store);
+                        mem::MemoryProductRepository products(store);
+                        mem::MemoryAddressRepository addresses(store);
+                        mem::MemoryOrderRepository orders(store);
+                        results = runSuite(opts, clients, products, addresses, orders, nullptr, n);
+                    } else if (orderlog) {
+                        namespace sql = ecocin::infra::repositories::sqlite;
+                        sql::ClientRepositorySqlite clients(cx);
+                        sql::ProductRepositorySqlite products(cx);
+                        sql::AddressRepositorySqlite addresses(cx);
+                        ecocin::infra::repositories::orderlog::OrderLogRepository orders(logDir);
+                        // A massa tem ids 1..n, na ordem: o create do log atribui os mesmos
+                        auto seeded = sql::OrderRepositorySqlite(cx).listAll();
+                        std::reverse(seeded.begin(), seeded.end());
+                        for (const auto& o : seeded) orders.create(o);
+                        results = runSuite(opts, clients, products, addresses, orders, &products, n);
+                    } else {
+                        namespace sql = ecocin::infra::repositories::sqlite;
+                        sql::ClientRepositorySqlite clients(cx);
+                        sql::ProductRepositorySqlite products(cx);
+                        sql::AddressRepositorySqlite addresses(cx);
+                        sql::OrderRepositorySqlite orders(cx);
+                        results = runSuite(opts, clients, products, addresses, orders, &products, n);
+                    }
+
+                    report["runs"].push_back({
+                        {"rows", n},
+                        {"storage", storage},
+                        {"seedSeconds", seedSeconds},
+                        {"results", std::move(results)},
+                    });
+                }
+                if (orderlog) std::filesystem::remove_all(logDir);
+                if (!memory) {
+                    std::remove(path.c_str());
+                    std::remove((path + "-wal").c_str());
+                    std::remove((path + "-shm").c_str());
+                }
+            }
+        }
+
+        const auto text = report.dump(2);
+        if (opts.out.empty()) {
+            std::cout << text << '\n';
+        } else {
+            std::ofstream(opts.out) << text << '\n';
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "repo_bench: " << e.what() << '\n';
+        return 1;
+    }
+    return 0;
+}
@@ -1,15 +1,30 @@
+#include <chrono>
+#include <condition_variable>
 #include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 #include "oatpp/Environment.hpp"
 #include "oatpp/web/server/HttpRouter.hpp"
 #include "oatpp/web/server/HttpConnectionHandler.hpp"
+#include "oatpp/web/server/AsyncHttpConnectionHandler.hpp"
+#include "oatpp/async/Executor.hpp"
 #include "oatpp/network/Address.hpp"
 #include "oatpp/network/tcp/server/ConnectionProvider.hpp"
 #include "oatpp/network/Server.hpp"
 #include "oatpp/json/ObjectMapper.hpp"
 
 #include "infra/db/SqliteConnection.h"
+#include "infra/db/DbWorkerPool.h"
+#include "infra/db/QueryProfiler.h"
+#include "infra/db/OrderArchive.h"
+#include "infra/db/ShardSet.h"
+#include "infra/admission/AdmissionControl.h"
+#include "infra/net/ReusePortConnectionProvider.h"
 #include "app/Migrations.h"
+#include "app/ServerConfig.h"
 
 #include "infra/repositories/sqlite/ClientRepositorySqlite.h"
 #include "services/ClientService.h"
@@ -18,6 +33,7 @@
 #include "controllers/ProductController.h"
 #include "infra/repositories/sqlite/ProductRepositorySqlite.h"
 #include "services/ProductService.h"
+#include "services/StockHoldService.h"
 
 #include "controllers/AddressController.h"
 #include "infra/repositories/sqlite/AddressRepositorySqlite.h"
@@ -27,41 +43,151 @@
 #include "infra/repositories/sqlite/OrderRepositorySqlite.h"
 #include "services/OrderService.h"
 
+#include "infra/repositories/sharded/ShardedClientRepository.h"
+#include "infra/repositories/sharded/ShardedProductRepository.h"
+#include "infra/repositories/sharded/ShardedAddressRepository.h"
+#include "infra/repositories/sharded/ShardedOrderRepository.h"
 
-// A função `main` é o ponto de entrada da aplicação. Ela é responsável por
-// inicializar todos os componentes da arquitetura e iniciar o servidor web.
-// Este processo é conhecido como "Composição da Raiz" (Composition Root),
-// um padrão onde todas as dependências são construídas e injetadas em um único local.
-int main() {
-  // O primeiro passo é configurar o banco de dados.
-  // Uma conexão com o SQLite é estabelecida e as migrações (criação/atualização de tabelas)
-  // são executadas para garantir que o esquema do banco esteja atualizado.
-  ecocin::infra::db::SqliteConnection cx{"e-cocin.db"};
-  ecocin::app::runMigrations(cx.raw());
-
-  // Aqui começa a injeção de dependência manual.
-  // Para cada entidade (Cliente, Produto, etc.), o padrão é o mesmo:
-  // 1. Cria-se uma instância do Repositório, passando a conexão com o banco.
-  // 2. Cria-se uma instância do Serviço, passando o repositório como dependência.
-  // Este processo constrói a cadeia de dependências de baixo para cima (dados -> negócio).
-  auto clientRepo    = std::make_shared<ecocin::infra::repositories::sqlite::ClientRepositorySqlite>(cx);
-  auto clientService = std::make_shared<ecocin::services::ClientService>(*clientRepo);
+#include "infra/repositories/memory/MemoryStore.h"
+#include "infra/repositories/memory/MemoryClientRepository.h"
+#include "infra/repositories/memory/MemoryProductRepository.h"
+#include "infra/repositories/memory/MemoryAddressRepository.h"
+#include "infra/repositories/memory/MemoryOrderRepository.h"
 
-  // Product Repo + Service
-  auto productRepo    = std::make_shared<ecocin::infra::repositories::sqlite::ProductRepositorySqlite>(cx);
-  auto productService = std::make_shared<ecocin::services::ProductService>(*productRepo);
+#include "infra/repositories/orderlog/OrderLogRepository.h"
 
-  // Adress Repo + Service
-  auto addressRepo    = std::make_shared<ecocin::infra::repositories::sqlite::AddressRepositorySqlite>(cx);
-  auto addressService = std::make_shared<ecocin::services::AddressService>(*addressRepo, *clientRepo);
+#include "controllers/async/ClientAsyncController.h"
+#include "controllers/async/ProductAsyncController.h"
+#include "controllers/async/AddressAsyncController.h"
+#include "controllers/async/OrderAsyncController.h"
 
-  // Order Repo + Service
-  auto orderRepo    = std::make_shared<ecocin::infra::repositories::sqlite::OrderRepositorySqlite>(cx);
-  auto orderService = std::make_shared<ecocin::services::OrderService>(
-      *orderRepo, *clientRepo, *productRepo, *addressRepo);
+#include "controllers/MetricsController.h"
+#include "controllers/async/MetricsAsyncController.h"
+#include "controllers/AdminController.h"
+#include "controllers/async/AdminAsyncController.h"
 
-  // Com os serviços prontos, a próxima etapa é configurar a camada web usando o framework OATPP.
-  oatpp::Environment::init();
+#include "controllers/interceptors/CompressionInterceptor.h"
+#include "controllers/interceptors/MetricsInterceptor.h"
+#include "controllers/interceptors/AdmissionInterceptor.h"
+
+#include <spdlog/spdlog.h>
+
+// Uma pilha completa da aplicação: conexão com o banco, repositórios, serviços,
+// roteador e handler HTTP. No modo com vários acceptors cada thread recebe a sua,
+// de modo que nenhuma estrutura (nem a conexão SQLite) é disputada entre elas.
+struct AppStack {
+  std::unique_ptr<ecocin::infra::db::SqliteConnection> cx;       // banco único (ECOCIN_DB_SHARDS=1)
+  std::unique_ptr<ecocin::infra::db::ShardSet> shards;           // ou uma conexão por shard
+  std::unique_ptr<ecocin::infra::db::OrderArchive> orderArchive; // partições mensais anexadas a cx
+
+  std::shared_ptr<ecocin::domain::repositories::IClientRepository>  clientRepo;
+  std::shared_ptr<ecocin::domain::repositories::IProductRepository> productRepo;
+  std::shared_ptr<ecocin::domain::repositories::IAddressRepository> addressRepo;
+  std::shared_ptr<ecocin::domain::repositories::IOrderRepository>   orderRepo;
+
+  std::shared_ptr<ecocin::services::ClientService>  clientService;
+  std::shared_ptr<ecocin::services::ProductService> productService;
+  std::shared_ptr<ecocin::services::AddressService> addressService;
+  std::shared_ptr<ecocin::services::OrderService>   orderService;
+
+  std::shared_ptr<ecocin::infra::db::DbWorkerPool>   dbPool;
+  std::shared_ptr<oatpp::network::ConnectionHandler> connectionHandler;
+};
+
+// Registra os interceptors HTTP (comuns aos modos síncrono e assíncrono) no handler.
+template <class Handler>
+static void installInterceptors(Handler& handler, const ecocin::app::ServerConfig& config,
+                                const std::shared_ptr<ecocin::infra::admission::AdmissionControl>& admission) {
+  // Métricas primeiro: o tempo medido inclui todos os demais interceptors.
+  if (config.metricsEnabled) {
+    handler.addRequestInterceptor(std::make_shared<ecocin::controllers::interceptors::MetricsRequestInterceptor>());
+    handler.addResponseInterceptor(std::make_shared<ecocin::controllers::interceptors::MetricsResponseInterceptor>(
+        std::chrono::milliseconds(config.slowRequestMs)));
+  }
+  // Admissão logo depois: requisições recusadas (429/503) não chegam ao roteador,
+  // mas ainda aparecem nas métricas com o seu status.
+  if (admission) {
+    handler.addRequestInterceptor(std::make_shared<ecocin::controllers::interceptors::AdmissionRequestInterceptor>(
+        admission, config.trustedProxies));
+    handler.addResponseInterceptor(std::make_shared<ecocin::controllers::interceptors::AdmissionResponseInterceptor>(admission));
+  }
+  // Compressão fica por último: opera sobre o corpo final de cada resposta.
+  if (config.compressionEnabled) {
+    handler.addResponseInterceptor(std::make_shared<ecocin::controllers::interceptors::CompressionInterceptor>(
+        config.compressionMinBytes, config.compressionLevel));
+  }
+}
+
+// Monta uma pilha seguindo o padrão "Composição da Raiz" (Composition Root):
+// todas as dependências são construídas e injetadas em um único local.
+static std::unique_ptr<AppStack> buildStack(const ecocin::app::ServerConfig& config, bool sharedDb,
+                                            const std::shared_ptr<ecocin::infra::admission::AdmissionControl>& admission,
+                                            ecocin::services::StockHoldService& holds,
+                                            ecocin::services::LookupFlights& flights,
+                                            ecocin::infra::repositories::memory::MemoryStore* memory,
+                                            const std::shared_ptr<ecocin::infra::repositories::orderlog::OrderLogRepository>& orderLog) {
+  auto stack = std::make_unique<AppStack>();
+
+  // O primeiro passo é abrir a conexão com o banco. Quando várias pilhas escrevem no mesmo
+  // arquivo, o WAL permite leitores concorrentes e o busy timeout espera o lock do escritor.
+  // Com o profiler ligado, toda instrução executada nesta conexão é medida e agregada por SQL.
+  auto prepareConnection = [&](ecocin::infra::db::SqliteConnection& c) {
+    if (sharedDb) c.enableConcurrentAccess();
+    if (config.sqlProfileEnabled) {
+      auto& profiler = ecocin::infra::db::QueryProfiler::instance();
+      profiler.setSlowThreshold(std::chrono::milliseconds(config.slowQueryMs));
+      profiler.attach(c.raw());
+    }
+  };
+
+  if (memory) {
+    // Banco em memória: um só para o processo, compartilhado por todas as pilhas, sem conexão SQLite.
+    stack->clientRepo  = std::make_shared<ecocin::infra::repositories::memory::MemoryClientRepository>(*memory);
+    stack->productRepo = std::make_shared<ecocin::infra::repositories::memory::MemoryProductRepository>(*memory);
+    stack->addressRepo = std::make_shared<ecocin::infra::repositories::memory::MemoryAddressRepository>(*memory);
+    stack->orderRepo   = std::make_shared<ecocin::infra::repositories::memory::MemoryOrderRepository>(*memory);
+  } else if (config.dbShards > 1) {
+    // Com shards, cada arquivo tem a sua conexão (e o seu escritor) e os repositórios roteiam
+    // cada chamada para o shard do cliente; os serviços não percebem a diferença.
+    stack->shards = std::make_unique<ecocin::infra::db::ShardSet>(config.dbPath, config.dbShards);
+    for (std::size_t i = 0; i < stack->shards->size(); ++i) prepareConnection(stack->shards->shard(i));
+    stack->clientRepo  = std::make_shared<ecocin::infra::repositories::sharded::ShardedClientRepository>(*stack->shards);
+    stack->productRepo = std::make_shared<ecocin::infra::repositories::sharded::ShardedProductRepository>(*stack->shards);
+    stack->addressRepo = std::make_shared<ecocin::infra::repositories::sharded::ShardedAddressRepository>(*stack->shards);
+    stack->orderRepo   = std::make_shared<ecocin::infra::repositories::sharded::ShardedOrderRepository>(*stack->shards);
+  } else {
+    stack->cx = std::make_unique<ecocin::infra::db::SqliteConnection>(config.dbPath);
+    prepareConnection(*stack->cx);
+    auto& cx = *stack->cx;
+
+    // Com o arquivo de pedidos ligado, as partições mensais são anexadas a esta conexão e as
+    // leituras de pedidos passam pela view que junta a tabela quente e o arquivo.
+    std::string orderReadSource = "orders";
+    if (!config.archiveDir.empty()) {
+      stack->orderArchive = std::make_unique<ecocin::infra::db::OrderArchive>(cx, config.archiveDir);
+      orderReadSource = ecocin::infra::db::OrderArchive::kView;
+    }
+
+    // Aqui começa a injeção de dependência manual: cada repositório recebe a conexão com o banco.
+    stack->clientRepo  = std::make_shared<ecocin::infra::repositories::sqlite::ClientRepositorySqlite>(cx);
+    stack->productRepo = std::make_shared<ecocin::infra::repositories::sqlite::ProductRepositorySqlite>(cx);
+    stack->addressRepo = std::make_shared<ecocin::infra::repositories::sqlite::AddressRepositorySqlite>(cx);
+    stack->orderRepo   = std::make_shared<ecocin::infra::repositories::sqlite::OrderRepositorySqlite>(cx, orderReadSource);
+    // Com o log de pedidos, os pedidos saem da tabela orders: todas as pilhas usam o mesmo log
+    if (orderLog) stack->orderRepo = orderLog;
+  }
+
+  // Com os repositórios prontos, a injeção de dependência continua nos serviços.
+  // Para cada entidade (Cliente, Produto, etc.), o padrão é o mesmo: o Serviço recebe o
+  // Repositório (pela interface, então tanto faz se é um banco único, shards ou a memória).
+  // Este processo constrói a cadeia de dependências de baixo para cima (dados -> negócio).
+  // Com o log de pedidos não há chave estrangeira de orders: os serviços conferem no log antes de remover.
+  ecocin::domain::repositories::IOrderReferences* orderRefs = orderLog.get();
+  stack->clientService  = std::make_shared<ecocin::services::ClientService>(*stack->clientRepo, flights, orderRefs);
+  stack->productService = std::make_shared<ecocin::services::ProductService>(*stack->productRepo, flights, &holds, orderRefs);
+  stack->addressService = std::make_shared<ecocin::services::AddressService>(*stack->addressRepo, *stack->clientRepo, orderRefs);
+  stack->orderService   = std::make_shared<ecocin::services::OrderService>(
+      *stack->orderRepo, *stack->clientRepo, *stack->productRepo, *stack->addressRepo, flights, &holds);
 
   // O ObjectMapper é responsável por converter objetos C++ para JSON e vice-versa.
   // O HttpRouter gerencia o mapeamento das rotas (ex: "/clients") para os métodos dos controllers.
@@ -73,32 +199,299 @@ int main() {
   // 2. O Controller recebe o ObjectMapper (para manipulação de JSON) e o Serviço correspondente.
   // 3. O Controller é registrado no roteador, associando seus endpoints (ex: GET /clients)
   //    às funções que irão tratar as requisições.
-  auto controller = std::make_shared<ClientController>(objectMapper, clientService);
-  router->addController(controller);
+  // No modo assíncrono os controllers equivalentes com ENDPOINT_ASYNC são usados e as chamadas
+  // aos serviços (que bloqueiam no SQLite) passam por um pool limitado de workers de banco.
+  // As rotas de cada controller também são registradas nas métricas, para agregar por rota (ex.: /products/{id}).
+  std::vector<std::shared_ptr<oatpp::web::server::api::ApiController>> controllers;
+  auto addControllers = [&] {
+    for (const auto& c : controllers) {
+      router->addController(c);
+      if (config.metricsEnabled) ecocin::controllers::interceptors::registerRouteMetrics(c);
+    }
+  };
+
+  if (config.mode == ecocin::app::ServerMode::Async) {
+    stack->dbPool = std::make_shared<ecocin::infra::db::DbWorkerPool>(config.dbWorkers, config.dbQueueCapacity);
+
+    controllers.push_back(std::make_shared<ClientAsyncController>(objectMapper, stack->clientService, stack->dbPool));
+    controllers.push_back(std::make_shared<ProductAsyncController>(objectMapper, stack->productService, stack->dbPool));
+    controllers.push_back(std::make_shared<AddressAsyncController>(objectMapper, stack->addressService, stack->dbPool));
+    controllers.push_back(std::make_shared<OrderAsyncController>(objectMapper, stack->orderService, stack->dbPool));
+    if (config.metricsEnabled) controllers.push_back(std::make_shared<MetricsAsyncController>(objectMapper));
+    controllers.push_back(std::make_shared<AdminAsyncController>(objectMapper, admission));
+    addControllers();
+
+    // O executor roda as corrotinas em poucas threads (dados, I/O e timers);
+    // o número de conexões abertas deixa de determinar o número de threads.
+    auto executor = std::make_shared<oatpp::async::Executor>(
+        config.asyncDataThreads, config.asyncIoThreads, config.asyncTimerThreads);
+    auto handler = oatpp::web::server::AsyncHttpConnectionHandler::createShared(router, executor);
+    installInterceptors(*handler, config, admission);
+    stack->connectionHandler = handler;
+  } else {
+    auto controller = std::make_shared<ClientController>(objectMapper, stack->clientService);
+    controllers.push_back(controller);
+
+    auto productController = std::make_shared<ProductController>(objectMapper, stack->productService);
+    controllers.push_back(productController);
+
+    auto addressController = std::make_shared<AddressController>(objectMapper, stack->addressService);
+    controllers.push_back(addressController);
+
+    auto orderController = std::make_shared<OrderController>(objectMapper, stack->orderService);
+    controllers.push_back(orderController);
+
+    if (config.metricsEnabled) controllers.push_back(std::make_shared<MetricsController>(objectMapper));
+    controllers.push_back(std::make_shared<AdminController>(objectMapper, admission));
+    addControllers();
+
+    auto handler = oatpp::web::server::HttpConnectionHandler::createShared(router);
+    installInterceptors(*handler, config, admission);
+    stack->connectionHandler = handler;
+  }
+  return stack;
+}
+
+// A função `main` é o ponto de entrada da aplicação. Ela lê a configuração, prepara o banco,
+// monta uma pilha por acceptor e inicia o(s) servidor(es) web.
+int main() {
+  // Configuração (modo do servidor, porta, banco, nº de acceptors...) vinda de variáveis de ambiente.
+  auto config = ecocin::app::loadServerConfig();
+
+  if (config.acceptors > 1 && !ecocin::infra::net::ReusePortConnectionProvider::isSupported()) {
+    spdlog::warn("SO_REUSEPORT indisponível nesta plataforma; usando um único acceptor");
+    config.acceptors = 1;
+  }
+  const bool multiAcceptor = config.acceptors > 1;
+  // Com o banco em memória não há arquivos SQLite no caminho das requisições: shards e arquivo não se aplicam
+  const bool memoryStorage = config.storage == ecocin::app::StorageEngine::Memory;
+  if (memoryStorage && (config.dbShards > 1 || !config.archiveDir.empty())) {
+    spdlog::warn("ECOCIN_DB_SHARDS e ECOCIN_ARCHIVE_DIR não se aplicam a ECOCIN_STORAGE=memory; ignorados");
+    config.dbShards = 1;
+    config.archiveDir.clear();
+  }
+  // O arquivo de pedidos anexa partições a uma conexão única; com shards ele fica desligado
+  if (config.dbShards > 1 && !config.archiveDir.empty()) {
+    spdlog::warn("ECOCIN_ARCHIVE_DIR não é suportado com ECOCIN_DB_SHARDS > 1; arquivo de pedidos desligado");
+    config.archiveDir.clear();
+  }
+  // O log de pedidos substitui só a tabela orders de um banco único; o arquivo move linhas dessa tabela
+  if (!config.orderLogDir.empty() && (memoryStorage || config.dbShards > 1)) {
+    spdlog::warn("ECOCIN_ORDER_LOG_DIR não se aplica a ECOCIN_STORAGE=memory nem a ECOCIN_DB_SHARDS > 1; ignorado");
+    config.orderLogDir.clear();
+  }
+  if (!config.orderLogDir.empty() && !ecocin::infra::repositories::orderlog::OrderSegment::isSupported()) {
+    spdlog::warn("log de pedidos (mmap) indisponível nesta plataforma; usando a tabela orders");
+    config.orderLogDir.clear();
+  }
+  if (!config.orderLogDir.empty() && !config.archiveDir.empty()) {
+    spdlog::warn("ECOCIN_ARCHIVE_DIR não se aplica com ECOCIN_ORDER_LOG_DIR; arquivo de pedidos desligado");
+    config.archiveDir.clear();
+  }
+  // O job de arquivamento escreve por uma conexão própria, então o banco também passa a ser compartilhado
+  const bool archiveJob = !config.archiveDir.empty() && config.archiveAfterDays > 0;
+  const bool sharedDb = multiAcceptor || archiveJob;
+
+  // As migrações (criação/atualização de tabelas) rodam uma única vez, antes de qualquer
+  // pilha ser criada, para garantir que o esquema do banco esteja atualizado.
+  // Com shards, rodam em cada arquivo, que também recebe a sua faixa de ids (ShardSet::prepare).
+  for (std::size_t i = 0; !memoryStorage && i < config.dbShards; ++i) {
+    ecocin::infra::db::SqliteConnection migrationCx{ecocin::infra::db::ShardSet::shardPath(config.dbPath, i)};
+    if (sharedDb) migrationCx.enableConcurrentAccess();
+    ecocin::app::runMigrations(migrationCx.raw());
+    ecocin::infra::db::ShardSet::prepare(migrationCx, i, config.dbShards);
+  }
+  // Emails de clientes são únicos entre shards pelo registro do shard 0, refeito aqui com os dados de todos
+  if (!memoryStorage && config.dbShards > 1) {
+    ecocin::infra::db::ShardSet bootShards{config.dbPath, config.dbShards};
+    ecocin::infra::repositories::sharded::ShardedClientRepository::rebuildEmailRegistry(bootShards);
+  }
+
+  // O log de pedidos não importa a tabela orders: se ela já tem pedidos, eles sumiriam da API.
+  // Nesse caso o servidor não sobe (o log só vale para um banco cuja tabela orders está vazia).
+  if (!config.orderLogDir.empty()) {
+    ecocin::infra::db::SqliteConnection checkCx{config.dbPath};
+    if (sharedDb) checkCx.enableConcurrentAccess();
+    bool hasOrders = false;
+    {
+      ecocin::infra::db::Statement st(checkCx, "SELECT EXISTS(SELECT 1 FROM orders)", "prepare orders check");
+      hasOrders = sqlite3_step(st) == SQLITE_ROW && sqlite3_column_int(st, 0) != 0;
+    }
+    if (hasOrders) {
+      spdlog::error("ECOCIN_ORDER_LOG_DIR definido, mas a tabela orders de {} já tem pedidos, que não estão no log; "
+                    "desligue o log ou use um banco sem pedidos", config.dbPath);
+      return 1;
+    }
+  }
+
+  // Meses do arquivo de pedidos além do limite de anexos vão para o arquivo frio antes de as
+  // conexões de leitura abrirem: cada uma precisa anexar todas as partições.
+  if (!config.archiveDir.empty()) {
+    ecocin::infra::db::SqliteConnection archiveCx{config.dbPath};
+    if (sharedDb) archiveCx.enableConcurrentAccess();
+    if (const auto rolled = ecocin::infra::db::OrderArchive::consolidate(archiveCx, config.archiveDir)) {
+      spdlog::info("arquivo de pedidos: {} meses consolidados no arquivo frio", rolled);
+    }
+  }
+
+  // Controle de admissão (limite por IP e descarte de carga), único para o processo: todos os
+  // acceptors disputam o mesmo banco, então os limites valem para o servidor como um todo.
+  std::shared_ptr<ecocin::infra::admission::AdmissionControl> admission;
+  if (config.rateLimitRps > 0 || config.maxInFlight > 0 || config.latencyTargetMs > 0) {
+    ecocin::infra::admission::AdmissionConfig ac;
+    ac.ratePerSec    = static_cast<double>(config.rateLimitRps);
+    ac.burst         = static_cast<double>(config.rateLimitBurst);
+    ac.maxInFlight   = config.maxInFlight;
+    ac.latencyTarget = std::chrono::milliseconds(config.latencyTargetMs);
+    admission = std::make_shared<ecocin::infra::admission::AdmissionControl>(ac);
+  }
+
+  // Reservas de estoque também são do processo: uma reserva feita por um acceptor precisa
+  // descontar o disponível visto pelos outros.
+  ecocin::services::StockHoldService holds;
+
+  // Pelo mesmo motivo, os agrupamentos de buscas por chave (SingleFlight) são um só: uma escrita
+  // em qualquer acceptor invalida as buscas em andamento de todos.
+  ecocin::services::LookupFlights flights;
+
+  // Banco em memória, também um por processo; o snapshot, se configurado, é carregado aqui.
+  std::unique_ptr<ecocin::infra::repositories::memory::MemoryStore> memory;
+  if (memoryStorage) {
+    memory = std::make_unique<ecocin::infra::repositories::memory::MemoryStore>();
+    if (!config.memorySnapshot.empty() && memory->loadSnapshot(config.memorySnapshot)) {
+      spdlog::info("banco em memória carregado de {}: {} clientes, {} produtos, {} pedidos", config.memorySnapshot,
+                   memory->clients.size(), memory->products.size(), memory->orders.size());
+    }
+  }
+
+  // Log de pedidos, um por processo (o fim do log é um só); relido aqui para montar os índices
+  std::shared_ptr<ecocin::infra::repositories::orderlog::OrderLogRepository> orderLog;
+  if (!config.orderLogDir.empty()) {
+    orderLog = std::make_shared<ecocin::infra::repositories::orderlog::OrderLogRepository>(
+        config.orderLogDir, ecocin::infra::repositories::orderlog::OrderLogRepository::kDefaultSegmentRecords,
+        config.orderLogSync);
+    const auto stats = orderLog->stats();
+    spdlog::info("log de pedidos em {}: {} segmentos, {} registros, {} pedidos", config.orderLogDir,
+                 stats.segments, stats.records, stats.orders);
+  }
+
+  // Com o banco pronto, a próxima etapa é configurar a camada web usando o framework OATPP.
+  oatpp::Environment::init();
+  {
+    std::vector<std::unique_ptr<AppStack>> stacks;
+    std::vector<std::shared_ptr<oatpp::network::Server>> servers;
+
+    for (std::size_t i = 0; i < config.acceptors; ++i) {
+      stacks.push_back(buildStack(config, sharedDb, admission, holds, flights, memory.get(), orderLog));
+
+      // O provedor de conexão aceita as conexões TCP. Com um acceptor usamos o provedor padrão do oatpp;
+      // com vários, cada um abre o seu próprio socket na mesma porta com SO_REUSEPORT e o kernel
+      // distribui as novas conexões entre eles (e, portanto, entre os núcleos).
+      // Nos dois casos as conexões levam o endereço do par ("peer_address"), que identifica o
+      // cliente no limite por IP; sem ele todas as requisições cairiam no mesmo balde.
+      std::shared_ptr<oatpp::network::ServerConnectionProvider> provider;
+      if (multiAcceptor) {
+        provider = ecocin::infra::net::ReusePortConnectionProvider::createShared(config.host, config.port);
+      } else {
+        provider = oatpp::network::tcp::server::ConnectionProvider::createShared(
+            {config.host.c_str(), config.port, oatpp::network::Address::IP_4}, // Por padrão escuta em todas as interfaces na porta 8000.
+            true /* useExtendedConnections: preenche peer_address */);
+      }
+
+      // O objeto 'Server' une o provedor de conexão com o manipulador de conexões
+      // (que processa as requisições HTTP através do roteador).
+      servers.push_back(std::make_shared<oatpp::network::Server>(provider, stacks.back()->connectionHandler));
+    }
+
+    std::cout << "🚀 API rodando em http://localhost:" << config.port
+              << (config.mode == ecocin::app::ServerMode::Async ? " (async)" : "")
+              << (multiAcceptor ? " com " + std::to_string(config.acceptors) + " acceptors" : std::string{})
+              << "\n";
 
-  auto productController = std::make_shared<ProductController>(objectMapper, productService);
-  router->addController(productController);
+    // O método 'run()' inicia o loop do servidor, que fica aguardando e processando requisições.
+    // É um processo bloqueante: os acceptors extras rodam em threads próprias e o primeiro
+    // ocupa a thread principal, mantendo a aplicação viva.
+    std::vector<std::thread> acceptorThreads;
+    for (std::size_t i = 1; i < servers.size(); ++i) {
+      acceptorThreads.emplace_back([server = servers[i]] { server->run(); });
+    }
 
-  auto addressController = std::make_shared<AddressController>(objectMapper, addressService);
-  router->addController(addressController);
+    // Jobs em segundo plano; param quando o servidor para (stopping).
+    std::mutex jobMutex;
+    std::condition_variable jobCv;
+    bool stopping = false;
 
-  auto orderController = std::make_shared<OrderController>(objectMapper, orderService);
-  router->addController(orderController);
+    // Job de arquivamento: de tempos em tempos move os pedidos mais antigos que o limite para as
+    // partições mensais, em lotes, por uma conexão própria (as pilhas só leem o arquivo).
+    std::thread archiveThread;
+    if (archiveJob) {
+      archiveThread = std::thread([&] {
+        ecocin::infra::db::SqliteConnection jobCx{config.dbPath};
+        jobCx.enableConcurrentAccess();
+        std::unique_lock<std::mutex> lock(jobMutex);
+        while (!stopping) {
+          lock.unlock();
+          try {
+            const auto cutoff = std::chrono::duration_cast<std::chrono::seconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count() -
+                static_cast<std::int64_t>(config.archiveAfterDays) * 86400;
+            const auto stats = ecocin::infra::db::OrderArchive::archiveBefore(
+                jobCx, config.archiveDir, cutoff, config.archiveBatch);
+            if (stats.moved > 0) {
+              spdlog::info("arquivo de pedidos: {} pedidos movidos em {} lotes", stats.moved, stats.batches);
+            }
+          } catch (const std::exception& e) {
+            spdlog::error("arquivo de pedidos: {}", e.what());
+          }
+          lock.lock();
+          jobCv.wait_for(lock, std::chrono::seconds(config.archiveIntervalS), [&] { return stopping; });
+        }
+      });
+    }
 
-  // Com todas as rotas e controllers configurados no roteador,
-  // os componentes finais do servidor são montados.
-  auto connectionHandler = oatpp::web::server::HttpConnectionHandler::createShared(router);
-  auto provider = oatpp::network::tcp::server::ConnectionProvider::createShared(
-      {"0.0.0.0", 8000, oatpp::network::Address::IP_4}); // Escuta em todas as interfaces na porta 8000.
+    // Snapshot periódico do banco em memória (o último é gravado ao encerrar, depois dos servidores)
+    std::thread snapshotThread;
+    if (memory && !config.memorySnapshot.empty() && config.memorySnapshotIntervalS > 0) {
+      snapshotThread = std::thread([&] {
+        std::unique_lock<std::mutex> lock(jobMutex);
+        while (!jobCv.wait_for(lock, std::chrono::seconds(config.memorySnapshotIntervalS), [&] { return stopping; })) {
+          lock.unlock();
+          try {
+            memory->saveSnapshot(config.memorySnapshot);
+          } catch (const std::exception& e) {
+            spdlog::error("snapshot do banco em memória: {}", e.what());
+          }
+          lock.lock();
+        }
+      });
+    }
 
-  // O objeto 'Server' é criado, unindo o provedor de conexão (que aceita conexões TCP)
-  // com o manipulador de conexões (que processa as requisições HTTP através do roteador).
-  oatpp::network::Server server(provider, connectionHandler);
-  std::cout << "🚀 API rodando em http://localhost:8000\n";
+    servers.front()->run();
 
-  // O método 'run()' inicia o loop do servidor, que fica aguardando e processando requisições.
-  // Este é um processo bloqueante que mantém a aplicação viva.
-  server.run();
+    for (auto& s : servers) s->stop();
+    for (auto& t : acceptorThreads) t.join();
+    {
+      std::lock_guard<std::mutex> lock(jobMutex);
+      stopping = true;
+    }
+    jobCv.notify_all();
+    if (archiveThread.joinable()) archiveThread.join();
+    if (snapshotThread.joinable()) snapshotThread.join();
+    if (memory && !config.memorySnapshot.empty()) {
+      try {
+        memory->saveSnapshot(config.memorySnapshot);
+      } catch (const std::exception& e) {
+        spdlog::error("snapshot do banco em memória: {}", e.what());
+      }
+    }
+    if (orderLog) {
+      try {
+        orderLog->sync();
+      } catch (const std::exception& e) {
+        spdlog::error("sync do log de pedidos: {}", e.what());
+      }
+    }
+  }
 
   // Após o término do servidor (ex: com um sinal de interrupção),
   // o ambiente do OATPP é finalizado para liberar recursos.
@@ -66,7 +66,11 @@ CREATE TABLE IF NOT EXISTS addresses (
   FOREIGN KEY (client_id) REFERENCES clients(id)
 );
 -- Índices auxiliares
-CREATE INDEX IF NOT EXISTS idx_addresses_client_id ON addresses(client_id);
+-- (client_id, create_date) atende listByClientId já na ordem pedida; (client_id, address_type, create_date)
+-- atende findByClientIdAndType. Os dois substituem o antigo idx_addresses_client_id (ver index_advisor).
+CREATE INDEX IF NOT EXISTS idx_addresses_client_id_create_date ON addresses(client_id, create_date);
+CREATE INDEX IF NOT EXISTS idx_addresses_client_id_address_type_create_date ON addresses(client_id, address_type, create_date);
+DROP INDEX IF EXISTS idx_addresses_client_id;
 CREATE INDEX IF NOT EXISTS idx_addresses_zip ON addresses(zip);
 
 -- ===========================
@@ -88,10 +92,15 @@ CREATE TABLE IF NOT EXISTS orders (
   FOREIGN KEY (shipping_address_id) REFERENCES addresses(id)
 );
 
-CREATE INDEX IF NOT EXISTS idx_orders_client_id   ON orders(client_id);
+-- listByClientId ordena por create_date DESC, id DESC: o índice composto entrega as linhas nessa ordem
+-- (o rowid é a última coluna de todo índice) e substitui o antigo idx_orders_client_id
+CREATE INDEX IF NOT EXISTS idx_orders_client_id_create_date ON orders(client_id, create_date);
+DROP INDEX IF EXISTS idx_orders_client_id;
 CREATE INDEX IF NOT EXISTS idx_orders_product_id  ON orders(product_id);
 CREATE INDEX IF NOT EXISTS idx_orders_status      ON orders(status);
 CREATE INDEX IF NOT EXISTS idx_orders_create_date ON orders(create_date);
+-- Sem ele, cada DELETE em addresses varre orders inteira para checar a chave estrangeira
+CREATE INDEX IF NOT EXISTS idx_orders_shipping_address_id ON orders(shipping_address_id);
 
 )SQL";
 
@@ -0,0 +1,184 @@
+// Configuração do servidor lida de variáveis de ambiente
+// Todos os valores têm padrão, então rodar sem nenhuma variável mantém o comportamento original
+
+#ifndef ECOCIN_APP_SERVERCONFIG_H
+#define ECOCIN_APP_SERVERCONFIG_H
+
+#include <cstdlib>
+#include <string>
+#include <thread>
+
+namespace ecocin::app {
+
+// Modo de processamento das conexões HTTP
+enum class ServerMode {
+  Sync,  // HttpConnectionHandler: uma thread por conexão
+  Async  // AsyncHttpConnectionHandler: corrotinas sobre um executor com poucas threads
+};
+
+// Onde os repositórios guardam os dados
+enum class StorageEngine {
+  Sqlite, // arquivos SQLite (dbPath e, com shards, os demais)
+  Memory  // infra/repositories/memory: tudo em memória, com snapshot opcional em arquivo
+};
+
+struct ServerConfig {
+  ServerMode  mode{ServerMode::Sync};
+  std::string host{"0.0.0.0"};
+  unsigned short port{8000};
+  std::string dbPath{"e-cocin.db"};
+
+  // Shards por cliente (infra/db/ShardSet.h): 1 = um único banco em dbPath. Fixo depois de criado.
+  std::size_t dbShards{1};
+
+  // Banco em memória (ECOCIN_STORAGE=memory). Sem snapshot os dados somem ao encerrar o processo;
+  // com ele, o arquivo é carregado no boot e regravado a cada intervalo e ao encerrar.
+  StorageEngine storage{StorageEngine::Sqlite};
+  std::string memorySnapshot;
+  std::size_t memorySnapshotIntervalS{300}; // 0 = só ao encerrar
+
+  // Pedidos no log de segmentos mapeados em memória (infra/repositories/orderlog) em vez da tabela
+  // orders; vazio desliga. Com orderLogSync, cada gravação espera o disco.
+  std::string orderLogDir;
+  bool orderLogSync{false};
+
+  // Número de acceptors independentes na mesma porta (SO_REUSEPORT).
+  // Cada um tem sua própria conexão SQLite, serviços e handler HTTP.
+  std::size_t acceptors{1};
+
+  // Modo assíncrono: threads do executor do oatpp
+  std::size_t asyncDataThreads{1};
+  std::size_t asyncIoThreads{1};
+  std::size_t asyncTimerThreads{1};
+
+  // Pool de workers que executa as chamadas bloqueantes ao SQLite no modo assíncrono
+  std::size_t dbWorkers{4};
+  std::size_t dbQueueCapacity{1024};
+
+  // Compressão de respostas (gzip/deflate conforme Accept-Encoding)
+  bool compressionEnabled{true};
+  std::size_t compressionMinBytes{1024}; // corpos menores seguem sem compressão
+  int compressionLevel{6};               // 1 (rápido) .. 9 (menor)
+
+  // Métricas (GET /metrics) e log de requisições lentas
+  bool metricsEnabled{true};
+  std::size_t slowRequestMs{1000};       // 0 desliga o log
+
+  // Profiler de consultas SQL (GET /admin/sql/top) e log de consultas lentas
+  bool sqlProfileEnabled{false};
+  std::size_t slowQueryMs{50};           // 0 desliga o log
+
+  // Controle de admissão (429/503 com Retry-After); tudo desligado por padrão
+  std::size_t rateLimitRps{0};           // requisições/s por IP (0 desliga)
+  std::size_t rateLimitBurst{0};         // rajada por IP (0 = 2x a taxa)
+  std::size_t trustedProxies{0};         // proxies confiáveis na frente: cliente por X-Forwarded-For (0 desliga)
+  std::size_t maxInFlight{0};            // requisições simultâneas antes de responder 503 (0 desliga)
+  std::size_t latencyTargetMs{0};        // alvo de latência do limite adaptativo (0 desliga)
+
+  // Arquivo de pedidos antigos em partições mensais anexadas (vazio desliga)
+  std::string archiveDir;
+  std::size_t archiveAfterDays{0};       // idade a partir da qual o job move os pedidos (0 = só leitura)
+  std::size_t archiveBatch{5000};        // pedidos por transação do job
+  std::size_t archiveIntervalS{3600};    // intervalo entre execuções do job
+};
+
+namespace detail {
+
+inline std::string envOr(const char* name, const std::string& fallback) {
+  const char* v = std::getenv(name);
+  return (v && *v) ? std::string(v) : fallback;
+}
+
+inline std::size_t envOr(const char* name, std::size_t fallback) {
+  const char* v = std::getenv(name);
+  if (!v || !*v) return fallback;
+  char* end = nullptr;
+  const unsigned long long parsed = std::strtoull(v, &end, 10);
+  return (end && *end == '\0') ? static_cast<std::size_t>(parsed) : fallback;
+}
+
+} // namespace detail
+
+// Monta a configuração a partir do ambiente:
+//   ECOCIN_SERVER_MODE        sync | async            (padrão: sync)
+//   ECOCIN_HOST / ECOCIN_PORT                         (padrão: 0.0.0.0:8000)
+//   ECOCIN_DB_PATH                                    (padrão: e-cocin.db)
+//   ECOCIN_DB_SHARDS                                  (padrão: 1; >1 divide clientes e pedidos em arquivos)
+//   ECOCIN_STORAGE            sqlite | memory         (padrão: sqlite)
+//   ECOCIN_MEMORY_SNAPSHOT                            (padrão: vazio, banco em memória sem persistência)
+//   ECOCIN_MEMORY_SNAPSHOT_INTERVAL_S                 (padrão: 300; 0 = só ao encerrar)
+//   ECOCIN_ORDER_LOG_DIR                              (padrão: vazio, pedidos na tabela orders)
+//   ECOCIN_ORDER_LOG_SYNC     on | off                (padrão: off)
+//   ECOCIN_ACCEPTORS                                  (padrão: 1; >1 usa SO_REUSEPORT; 0 = um por núcleo)
+//   ECOCIN_ASYNC_DATA_THREADS / _IO_THREADS / _TIMER_THREADS
+//   ECOCIN_DB_WORKERS / ECOCIN_DB_QUEUE               (pool de acesso ao banco no modo async)
+//   ECOCIN_COMPRESSION        on | off                (padrão: on)
+//   ECOCIN_COMPRESSION_MIN_BYTES / ECOCIN_COMPRESSION_LEVEL
+//   ECOCIN_METRICS            on | off                (padrão: on)
+//   ECOCIN_SLOW_REQUEST_MS                            (padrão: 1000; 0 desliga)
+//   ECOCIN_SQL_PROFILE        on | off                (padrão: off)
+//   ECOCIN_SLOW_QUERY_MS                              (padrão: 50; 0 desliga)
+//   ECOCIN_RATE_LIMIT_RPS / ECOCIN_RATE_LIMIT_BURST   (padrão: 0, sem limite por IP)
+//   ECOCIN_TRUST_PROXY        off | on | N            (padrão: off; on = 1 proxy)
+//   ECOCIN_MAX_IN_FLIGHT / ECOCIN_LATENCY_TARGET_MS   (padrão: 0, sem descarte de carga)
+//   ECOCIN_ARCHIVE_DIR                                (padrão: vazio, sem arquivo de pedidos)
+//   ECOCIN_ARCHIVE_AFTER_DAYS / _BATCH / _INTERVAL_S  (padrão: 0 / 5000 / 3600)
+inline ServerConfig loadServerConfig() {
+  ServerConfig cfg;
+  const auto hw = std::thread::hardware_concurrency();
+
+  cfg.mode   = detail::envOr("ECOCIN_SERVER_MODE", std::string("sync")) == "async"
+                 ? ServerMode::Async : ServerMode::Sync;
+  cfg.host   = detail::envOr("ECOCIN_HOST", cfg.host);
+  cfg.port   = static_cast<unsigned short>(detail::envOr("ECOCIN_PORT", std::size_t{cfg.port}));
+  cfg.dbPath = detail::envOr("ECOCIN_DB_PATH", cfg.dbPath);
+  cfg.dbShards = detail::envOr("ECOCIN_DB_SHARDS", cfg.dbShards);
+  if (cfg.dbShards == 0) cfg.dbShards = 1;
+  cfg.storage = detail::envOr("ECOCIN_STORAGE", std::string("sqlite")) == "memory"
+                  ? StorageEngine::Memory : StorageEngine::Sqlite;
+  cfg.memorySnapshot = detail::envOr("ECOCIN_MEMORY_SNAPSHOT", cfg.memorySnapshot);
+  cfg.memorySnapshotIntervalS = detail::envOr("ECOCIN_MEMORY_SNAPSHOT_INTERVAL_S", cfg.memorySnapshotIntervalS);
+  cfg.orderLogDir = detail::envOr("ECOCIN_ORDER_LOG_DIR", cfg.orderLogDir);
+  cfg.orderLogSync = detail::envOr("ECOCIN_ORDER_LOG_SYNC", std::string("off")) == "on";
+  cfg.acceptors = detail::envOr("ECOCIN_ACCEPTORS", cfg.acceptors);
+  if (cfg.acceptors == 0) cfg.acceptors = hw ? hw : 1;
+
+  cfg.asyncDataThreads  = detail::envOr("ECOCIN_ASYNC_DATA_THREADS", std::size_t{hw ? hw : 1});
+  cfg.asyncIoThreads    = detail::envOr("ECOCIN_ASYNC_IO_THREADS", cfg.asyncIoThreads);
+  cfg.asyncTimerThreads = detail::envOr("ECOCIN_ASYNC_TIMER_THREADS", cfg.asyncTimerThreads);
+
+  cfg.dbWorkers       = detail::envOr("ECOCIN_DB_WORKERS", cfg.dbWorkers);
+  cfg.dbQueueCapacity = detail::envOr("ECOCIN_DB_QUEUE", cfg.dbQueueCapacity);
+  if (cfg.dbWorkers == 0) cfg.dbWorkers = 1;
+  if (cfg.dbQueueCapacity == 0) cfg.dbQueueCapacity = 1;
+
+  cfg.compressionEnabled  = detail::envOr("ECOCIN_COMPRESSION", std::string("on")) != "off";
+  cfg.compressionMinBytes = detail::envOr("ECOCIN_COMPRESSION_MIN_BYTES", cfg.compressionMinBytes);
+  const auto level = detail::envOr("ECOCIN_COMPRESSION_LEVEL", std::size_t(cfg.compressionLevel));
+  cfg.compressionLevel = static_cast<int>(level < 1 ? 1 : (level > 9 ? 9 : level));
+
+  cfg.metricsEnabled = detail::envOr("ECOCIN_METRICS", std::string("on")) != "off";
+  cfg.slowRequestMs  = detail::envOr("ECOCIN_SLOW_REQUEST_MS", cfg.slowRequestMs);
+
+  cfg.sqlProfileEnabled = detail::envOr("ECOCIN_SQL_PROFILE", std::string("off")) == "on";
+  cfg.slowQueryMs       = detail::envOr("ECOCIN_SLOW_QUERY_MS", cfg.slowQueryMs);
+
+  cfg.rateLimitRps    = detail::envOr("ECOCIN_RATE_LIMIT_RPS", cfg.rateLimitRps);
+  cfg.rateLimitBurst  = detail::envOr("ECOCIN_RATE_LIMIT_BURST", cfg.rateLimitBurst);
+  const auto trustProxy = detail::envOr("ECOCIN_TRUST_PROXY", std::string("off"));
+  cfg.trustedProxies  = trustProxy == "on" ? 1 : detail::envOr("ECOCIN_TRUST_PROXY", std::size_t{0});
+  cfg.maxInFlight     = detail::envOr("ECOCIN_MAX_IN_FLIGHT", cfg.maxInFlight);
+  cfg.latencyTargetMs = detail::envOr("ECOCIN_LATENCY_TARGET_MS", cfg.latencyTargetMs);
+
+  cfg.archiveDir       = detail::envOr("ECOCIN_ARCHIVE_DIR", cfg.archiveDir);
+  cfg.archiveAfterDays = detail::envOr("ECOCIN_ARCHIVE_AFTER_DAYS", cfg.archiveAfterDays);
+  cfg.archiveBatch     = detail::envOr("ECOCIN_ARCHIVE_BATCH", cfg.archiveBatch);
+  cfg.archiveIntervalS = detail::envOr("ECOCIN_ARCHIVE_INTERVAL_S", cfg.archiveIntervalS);
+  if (cfg.archiveBatch == 0) cfg.archiveBatch = 1;
+  if (cfg.archiveIntervalS == 0) cfg.archiveIntervalS = 1;
+  return cfg;
+}
+
+} // namespace ecocin::app
+
+#endif // ECOCIN_APP_SERVERCONFIG_H
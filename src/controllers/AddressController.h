@@ -6,6 +6,8 @@
 #include "../services/AddressService.h"
 #include "dto/AddressDto.h"
 #include "dto/AddressOutDto.h"
+#include "codec/EntityResponse.h"
+#include "../infra/memory/RequestArena.h"
 #include <memory>
 #include <chrono>
 
@@ -20,6 +22,7 @@ class AddressController : public oatpp::web::server::api::ApiController {
 private:
   std::shared_ptr<ecocin::services::AddressService> addressService;
 
+public:
   // Converte um objeto de domínio 'Address' para um 'AddressOutDto' (Data Transfer Object).
   // O uso de DTOs é uma prática de encapsulamento que desacopla a representação interna
   // do domínio daquela exposta pela API. Isso permite que o modelo de domínio evolua
@@ -39,7 +42,6 @@ private:
     return dto;
   }
 
-public:
   // O construtor utiliza injeção de dependência para receber o serviço de endereço.
   // Isso segue o princípio da Inversão de Dependência, tornando o controller
   // independente da forma como o serviço é criado e facilitando os testes unitários
@@ -77,16 +79,13 @@ public:
   }
 
   // Define o endpoint para listar todos os endereços.
-  // O controller delega a busca dos dados para a camada de serviço, recebe a lista
-  // de objetos de domínio e a transforma em uma lista de DTOs para a resposta.
-  // Essa transformação garante que a API exponha apenas os dados necessários e no formato correto.
-  ENDPOINT("GET", "/addresses", listAll) {
-    const auto items = addressService->listAll();
-    auto arr = oatpp::List<oatpp::Object<AddressOutDto>>::createShared();
-    for (const auto& addr : items) {
-      arr->push_back(toOutDto(addr));
-    }
-    return createDtoResponse(Status::CODE_200, arr);
+  // O controller delega a busca dos dados para a camada de serviço e serializa a lista
+  // de objetos de domínio direto no corpo da resposta, guiado pelos descritores de campos
+  // (codec/EntityFields.h), que expõem apenas os dados do contrato do AddressOutDto.
+  ENDPOINT("GET", "/addresses", listAll, REQUEST(std::shared_ptr<IncomingRequest>, request)) {
+    ecocin::infra::memory::RequestArena arena; // vetor de endereços alocado na arena da requisição
+    const auto items = addressService->listAll(arena.resource());
+    return ecocin::controllers::codec::entityResponse<Address>(request, Status::CODE_200, items);
   }
 
   // Define o endpoint para listar os endereços de um cliente específico.
@@ -95,11 +94,11 @@ public:
   // é gerenciar o fluxo da requisição e resposta, mantendo a lógica de negócio
   // isolada na camada de serviço.
   ENDPOINT("GET", "/clients/{cpf}/addresses", listAddressesByCpf,
-           PATH(String, cpf)) {
-    auto list = addressService->listByCpf(std::string(cpf->c_str()));
-    auto arr = oatpp::List<oatpp::Object<AddressOutDto>>::createShared();
-    for (const auto& a : list) arr->push_back(toOutDto(a));
-    return createDtoResponse(Status::CODE_200, arr);
+           PATH(String, cpf),
+           REQUEST(std::shared_ptr<IncomingRequest>, request)) {
+    ecocin::infra::memory::RequestArena arena;
+    auto list = addressService->listByCpf(std::string(cpf->c_str()), arena.resource());
+    return ecocin::controllers::codec::entityResponse<Address>(request, Status::CODE_200, list);
   }
 };
 
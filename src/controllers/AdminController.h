@@ -0,0 +1,66 @@
+#pragma once
+#include "oatpp/macro/codegen.hpp"
+#include "oatpp/web/server/api/ApiController.hpp"
+#include "oatpp/json/ObjectMapper.hpp"
+#include "oatpp/web/protocol/http/outgoing/BufferBody.hpp"
+#include "codec/EntityResponse.h"
+#include "../infra/admission/AdmissionControl.h"
+#include "../infra/db/QueryProfiler.h"
+#include <cstdlib>
+#include <memory>
+#include <string>
+
+#include OATPP_CODEGEN_BEGIN(ApiController)
+
+// O AdminController reúne rotas de diagnóstico do servidor, que não fazem parte da API de negócio.
+// GET /admin/sql/top?n=20 devolve as n consultas SQL com maior tempo acumulado, segundo o
+// QueryProfiler (vazio quando ECOCIN_SQL_PROFILE não está ligado).
+// GET /health responde sempre (é rota crítica para o controle de admissão) e, com o controle
+// ligado, traz as requisições em andamento, o limite atual e quantas foram recusadas.
+class AdminController : public oatpp::web::server::api::ApiController {
+private:
+  std::shared_ptr<ecocin::infra::admission::AdmissionControl> admission_; // nulo quando desligado
+
+public:
+  explicit AdminController(const std::shared_ptr<oatpp::json::ObjectMapper>& objectMapper,
+                           std::shared_ptr<ecocin::infra::admission::AdmissionControl> admission = nullptr)
+    : oatpp::web::server::api::ApiController(objectMapper), admission_(std::move(admission)) {}
+
+  // Monta a resposta do health check (compartilhado com o controller assíncrono)
+  static std::shared_ptr<OutgoingResponse> healthResponse(const ecocin::infra::admission::AdmissionControl* admission) {
+    std::string json = "{\"status\":\"ok\"";
+    if (admission) {
+      json += ",\"inFlight\":" + std::to_string(admission->inFlight());
+      json += ",\"limit\":" + std::to_string(admission->limit());
+      json += ",\"rateLimited\":" + std::to_string(admission->rateLimitedCount());
+      json += ",\"shed\":" + std::to_string(admission->shedCount());
+    }
+    json += "}";
+    auto body = oatpp::web::protocol::http::outgoing::BufferBody::createShared(oatpp::String(json), "application/json");
+    return OutgoingResponse::createShared(Status::CODE_200, body);
+  }
+
+  // Quantidade pedida em ?n= (padrão 20, limitada a 1000)
+  static std::size_t topCount(const std::shared_ptr<IncomingRequest>& request) {
+    const auto n = request->getQueryParameter("n");
+    if (!n) return 20;
+    const auto parsed = std::strtoul(n->c_str(), nullptr, 10);
+    return parsed == 0 ? 20 : (parsed > 1000 ? 1000 : static_cast<std::size_t>(parsed));
+  }
+
+  // Monta a resposta da tabela de consultas (compartilhado com o controller assíncrono)
+  static std::shared_ptr<OutgoingResponse> sqlTopResponse(const std::shared_ptr<IncomingRequest>& request) {
+    return ecocin::controllers::codec::entityResponse<ecocin::infra::db::QueryStats>(
+      request, Status::CODE_200, ecocin::infra::db::QueryProfiler::instance().top(topCount(request)));
+  }
+
+  ENDPOINT("GET", "/health", health) {
+    return healthResponse(admission_.get());
+  }
+
+  ENDPOINT("GET", "/admin/sql/top", sqlTop, REQUEST(std::shared_ptr<IncomingRequest>, request)) {
+    return sqlTopResponse(request);
+  }
+};
+
+#include OATPP_CODEGEN_END(ApiController)
@@ -6,6 +6,8 @@
 #include "../services/ClientService.h"
 #include "dto/ClientDto.h"
 #include "dto/ClientOutDto.h"
+#include "codec/EntityResponse.h"
+#include "../infra/memory/RequestArena.h"
 #include <memory>
 
 #include OATPP_CODEGEN_BEGIN(ApiController)
@@ -18,8 +20,9 @@ class ClientController : public oatpp::web::server::api::ApiController {
 private:
   std::shared_ptr<ecocin::services::ClientService> clientService;
 
+public:
 // Converte um objeto de domínio 'Client' em um 'ClientOutDto'.
-// Este método privado é um exemplo de encapsulamento e do padrão DTO (Data Transfer Object).
+// Este método (público para ser reaproveitado pelo controller assíncrono) é um exemplo de encapsulamento e do padrão DTO (Data Transfer Object).
 // Ele garante que a representação interna do cliente seja desacoplada da estrutura de dados
 // exposta pela API, permitindo modificações internas sem impactar os clientes da API.
 static oatpp::Object<ClientOutDto> toOutDto(const Client& c) {
@@ -34,7 +37,6 @@ static oatpp::Object<ClientOutDto> toOutDto(const Client& c) {
     return dto;
   }
 
-public:
   // O construtor utiliza injeção de dependência para obter o serviço de cliente.
   // Este design, alinhado com os princípios SOLID, promove o baixo acoplamento,
   // tornando o controller mais fácil de testar e manter, pois sua dependência
@@ -61,17 +63,14 @@ public:
 
 
   // Endpoint para listar todos os clientes cadastrados.
-  // O controller chama o serviço para obter a lista de clientes,
-  // converte cada objeto de domínio para seu DTO correspondente e retorna
-  // a lista como uma resposta JSON, demonstrando a separação de responsabilidades.
-  ENDPOINT("GET", "/clients", listAll) {
-    const auto clients = clientService->listAllClients();
+  // O controller chama o serviço para obter a lista de clientes e a serializa
+  // direto a partir das entidades (mesmo formato do ClientOutDto), sem criar um DTO por item,
+  // mantendo a separação de responsabilidades.
+  ENDPOINT("GET", "/clients", listAll, REQUEST(std::shared_ptr<IncomingRequest>, request)) {
+    ecocin::infra::memory::RequestArena arena; // vetor de clientes alocado na arena da requisição
+    const auto clients = clientService->listAllClients(arena.resource());
     
-    auto arr = oatpp::List<oatpp::Object<ClientOutDto>>::createShared();
-    for (const auto& c : clients) {
-      arr->push_back(toOutDto(c));
-    }
-    return createDtoResponse(Status::CODE_200, arr);
+    return ecocin::controllers::codec::entityResponse<Client>(request, Status::CODE_200, clients);
   }
 
 // Endpoint para buscar um cliente específico pelo seu CPF.
@@ -79,13 +78,14 @@ public:
 // para encontrar o cliente. Se o cliente não for encontrado, ele retorna um status 404 (Not Found),
 // tratando adequadamente os diferentes resultados da lógica de negócio.
 ENDPOINT("GET", "/clients/cpf/{cpf}", getClient,
-         PATH(String, cpf)) {
+         PATH(String, cpf),
+         REQUEST(std::shared_ptr<IncomingRequest>, request)) {
   const std::string key = cpf ? std::string(cpf->c_str()) : std::string{};
   auto client = clientService->getClientByCpf(key);
   if (!client) {
     return createResponse(Status::CODE_404, "Client not found");
   }
-  return createDtoResponse(Status::CODE_200, toOutDto(*client));
+  return ecocin::controllers::codec::entityResponse<Client>(request, Status::CODE_200, *client);
 }
 
   // Endpoint para buscar um cliente pelo seu ID técnico.
@@ -93,12 +93,13 @@ ENDPOINT("GET", "/clients/cpf/{cpf}", getClient,
   // a chamada ao serviço e a formatação da resposta, seja ela de sucesso (200 OK com os dados)
   // ou de erro (404 Not Found).
   ENDPOINT("GET", "/clients/{id}", getClientById,
-           PATH(Int64, id)) {
+           PATH(Int64, id),
+           REQUEST(std::shared_ptr<IncomingRequest>, request)) {
     auto client = clientService->getClientById(id);
     if (!client) {
       return createResponse(Status::CODE_404, "Client not found");
     }
-  return createDtoResponse(Status::CODE_200, toOutDto(*client));
+  return ecocin::controllers::codec::entityResponse<Client>(request, Status::CODE_200, *client);
 }
 
 };
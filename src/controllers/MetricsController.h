@@ -0,0 +1,35 @@
+#pragma once
+#include "oatpp/macro/codegen.hpp"
+#include "oatpp/web/server/api/ApiController.hpp"
+#include "oatpp/web/protocol/http/outgoing/BufferBody.hpp"
+#include "oatpp/json/ObjectMapper.hpp"
+#include "../infra/metrics/Metrics.h"
+#include <memory>
+
+#include OATPP_CODEGEN_BEGIN(ApiController)
+
+// Content-Type do formato de exposição em texto do Prometheus
+inline constexpr const char* kPrometheusContentType = "text/plain; version=0.0.4; charset=utf-8";
+
+// O MetricsController expõe as métricas do processo para o Prometheus.
+// Latências por rota, contagem de status, requisições em andamento e tempos das operações
+// dos repositórios são coletados pelos interceptors e repositórios no registro global;
+// aqui apenas renderizamos esse registro no formato texto que o Prometheus raspa.
+class MetricsController : public oatpp::web::server::api::ApiController {
+public:
+  explicit MetricsController(const std::shared_ptr<oatpp::json::ObjectMapper>& objectMapper)
+    : oatpp::web::server::api::ApiController(objectMapper) {}
+
+  // Monta a resposta com o texto atual das métricas (compartilhado com o controller assíncrono)
+  static std::shared_ptr<OutgoingResponse> metricsResponse() {
+    auto body = oatpp::web::protocol::http::outgoing::BufferBody::createShared(
+      oatpp::String(ecocin::infra::metrics::Registry::instance().renderPrometheus()), kPrometheusContentType);
+    return OutgoingResponse::createShared(Status::CODE_200, body);
+  }
+
+  ENDPOINT("GET", "/metrics", metrics) {
+    return metricsResponse();
+  }
+};
+
+#include OATPP_CODEGEN_END(ApiController)
@@ -5,12 +5,17 @@
 #include "oatpp/data/type/Type.hpp"
 
 #include "../services/OrderService.h"
+#include "../domain/repositories/IOrderReferences.h"
 #include "dto/OrderDto.h"
 #include "dto/OrderOutDto.h"
 #include "dto/AddressBriefDto.h"
+#include "codec/EntityResponse.h"
+#include "../infra/memory/RequestArena.h"
 
 #include <chrono>
+#include <cstdint>
 #include <memory>
+#include <optional>
 
 #include OATPP_CODEGEN_BEGIN(ApiController)
 
@@ -22,6 +27,7 @@ class OrderController : public oatpp::web::server::api::ApiController {
 private:
   std::shared_ptr<ecocin::services::OrderService> orderService_;
 
+public:
   // Converte um objeto de domínio 'Address' em um 'AddressBriefDto'.
   // Este DTO mais enxuto é usado para encapsular as informações do endereço de entrega
   // dentro do DTO principal do pedido, evitando a exposição de dados desnecessários.
@@ -55,7 +61,6 @@ private:
     return dto;
   }
 
-public:
   // O construtor utiliza injeção de dependência para receber o serviço de pedidos.
   // Esta abordagem, central para o princípio de Inversão de Dependência, torna o controller
   // mais modular, testável e fácil de manter, pois ele não depende de uma instância concreta do serviço.
@@ -73,18 +78,27 @@ public:
     if (!body || !body->cpf || !body->sku || !body->shippingAddressType) {
       return createResponse(Status::CODE_400, "cpf, sku e shippingAddressType são obrigatórios");
     }
-    const int qty = body->quantity ? (int)*body->quantity : 1;
+    // Com reserva, a quantidade (se omitida) é a reservada
+    const int qty = body->quantity ? (int)*body->quantity : (body->holdId ? 0 : 1);
+    std::optional<std::uint64_t> holdId;
+    if (body->holdId) holdId = static_cast<std::uint64_t>(*body->holdId);
 
-    auto created = orderService_->createByCpfSkuAndType(
-      body->cpf->c_str(),
-      body->sku->c_str(),
-      body->shippingAddressType->c_str(),
-      qty
-    );
+    std::optional<Order> created;
+    try {
+      created = orderService_->createByCpfSkuAndType(
+        body->cpf->c_str(),
+        body->sku->c_str(),
+        body->shippingAddressType->c_str(),
+        qty,
+        holdId
+      );
+    } catch (const ecocin::domain::repositories::OrderReferenceConflict& e) {
+      return createResponse(Status::CODE_409, e.what()); // cliente/produto/endereço removido no meio
+    }
 
     if (!created) {
       return createResponse(Status::CODE_400,
-        "Cliente/produto não encontrado ou endereço inválido para o tipo informado");
+        "Cliente/produto não encontrado, endereço inválido para o tipo informado ou reserva inválida/expirada");
     }
     // retorno simples do recurso criado (sem enriquecer — GET abaixo enriquece)
     // Se preferir já enriquecer, faça um getById + composição como em listagem.
@@ -95,17 +109,16 @@ public:
   // O controller extrai o parâmetro da query, invoca o serviço para obter os detalhes
   // dos pedidos e, em seguida, utiliza os métodos de conversão para DTO para formatar
   // a resposta. Este fluxo demonstra a clara separação de responsabilidades na arquitetura.
-  ENDPOINT("GET", "/orders", listByCpf, QUERY(String, cpf)) {
+  ENDPOINT("GET", "/orders", listByCpf, QUERY(String, cpf),
+           REQUEST(std::shared_ptr<IncomingRequest>, request)) {
     if (!cpf || cpf->empty()) {
       return createResponse(Status::CODE_400, "cpf é obrigatório");
     }
-    auto details = orderService_->listDetailsByCpf(cpf->c_str());
+    // Pedidos, detalhes e mapas intermediários vêm da arena da requisição e saem juntos no fim do escopo
+    ecocin::infra::memory::RequestArena arena;
+    auto details = orderService_->listDetailsByCpf(cpf->c_str(), arena.resource());
 
-    auto arr = oatpp::List<oatpp::Object<OrderOutDto>>::createShared();
-    for (const auto& d : details) {
-      arr->push_back(toOutDto(d));
-    }
-    return createDtoResponse(Status::CODE_200, arr);
+    return ecocin::controllers::codec::entityResponse<ecocin::services::OrderDetails>(request, Status::CODE_200, details);
   }
 };
 
@@ -6,7 +6,19 @@
 #include "../services/ProductService.h"
 #include "dto/ProductDto.h"
 #include "dto/ProductOutDto.h"
+#include "dto/ProductPatchDto.h"
+#include "dto/StockHoldDto.h"
+#include "codec/EntityResponse.h"
+#include "../infra/memory/RequestArena.h"
+#include <charconv>
+#include <chrono>
+#include <cstdint>
 #include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
 
 #include OATPP_CODEGEN_BEGIN(ApiController)
 
@@ -48,6 +60,58 @@ private:
   }
 
 
+  // Filtro de GET /products?ids=1,2,3&skus=a,b: produtos pedidos pelo ID e/ou pelo SKU,
+  // resolvidos numa consulta só (carrinhos e páginas de pedido em vez de um GET por item).
+  static constexpr std::size_t kMaxBatchKeys = 1000;
+  struct BatchQuery {
+    std::vector<long long> ids;
+    std::vector<std::string> skus;
+    std::string error; // preenchido se a lista for inválida (400)
+  };
+
+  // std::nullopt se a requisição não tem ids nem skus (listagem completa)
+  static std::optional<BatchQuery> batchQuery(const std::shared_ptr<IncomingRequest>& request) {
+    const auto ids = request->getQueryParameter("ids");
+    const auto skus = request->getQueryParameter("skus");
+    if (!ids && !skus) return std::nullopt;
+
+    BatchQuery q;
+    auto split = [](const oatpp::String& s, auto&& add) {
+      if (!s) return;
+      std::string_view rest(s->c_str(), s->size());
+      while (!rest.empty()) {
+        const auto comma = rest.find(',');
+        const auto item = rest.substr(0, comma);
+        if (!item.empty()) add(item);
+        rest = comma == std::string_view::npos ? std::string_view{} : rest.substr(comma + 1);
+      }
+    };
+    split(ids, [&](std::string_view item) {
+      long long id = 0;
+      const auto [end, ec] = std::from_chars(item.data(), item.data() + item.size(), id);
+      if (ec != std::errc{} || end != item.data() + item.size()) q.error = "ids inválidos";
+      else q.ids.push_back(id);
+    });
+    split(skus, [&](std::string_view item) { q.skus.emplace_back(item); });
+    if (q.ids.size() + q.skus.size() > kMaxBatchKeys) {
+      q.error = "no máximo " + std::to_string(kMaxBatchKeys) + " ids/skus por requisição";
+    }
+    return q;
+  }
+
+  // Produtos de q: os dos ids e depois os dos skus, sem repetir (compartilhado com o controller assíncrono)
+  static std::vector<Product> findBatch(ecocin::services::ProductService& service, const BatchQuery& q) {
+    std::vector<Product> out = q.ids.empty() ? std::vector<Product>{} : service.getByIds(q.ids);
+    if (!q.skus.empty()) {
+      std::unordered_set<long long> seen;
+      for (const auto& p : out) seen.insert(p.getId());
+      for (auto& p : service.getBySkus(q.skus)) {
+        if (seen.insert(p.getId()).second) out.push_back(std::move(p));
+      }
+    }
+    return out;
+  }
+
   // Endpoint para criar um novo produto.
   // Ele extrai os dados do corpo da requisição (BODY_DTO), constrói um objeto de domínio 'Product'
   // e o passa para a camada de serviço, que contém as regras de negócio (validação, etc.).
@@ -66,39 +130,43 @@ private:
 }
 
   // Endpoint para listar todos os produtos.
-  // O controller delega a busca ao serviço, recebe a lista de produtos,
-  // converte cada um para seu DTO correspondente e retorna a coleção na resposta HTTP.
-  ENDPOINT("GET", "/products", listAll) {
-  const auto items = productService->listAll();
-
-  auto arr = oatpp::List<oatpp::Object<ProductOutDto>>::createShared();
-  for (const auto& p : items) {
-    arr->push_back(toOutDto(p));
+  // O controller delega a busca ao serviço, recebe a lista de produtos e a serializa
+  // direto no corpo da resposta (JSON, ou CBOR/MessagePack se pedido no Accept).
+  // Com ?ids= e/ou ?skus= devolve só os produtos pedidos (ver batchQuery).
+  ENDPOINT("GET", "/products", listAll, REQUEST(std::shared_ptr<IncomingRequest>, request)) {
+  if (const auto batch = batchQuery(request)) {
+    if (!batch->error.empty()) return createResponse(Status::CODE_400, oatpp::String(batch->error.c_str()));
+    return ecocin::controllers::codec::entityResponse<Product>(request, Status::CODE_200, findBatch(*productService, *batch));
   }
-  return createDtoResponse(Status::CODE_200, arr);
+  ecocin::infra::memory::RequestArena arena; // vetor de produtos alocado na arena da requisição
+  const auto items = productService->listAll(arena.resource());
+
+  return ecocin::controllers::codec::entityResponse<Product>(request, Status::CODE_200, items);
 }
 
   // Endpoint para buscar um produto pelo seu SKU (identificador de negócio).
   // Ele extrai o SKU da URL, chama o serviço e trata os dois possíveis resultados:
   // sucesso (retorna 200 OK com o DTO do produto) ou falha (retorna 404 Not Found).
-  ENDPOINT("GET", "/products/sku/{sku}", getBySku, PATH(String, sku)) {
+  ENDPOINT("GET", "/products/sku/{sku}", getBySku, PATH(String, sku),
+           REQUEST(std::shared_ptr<IncomingRequest>, request)) {
     const std::string key = sku ? std::string(sku->c_str()) : std::string{};
     auto p = productService->getBySku(key);
     if (!p) {
       return createResponse(Status::CODE_404, "Product not found");
     }
-    return createDtoResponse(Status::CODE_200, toOutDto(*p));
+    return ecocin::controllers::codec::entityResponse<Product>(request, Status::CODE_200, *p);
   }
 
   // Endpoint para buscar um produto pelo seu ID técnico.
   // A lógica é similar à busca por SKU, demonstrando como o controller
   // pode expor diferentes formas de acessar o mesmo recurso.
-  ENDPOINT("GET", "/products/{id}", getById, PATH(Int64, id)) {
+  ENDPOINT("GET", "/products/{id}", getById, PATH(Int64, id),
+           REQUEST(std::shared_ptr<IncomingRequest>, request)) {
     auto p = productService->getById(id);
     if (!p) {
       return createResponse(Status::CODE_404, "Product not found");
     }
-    return createDtoResponse(Status::CODE_200, toOutDto(*p));
+    return ecocin::controllers::codec::entityResponse<Product>(request, Status::CODE_200, *p);
   }
 
   // Endpoint para atualizar um produto existente.
@@ -125,11 +193,111 @@ private:
   return createDtoResponse(Status::CODE_200, toOutDto(p));
 }
 
+  // Respostas dos PATCH de estoque e preço (compartilhadas com o controller assíncrono)
+  static oatpp::Object<StockOutDto> toStockOutDto(long long id, int stockQuantity) {
+    auto dto = StockOutDto::createShared();
+    dto->id = id;
+    dto->stockQuantity = stockQuantity;
+    return dto;
+  }
+
+  static oatpp::Object<PriceOutDto> toPriceOutDto(long long id, double price) {
+    auto dto = PriceOutDto::createShared();
+    dto->id = id;
+    dto->price = price;
+    return dto;
+  }
+
+  // Endpoint para ajustar o estoque: { "delta": -3 } baixa três unidades.
+  // Diferente do PUT, não carrega o produto: vira um único UPDATE relativo no banco, então
+  // sincronizações de estoque simultâneas não se sobrescrevem. 409 se o estoque ficaria negativo.
+  ENDPOINT("PATCH", "/products/{id}/stock", adjustStock,
+           PATH(Int64, id),
+           BODY_DTO(Object<StockPatchDto>, body)) {
+    if (!body || !body->delta) return createResponse(Status::CODE_400, "delta is required");
+    const auto r = productService->adjustStock(id, *body->delta);
+    if (r.status == ecocin::services::PatchStatus::NotFound) return createResponse(Status::CODE_404, "Product not found");
+    if (r.status == ecocin::services::PatchStatus::Invalid) return createResponse(Status::CODE_409, "Insufficient stock");
+    return createDtoResponse(Status::CODE_200, toStockOutDto(id, r.value));
+  }
+
+  // Endpoint para trocar o preço: { "price": 19.9 }; também um único UPDATE, sem regravar o SKU.
+  ENDPOINT("PATCH", "/products/{id}/price", updatePrice,
+           PATH(Int64, id),
+           BODY_DTO(Object<PricePatchDto>, body)) {
+    if (!body || !body->price) return createResponse(Status::CODE_400, "price is required");
+    const auto r = productService->updatePrice(id, *body->price);
+    if (r.status == ecocin::services::PatchStatus::NotFound) return createResponse(Status::CODE_404, "Product not found");
+    if (r.status == ecocin::services::PatchStatus::Invalid) return createResponse(Status::CODE_400, "price must be >= 0");
+    return createDtoResponse(Status::CODE_200, toPriceOutDto(id, r.value));
+  }
+
+  // Respostas das reservas de estoque (compartilhadas com o controller assíncrono)
+  static oatpp::Object<StockHoldOutDto> toHoldOutDto(const ecocin::services::HoldResult& r) {
+    using namespace std::chrono;
+    auto dto = StockHoldOutDto::createShared();
+    dto->holdId    = static_cast<v_int64>(r.hold.id);
+    dto->productId = r.hold.productId;
+    dto->quantity  = r.hold.quantity;
+    dto->expiresAt = duration_cast<seconds>(r.hold.expiresAt.time_since_epoch()).count();
+    dto->available = r.available;
+    return dto;
+  }
+
+  static oatpp::Object<AvailabilityOutDto> toAvailabilityOutDto(long long id, const ecocin::services::StockAvailability& a) {
+    auto dto = AvailabilityOutDto::createShared();
+    dto->id            = id;
+    dto->stockQuantity = a.stockQuantity;
+    dto->held          = a.held;
+    dto->available     = a.available;
+    return dto;
+  }
+
+  static std::chrono::seconds holdTtl(const oatpp::Object<StockHoldDto>& body) {
+    return body->ttlSeconds ? std::chrono::seconds(*body->ttlSeconds) : ecocin::services::StockHoldService::kDefaultTtl;
+  }
+
+  // Endpoint para reservar estoque por um prazo: { "quantity": 2, "ttlSeconds": 600 }.
+  // As unidades reservadas deixam de contar como disponíveis até a reserva virar pedido
+  // (holdId no POST /orders), ser solta (DELETE) ou expirar. 409 se não há estoque livre.
+  ENDPOINT("POST", "/products/{id}/holds", placeHold,
+           PATH(Int64, id),
+           BODY_DTO(Object<StockHoldDto>, body)) {
+    if (!body || !body->quantity) return createResponse(Status::CODE_400, "quantity is required");
+    const auto r = productService->placeHold(id, *body->quantity, holdTtl(body));
+    if (r.status == ecocin::services::HoldStatus::NotFound) return createResponse(Status::CODE_404, "Product not found");
+    if (r.status == ecocin::services::HoldStatus::Invalid) return createResponse(Status::CODE_400, "quantity must be > 0 and ttlSeconds in 1..86400");
+    if (r.status == ecocin::services::HoldStatus::Insufficient) return createResponse(Status::CODE_409, "Insufficient stock");
+    return createDtoResponse(Status::CODE_201, toHoldOutDto(r));
+  }
+
+  // Endpoint para soltar uma reserva antes do prazo.
+  ENDPOINT("DELETE", "/products/{id}/holds/{holdId}", releaseHold,
+           PATH(Int64, id),
+           PATH(Int64, holdId)) {
+    if (!productService->releaseHold(id, static_cast<std::uint64_t>(*holdId))) {
+      return createResponse(Status::CODE_404, "Hold not found");
+    }
+    return createResponse(Status::CODE_200, "Hold released");
+  }
+
+  // Endpoint para consultar o estoque livre: stock_quantity menos as reservas ativas.
+  ENDPOINT("GET", "/products/{id}/availability", getAvailability, PATH(Int64, id)) {
+    auto a = productService->availability(id);
+    if (!a) return createResponse(Status::CODE_404, "Product not found");
+    return createDtoResponse(Status::CODE_200, toAvailabilityOutDto(id, *a));
+  }
+
   // Endpoint para remover um produto pelo ID.
   // O controller invoca o serviço para realizar a exclusão e retorna uma resposta
   // apropriada com base no feedback do serviço (sucesso na remoção ou produto não encontrado).
   ENDPOINT("DELETE", "/products/{id}", deleteById, PATH(Int64, id)) {
-    auto msg = productService->removeByIdMessage(id);
+    std::string msg;
+    try {
+      msg = productService->removeByIdMessage(id);
+    } catch (const ecocin::domain::repositories::OrderReferenceConflict& e) {
+      return createResponse(Status::CODE_409, e.what()); // produto com pedidos no log de pedidos
+    }
     if (msg == "Product not found") {
       return createResponse(Status::CODE_404, oatpp::String(msg.c_str()));
     }
@@ -0,0 +1,118 @@
+#pragma once
+#include "oatpp/macro/codegen.hpp"
+#include "oatpp/web/server/api/ApiController.hpp"
+#include "oatpp/json/ObjectMapper.hpp"
+#include "oatpp/data/type/Type.hpp"
+#include "../AddressController.h"
+#include "../../infra/db/DbWorkerPool.h"
+#include "AsyncSupport.h"
+#include <future>
+#include <memory>
+
+#include OATPP_CODEGEN_BEGIN(ApiController)
+
+// Versão assíncrona do AddressController (mesmas rotas e respostas).
+// As consultas ao AddressService rodam no DbWorkerPool; a corrotina só monta a resposta.
+class AddressAsyncController : public oatpp::web::server::api::ApiController {
+private:
+  typedef AddressAsyncController __ControllerType;
+
+  std::shared_ptr<ecocin::services::AddressService> addressService;
+  std::shared_ptr<ecocin::infra::db::DbWorkerPool> dbPool;
+
+public:
+  AddressAsyncController(const std::shared_ptr<oatpp::json::ObjectMapper>& objectMapper,
+                         std::shared_ptr<ecocin::services::AddressService> service,
+                         std::shared_ptr<ecocin::infra::db::DbWorkerPool> pool)
+    : oatpp::web::server::api::ApiController(objectMapper),
+      addressService(std::move(service)),
+      dbPool(std::move(pool)) {}
+
+  // POST /addresses
+  ENDPOINT_ASYNC("POST", "/addresses", CreateAddress) {
+    ENDPOINT_ASYNC_INIT(CreateAddress)
+
+    std::future<std::optional<Address>> result_;
+
+    Action act() override {
+      return request->readBodyToDtoAsync<oatpp::Object<AddressDto>>(
+        controller->getContentMappers()->getDefaultMapper()).callbackTo(&CreateAddress::onBody);
+    }
+
+    Action onBody(const oatpp::Object<AddressDto>& body) {
+      if (!body || !body->cpf || body->cpf->empty()) {
+        return _return(controller->createResponse(Status::CODE_400, "cpf é obrigatório"));
+      }
+
+      Address in;
+      if (body->street)      in.setStreet(std::string(body->street->c_str()));
+      if (body->number)      in.setNumber(std::string(body->number->c_str()));
+      if (body->city)        in.setCity(std::string(body->city->c_str()));
+      if (body->state)       in.setState(std::string(body->state->c_str()));
+      if (body->zip)         in.setZip(std::string(body->zip->c_str()));
+      if (body->addressType) in.setAddressType(std::string(body->addressType->c_str()));
+
+      auto svc = controller->addressService;
+      const std::string cpf(body->cpf->c_str());
+      auto task = controller->dbPool->trySubmit([svc, cpf, in] { return svc->create(cpf, in); });
+      if (!task) return _return(controller->createResponse(Status::CODE_503, ecocin::controllers::async::kDbBusyMessage));
+      result_ = std::move(*task);
+      return yieldTo(&CreateAddress::onResult);
+    }
+
+    Action onResult() {
+      if (!ecocin::infra::db::isReady(result_)) return waitRepeat(ecocin::controllers::async::kDbPollInterval);
+      auto created = result_.get();
+      if (!created) {
+        return _return(controller->createResponse(Status::CODE_400, "CPF não encontrado"));
+      }
+      return _return(controller->createResponse(Status::CODE_201));
+    }
+  };
+
+  // GET /addresses
+  ENDPOINT_ASYNC("GET", "/addresses", ListAll) {
+    ENDPOINT_ASYNC_INIT(ListAll)
+
+    std::future<std::vector<Address>> result_;
+
+    Action act() override {
+      auto svc = controller->addressService;
+      auto task = controller->dbPool->trySubmit([svc] { return svc->listAll(); });
+      if (!task) return _return(controller->createResponse(Status::CODE_503, ecocin::controllers::async::kDbBusyMessage));
+      result_ = std::move(*task);
+      return yieldTo(&ListAll::onResult);
+    }
+
+    Action onResult() {
+      if (!ecocin::infra::db::isReady(result_)) return waitRepeat(ecocin::controllers::async::kDbPollInterval);
+      const auto items = result_.get();
+      return _return(ecocin::controllers::codec::entityResponse<Address>(request, Status::CODE_200, items));
+    }
+  };
+
+  // GET /clients/{cpf}/addresses
+  ENDPOINT_ASYNC("GET", "/clients/{cpf}/addresses", ListAddressesByCpf) {
+    ENDPOINT_ASYNC_INIT(ListAddressesByCpf)
+
+    std::future<std::vector<Address>> result_;
+
+    Action act() override {
+      auto cpf = request->getPathVariable("cpf");
+      const std::string key = cpf ? std::string(cpf->c_str()) : std::string{};
+      auto svc = controller->addressService;
+      auto task = controller->dbPool->trySubmit([svc, key] { return svc->listByCpf(key); });
+      if (!task) return _return(controller->createResponse(Status::CODE_503, ecocin::controllers::async::kDbBusyMessage));
+      result_ = std::move(*task);
+      return yieldTo(&ListAddressesByCpf::onResult);
+    }
+
+    Action onResult() {
+      if (!ecocin::infra::db::isReady(result_)) return waitRepeat(ecocin::controllers::async::kDbPollInterval);
+      const auto list = result_.get();
+      return _return(ecocin::controllers::codec::entityResponse<Address>(request, Status::CODE_200, list));
+    }
+  };
+};
+
+#include OATPP_CODEGEN_END(ApiController)
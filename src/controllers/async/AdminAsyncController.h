@@ -0,0 +1,41 @@
+#pragma once
+#include "oatpp/macro/codegen.hpp"
+#include "oatpp/web/server/api/ApiController.hpp"
+#include "oatpp/json/ObjectMapper.hpp"
+#include "../AdminController.h"
+#include <memory>
+
+#include OATPP_CODEGEN_BEGIN(ApiController)
+
+// Versão assíncrona do AdminController. As estatísticas ficam em memória no profiler
+// e no controle de admissão, então as corrotinas respondem direto, sem passar pelo DbWorkerPool.
+class AdminAsyncController : public oatpp::web::server::api::ApiController {
+private:
+  typedef AdminAsyncController __ControllerType;
+  std::shared_ptr<ecocin::infra::admission::AdmissionControl> admission_;
+
+public:
+  explicit AdminAsyncController(const std::shared_ptr<oatpp::json::ObjectMapper>& objectMapper,
+                                std::shared_ptr<ecocin::infra::admission::AdmissionControl> admission = nullptr)
+    : oatpp::web::server::api::ApiController(objectMapper), admission_(std::move(admission)) {}
+
+  // GET /health
+  ENDPOINT_ASYNC("GET", "/health", Health) {
+    ENDPOINT_ASYNC_INIT(Health)
+
+    Action act() override {
+      return _return(AdminController::healthResponse(controller->admission_.get()));
+    }
+  };
+
+  // GET /admin/sql/top?n=
+  ENDPOINT_ASYNC("GET", "/admin/sql/top", SqlTop) {
+    ENDPOINT_ASYNC_INIT(SqlTop)
+
+    Action act() override {
+      return _return(AdminController::sqlTopResponse(request));
+    }
+  };
+};
+
+#include OATPP_CODEGEN_END(ApiController)
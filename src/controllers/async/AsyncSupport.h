@@ -0,0 +1,30 @@
+#pragma once
+#include "oatpp/data/type/Type.hpp"
+#include <chrono>
+#include <optional>
+#include <string>
+
+// Utilitários compartilhados pelos controllers assíncronos.
+namespace ecocin::controllers::async {
+
+// Intervalo com que uma corrotina volta a verificar o resultado de uma tarefa do DbWorkerPool.
+// Curto o suficiente para não somar latência perceptível, longo o suficiente para não girar o executor à toa.
+inline constexpr std::chrono::microseconds kDbPollInterval{200};
+
+// Mensagem devolvida (503) quando a fila do pool de banco está cheia.
+inline constexpr const char* kDbBusyMessage = "Servidor ocupado, tente novamente";
+
+// Converte uma variável de caminho em inteiro; std::nullopt se não for um número válido.
+inline std::optional<long long> parseInt64(const oatpp::String& s) {
+  if (!s || s->empty()) return std::nullopt;
+  try {
+    std::size_t pos = 0;
+    const long long v = std::stoll(*s, &pos);
+    if (pos != s->size()) return std::nullopt;
+    return v;
+  } catch (...) {
+    return std::nullopt;
+  }
+}
+
+} // namespace ecocin::controllers::async
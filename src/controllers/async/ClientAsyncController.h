@@ -0,0 +1,137 @@
+#pragma once
+#include "oatpp/macro/codegen.hpp"
+#include "oatpp/web/server/api/ApiController.hpp"
+#include "oatpp/json/ObjectMapper.hpp"
+#include "oatpp/data/type/Type.hpp"
+#include "../ClientController.h"
+#include "../../infra/db/DbWorkerPool.h"
+#include "AsyncSupport.h"
+#include <future>
+#include <memory>
+
+#include OATPP_CODEGEN_BEGIN(ApiController)
+
+// Versão assíncrona do ClientController (mesmas rotas e respostas).
+// Cada endpoint delega a chamada ao ClientService para o DbWorkerPool e a corrotina
+// aguarda o resultado sem ocupar uma thread do executor.
+class ClientAsyncController : public oatpp::web::server::api::ApiController {
+private:
+  typedef ClientAsyncController __ControllerType;
+
+  std::shared_ptr<ecocin::services::ClientService> clientService;
+  std::shared_ptr<ecocin::infra::db::DbWorkerPool> dbPool;
+
+public:
+  ClientAsyncController(const std::shared_ptr<oatpp::json::ObjectMapper>& objectMapper,
+                        std::shared_ptr<ecocin::services::ClientService> service,
+                        std::shared_ptr<ecocin::infra::db::DbWorkerPool> pool)
+    : oatpp::web::server::api::ApiController(objectMapper),
+      clientService(std::move(service)),
+      dbPool(std::move(pool)) {}
+
+  // POST /clients
+  ENDPOINT_ASYNC("POST", "/clients", CreateClient) {
+    ENDPOINT_ASYNC_INIT(CreateClient)
+
+    std::future<std::string> result_;
+
+    Action act() override {
+      return request->readBodyToDtoAsync<oatpp::Object<ClientDto>>(
+        controller->getContentMappers()->getDefaultMapper()).callbackTo(&CreateClient::onBody);
+    }
+
+    Action onBody(const oatpp::Object<ClientDto>& body) {
+      Client client;
+      if (body->name)  client.setName(std::string(body->name->c_str()));
+      if (body->email) client.setEmail(std::string(body->email->c_str()));
+      if (body->cpf)   client.setCpf(std::string(body->cpf->c_str()));
+
+      auto svc = controller->clientService;
+      auto task = controller->dbPool->trySubmit([svc, client] { return svc->createClient(client); });
+      if (!task) return _return(controller->createResponse(Status::CODE_503, ecocin::controllers::async::kDbBusyMessage));
+      result_ = std::move(*task);
+      return yieldTo(&CreateClient::onResult);
+    }
+
+    Action onResult() {
+      if (!ecocin::infra::db::isReady(result_)) return waitRepeat(ecocin::controllers::async::kDbPollInterval);
+      auto msg = result_.get();
+      return _return(controller->createResponse(Status::CODE_200, oatpp::String(msg.c_str())));
+    }
+  };
+
+  // GET /clients
+  ENDPOINT_ASYNC("GET", "/clients", ListAll) {
+    ENDPOINT_ASYNC_INIT(ListAll)
+
+    std::future<std::vector<Client>> result_;
+
+    Action act() override {
+      auto svc = controller->clientService;
+      auto task = controller->dbPool->trySubmit([svc] { return svc->listAllClients(); });
+      if (!task) return _return(controller->createResponse(Status::CODE_503, ecocin::controllers::async::kDbBusyMessage));
+      result_ = std::move(*task);
+      return yieldTo(&ListAll::onResult);
+    }
+
+    Action onResult() {
+      if (!ecocin::infra::db::isReady(result_)) return waitRepeat(ecocin::controllers::async::kDbPollInterval);
+      const auto clients = result_.get();
+      return _return(ecocin::controllers::codec::entityResponse<Client>(request, Status::CODE_200, clients));
+    }
+  };
+
+  // GET /clients/cpf/{cpf}
+  ENDPOINT_ASYNC("GET", "/clients/cpf/{cpf}", GetClient) {
+    ENDPOINT_ASYNC_INIT(GetClient)
+
+    std::future<std::optional<Client>> result_;
+
+    Action act() override {
+      auto cpf = request->getPathVariable("cpf");
+      const std::string key = cpf ? std::string(cpf->c_str()) : std::string{};
+      auto svc = controller->clientService;
+      auto task = controller->dbPool->trySubmit([svc, key] { return svc->getClientByCpf(key); });
+      if (!task) return _return(controller->createResponse(Status::CODE_503, ecocin::controllers::async::kDbBusyMessage));
+      result_ = std::move(*task);
+      return yieldTo(&GetClient::onResult);
+    }
+
+    Action onResult() {
+      if (!ecocin::infra::db::isReady(result_)) return waitRepeat(ecocin::controllers::async::kDbPollInterval);
+      auto client = result_.get();
+      if (!client) {
+        return _return(controller->createResponse(Status::CODE_404, "Client not found"));
+      }
+      return _return(ecocin::controllers::codec::entityResponse<Client>(request, Status::CODE_200, *client));
+    }
+  };
+
+  // GET /clients/{id}
+  ENDPOINT_ASYNC("GET", "/clients/{id}", GetClientById) {
+    ENDPOINT_ASYNC_INIT(GetClientById)
+
+    std::future<std::optional<Client>> result_;
+
+    Action act() override {
+      auto id = ecocin::controllers::async::parseInt64(request->getPathVariable("id"));
+      if (!id) return _return(controller->createResponse(Status::CODE_400, "Invalid id"));
+      auto svc = controller->clientService;
+      auto task = controller->dbPool->trySubmit([svc, id = *id] { return svc->getClientById(id); });
+      if (!task) return _return(controller->createResponse(Status::CODE_503, ecocin::controllers::async::kDbBusyMessage));
+      result_ = std::move(*task);
+      return yieldTo(&GetClientById::onResult);
+    }
+
+    Action onResult() {
+      if (!ecocin::infra::db::isReady(result_)) return waitRepeat(ecocin::controllers::async::kDbPollInterval);
+      auto client = result_.get();
+      if (!client) {
+        return _return(controller->createResponse(Status::CODE_404, "Client not found"));
+      }
+      return _return(ecocin::controllers::codec::entityResponse<Client>(request, Status::CODE_200, *client));
+    }
+  };
+};
+
+#include OATPP_CODEGEN_END(ApiController)
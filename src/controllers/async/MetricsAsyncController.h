@@ -0,0 +1,30 @@
+#pragma once
+#include "oatpp/macro/codegen.hpp"
+#include "oatpp/web/server/api/ApiController.hpp"
+#include "oatpp/json/ObjectMapper.hpp"
+#include "../MetricsController.h"
+#include <memory>
+
+#include OATPP_CODEGEN_BEGIN(ApiController)
+
+// Versão assíncrona do MetricsController. Renderizar o registro não toca o banco,
+// então a corrotina responde direto, sem passar pelo DbWorkerPool.
+class MetricsAsyncController : public oatpp::web::server::api::ApiController {
+private:
+  typedef MetricsAsyncController __ControllerType;
+
+public:
+  explicit MetricsAsyncController(const std::shared_ptr<oatpp::json::ObjectMapper>& objectMapper)
+    : oatpp::web::server::api::ApiController(objectMapper) {}
+
+  // GET /metrics
+  ENDPOINT_ASYNC("GET", "/metrics", Metrics) {
+    ENDPOINT_ASYNC_INIT(Metrics)
+
+    Action act() override {
+      return _return(MetricsController::metricsResponse());
+    }
+  };
+};
+
+#include OATPP_CODEGEN_END(ApiController)
@@ -0,0 +1,115 @@
+#pragma once
+#include "oatpp/macro/codegen.hpp"
+#include "oatpp/web/server/api/ApiController.hpp"
+#include "oatpp/json/ObjectMapper.hpp"
+#include "oatpp/data/type/Type.hpp"
+#include "../OrderController.h"
+#include "../../infra/db/DbWorkerPool.h"
+#include "../../infra/memory/RequestArena.h"
+#include "AsyncSupport.h"
+#include <future>
+#include <memory>
+#include <string>
+
+#include OATPP_CODEGEN_BEGIN(ApiController)
+
+// Versão assíncrona do OrderController (mesmas rotas e respostas).
+// Criação e listagem de pedidos envolvem várias consultas encadeadas no OrderService;
+// todas rodam juntas numa tarefa do DbWorkerPool.
+class OrderAsyncController : public oatpp::web::server::api::ApiController {
+private:
+  typedef OrderAsyncController __ControllerType;
+
+  std::shared_ptr<ecocin::services::OrderService> orderService_;
+  std::shared_ptr<ecocin::infra::db::DbWorkerPool> dbPool_;
+
+public:
+  OrderAsyncController(const std::shared_ptr<oatpp::json::ObjectMapper>& objectMapper,
+                       std::shared_ptr<ecocin::services::OrderService> service,
+                       std::shared_ptr<ecocin::infra::db::DbWorkerPool> pool)
+    : oatpp::web::server::api::ApiController(objectMapper),
+      orderService_(std::move(service)),
+      dbPool_(std::move(pool)) {}
+
+  // POST /orders
+  ENDPOINT_ASYNC("POST", "/orders", CreateOrder) {
+    ENDPOINT_ASYNC_INIT(CreateOrder)
+
+    std::future<std::optional<Order>> result_;
+
+    Action act() override {
+      return request->readBodyToDtoAsync<oatpp::Object<OrderDto>>(
+        controller->getContentMappers()->getDefaultMapper()).callbackTo(&CreateOrder::onBody);
+    }
+
+    Action onBody(const oatpp::Object<OrderDto>& body) {
+      if (!body || !body->cpf || !body->sku || !body->shippingAddressType) {
+        return _return(controller->createResponse(Status::CODE_400, "cpf, sku e shippingAddressType são obrigatórios"));
+      }
+      const int qty = body->quantity ? (int)*body->quantity : (body->holdId ? 0 : 1);
+      std::optional<std::uint64_t> holdId;
+      if (body->holdId) holdId = static_cast<std::uint64_t>(*body->holdId);
+      const std::string cpf(body->cpf->c_str());
+      const std::string sku(body->sku->c_str());
+      const std::string type(body->shippingAddressType->c_str());
+
+      auto svc = controller->orderService_;
+      auto task = controller->dbPool_->trySubmit([svc, cpf, sku, type, qty, holdId] {
+        return svc->createByCpfSkuAndType(cpf, sku, type, qty, holdId);
+      });
+      if (!task) return _return(controller->createResponse(Status::CODE_503, ecocin::controllers::async::kDbBusyMessage));
+      result_ = std::move(*task);
+      return yieldTo(&CreateOrder::onResult);
+    }
+
+    Action onResult() {
+      if (!ecocin::infra::db::isReady(result_)) return waitRepeat(ecocin::controllers::async::kDbPollInterval);
+      std::optional<Order> created;
+      try {
+        created = result_.get();
+      } catch (const ecocin::domain::repositories::OrderReferenceConflict& e) {
+        return _return(controller->createResponse(Status::CODE_409, e.what()));
+      }
+      if (!created) {
+        return _return(controller->createResponse(Status::CODE_400,
+          "Cliente/produto não encontrado, endereço inválido para o tipo informado ou reserva inválida/expirada"));
+      }
+      return _return(controller->createResponse(Status::CODE_201));
+    }
+  };
+
+  // GET /orders?cpf=
+  ENDPOINT_ASYNC("GET", "/orders", ListByCpf) {
+    ENDPOINT_ASYNC_INIT(ListByCpf)
+
+    ecocin::controllers::codec::WireFormat format_{ecocin::controllers::codec::WireFormat::Json};
+    std::future<std::string> result_;
+
+    Action act() override {
+      auto cpf = request->getQueryParameter("cpf");
+      if (!cpf || cpf->empty()) {
+        return _return(controller->createResponse(Status::CODE_400, "cpf é obrigatório"));
+      }
+      auto svc = controller->orderService_;
+      const std::string key(cpf->c_str());
+      format_ = ecocin::controllers::codec::requestedFormat(request);
+      // A arena só vale na thread que a criou: pedidos e detalhes são alocados, serializados e
+      // liberados dentro da tarefa, e só o corpo pronto volta para a corrotina
+      auto task = controller->dbPool_->trySubmit([svc, key, format = format_] {
+        ecocin::infra::memory::RequestArena arena;
+        const auto details = svc->listDetailsByCpf(key, arena.resource());
+        return ecocin::controllers::codec::serialize<ecocin::services::OrderDetails>(format, details);
+      });
+      if (!task) return _return(controller->createResponse(Status::CODE_503, ecocin::controllers::async::kDbBusyMessage));
+      result_ = std::move(*task);
+      return yieldTo(&ListByCpf::onResult);
+    }
+
+    Action onResult() {
+      if (!ecocin::infra::db::isReady(result_)) return waitRepeat(ecocin::controllers::async::kDbPollInterval);
+      return _return(ecocin::controllers::codec::serializedResponse(Status::CODE_200, format_, result_.get()));
+    }
+  };
+};
+
+#include OATPP_CODEGEN_END(ApiController)
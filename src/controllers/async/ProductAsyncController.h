@@ -0,0 +1,367 @@
+#pragma once
+#include "oatpp/macro/codegen.hpp"
+#include "oatpp/web/server/api/ApiController.hpp"
+#include "oatpp/json/ObjectMapper.hpp"
+#include "oatpp/data/type/Type.hpp"
+#include "../ProductController.h"
+#include "../../infra/db/DbWorkerPool.h"
+#include "AsyncSupport.h"
+#include <future>
+#include <memory>
+
+#include OATPP_CODEGEN_BEGIN(ApiController)
+
+// Versão assíncrona do ProductController, usada quando o servidor roda com
+// AsyncHttpConnectionHandler. As rotas e respostas são as mesmas do controller síncrono;
+// a diferença é que cada endpoint é uma corrotina que entrega a chamada ao serviço
+// (bloqueante, pois toca o SQLite) ao DbWorkerPool e só volta a executar quando o resultado está pronto.
+// Assim poucas threads do executor atendem milhares de conexões.
+class ProductAsyncController : public oatpp::web::server::api::ApiController {
+private:
+  typedef ProductAsyncController __ControllerType;
+
+  std::shared_ptr<ecocin::services::ProductService> productService;
+  std::shared_ptr<ecocin::infra::db::DbWorkerPool> dbPool;
+
+  // Aplica os campos presentes no DTO sobre o produto (mesma regra do controller síncrono)
+  static void applyDto(Product& p, const oatpp::Object<ProductDto>& body) {
+    if (body->name)          p.setName(std::string(body->name->c_str()));
+    if (body->description)   p.setDescription(std::string(body->description->c_str()));
+    if (body->price)         p.setPrice(*body->price);
+    if (body->stockQuantity) p.setStockQuantity(*body->stockQuantity);
+    if (body->isActive)      p.setIsActive(*body->isActive);
+    if (body->sku)           p.setSku(ecocin::core::Uuid(std::string(body->sku->c_str())));
+  }
+
+public:
+  ProductAsyncController(const std::shared_ptr<oatpp::json::ObjectMapper>& objectMapper,
+                         std::shared_ptr<ecocin::services::ProductService> service,
+                         std::shared_ptr<ecocin::infra::db::DbWorkerPool> pool)
+    : oatpp::web::server::api::ApiController(objectMapper),
+      productService(std::move(service)),
+      dbPool(std::move(pool)) {}
+
+  // POST /products — lê o corpo de forma assíncrona e cria o produto no pool de banco.
+  ENDPOINT_ASYNC("POST", "/products", CreateProduct) {
+    ENDPOINT_ASYNC_INIT(CreateProduct)
+
+    std::future<std::string> result_;
+
+    Action act() override {
+      return request->readBodyToDtoAsync<oatpp::Object<ProductDto>>(
+        controller->getContentMappers()->getDefaultMapper()).callbackTo(&CreateProduct::onBody);
+    }
+
+    Action onBody(const oatpp::Object<ProductDto>& body) {
+      Product p;
+      applyDto(p, body);
+      auto svc = controller->productService;
+      auto task = controller->dbPool->trySubmit([svc, p] { return svc->createProduct(p); });
+      if (!task) return _return(controller->createResponse(Status::CODE_503, ecocin::controllers::async::kDbBusyMessage));
+      result_ = std::move(*task);
+      return yieldTo(&CreateProduct::onResult);
+    }
+
+    Action onResult() {
+      if (!ecocin::infra::db::isReady(result_)) return waitRepeat(ecocin::controllers::async::kDbPollInterval);
+      auto msg = result_.get();
+      return _return(controller->createResponse(Status::CODE_200, oatpp::String(msg.c_str())));
+    }
+  };
+
+  // GET /products (com ?ids= / ?skus=, só os produtos pedidos)
+  ENDPOINT_ASYNC("GET", "/products", ListAll) {
+    ENDPOINT_ASYNC_INIT(ListAll)
+
+    std::future<std::vector<Product>> result_;
+
+    Action act() override {
+      auto batch = ProductController::batchQuery(request);
+      if (batch && !batch->error.empty()) {
+        return _return(controller->createResponse(Status::CODE_400, oatpp::String(batch->error.c_str())));
+      }
+      auto svc = controller->productService;
+      auto task = controller->dbPool->trySubmit([svc, batch = std::move(batch)] {
+        return batch ? ProductController::findBatch(*svc, *batch) : svc->listAll();
+      });
+      if (!task) return _return(controller->createResponse(Status::CODE_503, ecocin::controllers::async::kDbBusyMessage));
+      result_ = std::move(*task);
+      return yieldTo(&ListAll::onResult);
+    }
+
+    Action onResult() {
+      if (!ecocin::infra::db::isReady(result_)) return waitRepeat(ecocin::controllers::async::kDbPollInterval);
+      const auto items = result_.get();
+      return _return(ecocin::controllers::codec::entityResponse<Product>(request, Status::CODE_200, items));
+    }
+  };
+
+  // GET /products/sku/{sku}
+  ENDPOINT_ASYNC("GET", "/products/sku/{sku}", GetBySku) {
+    ENDPOINT_ASYNC_INIT(GetBySku)
+
+    std::future<std::optional<Product>> result_;
+
+    Action act() override {
+      auto sku = request->getPathVariable("sku");
+      const std::string key = sku ? std::string(sku->c_str()) : std::string{};
+      auto svc = controller->productService;
+      auto task = controller->dbPool->trySubmit([svc, key] { return svc->getBySku(key); });
+      if (!task) return _return(controller->createResponse(Status::CODE_503, ecocin::controllers::async::kDbBusyMessage));
+      result_ = std::move(*task);
+      return yieldTo(&GetBySku::onResult);
+    }
+
+    Action onResult() {
+      if (!ecocin::infra::db::isReady(result_)) return waitRepeat(ecocin::controllers::async::kDbPollInterval);
+      auto p = result_.get();
+      if (!p) {
+        return _return(controller->createResponse(Status::CODE_404, "Product not found"));
+      }
+      return _return(ecocin::controllers::codec::entityResponse<Product>(request, Status::CODE_200, *p));
+    }
+  };
+
+  // GET /products/{id}
+  ENDPOINT_ASYNC("GET", "/products/{id}", GetById) {
+    ENDPOINT_ASYNC_INIT(GetById)
+
+    std::future<std::optional<Product>> result_;
+
+    Action act() override {
+      auto id = ecocin::controllers::async::parseInt64(request->getPathVariable("id"));
+      if (!id) return _return(controller->createResponse(Status::CODE_400, "Invalid id"));
+      auto svc = controller->productService;
+      auto task = controller->dbPool->trySubmit([svc, id = *id] { return svc->getById(id); });
+      if (!task) return _return(controller->createResponse(Status::CODE_503, ecocin::controllers::async::kDbBusyMessage));
+      result_ = std::move(*task);
+      return yieldTo(&GetById::onResult);
+    }
+
+    Action onResult() {
+      if (!ecocin::infra::db::isReady(result_)) return waitRepeat(ecocin::controllers::async::kDbPollInterval);
+      auto p = result_.get();
+      if (!p) {
+        return _return(controller->createResponse(Status::CODE_404, "Product not found"));
+      }
+      return _return(ecocin::controllers::codec::entityResponse<Product>(request, Status::CODE_200, *p));
+    }
+  };
+
+  // PUT /products/{id} — carrega, aplica o corpo e valida/persiste numa única tarefa do pool,
+  // para que a leitura e a escrita não fiquem intercaladas com outras requisições do mesmo produto.
+  ENDPOINT_ASYNC("PUT", "/products/{id}", UpdateProduct) {
+    ENDPOINT_ASYNC_INIT(UpdateProduct)
+
+    long long id_{0};
+    std::future<std::pair<int, std::optional<Product>>> result_;
+
+    Action act() override {
+      auto id = ecocin::controllers::async::parseInt64(request->getPathVariable("id"));
+      if (!id) return _return(controller->createResponse(Status::CODE_400, "Invalid id"));
+      id_ = *id;
+      return request->readBodyToDtoAsync<oatpp::Object<ProductDto>>(
+        controller->getContentMappers()->getDefaultMapper()).callbackTo(&UpdateProduct::onBody);
+    }
+
+    Action onBody(const oatpp::Object<ProductDto>& body) {
+      auto svc = controller->productService;
+      auto task = controller->dbPool->trySubmit([svc, id = id_, body]() -> std::pair<int, std::optional<Product>> {
+        auto existing = svc->getById(id);
+        if (!existing) return {404, std::nullopt};
+        Product p = *existing;
+        applyDto(p, body);
+        if (!svc->updateProduct(p)) return {400, std::nullopt};
+        return {200, p};
+      });
+      if (!task) return _return(controller->createResponse(Status::CODE_503, ecocin::controllers::async::kDbBusyMessage));
+      result_ = std::move(*task);
+      return yieldTo(&UpdateProduct::onResult);
+    }
+
+    Action onResult() {
+      if (!ecocin::infra::db::isReady(result_)) return waitRepeat(ecocin::controllers::async::kDbPollInterval);
+      auto [code, p] = result_.get();
+      if (code == 404) return _return(controller->createResponse(Status::CODE_404, "Product not found"));
+      if (code == 400) return _return(controller->createResponse(Status::CODE_400, "Invalid product data"));
+      return _return(controller->createDtoResponse(Status::CODE_200, ProductController::toOutDto(*p)));
+    }
+  };
+
+  // PATCH /products/{id}/stock — um UPDATE relativo no pool de banco (ver ProductController::adjustStock)
+  ENDPOINT_ASYNC("PATCH", "/products/{id}/stock", AdjustStock) {
+    ENDPOINT_ASYNC_INIT(AdjustStock)
+
+    long long id_{0};
+    std::future<ecocin::services::PatchResult<int>> result_;
+
+    Action act() override {
+      auto id = ecocin::controllers::async::parseInt64(request->getPathVariable("id"));
+      if (!id) return _return(controller->createResponse(Status::CODE_400, "Invalid id"));
+      id_ = *id;
+      return request->readBodyToDtoAsync<oatpp::Object<StockPatchDto>>(
+        controller->getContentMappers()->getDefaultMapper()).callbackTo(&AdjustStock::onBody);
+    }
+
+    Action onBody(const oatpp::Object<StockPatchDto>& body) {
+      if (!body || !body->delta) return _return(controller->createResponse(Status::CODE_400, "delta is required"));
+      auto svc = controller->productService;
+      auto task = controller->dbPool->trySubmit([svc, id = id_, delta = *body->delta] { return svc->adjustStock(id, delta); });
+      if (!task) return _return(controller->createResponse(Status::CODE_503, ecocin::controllers::async::kDbBusyMessage));
+      result_ = std::move(*task);
+      return yieldTo(&AdjustStock::onResult);
+    }
+
+    Action onResult() {
+      if (!ecocin::infra::db::isReady(result_)) return waitRepeat(ecocin::controllers::async::kDbPollInterval);
+      const auto r = result_.get();
+      if (r.status == ecocin::services::PatchStatus::NotFound) return _return(controller->createResponse(Status::CODE_404, "Product not found"));
+      if (r.status == ecocin::services::PatchStatus::Invalid) return _return(controller->createResponse(Status::CODE_409, "Insufficient stock"));
+      return _return(controller->createDtoResponse(Status::CODE_200, ProductController::toStockOutDto(id_, r.value)));
+    }
+  };
+
+  // PATCH /products/{id}/price
+  ENDPOINT_ASYNC("PATCH", "/products/{id}/price", UpdatePrice) {
+    ENDPOINT_ASYNC_INIT(UpdatePrice)
+
+    long long id_{0};
+    std::future<ecocin::services::PatchResult<double>> result_;
+
+    Action act() override {
+      auto id = ecocin::controllers::async::parseInt64(request->getPathVariable("id"));
+      if (!id) return _return(controller->createResponse(Status::CODE_400, "Invalid id"));
+      id_ = *id;
+      return request->readBodyToDtoAsync<oatpp::Object<PricePatchDto>>(
+        controller->getContentMappers()->getDefaultMapper()).callbackTo(&UpdatePrice::onBody);
+    }
+
+    Action onBody(const oatpp::Object<PricePatchDto>& body) {
+      if (!body || !body->price) return _return(controller->createResponse(Status::CODE_400, "price is required"));
+      auto svc = controller->productService;
+      auto task = controller->dbPool->trySubmit([svc, id = id_, price = *body->price] { return svc->updatePrice(id, price); });
+      if (!task) return _return(controller->createResponse(Status::CODE_503, ecocin::controllers::async::kDbBusyMessage));
+      result_ = std::move(*task);
+      return yieldTo(&UpdatePrice::onResult);
+    }
+
+    Action onResult() {
+      if (!ecocin::infra::db::isReady(result_)) return waitRepeat(ecocin::controllers::async::kDbPollInterval);
+      const auto r = result_.get();
+      if (r.status == ecocin::services::PatchStatus::NotFound) return _return(controller->createResponse(Status::CODE_404, "Product not found"));
+      if (r.status == ecocin::services::PatchStatus::Invalid) return _return(controller->createResponse(Status::CODE_400, "price must be >= 0"));
+      return _return(controller->createDtoResponse(Status::CODE_200, ProductController::toPriceOutDto(id_, r.value)));
+    }
+  };
+
+  // POST /products/{id}/holds
+  ENDPOINT_ASYNC("POST", "/products/{id}/holds", PlaceHold) {
+    ENDPOINT_ASYNC_INIT(PlaceHold)
+
+    long long id_{0};
+    std::future<ecocin::services::HoldResult> result_;
+
+    Action act() override {
+      auto id = ecocin::controllers::async::parseInt64(request->getPathVariable("id"));
+      if (!id) return _return(controller->createResponse(Status::CODE_400, "Invalid id"));
+      id_ = *id;
+      return request->readBodyToDtoAsync<oatpp::Object<StockHoldDto>>(
+        controller->getContentMappers()->getDefaultMapper()).callbackTo(&PlaceHold::onBody);
+    }
+
+    Action onBody(const oatpp::Object<StockHoldDto>& body) {
+      if (!body || !body->quantity) return _return(controller->createResponse(Status::CODE_400, "quantity is required"));
+      auto svc = controller->productService;
+      auto task = controller->dbPool->trySubmit([svc, id = id_, qty = *body->quantity, ttl = ProductController::holdTtl(body)] {
+        return svc->placeHold(id, qty, ttl);
+      });
+      if (!task) return _return(controller->createResponse(Status::CODE_503, ecocin::controllers::async::kDbBusyMessage));
+      result_ = std::move(*task);
+      return yieldTo(&PlaceHold::onResult);
+    }
+
+    Action onResult() {
+      if (!ecocin::infra::db::isReady(result_)) return waitRepeat(ecocin::controllers::async::kDbPollInterval);
+      const auto r = result_.get();
+      if (r.status == ecocin::services::HoldStatus::NotFound) return _return(controller->createResponse(Status::CODE_404, "Product not found"));
+      if (r.status == ecocin::services::HoldStatus::Invalid) return _return(controller->createResponse(Status::CODE_400, "quantity must be > 0 and ttlSeconds in 1..86400"));
+      if (r.status == ecocin::services::HoldStatus::Insufficient) return _return(controller->createResponse(Status::CODE_409, "Insufficient stock"));
+      return _return(controller->createDtoResponse(Status::CODE_201, ProductController::toHoldOutDto(r)));
+    }
+  };
+
+  // DELETE /products/{id}/holds/{holdId}
+  // Só mexe nas reservas em memória (não toca o SQLite), então roda direto na corrotina.
+  ENDPOINT_ASYNC("DELETE", "/products/{id}/holds/{holdId}", ReleaseHold) {
+    ENDPOINT_ASYNC_INIT(ReleaseHold)
+
+    Action act() override {
+      auto id = ecocin::controllers::async::parseInt64(request->getPathVariable("id"));
+      auto holdId = ecocin::controllers::async::parseInt64(request->getPathVariable("holdId"));
+      if (!id || !holdId) return _return(controller->createResponse(Status::CODE_400, "Invalid id"));
+      if (!controller->productService->releaseHold(*id, static_cast<std::uint64_t>(*holdId))) {
+        return _return(controller->createResponse(Status::CODE_404, "Hold not found"));
+      }
+      return _return(controller->createResponse(Status::CODE_200, "Hold released"));
+    }
+  };
+
+  // GET /products/{id}/availability
+  ENDPOINT_ASYNC("GET", "/products/{id}/availability", GetAvailability) {
+    ENDPOINT_ASYNC_INIT(GetAvailability)
+
+    long long id_{0};
+    std::future<std::optional<ecocin::services::StockAvailability>> result_;
+
+    Action act() override {
+      auto id = ecocin::controllers::async::parseInt64(request->getPathVariable("id"));
+      if (!id) return _return(controller->createResponse(Status::CODE_400, "Invalid id"));
+      id_ = *id;
+      auto svc = controller->productService;
+      auto task = controller->dbPool->trySubmit([svc, id = id_] { return svc->availability(id); });
+      if (!task) return _return(controller->createResponse(Status::CODE_503, ecocin::controllers::async::kDbBusyMessage));
+      result_ = std::move(*task);
+      return yieldTo(&GetAvailability::onResult);
+    }
+
+    Action onResult() {
+      if (!ecocin::infra::db::isReady(result_)) return waitRepeat(ecocin::controllers::async::kDbPollInterval);
+      const auto a = result_.get();
+      if (!a) return _return(controller->createResponse(Status::CODE_404, "Product not found"));
+      return _return(controller->createDtoResponse(Status::CODE_200, ProductController::toAvailabilityOutDto(id_, *a)));
+    }
+  };
+
+  // DELETE /products/{id}
+  ENDPOINT_ASYNC("DELETE", "/products/{id}", DeleteById) {
+    ENDPOINT_ASYNC_INIT(DeleteById)
+
+    std::future<std::string> result_;
+
+    Action act() override {
+      auto id = ecocin::controllers::async::parseInt64(request->getPathVariable("id"));
+      if (!id) return _return(controller->createResponse(Status::CODE_400, "Invalid id"));
+      auto svc = controller->productService;
+      auto task = controller->dbPool->trySubmit([svc, id = *id] { return svc->removeByIdMessage(id); });
+      if (!task) return _return(controller->createResponse(Status::CODE_503, ecocin::controllers::async::kDbBusyMessage));
+      result_ = std::move(*task);
+      return yieldTo(&DeleteById::onResult);
+    }
+
+    Action onResult() {
+      if (!ecocin::infra::db::isReady(result_)) return waitRepeat(ecocin::controllers::async::kDbPollInterval);
+      std::string msg;
+      try {
+        msg = result_.get();
+      } catch (const ecocin::domain::repositories::OrderReferenceConflict& e) {
+        return _return(controller->createResponse(Status::CODE_409, e.what()));
+      }
+      if (msg == "Product not found") {
+        return _return(controller->createResponse(Status::CODE_404, oatpp::String(msg.c_str())));
+      }
+      return _return(controller->createResponse(Status::CODE_200, oatpp::String(msg.c_str())));
+    }
+  };
+};
+
+#include OATPP_CODEGEN_END(ApiController)
@@ -0,0 +1,161 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <utility>
+
+// Escritores dos formatos binários servidos pela API (CBOR — RFC 8949 — e MessagePack).
+// Os dois expõem a mesma interface (beginMap/beginArray/key/string/int64/float64/boolean/null),
+// então o código que percorre um DTO é escrito uma vez e instanciado para cada formato.
+// Ambos usam sempre comprimentos definidos: o número de itens de mapas e arrays é informado antes,
+// por isso endMap/endArray não escrevem nada (existem para o JsonWriter, que fecha os containers).
+namespace ecocin::controllers::codec {
+
+// Escreve os n bytes menos significativos de v em big-endian (ordem de rede, exigida pelos dois formatos)
+inline void appendBigEndian(std::string& out, std::uint64_t v, int n) {
+  for (int i = n - 1; i >= 0; --i) {
+    out.push_back(static_cast<char>((v >> (8 * i)) & 0xFF));
+  }
+}
+
+inline std::uint64_t doubleBits(double d) {
+  std::uint64_t bits;
+  std::memcpy(&bits, &d, sizeof(bits));
+  return bits;
+}
+
+class CborWriter {
+private:
+  std::string out_;
+
+  // Cabeçalho CBOR: 3 bits de tipo maior + argumento no menor número de bytes possível
+  void head(std::uint8_t major, std::uint64_t arg) {
+    const auto mt = static_cast<std::uint8_t>(major << 5);
+    if (arg < 24) {
+      out_.push_back(static_cast<char>(mt | arg));
+    } else if (arg <= 0xFF) {
+      out_.push_back(static_cast<char>(mt | 24));
+      appendBigEndian(out_, arg, 1);
+    } else if (arg <= 0xFFFF) {
+      out_.push_back(static_cast<char>(mt | 25));
+      appendBigEndian(out_, arg, 2);
+    } else if (arg <= 0xFFFFFFFFull) {
+      out_.push_back(static_cast<char>(mt | 26));
+      appendBigEndian(out_, arg, 4);
+    } else {
+      out_.push_back(static_cast<char>(mt | 27));
+      appendBigEndian(out_, arg, 8);
+    }
+  }
+
+public:
+  static constexpr const char* kContentType = "application/cbor";
+
+  void reserve(std::size_t n) { out_.reserve(n); }
+
+  void beginMap(std::size_t n)   { head(5, n); }
+  void endMap()                  {}
+  void beginArray(std::size_t n) { head(4, n); }
+  void endArray()                {}
+  void key(std::string_view k)   { string(k); }
+
+  void string(std::string_view s) {
+    head(3, s.size());
+    out_.append(s.data(), s.size());
+  }
+
+  void int64(std::int64_t v) {
+    // inteiros negativos são codificados como -1 - n no tipo maior 1
+    if (v >= 0) head(0, static_cast<std::uint64_t>(v));
+    else        head(1, ~static_cast<std::uint64_t>(v));
+  }
+
+  void float64(double d) {
+    out_.push_back(static_cast<char>(0xFB));
+    appendBigEndian(out_, doubleBits(d), 8);
+  }
+
+  void boolean(bool b) { out_.push_back(static_cast<char>(b ? 0xF5 : 0xF4)); }
+  void null()          { out_.push_back(static_cast<char>(0xF6)); }
+
+  const std::string& data() const { return out_; }
+  std::string take() { return std::move(out_); }
+};
+
+class MsgPackWriter {
+private:
+  std::string out_;
+
+  // Escolhe entre a forma "fix" (tamanho embutido no próprio byte de tipo) e as formas 16/32 bits
+  void container(std::size_t n, std::uint8_t fixBase, std::size_t fixMax, std::uint8_t tag16, std::uint8_t tag32) {
+    if (n <= fixMax) {
+      out_.push_back(static_cast<char>(fixBase | n));
+    } else if (n <= 0xFFFF) {
+      out_.push_back(static_cast<char>(tag16));
+      appendBigEndian(out_, n, 2);
+    } else {
+      out_.push_back(static_cast<char>(tag32));
+      appendBigEndian(out_, n, 4);
+    }
+  }
+
+public:
+  static constexpr const char* kContentType = "application/msgpack";
+
+  void reserve(std::size_t n) { out_.reserve(n); }
+
+  void beginMap(std::size_t n)   { container(n, 0x80, 15, 0xDE, 0xDF); }
+  void endMap()                  {}
+  void beginArray(std::size_t n) { container(n, 0x90, 15, 0xDC, 0xDD); }
+  void endArray()                {}
+  void key(std::string_view k)   { string(k); }
+
+  void string(std::string_view s) {
+    const auto n = s.size();
+    if (n <= 31) {
+      out_.push_back(static_cast<char>(0xA0 | n));
+    } else if (n <= 0xFF) {
+      out_.push_back(static_cast<char>(0xD9));
+      appendBigEndian(out_, n, 1);
+    } else if (n <= 0xFFFF) {
+      out_.push_back(static_cast<char>(0xDA));
+      appendBigEndian(out_, n, 2);
+    } else {
+      out_.push_back(static_cast<char>(0xDB));
+      appendBigEndian(out_, n, 4);
+    }
+    out_.append(s.data(), n);
+  }
+
+  void int64(std::int64_t v) {
+    if (v >= 0) {
+      const auto u = static_cast<std::uint64_t>(v);
+      if (u <= 0x7F)             { out_.push_back(static_cast<char>(u)); }
+      else if (u <= 0xFF)        { out_.push_back(static_cast<char>(0xCC)); appendBigEndian(out_, u, 1); }
+      else if (u <= 0xFFFF)      { out_.push_back(static_cast<char>(0xCD)); appendBigEndian(out_, u, 2); }
+      else if (u <= 0xFFFFFFFFu) { out_.push_back(static_cast<char>(0xCE)); appendBigEndian(out_, u, 4); }
+      else                       { out_.push_back(static_cast<char>(0xCF)); appendBigEndian(out_, u, 8); }
+      return;
+    }
+    const auto u = static_cast<std::uint64_t>(v); // complemento de dois, truncado pelo appendBigEndian
+    if (v >= -32)                 { out_.push_back(static_cast<char>(v)); }
+    else if (v >= INT8_MIN)       { out_.push_back(static_cast<char>(0xD0)); appendBigEndian(out_, u, 1); }
+    else if (v >= INT16_MIN)      { out_.push_back(static_cast<char>(0xD1)); appendBigEndian(out_, u, 2); }
+    else if (v >= INT32_MIN)      { out_.push_back(static_cast<char>(0xD2)); appendBigEndian(out_, u, 4); }
+    else                          { out_.push_back(static_cast<char>(0xD3)); appendBigEndian(out_, u, 8); }
+  }
+
+  void float64(double d) {
+    out_.push_back(static_cast<char>(0xCB));
+    appendBigEndian(out_, doubleBits(d), 8);
+  }
+
+  void boolean(bool b) { out_.push_back(static_cast<char>(b ? 0xC3 : 0xC2)); }
+  void null()          { out_.push_back(static_cast<char>(0xC0)); }
+
+  const std::string& data() const { return out_; }
+  std::string take() { return std::move(out_); }
+};
+
+} // namespace ecocin::controllers::codec
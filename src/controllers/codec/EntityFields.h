@@ -0,0 +1,130 @@
+#pragma once
+#include "../../domain/entities/Client.h"
+#include "../../domain/entities/Product.h"
+#include "../../domain/entities/Address.h"
+#include "../../services/OrderService.h"
+#include "../../infra/db/QueryProfiler.h"
+
+#include <string_view>
+#include <tuple>
+
+// Descritores de campos, resolvidos em tempo de compilação, que dizem como cada entidade
+// aparece na API: nome da chave + como obter o valor (getter ou projeção).
+// A ordem e os nomes são os mesmos dos DTOs de saída (ProductOutDto, ClientOutDto, ...),
+// então o JSON produzido a partir daqui é o mesmo contrato de antes.
+namespace ecocin::controllers::codec {
+
+// Campo simples: o valor vem de um getter (ou lambda) aplicado à entidade
+template <class Getter>
+struct Field {
+  std::string_view name;
+  Getter get;
+};
+
+// Campo que é um objeto aninhado, serializado pelos descritores de View
+template <class View, class Getter>
+struct NestedField {
+  std::string_view name;
+  Getter get;
+};
+
+template <class Getter>
+constexpr Field<Getter> field(std::string_view name, Getter get) { return {name, get}; }
+
+template <class View, class Getter>
+constexpr NestedField<View, Getter> nested(std::string_view name, Getter get) { return {name, get}; }
+
+// Cada visão de saída especializa Fields com a entidade de origem e a lista de campos
+template <class View>
+struct Fields;
+
+template <>
+struct Fields<Product> {
+  using Entity = Product;
+  static constexpr auto list = std::make_tuple(
+    field("id",            &Product::getId),
+    field("name",          &Product::getName),
+    field("description",   &Product::getDescription),
+    field("sku",           &Product::getSku),
+    field("price",         &Product::getPrice),
+    field("stockQuantity", &Product::getStockQuantity),
+    field("isActive",      &Product::getIsActive),
+    field("createDate",    &Product::getCreateDate));
+};
+
+template <>
+struct Fields<Client> {
+  using Entity = Client;
+  static constexpr auto list = std::make_tuple(
+    field("id",         &Client::getId),
+    field("name",       &Client::getName),
+    field("email",      &Client::getEmail),
+    field("cpf",        &Client::getCpf),
+    field("createDate", &Client::getCreateDate));
+};
+
+template <>
+struct Fields<Address> {
+  using Entity = Address;
+  static constexpr auto list = std::make_tuple(
+    field("id",          &Address::getId),
+    field("clientId",    &Address::getClientId),
+    field("street",      &Address::getStreet),
+    field("number",      &Address::getNumber),
+    field("city",        &Address::getCity),
+    field("state",       &Address::getState),
+    field("zip",         &Address::getZip),
+    field("addressType", &Address::getAddressType),
+    field("createDate",  &Address::getCreateDate));
+};
+
+// Visão resumida do endereço usada dentro do pedido (equivale ao AddressBriefDto)
+struct AddressBriefView {};
+
+template <>
+struct Fields<AddressBriefView> {
+  using Entity = Address;
+  static constexpr auto list = std::make_tuple(
+    field("street",      &Address::getStreet),
+    field("number",      &Address::getNumber),
+    field("city",        &Address::getCity),
+    field("state",       &Address::getState),
+    field("zip",         &Address::getZip),
+    field("addressType", &Address::getAddressType));
+};
+
+// Pedido com os dados agregados de cliente, produto e endereço (equivale ao OrderOutDto)
+template <>
+struct Fields<ecocin::services::OrderDetails> {
+  using Entity = ecocin::services::OrderDetails;
+  static constexpr auto list = std::make_tuple(
+    field("id",                 [](const Entity& d) { return d.order.getId(); }),
+    field("clientName",         [](const Entity& d) -> const std::string& { return d.client.getName(); }),
+    field("productDescription", [](const Entity& d) -> const std::string& { return d.product.getDescription(); }),
+    nested<AddressBriefView>("shippingAddress", &Entity::address),
+    field("quantity",           [](const Entity& d) { return d.order.getQuantity(); }),
+    field("unitPrice",          [](const Entity& d) { return d.order.getUnitPrice(); }),
+    field("totalPrice",         [](const Entity& d) { return d.order.getTotalPrice(); }),
+    field("status",             [](const Entity& d) -> const std::string& { return d.order.getStatus(); }),
+    field("createDate",         [](const Entity& d) { return d.order.getCreateDate(); }));
+};
+
+// Linha da tabela de consultas do profiler (GET /admin/sql/top)
+template <>
+struct Fields<ecocin::infra::db::QueryStats> {
+  using Entity = ecocin::infra::db::QueryStats;
+  static constexpr auto list = std::make_tuple(
+    field("sql",           &Entity::sql),
+    field("calls",         &Entity::calls),
+    field("totalMs",       &Entity::totalMs),
+    field("meanMs",        &Entity::meanMs),
+    field("maxMs",         &Entity::maxMs),
+    field("rows",          &Entity::rows),
+    field("vmSteps",       &Entity::vmSteps),
+    field("fullScanSteps", &Entity::fullScanSteps),
+    field("sortSteps",     &Entity::sortSteps),
+    field("autoIndexes",   &Entity::autoIndexes),
+    field("plan",          &Entity::plan));
+};
+
+} // namespace ecocin::controllers::codec
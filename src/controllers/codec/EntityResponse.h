@@ -0,0 +1,44 @@
+#pragma once
+#include "oatpp/web/protocol/http/incoming/Request.hpp"
+#include "oatpp/web/protocol/http/outgoing/Response.hpp"
+#include "oatpp/web/protocol/http/outgoing/BufferBody.hpp"
+#include "oatpp/data/type/Type.hpp"
+
+#include "EntitySerializer.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+
+// Ponte entre o serializador de entidades e o oatpp: escolhe o formato pelo cabeçalho Accept
+// e monta a resposta com o corpo já serializado.
+namespace ecocin::controllers::codec {
+
+// Formato pedido pelo cliente no cabeçalho Accept (JSON se ausente)
+inline WireFormat requestedFormat(const std::shared_ptr<oatpp::web::protocol::http::incoming::Request>& request) {
+  if (!request) return WireFormat::Json;
+  const auto accept = request->getHeader("Accept");
+  return accept ? negotiateWireFormat(*accept) : WireFormat::Json;
+}
+
+// Resposta com um corpo já serializado em format (ex.: serializado numa tarefa do DbWorkerPool)
+inline std::shared_ptr<oatpp::web::protocol::http::outgoing::Response>
+serializedResponse(const oatpp::web::protocol::http::Status& status, WireFormat format, std::string serialized) {
+  auto body = oatpp::web::protocol::http::outgoing::BufferBody::createShared(
+    oatpp::String(std::move(serialized)), contentTypeOf(format));
+  auto response = oatpp::web::protocol::http::outgoing::Response::createShared(status, body);
+  response->putHeader("Vary", "Accept");
+  return response;
+}
+
+// Serializa uma entidade (ou coleção de entidades) pela View indicada e devolve a resposta.
+// Ex.: entityResponse<Product>(request, Status::CODE_200, productService->listAll())
+template <class View, class Value>
+std::shared_ptr<oatpp::web::protocol::http::outgoing::Response>
+entityResponse(const std::shared_ptr<oatpp::web::protocol::http::incoming::Request>& request,
+               const oatpp::web::protocol::http::Status& status, const Value& value) {
+  const auto format = requestedFormat(request);
+  return serializedResponse(status, format, serialize<View>(format, value));
+}
+
+} // namespace ecocin::controllers::codec
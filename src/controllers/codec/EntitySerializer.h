@@ -0,0 +1,110 @@
+#pragma once
+#include "EntityFields.h"
+#include "BinaryWriters.h"
+#include "JsonWriter.h"
+#include "WireFormat.h"
+
+#include "../../domain/core/Time.h"
+#include "../../domain/core/Uuid.h"
+
+#include <array>
+#include <chrono>
+#include <functional>
+#include <iterator>
+#include <string>
+#include <tuple>
+#include <type_traits>
+
+// Serializador guiado pelos descritores de EntityFields.h. Percorre os campos em tempo de
+// compilação (std::apply sobre a tupla de descritores) e escreve cada valor direto no Writer
+// (JsonWriter, CborWriter ou MsgPackWriter), sem montar DTOs do oatpp no meio do caminho.
+namespace ecocin::controllers::codec {
+
+namespace detail {
+
+template <class W, class V>
+void writeValue(W& w, const V& v) {
+  using T = std::decay_t<V>;
+  if constexpr (std::is_same_v<T, bool>) {
+    w.boolean(v);
+  } else if constexpr (std::is_integral_v<T>) {
+    w.int64(static_cast<std::int64_t>(v));
+  } else if constexpr (std::is_floating_point_v<T>) {
+    w.float64(static_cast<double>(v));
+  } else if constexpr (std::is_same_v<T, std::string>) {
+    w.string(v);
+  } else if constexpr (std::is_same_v<T, ecocin::core::Timestamp>) {
+    // Datas seguem o padrão da API: epoch em segundos
+    w.int64(std::chrono::duration_cast<std::chrono::seconds>(v.time_since_epoch()).count());
+  } else if constexpr (std::is_same_v<T, ecocin::core::Uuid>) {
+    std::array<char, ecocin::core::Uuid::kTextSize> buf;
+    w.string(v.view(buf));
+  } else {
+    static_assert(std::is_void_v<T>, "tipo de campo sem serialização definida");
+  }
+}
+
+} // namespace detail
+
+template <class View, class W>
+void writeObject(W& w, const typename Fields<View>::Entity& e);
+
+namespace detail {
+
+template <class W, class Entity, class Getter>
+void writeField(W& w, const Entity& e, const Field<Getter>& f) {
+  w.key(f.name);
+  writeValue(w, std::invoke(f.get, e));
+}
+
+template <class W, class Entity, class View, class Getter>
+void writeField(W& w, const Entity& e, const NestedField<View, Getter>& f) {
+  w.key(f.name);
+  writeObject<View>(w, std::invoke(f.get, e));
+}
+
+} // namespace detail
+
+// Escreve uma entidade como mapa, na ordem dos descritores
+template <class View, class W>
+void writeObject(W& w, const typename Fields<View>::Entity& e) {
+  constexpr auto count = std::tuple_size_v<std::decay_t<decltype(Fields<View>::list)>>;
+  w.beginMap(count);
+  std::apply([&](const auto&... f) { (detail::writeField(w, e, f), ...); }, Fields<View>::list);
+  w.endMap();
+}
+
+// Escreve qualquer coleção de entidades (vector, pmr::vector, ...) como array
+template <class View, class W, class Range>
+void writeArray(W& w, const Range& items) {
+  w.beginArray(std::size(items));
+  for (const auto& e : items) writeObject<View>(w, e);
+  w.endArray();
+}
+
+// Serializa no formato pedido. Cada thread lembra o tamanho da última saída de cada View
+// e reserva esse espaço de antemão: a string cresce uma vez só e depois é movida para o corpo da resposta.
+template <class View, class Value>
+std::string serialize(WireFormat format, const Value& value) {
+  thread_local std::size_t sizeHint = 256;
+
+  auto run = [&](auto writer) {
+    writer.reserve(sizeHint);
+    if constexpr (std::is_same_v<std::decay_t<Value>, typename Fields<View>::Entity>) {
+      writeObject<View>(writer, value);
+    } else {
+      writeArray<View>(writer, value);
+    }
+    std::string out = writer.take();
+    sizeHint = out.size() + out.size() / 8;
+    return out;
+  };
+
+  switch (format) {
+    case WireFormat::Cbor:    return run(CborWriter{});
+    case WireFormat::MsgPack: return run(MsgPackWriter{});
+    default:                  return run(JsonWriter{});
+  }
+}
+
+} // namespace ecocin::controllers::codec
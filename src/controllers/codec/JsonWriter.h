@@ -0,0 +1,98 @@
+#pragma once
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+
+// Escritor de JSON com a mesma interface do CborWriter/MsgPackWriter.
+// Escreve direto em um std::string (números via std::to_chars, sem locale nem stringstream),
+// então serializar uma lista de entidades não cria nenhum objeto intermediário.
+namespace ecocin::controllers::codec {
+
+class JsonWriter {
+private:
+  std::string out_;
+  bool needComma_{false}; // o próximo item do container atual precisa de ','
+
+  void sep() {
+    if (needComma_) out_.push_back(',');
+  }
+
+  void quoted(std::string_view s) {
+    static constexpr char kHex[] = "0123456789abcdef";
+    out_.push_back('"');
+    // Copia trechos que não precisam de escape de uma vez; só aspas, barra e controles são escapados
+    std::size_t run = 0;
+    for (std::size_t i = 0; i < s.size(); ++i) {
+      const auto c = static_cast<unsigned char>(s[i]);
+      if (c >= 0x20 && c != '"' && c != '\\') continue;
+      out_.append(s.data() + run, i - run);
+      run = i + 1;
+      switch (c) {
+        case '"':  out_ += "\\\""; break;
+        case '\\': out_ += "\\\\"; break;
+        case '\n': out_ += "\\n";  break;
+        case '\r': out_ += "\\r";  break;
+        case '\t': out_ += "\\t";  break;
+        case '\b': out_ += "\\b";  break;
+        case '\f': out_ += "\\f";  break;
+        default: {
+          const char esc[] = {'\\', 'u', '0', '0', kHex[c >> 4], kHex[c & 0xF]};
+          out_.append(esc, sizeof(esc));
+        }
+      }
+    }
+    out_.append(s.data() + run, s.size() - run);
+    out_.push_back('"');
+  }
+
+public:
+  static constexpr const char* kContentType = "application/json";
+
+  void reserve(std::size_t n) { out_.reserve(n); }
+
+  // JSON não precisa do número de itens; o parâmetro existe para manter a interface comum
+  void beginMap(std::size_t)   { sep(); out_.push_back('{'); needComma_ = false; }
+  void endMap()                { out_.push_back('}'); needComma_ = true; }
+  void beginArray(std::size_t) { sep(); out_.push_back('['); needComma_ = false; }
+  void endArray()              { out_.push_back(']'); needComma_ = true; }
+
+  void key(std::string_view k) {
+    sep();
+    quoted(k);
+    out_.push_back(':');
+    needComma_ = false;
+  }
+
+  void string(std::string_view s) { sep(); quoted(s); needComma_ = true; }
+
+  void int64(std::int64_t v) {
+    sep();
+    char buf[24];
+    const auto r = std::to_chars(buf, buf + sizeof(buf), v);
+    out_.append(buf, r.ptr);
+    needComma_ = true;
+  }
+
+  void float64(double d) {
+    sep();
+    if (!std::isfinite(d)) {
+      out_ += "null"; // JSON não representa NaN/Infinity
+    } else {
+      char buf[32];
+      const auto r = std::to_chars(buf, buf + sizeof(buf), d);
+      out_.append(buf, r.ptr);
+    }
+    needComma_ = true;
+  }
+
+  void boolean(bool b) { sep(); out_ += b ? "true" : "false"; needComma_ = true; }
+  void null()          { sep(); out_ += "null"; needComma_ = true; }
+
+  const std::string& data() const { return out_; }
+  std::string take() { needComma_ = false; return std::move(out_); }
+};
+
+} // namespace ecocin::controllers::codec
@@ -0,0 +1,71 @@
+#pragma once
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+
+// Negociação do formato de resposta a partir do cabeçalho Accept.
+namespace ecocin::controllers::codec {
+
+enum class WireFormat { Json, Cbor, MsgPack };
+
+inline const char* contentTypeOf(WireFormat f) {
+  switch (f) {
+    case WireFormat::Cbor:    return "application/cbor";
+    case WireFormat::MsgPack: return "application/msgpack";
+    default:                  return "application/json";
+  }
+}
+
+// Escolhe o formato de maior q entre os que a API sabe produzir. JSON continua sendo
+// o padrão (sem Accept, com */* ou com tipos desconhecidos) e vence empates, de modo que
+// clientes existentes não percebem diferença; só quem pede explicitamente recebe binário.
+inline WireFormat negotiateWireFormat(std::string_view accept) {
+  WireFormat best = WireFormat::Json;
+  double bestQ = 0.0;
+
+  std::size_t start = 0;
+  while (start < accept.size()) {
+    auto comma = accept.find(',', start);
+    if (comma == std::string_view::npos) comma = accept.size();
+    std::string_view item = accept.substr(start, comma - start);
+    start = comma + 1;
+
+    const auto semi = item.find(';');
+    std::string_view type = item.substr(0, semi);
+    while (!type.empty() && (type.front() == ' ' || type.front() == '\t')) type.remove_prefix(1);
+    while (!type.empty() && (type.back() == ' ' || type.back() == '\t')) type.remove_suffix(1);
+
+    std::string media(type);
+    std::transform(media.begin(), media.end(), media.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+
+    double q = 1.0;
+    if (semi != std::string_view::npos) {
+      const auto qpos = item.find("q=", semi);
+      if (qpos != std::string_view::npos) q = std::strtod(std::string(item.substr(qpos + 2)).c_str(), nullptr);
+    }
+    if (q <= 0.0) continue;
+
+    WireFormat f;
+    if (media == "application/cbor") {
+      f = WireFormat::Cbor;
+    } else if (media == "application/msgpack" || media == "application/x-msgpack" ||
+               media == "application/vnd.msgpack") {
+      f = WireFormat::MsgPack;
+    } else if (media == "application/json" || media == "application/*" || media == "*/*") {
+      f = WireFormat::Json;
+    } else {
+      continue;
+    }
+
+    if (q > bestQ || (q == bestQ && f == WireFormat::Json)) {
+      best = f;
+      bestQ = q;
+    }
+  }
+  return best;
+}
+
+} // namespace ecocin::controllers::codec
@@ -10,7 +10,8 @@ class OrderDto : public oatpp::DTO {
   DTO_FIELD(String, cpf);               // obrigatório no service
   DTO_FIELD(String, sku);               // obrigatório no service
   DTO_FIELD(String, shippingAddressType); // obrigatório no service
-  DTO_FIELD(Int32,  quantity);          // padrão: 1 (se controller/service quiser)
+  DTO_FIELD(Int32,  quantity);          // padrão: 1 (se controller/service quiser); com holdId, a da reserva
+  DTO_FIELD(Int64,  holdId);            // opcional: reserva de estoque (POST /products/{id}/holds) a converter
 };
 
 #include OATPP_CODEGEN_END(DTO)
@@ -0,0 +1,36 @@
+#pragma once
+#include "oatpp/macro/codegen.hpp"
+#include "oatpp/data/type/Type.hpp"
+
+#include OATPP_CODEGEN_BEGIN(DTO)
+
+// Corpo de PATCH /products/{id}/stock: quanto somar ao estoque (negativo baixa)
+class StockPatchDto : public oatpp::DTO {
+    DTO_INIT(StockPatchDto, DTO)
+
+    DTO_FIELD(Int32, delta);
+};
+
+// Corpo de PATCH /products/{id}/price
+class PricePatchDto : public oatpp::DTO {
+    DTO_INIT(PricePatchDto, DTO)
+
+    DTO_FIELD(Float64, price);
+};
+
+// Resposta dos PATCH: o valor gravado
+class StockOutDto : public oatpp::DTO {
+    DTO_INIT(StockOutDto, DTO)
+
+    DTO_FIELD(Int64, id);
+    DTO_FIELD(Int32, stockQuantity);
+};
+
+class PriceOutDto : public oatpp::DTO {
+    DTO_INIT(PriceOutDto, DTO)
+
+    DTO_FIELD(Int64, id);
+    DTO_FIELD(Float64, price);
+};
+
+#include OATPP_CODEGEN_END(DTO)
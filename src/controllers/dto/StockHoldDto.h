@@ -0,0 +1,36 @@
+#pragma once
+#include "oatpp/macro/codegen.hpp"
+#include "oatpp/data/type/Type.hpp"
+
+#include OATPP_CODEGEN_BEGIN(DTO)
+
+// Corpo de POST /products/{id}/holds: quantas unidades reservar e por quanto tempo
+class StockHoldDto : public oatpp::DTO {
+    DTO_INIT(StockHoldDto, DTO)
+
+    DTO_FIELD(Int32, quantity);
+    DTO_FIELD(Int32, ttlSeconds); // padrão: 600; máximo: 86400
+};
+
+// Reserva criada; holdId vai no POST /orders para virar baixa de estoque
+class StockHoldOutDto : public oatpp::DTO {
+    DTO_INIT(StockHoldOutDto, DTO)
+
+    DTO_FIELD(Int64, holdId);
+    DTO_FIELD(Int64, productId);
+    DTO_FIELD(Int32, quantity);
+    DTO_FIELD(Int64, expiresAt); // epoch em segundos
+    DTO_FIELD(Int64, available); // estoque livre depois da reserva
+};
+
+// GET /products/{id}/availability
+class AvailabilityOutDto : public oatpp::DTO {
+    DTO_INIT(AvailabilityOutDto, DTO)
+
+    DTO_FIELD(Int64, id);
+    DTO_FIELD(Int32, stockQuantity);
+    DTO_FIELD(Int64, held);
+    DTO_FIELD(Int64, available);
+};
+
+#include OATPP_CODEGEN_END(DTO)
@@ -0,0 +1,85 @@
+#include "AdmissionInterceptor.h"
+
+#include "oatpp/web/protocol/http/outgoing/ResponseFactory.hpp"
+
+#include <chrono>
+#include <string_view>
+
+namespace ecocin::controllers::interceptors {
+
+namespace {
+
+using ecocin::infra::admission::Clock;
+using ecocin::infra::admission::Priority;
+using ecocin::infra::admission::Verdict;
+using oatpp::web::protocol::http::Status;
+
+// Presentes no bundle só para requisições admitidas que ocupam vaga no limite de concorrência
+constexpr const char* kPriorityKey = "ecocin.admission.priority";
+constexpr const char* kStartKey    = "ecocin.admission.start";
+
+std::string_view view(const oatpp::data::share::StringKeyLabel& label) {
+  return {static_cast<const char*>(label.getData()), static_cast<std::size_t>(label.getSize())};
+}
+
+std::int64_t nowNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+}
+
+} // namespace
+
+std::string AdmissionRequestInterceptor::clientOf(const std::shared_ptr<IncomingRequest>& request) const {
+  if (trustedProxies_ > 0) {
+    const auto forwarded = request->getHeader("X-Forwarded-For");
+    if (forwarded) {
+      auto client = ecocin::infra::admission::AdmissionControl::clientFromForwardedFor(*forwarded, trustedProxies_);
+      if (!client.empty()) return client;
+    }
+  }
+  // Endereço do par TCP, preenchido pelo ConnectionProvider do oatpp
+  const auto& connection = request->getConnection();
+  if (connection.object) {
+    const auto peer = connection.object->getInputStreamContext().getProperties().get("peer_address");
+    if (peer) return *peer;
+  }
+  return "unknown";
+}
+
+std::shared_ptr<AdmissionRequestInterceptor::OutgoingResponse>
+AdmissionRequestInterceptor::intercept(const std::shared_ptr<IncomingRequest>& request) {
+  const auto& line = request->getStartingLine();
+  const auto priority = ecocin::infra::admission::AdmissionControl::classify(view(line.method), view(line.path));
+  if (priority == Priority::Critical) return nullptr;
+
+  // O IP só é resolvido quando o limite por cliente está ligado
+  const auto decision = admission_->admit(admission_->rateLimitEnabled() ? clientOf(request) : std::string{}, priority);
+  if (decision.verdict == Verdict::Admit) {
+    if (admission_->sheddingEnabled()) {
+      request->putBundleData(kPriorityKey, oatpp::Int32(static_cast<std::int32_t>(priority)));
+      request->putBundleData(kStartKey, oatpp::Int64(nowNs()));
+    }
+    return nullptr; // segue para o endpoint
+  }
+
+  auto response = decision.verdict == Verdict::RateLimited
+    ? oatpp::web::protocol::http::outgoing::ResponseFactory::createResponse(Status::CODE_429, "Too many requests")
+    : oatpp::web::protocol::http::outgoing::ResponseFactory::createResponse(Status::CODE_503, "Server overloaded, try again later");
+  response->putHeader("Retry-After", oatpp::String(std::to_string(decision.retryAfter.count())));
+  return response;
+}
+
+std::shared_ptr<AdmissionResponseInterceptor::OutgoingResponse>
+AdmissionResponseInterceptor::intercept(const std::shared_ptr<IncomingRequest>& request,
+                                        const std::shared_ptr<OutgoingResponse>& response) {
+  if (!request) return response;
+
+  const auto priority = request->getBundleData<oatpp::Int32>(kPriorityKey);
+  const auto start = request->getBundleData<oatpp::Int64>(kStartKey);
+  if (!priority || !start) return response; // crítica, recusada ou sem limite de concorrência
+
+  const auto elapsed = nowNs() - *start;
+  admission_->finish(static_cast<Priority>(*priority), std::chrono::nanoseconds(elapsed > 0 ? elapsed : 0));
+  return response;
+}
+
+} // namespace ecocin::controllers::interceptors
@@ -0,0 +1,44 @@
+#pragma once
+#include "oatpp/web/server/interceptor/RequestInterceptor.hpp"
+#include "oatpp/web/server/interceptor/ResponseInterceptor.hpp"
+#include "../../infra/admission/AdmissionControl.h"
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace ecocin::controllers::interceptors {
+
+// Entrada da requisição: classifica a rota (crítica, leitura ou escrita), aplica o limite por IP
+// e o limite de concorrência e, se a requisição não puder entrar, responde na hora com
+// 429 (cliente acima da taxa) ou 503 (servidor sobrecarregado), ambos com Retry-After.
+// Recusar cedo evita que as threads se acumulem atrás da conexão SQLite até tudo estourar o tempo.
+class AdmissionRequestInterceptor : public oatpp::web::server::interceptor::RequestInterceptor {
+private:
+  std::shared_ptr<ecocin::infra::admission::AdmissionControl> admission_;
+  std::size_t trustedProxies_; // proxies reversos confiáveis na frente do servidor (0 ignora X-Forwarded-For)
+
+  std::string clientOf(const std::shared_ptr<IncomingRequest>& request) const;
+
+public:
+  AdmissionRequestInterceptor(std::shared_ptr<ecocin::infra::admission::AdmissionControl> admission,
+                              std::size_t trustedProxies)
+    : admission_(std::move(admission)), trustedProxies_(trustedProxies) {}
+
+  std::shared_ptr<OutgoingResponse> intercept(const std::shared_ptr<IncomingRequest>& request) override;
+};
+
+// Fim da requisição: libera a vaga no limite de concorrência e informa a latência observada,
+// que alimenta o ajuste adaptativo do limite.
+class AdmissionResponseInterceptor : public oatpp::web::server::interceptor::ResponseInterceptor {
+private:
+  std::shared_ptr<ecocin::infra::admission::AdmissionControl> admission_;
+
+public:
+  explicit AdmissionResponseInterceptor(std::shared_ptr<ecocin::infra::admission::AdmissionControl> admission)
+    : admission_(std::move(admission)) {}
+
+  std::shared_ptr<OutgoingResponse> intercept(const std::shared_ptr<IncomingRequest>& request,
+                                              const std::shared_ptr<OutgoingResponse>& response) override;
+};
+
+} // namespace ecocin::controllers::interceptors
@@ -0,0 +1,179 @@
+#include "CompressionInterceptor.h"
+
+#include "oatpp/web/protocol/http/outgoing/BufferBody.hpp"
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <stdexcept>
+
+namespace ecocin::controllers::interceptors {
+
+namespace {
+
+// Contexto de compressão reaproveitado pela thread. deflateInit2 aloca ~256KB de estado;
+// fazer isso uma vez por thread e só deflateReset por resposta tira esse custo do caminho quente.
+class ZStreamContext {
+private:
+  z_stream zs_{};
+  bool ready_{false};
+  int level_{-1};
+  int windowBits_{0};
+
+  void release() {
+    if (ready_) deflateEnd(&zs_);
+    ready_ = false;
+  }
+
+public:
+  ~ZStreamContext() { release(); }
+
+  z_stream& acquire(int windowBits, int level) {
+    if (ready_ && level_ == level && windowBits_ == windowBits) {
+      deflateReset(&zs_);
+      return zs_;
+    }
+    release();
+    zs_ = z_stream{};
+    if (deflateInit2(&zs_, level, Z_DEFLATED, windowBits, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+      throw std::runtime_error("deflateInit2 failed");
+    }
+    ready_ = true;
+    level_ = level;
+    windowBits_ = windowBits;
+    return zs_;
+  }
+};
+
+// 15 = janela máxima; +16 produz o cabeçalho/rodapé gzip, sem somar produz o formato zlib ("deflate" do HTTP)
+constexpr int kGzipWindowBits    = 15 + 16;
+constexpr int kDeflateWindowBits = 15;
+
+thread_local ZStreamContext tlGzip;
+thread_local ZStreamContext tlDeflate;
+
+std::string toLower(std::string s) {
+  std::transform(s.begin(), s.end(), s.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+  return s;
+}
+
+std::string trim(const std::string& s) {
+  const auto b = s.find_first_not_of(" \t");
+  if (b == std::string::npos) return {};
+  const auto e = s.find_last_not_of(" \t");
+  return s.substr(b, e - b + 1);
+}
+
+// Soma Accept-Encoding ao Vary que a resposta já tenha (o codec de entidades declara "Accept")
+void varyOnEncoding(oatpp::web::protocol::http::outgoing::Response& response) {
+  const auto vary = response.getHeader("Vary");
+  if (!vary) {
+    response.putHeader("Vary", "Accept-Encoding");
+    return;
+  }
+  const std::string current(vary->c_str());
+  if (toLower(current).find("accept-encoding") != std::string::npos) return;
+  response.putOrReplaceHeader("Vary", oatpp::String(current + ", Accept-Encoding"));
+}
+
+} // namespace
+
+ContentCoding CompressionInterceptor::negotiate(const std::string& acceptEncoding) {
+  // q < 0 indica "não mencionado"
+  double gzipQ = -1.0, deflateQ = -1.0, anyQ = -1.0;
+
+  std::size_t start = 0;
+  while (start <= acceptEncoding.size()) {
+    const auto comma = acceptEncoding.find(',', start);
+    const std::string item = acceptEncoding.substr(start, comma == std::string::npos ? std::string::npos : comma - start);
+    start = (comma == std::string::npos) ? acceptEncoding.size() + 1 : comma + 1;
+
+    const auto semi = item.find(';');
+    const std::string coding = toLower(trim(item.substr(0, semi)));
+    double q = 1.0;
+    if (semi != std::string::npos) {
+      const std::string params = toLower(trim(item.substr(semi + 1)));
+      if (params.rfind("q=", 0) == 0) q = std::strtod(params.c_str() + 2, nullptr);
+    }
+
+    if (coding == "gzip" || coding == "x-gzip") gzipQ = q;
+    else if (coding == "deflate")              deflateQ = q;
+    else if (coding == "*")                    anyQ = q;
+  }
+
+  if (gzipQ < 0)    gzipQ = anyQ;
+  if (deflateQ < 0) deflateQ = anyQ;
+  if (gzipQ > 0 && gzipQ >= deflateQ) return ContentCoding::Gzip;
+  if (deflateQ > 0)                   return ContentCoding::Deflate;
+  return ContentCoding::Identity;
+}
+
+std::string CompressionInterceptor::compress(const char* data, std::size_t size, ContentCoding coding, int level) {
+  z_stream& zs = (coding == ContentCoding::Gzip)
+    ? tlGzip.acquire(kGzipWindowBits, level)
+    : tlDeflate.acquire(kDeflateWindowBits, level);
+
+  // deflateBound garante espaço suficiente para um único deflate(Z_FINISH)
+  std::string out;
+  out.resize(deflateBound(&zs, static_cast<uLong>(size)));
+
+  zs.next_in   = reinterpret_cast<Bytef*>(const_cast<char*>(data));
+  zs.avail_in  = static_cast<uInt>(size);
+  zs.next_out  = reinterpret_cast<Bytef*>(out.data());
+  zs.avail_out = static_cast<uInt>(out.size());
+
+  if (deflate(&zs, Z_FINISH) != Z_STREAM_END) {
+    throw std::runtime_error("deflate failed");
+  }
+  out.resize(zs.total_out);
+  return out;
+}
+
+std::shared_ptr<CompressionInterceptor::OutgoingResponse>
+CompressionInterceptor::intercept(const std::shared_ptr<IncomingRequest>& request,
+                                  const std::shared_ptr<OutgoingResponse>& response) {
+  if (!response) return response;
+
+  auto body = response->getBody();
+  if (!body) return response;
+
+  // Só corpos já materializados (BufferBody) e grandes o bastante compensam
+  const auto size = body->getKnownSize();
+  const auto* data = body->getKnownData();
+  if (data == nullptr || size < 0 || static_cast<std::size_t>(size) < minBytes_) return response;
+
+  const auto status = response->getStatus();
+  if (status.code == 204 || status.code == 304) return response;
+  if (response->getHeader("Content-Encoding")) return response;
+
+  // Daqui em diante o corpo depende do Accept-Encoding, comprimido ou não: um cache na frente
+  // precisa do Vary também na resposta sem compressão, senão a serve a quem pediu gzip (e vice-versa)
+  varyOnEncoding(*response);
+
+  const auto accept = request->getHeader("Accept-Encoding");
+  if (!accept) return response;
+  const auto coding = negotiate(std::string(accept->c_str()));
+  if (coding == ContentCoding::Identity) return response;
+
+  auto compressed = compress(reinterpret_cast<const char*>(data), static_cast<std::size_t>(size), coding, level_);
+  if (compressed.size() >= static_cast<std::size_t>(size)) return response; // não compensou
+
+  // O Content-Type é declarado pelo próprio corpo; recuperamos para repassar ao novo corpo.
+  oatpp::web::protocol::http::Headers bodyHeaders;
+  body->declareHeaders(bodyHeaders);
+  const auto contentType = bodyHeaders.get("Content-Type");
+
+  auto newBody = oatpp::web::protocol::http::outgoing::BufferBody::createShared(
+    oatpp::String(std::move(compressed)), contentType);
+  auto out = OutgoingResponse::createShared(status, newBody);
+
+  for (const auto& h : response->getHeaders().getAll_Unsafe()) {
+    out->putHeader(h.first.toString(), h.second.toString());
+  }
+  out->putHeader("Content-Encoding", coding == ContentCoding::Gzip ? "gzip" : "deflate");
+  return out;
+}
+
+} // namespace ecocin::controllers::interceptors
@@ -0,0 +1,36 @@
+#pragma once
+#include "oatpp/web/server/interceptor/ResponseInterceptor.hpp"
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace ecocin::controllers::interceptors {
+
+// Algoritmos de Content-Encoding suportados
+enum class ContentCoding { Identity, Gzip, Deflate };
+
+// Interceptor de resposta que comprime o corpo conforme o Accept-Encoding do cliente.
+// Só atua em corpos de tamanho conhecido acima de um limite configurável: listas como
+// GET /products e GET /orders?cpf= (JSON grande e repetitivo) encolhem bastante, enquanto
+// respostas curtas não pagam o custo da compressão. Os contextos do zlib são reaproveitados
+// por thread (um para gzip, outro para deflate), evitando deflateInit a cada resposta.
+class CompressionInterceptor : public oatpp::web::server::interceptor::ResponseInterceptor {
+private:
+  std::size_t minBytes_;
+  int level_;
+
+public:
+  CompressionInterceptor(std::size_t minBytes, int level)
+    : minBytes_(minBytes), level_(level) {}
+
+  // Escolhe a codificação a partir do valor do Accept-Encoding (respeita q=0; prefere gzip)
+  static ContentCoding negotiate(const std::string& acceptEncoding);
+
+  // Comprime data no formato pedido usando o contexto zlib da thread atual
+  static std::string compress(const char* data, std::size_t size, ContentCoding coding, int level);
+
+  std::shared_ptr<OutgoingResponse> intercept(const std::shared_ptr<IncomingRequest>& request,
+                                              const std::shared_ptr<OutgoingResponse>& response) override;
+};
+
+} // namespace ecocin::controllers::interceptors
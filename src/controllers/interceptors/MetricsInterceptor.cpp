@@ -0,0 +1,76 @@
+#include "MetricsInterceptor.h"
+
+#include "../../infra/metrics/Metrics.h"
+
+#include <spdlog/spdlog.h>
+
+#include <string>
+#include <string_view>
+
+namespace ecocin::controllers::interceptors {
+
+namespace {
+
+constexpr const char* kStartKey = "ecocin.metrics.start";
+constexpr const char* kRouteKey = "ecocin.metrics.route";
+
+std::string_view view(const oatpp::data::share::StringKeyLabel& label) {
+  return {static_cast<const char*>(label.getData()), static_cast<std::size_t>(label.getSize())};
+}
+
+std::int64_t nowNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+} // namespace
+
+void registerRouteMetrics(const std::shared_ptr<oatpp::web::server::api::ApiController>& controller) {
+  auto& registry = ecocin::infra::metrics::Registry::instance();
+  for (const auto& endpoint : controller->getEndpoints().list) {
+    const auto info = endpoint->info();
+    if (!info || !info->method || !info->path) continue;
+    registry.registerRoute(*info->method, *info->path);
+  }
+}
+
+std::shared_ptr<MetricsRequestInterceptor::OutgoingResponse>
+MetricsRequestInterceptor::intercept(const std::shared_ptr<IncomingRequest>& request) {
+  const auto& line = request->getStartingLine();
+  const auto index = ecocin::infra::metrics::Registry::instance().match(
+    view(line.method), view(line.path));
+
+  ecocin::infra::metrics::Registry::instance().route(index).inFlight.fetch_add(1, std::memory_order_relaxed);
+  request->putBundleData(kRouteKey, oatpp::Int64(static_cast<std::int64_t>(index)));
+  request->putBundleData(kStartKey, oatpp::Int64(nowNs()));
+  return nullptr; // segue para o endpoint
+}
+
+std::shared_ptr<MetricsResponseInterceptor::OutgoingResponse>
+MetricsResponseInterceptor::intercept(const std::shared_ptr<IncomingRequest>& request,
+                                      const std::shared_ptr<OutgoingResponse>& response) {
+  if (!request || !response) return response;
+
+  const auto start = request->getBundleData<oatpp::Int64>(kStartKey);
+  const auto index = request->getBundleData<oatpp::Int64>(kRouteKey);
+  if (!start || !index) return response; // a requisição não passou pelo interceptor de entrada
+
+  auto& route = ecocin::infra::metrics::Registry::instance().route(static_cast<std::size_t>(*index));
+  const auto elapsed = nowNs() - *start;
+  route.latencyNs.record(static_cast<std::uint64_t>(elapsed > 0 ? elapsed : 0));
+  route.inFlight.fetch_sub(1, std::memory_order_relaxed);
+
+  const auto code = response->getStatus().code;
+  if (code >= 0 && static_cast<std::size_t>(code) < route.byStatus.size()) {
+    route.byStatus[static_cast<std::size_t>(code)].fetch_add(1, std::memory_order_relaxed);
+  }
+
+  if (slowThreshold_.count() > 0 && elapsed >= std::chrono::nanoseconds(slowThreshold_).count()) {
+    spdlog::warn("requisição lenta: {} {} -> {} em {:.1f} ms",
+                 route.method, view(request->getStartingLine().path), code,
+                 static_cast<double>(elapsed) / 1e6);
+  }
+  return response;
+}
+
+} // namespace ecocin::controllers::interceptors
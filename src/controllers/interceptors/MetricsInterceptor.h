@@ -0,0 +1,35 @@
+#pragma once
+#include "oatpp/web/server/interceptor/RequestInterceptor.hpp"
+#include "oatpp/web/server/interceptor/ResponseInterceptor.hpp"
+#include "oatpp/web/server/api/ApiController.hpp"
+#include <chrono>
+#include <memory>
+
+namespace ecocin::controllers::interceptors {
+
+// Registra as rotas de um controller no registro de métricas (método + caminho com variáveis),
+// para que as requisições sejam agregadas por rota e não por URL concreta.
+void registerRouteMetrics(const std::shared_ptr<oatpp::web::server::api::ApiController>& controller);
+
+// Início da requisição: identifica a rota, incrementa o gauge de requisições em andamento
+// e guarda no bundle da requisição o instante de chegada.
+class MetricsRequestInterceptor : public oatpp::web::server::interceptor::RequestInterceptor {
+public:
+  std::shared_ptr<OutgoingResponse> intercept(const std::shared_ptr<IncomingRequest>& request) override;
+};
+
+// Fim da requisição: registra a latência no histograma da rota, conta o status e
+// decrementa o gauge. Requisições acima de slowThreshold são registradas em log (spdlog).
+class MetricsResponseInterceptor : public oatpp::web::server::interceptor::ResponseInterceptor {
+private:
+  std::chrono::milliseconds slowThreshold_;
+
+public:
+  explicit MetricsResponseInterceptor(std::chrono::milliseconds slowThreshold)
+    : slowThreshold_(slowThreshold) {}
+
+  std::shared_ptr<OutgoingResponse> intercept(const std::shared_ptr<IncomingRequest>& request,
+                                              const std::shared_ptr<OutgoingResponse>& response) override;
+};
+
+} // namespace ecocin::controllers::interceptors
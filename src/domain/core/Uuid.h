@@ -1,57 +1,223 @@
 #ifndef ECOCIN_CORE_UUID_H
 #define ECOCIN_CORE_UUID_H
 
-#include <string>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <optional>
 #include <random>
-#include <sstream>
-#include <iomanip>
+#include <string>
+#include <string_view>
+#include <thread>
 
 // Classe utilitária para geração e manipulação de UUID v4
 // Serve para identificar entidades de forma única no sistema
 // Mantida inline, pois é leve e não requer .cpp adicional
+//
+// Representação: um UUID canônico (36 caracteres, hexadecimal minúsculo com hífens) é guardado
+// como 16 bytes; comparar, ordenar e calcular hash passam a ser operações sobre dois inteiros.
+// Como o SKU também pode ser informado pelo cliente em qualquer formato, textos que não são
+// um UUID canônico são guardados como string, exatamente como chegaram (str() devolve o mesmo texto).
 
 namespace ecocin::core {
 
+namespace detail {
+
+// Valor de cada caractere hexadecimal minúsculo (-1 para os demais)
+constexpr std::array<std::int8_t, 256> makeHexValues() {
+    std::array<std::int8_t, 256> t{};
+    for (auto& v : t) v = -1;
+    for (int i = 0; i < 10; ++i) t['0' + i] = static_cast<std::int8_t>(i);
+    for (int i = 0; i < 6; ++i)  t['a' + i] = static_cast<std::int8_t>(10 + i);
+    return t;
+}
+inline constexpr auto kHexValues = makeHexValues();
+
+// Os dois dígitos hexadecimais de cada byte, em sequência: "000102...feff"
+constexpr std::array<char, 512> makeHexPairs() {
+    constexpr char digits[] = "0123456789abcdef";
+    std::array<char, 512> t{};
+    for (int b = 0; b < 256; ++b) {
+        t[2 * b]     = digits[b >> 4];
+        t[2 * b + 1] = digits[b & 0xF];
+    }
+    return t;
+}
+inline constexpr auto kHexPairs = makeHexPairs();
+
+// xoshiro256** (Blackman/Vigna): gerador rápido e de boa qualidade estatística.
+// Não é criptográfico, o que é suficiente para SKUs; cada thread tem sua própria instância.
+class Xoshiro256 {
+private:
+    std::uint64_t s_[4];
+
+    static std::uint64_t rotl(std::uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+    // splitmix64 espalha a semente pelos 256 bits de estado
+    static std::uint64_t splitmix(std::uint64_t& x) {
+        std::uint64_t z = (x += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+public:
+    explicit Xoshiro256(std::uint64_t seed) {
+        for (auto& s : s_) s = splitmix(seed);
+    }
+
+    std::uint64_t next() {
+        const std::uint64_t result = rotl(s_[1] * 5, 7) * 9;
+        const std::uint64_t t = s_[1] << 17;
+        s_[2] ^= s_[0];
+        s_[3] ^= s_[1];
+        s_[1] ^= s_[2];
+        s_[0] ^= s_[3];
+        s_[2] ^= t;
+        s_[3] = rotl(s_[3], 45);
+        return result;
+    }
+};
+
+// Gerador da thread atual, semeado uma única vez (random_device + relógio + id da thread)
+inline Xoshiro256& threadRng() {
+    thread_local Xoshiro256 rng([] {
+        std::random_device rd;
+        const std::uint64_t entropy = (static_cast<std::uint64_t>(rd()) << 32) ^ rd();
+        const auto now = static_cast<std::uint64_t>(std::chrono::high_resolution_clock::now().time_since_epoch().count());
+        const auto tid = static_cast<std::uint64_t>(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+        return entropy ^ now ^ (tid * 0x9E3779B97F4A7C15ull);
+    }());
+    return rng;
+}
+
+} // namespace detail
+
 class Uuid {
+public:
+    using Bytes = std::array<std::uint8_t, 16>;
+    static constexpr std::size_t kTextSize = 36;
+
 private:
-    std::string value_;
+    Bytes bytes_{};
+    std::string raw_;       // usado apenas quando o texto não é um UUID canônico
+    bool binary_{false};    // true: bytes_ vale; false: raw_ vale (vazio = UUID vazio)
+
+    static constexpr bool isDashPos(std::size_t i) { return i == 8 || i == 13 || i == 18 || i == 23; }
+
+    // Escreve os 36 caracteres do formato canônico em out
+    void format(char* out) const {
+        std::size_t pos = 0;
+        for (std::size_t i = 0; i < 16; ++i) {
+            if (isDashPos(pos)) out[pos++] = '-';
+            std::memcpy(out + pos, &detail::kHexPairs[2 * bytes_[i]], 2);
+            pos += 2;
+        }
+    }
+
+    std::uint64_t half(std::size_t offset) const {
+        std::uint64_t v = 0;
+        for (std::size_t i = 0; i < 8; ++i) v = (v << 8) | bytes_[offset + i];
+        return v;
+    }
 
 public:
     // Construtores
     Uuid() = default;
-    explicit Uuid(const std::string& v) : value_(v) {}
+    explicit Uuid(const std::string& v) {
+        if (auto b = parse(v)) {
+            bytes_ = *b;
+            binary_ = true;
+        } else {
+            raw_ = v;
+        }
+    }
+
+    // Constrói a partir dos 16 bytes (big-endian, ordem do formato textual)
+    static Uuid fromBytes(const Bytes& bytes) {
+        Uuid u;
+        u.bytes_ = bytes;
+        u.binary_ = true;
+        return u;
+    }
+
+    // Interpreta um UUID canônico (36 caracteres, hexadecimal minúsculo); std::nullopt caso contrário
+    static std::optional<Bytes> parse(std::string_view s) {
+        if (s.size() != kTextSize) return std::nullopt;
+        Bytes out{};
+        std::size_t pos = 0;
+        for (std::size_t i = 0; i < 16; ++i) {
+            if (isDashPos(pos)) {
+                if (s[pos] != '-') return std::nullopt;
+                ++pos;
+            }
+            const auto hi = detail::kHexValues[static_cast<unsigned char>(s[pos])];
+            const auto lo = detail::kHexValues[static_cast<unsigned char>(s[pos + 1])];
+            if ((hi | lo) < 0) return std::nullopt;
+            out[i] = static_cast<std::uint8_t>((hi << 4) | lo);
+            pos += 2;
+        }
+        return out;
+    }
 
     // Retorna o valor do UUID em formato string
-    const std::string& str() const { return value_; }
+    std::string str() const {
+        if (!binary_) return raw_;
+        std::string s(kTextSize, '\0');
+        format(s.data());
+        return s;
+    }
+
+    // Mesmo texto de str() sem alocar: usa buf quando o UUID está em forma binária
+    std::string_view view(std::array<char, kTextSize>& buf) const {
+        if (!binary_) return raw_;
+        format(buf.data());
+        return {buf.data(), buf.size()};
+    }
 
     // Indica se o UUID é vazio
-    bool empty() const { return value_.empty(); }
+    bool empty() const { return !binary_ && raw_.empty(); }
+
+    // Indica se o valor está na forma compacta de 16 bytes
+    bool isBinary() const { return binary_; }
+    const Bytes& bytes() const { return bytes_; }
 
     // Comparações
-    bool operator==(const Uuid& other) const { return value_ == other.value_; }
+    bool operator==(const Uuid& other) const {
+        if (binary_ != other.binary_) return false;
+        return binary_ ? bytes_ == other.bytes_ : raw_ == other.raw_;
+    }
     bool operator!=(const Uuid& other) const { return !(*this == other); }
 
+    // Ordem total (para std::map/std::set): binários antes dos textuais, depois por valor
+    bool operator<(const Uuid& other) const {
+        if (binary_ != other.binary_) return binary_;
+        return binary_ ? bytes_ < other.bytes_ : raw_ < other.raw_;
+    }
+
+    std::size_t hash() const {
+        if (!binary_) return std::hash<std::string>{}(raw_);
+        // Os bits do UUID v4 já são aleatórios; basta combinar as duas metades
+        const std::uint64_t h = half(0) ^ (half(8) * 0x9E3779B97F4A7C15ull);
+        return static_cast<std::size_t>(h ^ (h >> 32));
+    }
+
     // Cria um UUID v4 aleatório (padrão RFC 4122)
     static Uuid v4() {
-        std::random_device rd;
-        std::mt19937 gen(rd());
-        std::uniform_int_distribution<int> dist(0, 15);
-        std::uniform_int_distribution<int> dist2(8, 11);
-
-        std::stringstream ss;
-        ss << std::hex;
-        for (int i = 0; i < 8; i++) ss << dist(gen);
-        ss << "-";
-        for (int i = 0; i < 4; i++) ss << dist(gen);
-        ss << "-4"; // versão
-        for (int i = 0; i < 3; i++) ss << dist(gen);
-        ss << "-";
-        ss << dist2(gen);
-        for (int i = 0; i < 3; i++) ss << dist(gen);
-        ss << "-";
-        for (int i = 0; i < 12; i++) ss << dist(gen);
-
-        return Uuid(ss.str());
+        auto& rng = detail::threadRng();
+        const std::uint64_t a = rng.next();
+        const std::uint64_t b = rng.next();
+
+        Bytes bytes;
+        for (std::size_t i = 0; i < 8; ++i) {
+            bytes[i]     = static_cast<std::uint8_t>(a >> (56 - 8 * i));
+            bytes[8 + i] = static_cast<std::uint8_t>(b >> (56 - 8 * i));
+        }
+        bytes[6] = static_cast<std::uint8_t>((bytes[6] & 0x0F) | 0x40); // versão 4
+        bytes[8] = static_cast<std::uint8_t>((bytes[8] & 0x3F) | 0x80); // variante RFC 4122
+        return fromBytes(bytes);
     }
 };
 
@@ -60,4 +226,9 @@ inline Uuid uuid_v4() { return Uuid::v4(); }
 
 } // namespace ecocin::core
 
+template <>
+struct std::hash<ecocin::core::Uuid> {
+    std::size_t operator()(const ecocin::core::Uuid& u) const noexcept { return u.hash(); }
+};
+
 #endif // ECOCIN_CORE_UUID_H
@@ -1,6 +1,7 @@
 #ifndef ADDRESS_H
 #define ADDRESS_H
 
+#include <cstdint>
 #include <string>
 #include <chrono>
 
@@ -15,6 +16,7 @@ private:
     std::string zip_;
     std::string addressType_;
     std::chrono::system_clock::time_point createDate_;
+    std::uint32_t dirty_{kAll}; // Campos alterados desde clearDirty()
 
 public:
     // Construtor padrão (necessário para ORM / deserialização)
@@ -28,6 +30,16 @@ public:
             const std::string& zip,
             const std::string& addressType);
 
+    // Campos que o UPDATE pode gravar. Um setter só marca o campo se o valor mudar;
+    // o repositório zera as marcas ao carregar/criar e o update grava só as colunas marcadas.
+    // Um objeto que não veio do banco começa com tudo marcado (o update grava todas).
+    enum Field : std::uint32_t {
+        kStreet = 1u << 0, kNumber = 1u << 1, kCity = 1u << 2,
+        kState = 1u << 3, kZip = 1u << 4, kAddressType = 1u << 5, kAll = (1u << 6) - 1
+    };
+    std::uint32_t dirtyFields() const { return dirty_; }
+    void clearDirty() { dirty_ = 0; }
+
     // Getters
     long long getId() const { return id_; }
     long long getClientId() const { return client_id_; }
@@ -42,12 +54,12 @@ public:
     // Setters
     void setId(long long id) { id_ = id; }
     void setClientId(long long client_id) { client_id_ = client_id; }
-    void setStreet(const std::string& street) { street_ = street; }
-    void setNumber(const std::string& number) { number_ = number; }
-    void setCity(const std::string& city) { city_ = city; }
-    void setState(const std::string& state) { state_ = state; }
-    void setZip(const std::string& zip) { zip_ = zip; }
-    void setAddressType(const std::string& type) { addressType_ = type; }
+    void setStreet(const std::string& street) { if (street != street_) { street_ = street; dirty_ |= kStreet; } }
+    void setNumber(const std::string& number) { if (number != number_) { number_ = number; dirty_ |= kNumber; } }
+    void setCity(const std::string& city) { if (city != city_) { city_ = city; dirty_ |= kCity; } }
+    void setState(const std::string& state) { if (state != state_) { state_ = state; dirty_ |= kState; } }
+    void setZip(const std::string& zip) { if (zip != zip_) { zip_ = zip; dirty_ |= kZip; } }
+    void setAddressType(const std::string& type) { if (type != addressType_) { addressType_ = type; dirty_ |= kAddressType; } }
     void setCreateDate(const std::chrono::system_clock::time_point& date) { createDate_ = date; }
 };
 
@@ -1,6 +1,7 @@
 #ifndef ECOCIN_ENTITIES_CLIENT_H
 #define ECOCIN_ENTITIES_CLIENT_H
 
+#include <cstdint>
 #include <string>
 #include "../core/Time.h"
 
@@ -11,6 +12,7 @@ class Client{
         std::string email_;
         std::string cpf_;
         ecocin::core::Timestamp createDate_;
+        std::uint32_t dirty_{kAll}; // Campos alterados desde clearDirty()
     
         //Construtores
     public:
@@ -20,6 +22,13 @@ class Client{
                const std::string& cpf);
 
 
+        // Campos que o UPDATE pode gravar. Um setter só marca o campo se o valor mudar;
+        // o repositório zera as marcas ao carregar/criar e o update grava só as colunas marcadas.
+        // Um objeto que não veio do banco começa com tudo marcado (o update grava todas).
+        enum Field : std::uint32_t { kName = 1u << 0, kEmail = 1u << 1, kCpf = 1u << 2, kAll = (1u << 3) - 1 };
+        std::uint32_t dirtyFields() const { return dirty_; }
+        void clearDirty() { dirty_ = 0; }
+
         //getters
         long long                 getId() const {return id_;}
         const std::string&        getName() const {return name_;}
@@ -29,9 +38,9 @@ class Client{
 
         //setters
         void setId(long long id)                            {id_ = id;}
-        void setName(const std::string& name)              { name_ = name; }
-        void setEmail(const std::string& email)            { email_ = email; }
-        void setCpf(const std::string& cpf)                { cpf_ = cpf; }
+        void setName(const std::string& name)              { if (name != name_) { name_ = name; dirty_ |= kName; } }
+        void setEmail(const std::string& email)            { if (email != email_) { email_ = email; dirty_ |= kEmail; } }
+        void setCpf(const std::string& cpf)                { if (cpf != cpf_) { cpf_ = cpf; dirty_ |= kCpf; } }
         void setCreateDate(ecocin::core::Timestamp createDate) { createDate_ = createDate; }
 
         // Utilitários leves (opcionais): normalizações simples
@@ -2,15 +2,21 @@
 #include <chrono>
 
 // Construtores
+// Valores iniciais iguais aos DEFAULT da tabela (os setters comparam com o valor atual)
 Product::Product()
-    : createDate_(std::chrono::system_clock::now()) {}
+    : id_(0),
+      price_(0.0),
+      stockQuantity_(0),
+      isActive_(true),
+      createDate_(std::chrono::system_clock::now()) {}
 Product::Product(const std::string& name,
                  const std::string& description,
                  const ecocin::core::Uuid& sku,
                  double price,
                  int stockQuantity,
                  bool isActive)
-    : name_(name),
+    : id_(0),
+      name_(name),
       description_(description),
       sku_(sku),
       price_(price),
@@ -1,6 +1,7 @@
 #ifndef PRODUCT_H
 #define PRODUCT_H
 
+#include <cstdint>
 #include <string>
 #include "../core/Time.h"
 #include "../core/Uuid.h"
@@ -15,6 +16,7 @@ private:
     int stockQuantity_;
     bool isActive_;
     ecocin::core::Timestamp createDate_;
+    std::uint32_t dirty_{kAll}; // Campos alterados desde clearDirty()
 
 public:
     // Construtores
@@ -25,6 +27,17 @@ public:
             double price,
             int stockQuantity,
             bool isActive);
+    // Campos que o UPDATE pode gravar. Um setter só marca o campo se o valor mudar; o repositório
+    // zera as marcas ao carregar/criar e o update grava só as colunas marcadas (trocar o estoque
+    // não regrava sku nem name, e os índices únicos/de nome não são tocados). Um objeto que não
+    // veio do banco começa com tudo marcado (o update grava todas as colunas).
+    enum Field : std::uint32_t {
+        kName = 1u << 0, kDescription = 1u << 1, kSku = 1u << 2,
+        kPrice = 1u << 3, kStockQuantity = 1u << 4, kIsActive = 1u << 5, kAll = (1u << 6) - 1
+    };
+    std::uint32_t dirtyFields() const { return dirty_; }
+    void clearDirty() { dirty_ = 0; }
+
     // Getters
     long long           getId() const { return id_; }
     const std::string& getName() const { return name_; }
@@ -36,12 +49,12 @@ public:
     ecocin::core::Timestamp getCreateDate() const { return createDate_; }
     // Setters
     void setId(long long id) { id_ = id; }
-    void setName(const std::string& name) { name_ = name; }
-    void setDescription(const std::string& description) { description_ = description; }
-    void setSku(const ecocin::core::Uuid& sku) { sku_ = sku; }
-    void setPrice(double price) { price_ = price; }
-    void setStockQuantity(int stockQuantity) { stockQuantity_ = stockQuantity; }
-    void setIsActive(bool isActive) { isActive_ = isActive; }
+    void setName(const std::string& name) { if (name != name_) { name_ = name; dirty_ |= kName; } }
+    void setDescription(const std::string& description) { if (description != description_) { description_ = description; dirty_ |= kDescription; } }
+    void setSku(const ecocin::core::Uuid& sku) { if (sku != sku_) { sku_ = sku; dirty_ |= kSku; } }
+    void setPrice(double price) { if (price != price_) { price_ = price; dirty_ |= kPrice; } }
+    void setStockQuantity(int stockQuantity) { if (stockQuantity != stockQuantity_) { stockQuantity_ = stockQuantity; dirty_ |= kStockQuantity; } }
+    void setIsActive(bool isActive) { if (isActive != isActive_) { isActive_ = isActive; dirty_ |= kIsActive; } }
     void setCreateDate(ecocin::core::Timestamp createDate) { createDate_ = createDate; }
 
 };
@@ -32,12 +32,14 @@ Order::Order(long long clientId,
 
 // Setters com lógica adicional
 void Order::setQuantity(int quantity) {
+    if (quantity != quantity_) dirty_ |= kQuantity | kTotalPrice;
     quantity_ = quantity;
     calculateTotal();
 }
 
 // Atualiza o preço unitário e recalcula o preço total
 void Order::setUnitPrice(double price) {
+    if (price != unitPrice_) dirty_ |= kUnitPrice | kTotalPrice;
     unitPrice_ = price;
     calculateTotal();
 }
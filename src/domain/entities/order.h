@@ -1,6 +1,7 @@
 #ifndef ORDER_H
 #define ORDER_H
 
+#include <cstdint>
 #include <string>
 #include "../core/Time.h"
 
@@ -15,6 +16,7 @@ private:
     double totalPrice_;
     std::string status_;
     ecocin::core::Timestamp createDate_;
+    std::uint32_t dirty_{kAll}; // Campos alterados desde clearDirty()
 
 public:
     // Construtores
@@ -26,6 +28,17 @@ public:
           double unitPrice,
           const std::string& status = "PENDING");
 
+    // Campos que o UPDATE pode gravar. Um setter só marca o campo se o valor mudar (quantity e
+    // unitPrice marcam também totalPrice); o repositório zera as marcas ao carregar/criar e o
+    // update grava só as colunas marcadas. Um objeto que não veio do banco começa com tudo marcado.
+    enum Field : std::uint32_t {
+        kClientId = 1u << 0, kProductId = 1u << 1, kShippingAddressId = 1u << 2,
+        kQuantity = 1u << 3, kUnitPrice = 1u << 4, kTotalPrice = 1u << 5, kStatus = 1u << 6,
+        kAll = (1u << 7) - 1
+    };
+    std::uint32_t dirtyFields() const { return dirty_; }
+    void clearDirty() { dirty_ = 0; }
+
     // Getters
     long long getId() const { return id_; }
     long long getClientId() const { return clientId_; }
@@ -39,12 +52,12 @@ public:
 
     // Setters
     void setId(long long id) { id_ = id; }
-    void setClientId(long long clientId) { clientId_ = clientId; }
-    void setProductId(long long productId) { productId_ = productId; }
-    void setShippingAddressId(long long addrId) { shippingAddressId_ = addrId; }
+    void setClientId(long long clientId) { if (clientId != clientId_) { clientId_ = clientId; dirty_ |= kClientId; } }
+    void setProductId(long long productId) { if (productId != productId_) { productId_ = productId; dirty_ |= kProductId; } }
+    void setShippingAddressId(long long addrId) { if (addrId != shippingAddressId_) { shippingAddressId_ = addrId; dirty_ |= kShippingAddressId; } }
     void setQuantity(int quantity);
     void setUnitPrice(double price);
-    void setStatus(const std::string& status) { status_ = status; }
+    void setStatus(const std::string& status) { if (status != status_) { status_ = status; dirty_ |= kStatus; } }
     void setCreateDate(ecocin::core::Timestamp date) { createDate_ = date; }
 
     // utilitário
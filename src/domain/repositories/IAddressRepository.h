@@ -1,7 +1,9 @@
 #ifndef IADDRESSREPOSITORY_H
 #define IADDRESSREPOSITORY_H
+#include <memory_resource>
 #include <vector>
 #include <optional>
+#include <string>
 #include "../../domain/entities/Address.h"
 
 namespace ecocin::domain::repositories {
@@ -13,10 +15,15 @@ public:
 
     virtual Address create(const Address& in) = 0;
     virtual std::optional<Address> findById(long long id) = 0;
+    // Vários de uma vez (uma consulta): na ordem pedida, sem repetidos; os que não existem ficam de fora
+    virtual std::vector<Address> findByIds(const std::vector<long long>& ids) = 0;
     virtual std::vector<Address> listAll() = 0;
+    virtual std::pmr::vector<Address> listAll(std::pmr::memory_resource* mr) = 0; // Vetor alocado em mr
     virtual bool update(const Address& addr) = 0;
     virtual bool remove(long long id) = 0;
     virtual std::vector<Address>   listByClientId(long long clientId) = 0;
+    virtual std::pmr::vector<Address> listByClientId(long long clientId, std::pmr::memory_resource* mr) = 0;
+    virtual std::optional<Address> findByClientIdAndType(long long clientId, const std::string& type) = 0; // Mais recente do tipo
 };
 }
 #endif // IADDRESSREPOSITORY_H
\ No newline at end of file
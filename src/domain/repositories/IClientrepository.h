@@ -1,6 +1,7 @@
 #ifndef ECOCIN_DOMAIN_REPOSITORIES_ICLIENTREPOSITORY_H
 #define ECOCIN_DOMAIN_REPOSITORIES_ICLIENTREPOSITORY_H
 
+#include <memory_resource>
 #include <vector>
 #include <optional>
 #include <string>
@@ -16,7 +17,11 @@ public:
     virtual Client create(const Client& in) = 0;
     virtual std::optional<Client> findById(long long id) = 0;
     virtual std::optional<Client> findByCpf(const std::string& cpf) = 0;
+    // Vários de uma vez (uma consulta): na ordem pedida, sem repetidos; os que não existem ficam de fora
+    virtual std::vector<Client> findByIds(const std::vector<long long>& ids) = 0;
+    virtual std::vector<Client> findByCpfs(const std::vector<std::string>& cpfs) = 0;
     virtual std::vector<Client> listAll() = 0;
+    virtual std::pmr::vector<Client> listAll(std::pmr::memory_resource* mr) = 0; // Vetor alocado em mr
     virtual bool update(const Client& c) = 0;
     virtual bool remove(long long id) = 0;
 };
@@ -0,0 +1,36 @@
+#ifndef ECOCIN_DOMAIN_REPOSITORIES_IORDERREFERENCES_H
+#define ECOCIN_DOMAIN_REPOSITORIES_IORDERREFERENCES_H
+
+#include <functional>
+#include <stdexcept>
+
+namespace ecocin::domain::repositories {
+
+// Remoção recusada porque há pedidos apontando para o registro, ou pedido recusado porque aponta
+// para um registro já removido. Os controllers respondem 409.
+class OrderReferenceConflict : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
+
+enum class OrderReference { Client, Product, Address };
+
+// Pedidos que apontam para um cliente, produto ou endereço, quando os pedidos ficam fora do SQLite
+// (log de pedidos) e as chaves estrangeiras de orders não os alcançam.
+class IOrderReferences {
+public:
+    virtual ~IOrderReferences() = default;
+
+    virtual bool referencesClient(long long clientId) const = 0;
+    virtual bool referencesProduct(long long productId) const = 0;
+    virtual bool referencesAddress(long long addressId) const = 0;
+
+    // Roda remove() travando a chave contra pedidos novos: lança OrderReferenceConflict sem chamar
+    // remove() se algum pedido aponta para ela; se remove() devolve true, pedidos gravados depois
+    // que apontem para ela também são recusados. Devolve o resultado de remove().
+    virtual bool removeUnreferenced(OrderReference kind, long long id, const std::function<bool()>& remove) = 0;
+};
+
+} // namespace ecocin::domain::repositories
+
+#endif // ECOCIN_DOMAIN_REPOSITORIES_IORDERREFERENCES_H
@@ -1,6 +1,7 @@
 #ifndef ECOCIN_DOMAIN_REPOSITORIES_IORDERREPOSITORY_H
 #define ECOCIN_DOMAIN_REPOSITORIES_IORDERREPOSITORY_H
 
+#include <memory_resource>
 #include <vector>
 #include <optional>
 #include <string>
@@ -16,11 +17,13 @@ public:
   virtual Order create(const Order& in) = 0;
   virtual std::optional<Order> findById(long long id) = 0;
   virtual std::vector<Order> listAll() = 0;
+  virtual std::pmr::vector<Order> listAll(std::pmr::memory_resource* mr) = 0; // Vetor alocado em mr
   virtual bool update(const Order& o) = 0;
   virtual bool remove(long long id) = 0;
 
   // Consultas
   virtual std::vector<Order> listByClientId(long long clientId) = 0; // Pedidos de um cliente
+  virtual std::pmr::vector<Order> listByClientId(long long clientId, std::pmr::memory_resource* mr) = 0;
   virtual bool updateStatus(long long id, const std::string& newStatus) = 0; // Atualiza status do pedido
   virtual bool updateShippingAddress(long long id, long long newAddressId) = 0; // Atualiza endereço de entrega
 };
@@ -1,12 +1,21 @@
 #ifndef ECOCIN_INFRA_REPOSITORIES_IPRODUCTREPOSITORY_H
 #define ECOCIN_INFRA_REPOSITORIES_IPRODUCTREPOSITORY_H
 
+#include <memory_resource>
+#include <string>
 #include <vector>
 #include <optional>
 #include "../../domain/entities/Product.h"
 
 namespace ecocin::domain::repositories {
 
+// Valor gravado por uma atualização parcial (adjustStock/updatePrice), com o SKU do produto
+template <class T>
+struct ProductFieldUpdate {
+    T value;
+    std::string sku;
+};
+
 // Interface para Product Repository
 class IProductRepository {
 public:
@@ -15,8 +24,16 @@ public:
     virtual Product create(const Product& in) = 0;
     virtual std::optional<Product> findById(long long id) = 0;
     virtual std::optional<Product> findBySku(const std::string& sku) = 0;
+    // Vários de uma vez (uma consulta): na ordem pedida, sem repetidos; os que não existem ficam de fora
+    virtual std::vector<Product> findByIds(const std::vector<long long>& ids) = 0;
+    virtual std::vector<Product> findBySkus(const std::vector<std::string>& skus) = 0;
     virtual std::vector<Product> listAll() = 0;
+    virtual std::pmr::vector<Product> listAll(std::pmr::memory_resource* mr) = 0; // Vetor alocado em mr
     virtual bool update(const Product& p) = 0;
+    // Atualizações parciais num único UPDATE, sem ler o produto antes. std::nullopt se o produto
+    // não existe ou (adjustStock) se o estoque resultante sairia de [0, INT_MAX]
+    virtual std::optional<ProductFieldUpdate<int>> adjustStock(long long id, int delta) = 0;
+    virtual std::optional<ProductFieldUpdate<double>> updatePrice(long long id, double price) = 0;
     virtual bool remove(long long id) = 0;
 };
 
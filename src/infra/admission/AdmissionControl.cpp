@@ -0,0 +1,175 @@
+#include "AdmissionControl.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+
+namespace ecocin::infra::admission {
+
+namespace {
+
+constexpr std::int64_t kNoSample = std::numeric_limits<std::int64_t>::max();
+
+// Limite usado quando só o alvo de latência foi configurado
+constexpr std::int64_t kDefaultCap = 1024;
+
+std::int64_t toNs(Clock::time_point t) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(t.time_since_epoch()).count();
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------------------------
+// TokenBucketLimiter
+
+TokenBucketLimiter::TokenBucketLimiter(double ratePerSec, double burst, std::size_t maxClients)
+    : rate_(ratePerSec),
+      burst_(burst > 0 ? burst : std::max(1.0, 2 * ratePerSec)),
+      maxPerShard_(std::max<std::size_t>(1, maxClients / kShards)) {}
+
+// Abre espaço no shard: primeiro descarta os baldes que já estariam cheios (cliente ocioso, o
+// estado não importa mais); se não bastar, o cliente visto há mais tempo.
+void TokenBucketLimiter::evictIdle(Shard& shard, Clock::time_point now) {
+    for (auto it = shard.buckets.begin(); it != shard.buckets.end();) {
+        const double elapsed = std::chrono::duration<double>(now - it->second.last).count();
+        it = it->second.tokens + elapsed * rate_ >= burst_ ? shard.buckets.erase(it) : std::next(it);
+    }
+    if (shard.buckets.size() < maxPerShard_) return;
+    const auto oldest = std::min_element(shard.buckets.begin(), shard.buckets.end(),
+        [](const auto& a, const auto& b) { return a.second.last < b.second.last; });
+    shard.buckets.erase(oldest);
+}
+
+bool TokenBucketLimiter::tryAcquire(std::string_view client, Clock::time_point now, std::chrono::nanoseconds& wait) {
+    auto& shard = shards_[std::hash<std::string_view>{}(client) % kShards];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    auto it = shard.buckets.find(client);
+    if (it == shard.buckets.end()) {
+        if (shard.buckets.size() >= maxPerShard_) evictIdle(shard, now);
+        it = shard.buckets.emplace(std::string(client), Bucket{burst_, now}).first;
+    }
+
+    auto& b = it->second;
+    const double elapsed = std::chrono::duration<double>(now - b.last).count();
+    b.tokens = std::min(burst_, b.tokens + std::max(0.0, elapsed) * rate_);
+    b.last = now;
+
+    if (b.tokens >= 1.0) {
+        b.tokens -= 1.0;
+        return true;
+    }
+    wait = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::duration<double>((1.0 - b.tokens) / rate_));
+    return false;
+}
+
+// ---------------------------------------------------------------------------------------------
+// AdaptiveLimiter
+
+AdaptiveLimiter::AdaptiveLimiter(std::size_t maxInFlight, std::chrono::nanoseconds latencyTarget, double writeShare)
+    : cap_(maxInFlight > 0 ? static_cast<std::int64_t>(maxInFlight) : kDefaultCap),
+      floor_(std::max<std::int64_t>(1, cap_ / 10)),
+      target_(latencyTarget),
+      writeShare_(std::clamp(writeShare, 0.0, 1.0)),
+      limit_(cap_) {}
+
+bool AdaptiveLimiter::tryEnter(Priority priority) {
+    if (priority == Priority::Critical) return true;
+
+    const auto limit = limit_.load(std::memory_order_relaxed);
+    const auto allowed = priority == Priority::Write
+        ? std::max<std::int64_t>(1, static_cast<std::int64_t>(static_cast<double>(limit) * writeShare_))
+        : limit;
+    if (inFlight_.fetch_add(1, std::memory_order_relaxed) + 1 > allowed) {
+        inFlight_.fetch_sub(1, std::memory_order_relaxed);
+        return false;
+    }
+    return true;
+}
+
+void AdaptiveLimiter::leave(std::chrono::nanoseconds latency, Clock::time_point now) {
+    inFlight_.fetch_sub(1, std::memory_order_relaxed);
+    if (target_.count() <= 0) return;
+
+    // Menor latência da janela atual
+    const auto ns = latency.count();
+    auto seen = windowMinNs_.load(std::memory_order_relaxed);
+    while (ns < seen && !windowMinNs_.compare_exchange_weak(seen, ns, std::memory_order_relaxed)) {}
+
+    // Quem fecha a janela recalcula o limite; as demais threads seguem sem esperar
+    const auto nowNs = toNs(now);
+    if (nowNs - windowStartNs_.load(std::memory_order_relaxed) < std::chrono::nanoseconds(kWindow).count()) return;
+    std::unique_lock<std::mutex> lock(windowMutex_, std::try_to_lock);
+    if (lock.owns_lock()) adjust(nowNs);
+}
+
+void AdaptiveLimiter::adjust(std::int64_t nowNs) {
+    if (nowNs - windowStartNs_.load(std::memory_order_relaxed) < std::chrono::nanoseconds(kWindow).count()) return;
+    windowStartNs_.store(nowNs, std::memory_order_relaxed);
+    const auto minNs = windowMinNs_.exchange(kNoSample, std::memory_order_relaxed);
+    if (minNs == kNoSample) return;
+
+    const auto current = limit_.load(std::memory_order_relaxed);
+    const auto next = minNs > target_.count()
+        ? std::max(floor_, static_cast<std::int64_t>(static_cast<double>(current) * 0.8))
+        : std::min(cap_, current + std::max<std::int64_t>(1, current / 20));
+    limit_.store(next, std::memory_order_relaxed);
+}
+
+// ---------------------------------------------------------------------------------------------
+// AdmissionControl
+
+AdmissionControl::AdmissionControl(const AdmissionConfig& config)
+    : config_(config),
+      buckets_(config.ratePerSec, config.burst, config.maxClients),
+      concurrency_(config.maxInFlight, config.latencyTarget, config.writeShare) {}
+
+Priority AdmissionControl::classify(std::string_view method, std::string_view path) {
+    path = path.substr(0, path.find('?'));
+    if (path == "/health" || path == "/metrics" || path.rfind("/admin/", 0) == 0) return Priority::Critical;
+    if (method == "GET" || method == "HEAD") return Priority::Read;
+    return Priority::Write;
+}
+
+std::string AdmissionControl::clientFromForwardedFor(std::string_view header, std::size_t trustedProxies) {
+    std::string_view client;
+    std::size_t seen = 0;
+    // Da direita para a esquerda, pulando entradas vazias
+    while (!header.empty() && seen < std::max<std::size_t>(trustedProxies, 1)) {
+        const auto comma = header.rfind(',');
+        auto entry = comma == std::string_view::npos ? header : header.substr(comma + 1);
+        header = comma == std::string_view::npos ? std::string_view{} : header.substr(0, comma);
+        const auto b = entry.find_first_not_of(" \t");
+        if (b == std::string_view::npos) continue;
+        entry = entry.substr(b, entry.find_last_not_of(" \t") - b + 1);
+        client = entry;
+        ++seen;
+    }
+    return std::string(client);
+}
+
+Decision AdmissionControl::admit(std::string_view client, Priority priority, Clock::time_point now) {
+    if (priority == Priority::Critical) return {};
+
+    if (rateLimitEnabled()) {
+        std::chrono::nanoseconds wait{0};
+        if (!buckets_.tryAcquire(client, now, wait)) {
+            rateLimited_.fetch_add(1, std::memory_order_relaxed);
+            const auto seconds = std::ceil(std::chrono::duration<double>(wait).count());
+            return {Verdict::RateLimited, std::chrono::seconds(std::max<std::int64_t>(1, static_cast<std::int64_t>(seconds)))};
+        }
+    }
+    if (sheddingEnabled() && !concurrency_.tryEnter(priority)) {
+        shed_.fetch_add(1, std::memory_order_relaxed);
+        return {Verdict::Overloaded, std::chrono::seconds(1)};
+    }
+    return {};
+}
+
+void AdmissionControl::finish(Priority priority, std::chrono::nanoseconds latency, Clock::time_point now) {
+    if (priority == Priority::Critical || !sheddingEnabled()) return;
+    concurrency_.leave(latency, now);
+}
+
+} // namespace ecocin::infra::admission
@@ -0,0 +1,150 @@
+#ifndef ECOCIN_INFRA_ADMISSION_ADMISSIONCONTROL_H
+#define ECOCIN_INFRA_ADMISSION_ADMISSIONCONTROL_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace ecocin::infra::admission {
+
+using Clock = std::chrono::steady_clock;
+
+// Classes de prioridade das requisições. Sob sobrecarga as escritas são recusadas primeiro,
+// depois as leituras; as rotas críticas (health, métricas, admin) nunca são recusadas.
+enum class Priority { Critical, Read, Write };
+
+enum class Verdict {
+    Admit,
+    RateLimited, // o cliente passou da sua taxa (429)
+    Overloaded   // o servidor está acima do limite de concorrência (503)
+};
+
+struct Decision {
+    Verdict verdict{Verdict::Admit};
+    std::chrono::seconds retryAfter{0}; // valor do cabeçalho Retry-After quando recusada
+};
+
+struct AdmissionConfig {
+    double ratePerSec{0};          // taxa sustentada por IP (0 desliga o limite por cliente)
+    double burst{0};               // tamanho do balde (0 = 2x a taxa)
+    std::size_t maxClients{100000}; // baldes mantidos em memória antes de descartar os ociosos
+    std::size_t maxInFlight{0};    // teto de requisições simultâneas (0 = sem teto fixo)
+    std::chrono::milliseconds latencyTarget{0}; // alvo de latência do limite adaptativo (0 desliga)
+    double writeShare{0.8};        // fração do limite que as escritas podem ocupar
+};
+
+// Limite por cliente com baldes de fichas (token bucket): cada IP acumula fichas a ratePerSec
+// até burst, e cada requisição gasta uma. Os baldes ficam em shards com mutex próprio para que
+// requisições de IPs diferentes não disputem o mesmo lock.
+class TokenBucketLimiter {
+private:
+    struct Bucket {
+        double tokens;
+        Clock::time_point last;
+    };
+    struct ClientHash {
+        using is_transparent = void;
+        std::size_t operator()(std::string_view s) const noexcept { return std::hash<std::string_view>{}(s); }
+    };
+    struct Shard {
+        std::mutex mutex;
+        std::unordered_map<std::string, Bucket, ClientHash, std::equal_to<>> buckets;
+    };
+    static constexpr std::size_t kShards = 16;
+
+    double rate_;
+    double burst_;
+    std::size_t maxPerShard_;
+    std::array<Shard, kShards> shards_;
+
+    void evictIdle(Shard& shard, Clock::time_point now);
+
+public:
+    TokenBucketLimiter(double ratePerSec, double burst, std::size_t maxClients);
+
+    // Gasta uma ficha do cliente; se não houver, devolve false e o tempo até a próxima ficha
+    bool tryAcquire(std::string_view client, Clock::time_point now, std::chrono::nanoseconds& wait);
+};
+
+// Limite de concorrência adaptativo. Conta as requisições não críticas em andamento (a fila
+// efetiva atrás da conexão SQLite) e só admite novas enquanto estiverem abaixo do limite atual.
+// Com um alvo de latência, o limite se ajusta a cada janela: se até a requisição mais rápida da
+// janela passou do alvo, há fila parada e o limite cai 20%; caso contrário ele volta a subir aos
+// poucos (aumento aditivo, redução multiplicativa).
+class AdaptiveLimiter {
+private:
+    static constexpr auto kWindow = std::chrono::milliseconds(100);
+
+    std::int64_t cap_;
+    std::int64_t floor_;
+    std::chrono::nanoseconds target_;
+    double writeShare_;
+    std::atomic<std::int64_t> inFlight_{0};
+    std::atomic<std::int64_t> limit_;
+
+    std::mutex windowMutex_;
+    std::atomic<std::int64_t> windowStartNs_{0};
+    std::atomic<std::int64_t> windowMinNs_{INT64_MAX};
+
+    void adjust(std::int64_t nowNs);
+
+public:
+    AdaptiveLimiter(std::size_t maxInFlight, std::chrono::nanoseconds latencyTarget, double writeShare);
+
+    // Reserva uma vaga para a requisição; false quando ela deve ser recusada
+    bool tryEnter(Priority priority);
+
+    // Libera a vaga e informa a latência observada
+    void leave(std::chrono::nanoseconds latency, Clock::time_point now);
+
+    std::int64_t inFlight() const { return inFlight_.load(std::memory_order_relaxed); }
+    std::int64_t limit() const { return limit_.load(std::memory_order_relaxed); }
+};
+
+// Controle de admissão do servidor, compartilhado por todos os acceptors: primeiro o limite por
+// cliente, depois o limite de concorrência. Rotas críticas passam direto pelos dois.
+class AdmissionControl {
+private:
+    AdmissionConfig config_;
+    TokenBucketLimiter buckets_;
+    AdaptiveLimiter concurrency_;
+    std::atomic<std::uint64_t> rateLimited_{0};
+    std::atomic<std::uint64_t> shed_{0};
+
+public:
+    explicit AdmissionControl(const AdmissionConfig& config);
+
+    // Classe de prioridade pela rota: GET /health, /metrics e /admin/* são críticas;
+    // GET e HEAD são leituras; o resto são escritas.
+    static Priority classify(std::string_view method, std::string_view path);
+
+    // Cliente de um X-Forwarded-For atrás de trustedProxies proxies: cada proxy acrescenta à direita
+    // o endereço de quem se conectou a ele, então só as trustedProxies entradas da direita são
+    // confiáveis e o cliente é a de número trustedProxies contando da direita (o que o cliente
+    // mandou no cabeçalho fica à esquerda e é ignorado). Com menos entradas, a mais à esquerda.
+    // Vazio se o cabeçalho não tem nenhuma entrada.
+    static std::string clientFromForwardedFor(std::string_view header, std::size_t trustedProxies);
+
+    // Decide se a requisição entra. Quando admitida (e não crítica), finish() deve ser chamado ao fim.
+    Decision admit(std::string_view client, Priority priority, Clock::time_point now = Clock::now());
+    void finish(Priority priority, std::chrono::nanoseconds latency, Clock::time_point now = Clock::now());
+
+    bool rateLimitEnabled() const { return config_.ratePerSec > 0; }
+    bool sheddingEnabled() const { return config_.maxInFlight > 0 || config_.latencyTarget.count() > 0; }
+
+    std::int64_t inFlight() const { return concurrency_.inFlight(); }
+    std::int64_t limit() const { return concurrency_.limit(); }
+    std::uint64_t rateLimitedCount() const { return rateLimited_.load(std::memory_order_relaxed); }
+    std::uint64_t shedCount() const { return shed_.load(std::memory_order_relaxed); }
+};
+
+} // namespace ecocin::infra::admission
+
+#endif // ECOCIN_INFRA_ADMISSION_ADMISSIONCONTROL_H
@@ -0,0 +1,176 @@
+#include "ColumnBatch.h"
+
+#include <algorithm>
+#include <cctype>
+#include <limits>
+#include <stdexcept>
+
+namespace ecocin::infra::db {
+
+namespace {
+
+// Afinidade do tipo declarado (mesmas regras do SQLite, seção 3.1 de datatype3)
+bool affinity(const char* decl, ColumnKind& kind) {
+    if (!decl || !*decl) return false;
+    std::string t(decl);
+    std::transform(t.begin(), t.end(), t.begin(), [](unsigned char c) { return static_cast<char>(std::toupper(c)); });
+    if (t.find("INT") != std::string::npos) kind = ColumnKind::Integer;
+    else if (t.find("CHAR") != std::string::npos || t.find("CLOB") != std::string::npos ||
+             t.find("TEXT") != std::string::npos || t.find("BLOB") != std::string::npos) kind = ColumnKind::Text;
+    else kind = ColumnKind::Real; // REAL, FLOAT, DOUBLE, NUMERIC, DECIMAL...
+    return true;
+}
+
+ColumnKind kindOfValue(int type) {
+    switch (type) {
+        case SQLITE_INTEGER: return ColumnKind::Integer;
+        case SQLITE_FLOAT:   return ColumnKind::Real;
+        default:             return ColumnKind::Text;
+    }
+}
+
+} // namespace
+
+void TextColumn::push(std::string_view value) {
+    if (bytes_.size() + value.size() > std::numeric_limits<std::uint32_t>::max()) {
+        throw std::length_error("coluna de texto passou de 4 GiB; leia em lotes (limit)");
+    }
+    bytes_.append(value);
+    offsets_.push_back(static_cast<std::uint32_t>(bytes_.size()));
+}
+
+ColumnBatch ColumnBatch::read(sqlite3_stmt* st, std::size_t expectedRows) {
+    ColumnBatch batch;
+    const int count = sqlite3_column_count(st);
+    std::vector<bool> typed(static_cast<std::size_t>(count));
+    batch.columns_.resize(static_cast<std::size_t>(count));
+    for (int c = 0; c < count; ++c) {
+        auto& col = batch.columns_[static_cast<std::size_t>(c)];
+        col.name = sqlite3_column_name(st, c);
+        typed[static_cast<std::size_t>(c)] = affinity(sqlite3_column_decltype(st, c), col.kind);
+    }
+
+    auto reserve = [&](Column& col) {
+        if (expectedRows == 0) return;
+        switch (col.kind) {
+            case ColumnKind::Integer: col.ints.reserve(expectedRows); break;
+            case ColumnKind::Real:    col.reals.reserve(expectedRows); break;
+            case ColumnKind::Text:    col.text.reserve(expectedRows, expectedRows * 16); break;
+        }
+    };
+    for (int c = 0; c < count; ++c) {
+        if (typed[static_cast<std::size_t>(c)]) reserve(batch.columns_[static_cast<std::size_t>(c)]);
+    }
+
+    int idColumn = -1;
+    for (int c = 0; c < count; ++c) {
+        const auto& col = batch.columns_[static_cast<std::size_t>(c)];
+        if (col.name == "id" && (col.kind == ColumnKind::Integer || !typed[static_cast<std::size_t>(c)])) idColumn = c;
+    }
+
+    int rc;
+    while ((rc = sqlite3_step(st)) == SQLITE_ROW) {
+        for (int c = 0; c < count; ++c) {
+            auto& col = batch.columns_[static_cast<std::size_t>(c)];
+            const int type = sqlite3_column_type(st, c);
+            if (!typed[static_cast<std::size_t>(c)] && type != SQLITE_NULL) {
+                // Expressão sem tipo declarado: vale o tipo do primeiro valor não nulo
+                col.kind = kindOfValue(type);
+                typed[static_cast<std::size_t>(c)] = true;
+                col.text = TextColumn{}; // linhas anteriores eram todas NULL
+                reserve(col);
+                if (batch.rows_ > 0) {
+                    if (col.kind == ColumnKind::Integer) col.ints.assign(batch.rows_, 0);
+                    else if (col.kind == ColumnKind::Real) col.reals.assign(batch.rows_, 0.0);
+                    else for (std::size_t r = 0; r < batch.rows_; ++r) col.text.push({});
+                }
+            }
+
+            if (type == SQLITE_NULL) {
+                if (col.nulls.empty()) col.nulls.assign(batch.rows_, 0);
+                col.nulls.push_back(1);
+            } else if (!col.nulls.empty()) {
+                col.nulls.push_back(0);
+            }
+
+            switch (col.kind) {
+                case ColumnKind::Integer: col.ints.push_back(sqlite3_column_int64(st, c)); break;
+                case ColumnKind::Real:    col.reals.push_back(sqlite3_column_double(st, c)); break;
+                case ColumnKind::Text: {
+                    const auto* p = reinterpret_cast<const char*>(sqlite3_column_text(st, c));
+                    col.text.push(p ? std::string_view(p, static_cast<std::size_t>(sqlite3_column_bytes(st, c))) : std::string_view{});
+                    break;
+                }
+            }
+        }
+        if (idColumn >= 0) batch.lastId_ = sqlite3_column_int64(st, idColumn);
+        ++batch.rows_;
+    }
+    if (rc != SQLITE_DONE) {
+        throw std::runtime_error(std::string("SQLite error @ column batch: ") + sqlite3_errmsg(sqlite3_db_handle(st)));
+    }
+
+    // Colunas só com NULL (ou lote vazio) ficam com o tipo de texto e o tamanho certo
+    for (auto& col : batch.columns_) {
+        if (col.kind == ColumnKind::Text) while (col.text.size() < batch.rows_) col.text.push({});
+    }
+    return batch;
+}
+
+ColumnBatch ColumnBatch::scan(SqliteConnection& cx, std::string_view source,
+                              std::initializer_list<std::string_view> allowed,
+                              const std::vector<std::string>& columns,
+                              long long afterId, std::size_t limit) {
+    std::string sql = "SELECT id";
+    auto add = [&](std::string_view name) {
+        if (name == "id") return;
+        sql += ',';
+        sql += name;
+    };
+    if (columns.empty()) {
+        for (auto name : allowed) add(name);
+    } else {
+        for (const auto& name : columns) {
+            if (std::find(allowed.begin(), allowed.end(), name) == allowed.end()) {
+                throw std::invalid_argument("coluna desconhecida em " + std::string(source) + ": " + name);
+            }
+            add(name);
+        }
+    }
+    sql += " FROM ";
+    sql += source;
+    sql += " WHERE id > ? ORDER BY id";
+    if (limit > 0) sql += " LIMIT ?";
+
+    Statement st(cx, sql, "prepare column scan");
+    sqlite3_bind_int64(st, 1, afterId);
+    if (limit > 0) sqlite3_bind_int64(st, 2, static_cast<sqlite3_int64>(limit));
+    return read(st, limit);
+}
+
+const ColumnBatch::Column& ColumnBatch::column(std::string_view name) const {
+    for (const auto& col : columns_) {
+        if (col.name == name) return col;
+    }
+    throw std::out_of_range("coluna ausente no lote: " + std::string(name));
+}
+
+std::span<const std::int64_t> ColumnBatch::ints(std::string_view name) const {
+    const auto& col = column(name);
+    if (col.kind != ColumnKind::Integer) throw std::out_of_range("coluna não é inteira: " + std::string(name));
+    return col.ints;
+}
+
+std::span<const double> ColumnBatch::reals(std::string_view name) const {
+    const auto& col = column(name);
+    if (col.kind != ColumnKind::Real) throw std::out_of_range("coluna não é real: " + std::string(name));
+    return col.reals;
+}
+
+const TextColumn& ColumnBatch::text(std::string_view name) const {
+    const auto& col = column(name);
+    if (col.kind != ColumnKind::Text) throw std::out_of_range("coluna não é texto: " + std::string(name));
+    return col.text;
+}
+
+} // namespace ecocin::infra::db
@@ -0,0 +1,93 @@
+#ifndef ECOCIN_INFRA_DB_COLUMNBATCH_H
+#define ECOCIN_INFRA_DB_COLUMNBATCH_H
+
+#include "SqliteConnection.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ecocin::infra::db {
+
+enum class ColumnKind { Integer, Real, Text };
+
+// Coluna de texto em dois arrays: os bytes de todas as linhas, um atrás do outro, e os offsets
+// (a linha i ocupa bytes[offsets[i], offsets[i+1])). Uma alocação por coluna em vez de uma por valor.
+class TextColumn {
+private:
+    std::vector<std::uint32_t> offsets_{0};
+    std::string bytes_;
+
+public:
+    void reserve(std::size_t rows, std::size_t bytes) {
+        offsets_.reserve(rows + 1);
+        bytes_.reserve(bytes);
+    }
+    void push(std::string_view value);
+
+    std::size_t size() const { return offsets_.size() - 1; }
+    std::string_view operator[](std::size_t row) const {
+        return std::string_view(bytes_).substr(offsets_[row], offsets_[row + 1] - offsets_[row]);
+    }
+    const std::vector<std::uint32_t>& offsets() const { return offsets_; }
+    const std::string& bytes() const { return bytes_; }
+};
+
+// Resultado colunar de uma consulta: um array contíguo por coluna, preenchido direto do sqlite3_stmt.
+// Para varreduras em massa (exportações, relatórios) que leem uma ou duas colunas de muitas linhas:
+// somar price de todos os produtos percorre um std::vector<double> em vez de pular de Product em
+// Product (cada um com várias std::string), e o laço fica em forma de o compilador vetorizar.
+//
+// O tipo de cada coluna vem do tipo declarado no esquema (INTEGER, REAL, TEXT); NULL vira 0 / ""
+// e é marcado em nulls, que só é alocado se aparecer algum NULL na coluna.
+class ColumnBatch {
+public:
+    struct Column {
+        std::string name;
+        ColumnKind kind{ColumnKind::Text};
+        std::vector<std::int64_t> ints;   // ColumnKind::Integer
+        std::vector<double> reals;        // ColumnKind::Real
+        TextColumn text;                  // ColumnKind::Text
+        std::vector<std::uint8_t> nulls;  // 1 = NULL; vazio se a coluna não tem NULL
+
+        bool isNull(std::size_t row) const { return !nulls.empty() && nulls[row]; }
+    };
+
+    // Lê todas as linhas de st (já com os parâmetros ligados). expectedRows só pré-reserva espaço.
+    static ColumnBatch read(sqlite3_stmt* st, std::size_t expectedRows = 0);
+
+    // SELECT id, <columns> FROM <source> WHERE id > afterId ORDER BY id [LIMIT limit].
+    // columns precisa ser subconjunto de allowed (nomes das colunas da tabela; nada do chamador vai
+    // para o SQL sem passar por essa lista); vazio lê todas. id sempre vem junto: com limit, o maior
+    // id do lote (lastId) é o afterId do próximo e a varredura anda em lotes pelo rowid, sem OFFSET.
+    static ColumnBatch scan(SqliteConnection& cx, std::string_view source,
+                            std::initializer_list<std::string_view> allowed,
+                            const std::vector<std::string>& columns,
+                            long long afterId = 0, std::size_t limit = 0);
+
+    std::size_t rows() const { return rows_; }
+    std::size_t columnCount() const { return columns_.size(); }
+    const std::vector<Column>& columns() const { return columns_; }
+
+    // Coluna pelo nome; lança std::out_of_range se não existir ou não for do tipo pedido
+    const Column& column(std::string_view name) const;
+    std::span<const std::int64_t> ints(std::string_view name) const;
+    std::span<const double> reals(std::string_view name) const;
+    const TextColumn& text(std::string_view name) const;
+
+    // Maior id lido (0 se o lote não tem a coluna id ou está vazio)
+    long long lastId() const { return lastId_; }
+
+private:
+    std::vector<Column> columns_;
+    std::size_t rows_{0};
+    long long lastId_{0};
+};
+
+} // namespace ecocin::infra::db
+
+#endif // ECOCIN_INFRA_DB_COLUMNBATCH_H
@@ -0,0 +1,56 @@
+#include "DbWorkerPool.h"
+
+namespace ecocin::infra::db {
+
+// Sobe as threads de trabalho; cada uma fica consumindo a fila até o pool ser destruído.
+DbWorkerPool::DbWorkerPool(std::size_t workers, std::size_t queueCapacity)
+    : capacity_(queueCapacity) {
+    workers_.reserve(workers);
+    for (std::size_t i = 0; i < workers; ++i) {
+        workers_.emplace_back([this] { workerLoop(); });
+    }
+}
+
+// Sinaliza parada, deixa as threads drenarem o que já foi aceito e aguarda todas.
+DbWorkerPool::~DbWorkerPool() {
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        stopping_ = true;
+    }
+    cv_.notify_all();
+    for (auto& t : workers_) {
+        if (t.joinable()) t.join();
+    }
+}
+
+bool DbWorkerPool::tryEnqueue(std::function<void()> job) {
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        if (stopping_ || queue_.size() >= capacity_) return false;
+        queue_.push_back(std::move(job));
+    }
+    cv_.notify_one();
+    return true;
+}
+
+std::size_t DbWorkerPool::pending() {
+    std::lock_guard<std::mutex> lock(mtx_);
+    return queue_.size();
+}
+
+void DbWorkerPool::workerLoop() {
+    for (;;) {
+        std::function<void()> job;
+        {
+            std::unique_lock<std::mutex> lock(mtx_);
+            cv_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+            if (queue_.empty()) return; // stopping_ e nada mais a fazer
+            job = std::move(queue_.front());
+            queue_.pop_front();
+        }
+        // Exceções ficam guardadas no future do packaged_task
+        job();
+    }
+}
+
+} // namespace ecocin::infra::db
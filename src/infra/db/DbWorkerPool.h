@@ -0,0 +1,65 @@
+#ifndef ECOCIN_INFRA_DB_DBWORKERPOOL_H
+#define ECOCIN_INFRA_DB_DBWORKERPOOL_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace ecocin::infra::db {
+
+// Pool limitado de threads para executar chamadas bloqueantes ao banco.
+// No modo assíncrono as corrotinas do oatpp não podem bloquear o executor,
+// então cada acesso a repositório é enfileirado aqui e a corrotina apenas
+// consulta o std::future até o resultado ficar pronto.
+// A fila tem capacidade fixa: quando cheia, trySubmit devolve std::nullopt
+// e o chamador responde 503 em vez de acumular trabalho sem limite.
+class DbWorkerPool {
+private:
+    std::mutex mtx_;
+    std::condition_variable cv_;
+    std::deque<std::function<void()>> queue_;
+    std::vector<std::thread> workers_;
+    std::size_t capacity_;
+    bool stopping_{false};
+
+    bool tryEnqueue(std::function<void()> job);
+    void workerLoop();
+
+public:
+    DbWorkerPool(std::size_t workers, std::size_t queueCapacity);
+    ~DbWorkerPool();
+
+    DbWorkerPool(const DbWorkerPool&) = delete;
+    DbWorkerPool& operator=(const DbWorkerPool&) = delete;
+
+    // Enfileira fn e devolve o future do resultado, ou std::nullopt se a fila estiver cheia
+    template <class F>
+    auto trySubmit(F&& fn) -> std::optional<std::future<std::invoke_result_t<std::decay_t<F>>>> {
+        using R = std::invoke_result_t<std::decay_t<F>>;
+        auto task = std::make_shared<std::packaged_task<R()>>(std::forward<F>(fn));
+        auto fut = task->get_future();
+        if (!tryEnqueue([task] { (*task)(); })) return std::nullopt;
+        return fut;
+    }
+
+    std::size_t pending();
+};
+
+// Verifica sem bloquear se o resultado de uma tarefa já está disponível
+template <class T>
+bool isReady(const std::future<T>& f) {
+    return f.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
+
+} // namespace ecocin::infra::db
+
+#endif // ECOCIN_INFRA_DB_DBWORKERPOOL_H
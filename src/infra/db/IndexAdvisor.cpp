@@ -0,0 +1,509 @@
+#include "IndexAdvisor.h"
+
+#include <algorithm>
+#include <cctype>
+#include <optional>
+#include <regex>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+namespace ecocin::infra::db {
+
+namespace {
+
+// Formato de um SQL, extraído por uma análise simples do texto (suficiente para o SQL dos repositórios:
+// uma tabela, WHERE com AND e ORDER BY por colunas)
+struct Shape {
+    std::string verb;                                // SELECT, UPDATE ou DELETE
+    std::string table;
+    std::vector<std::string> eq;                     // col = ? / col IN (...) / col IS ?
+    std::vector<std::string> range;                  // col < ? / col BETWEEN ? AND ? ...
+    std::vector<std::pair<std::string, bool>> order; // (coluna, DESC)
+    std::vector<std::string> select;                 // colunas lidas pelo SELECT
+    bool selectAll{false};                           // SELECT com * ou expressões: não dá para cobrir
+    bool hasOr{false};
+};
+
+struct PlanText {
+    std::string text;
+    std::vector<std::string> details;
+};
+
+struct ExistingIndex {
+    std::string name;
+    bool removable{false}; // criado por CREATE INDEX, sem UNIQUE e sem WHERE
+    std::vector<std::string> columns;
+};
+
+bool isIdentChar(char c) {
+    return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+}
+
+std::string upper(std::string_view s) {
+    std::string out(s);
+    for (auto& c : out) c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+    return out;
+}
+
+std::string trim(std::string_view s) {
+    std::size_t b = 0, e = s.size();
+    while (b < e && std::isspace(static_cast<unsigned char>(s[b]))) ++b;
+    while (e > b && std::isspace(static_cast<unsigned char>(s[e - 1]))) --e;
+    return std::string(s.substr(b, e - b));
+}
+
+// Espaços colapsados e sem ";" final: a mesma consulta escrita em linhas diferentes vira um formato só
+std::string collapse(std::string_view sql) {
+    std::string out;
+    out.reserve(sql.size());
+    for (char c : sql) {
+        if (std::isspace(static_cast<unsigned char>(c))) {
+            if (!out.empty() && out.back() != ' ') out += ' ';
+        } else {
+            out += c;
+        }
+    }
+    while (!out.empty() && (out.back() == ' ' || out.back() == ';')) out.pop_back();
+    return out;
+}
+
+// Posição da palavra-chave kw (em maiúsculas) em u, como palavra inteira, a partir de from
+std::size_t findKeyword(const std::string& u, std::string_view kw, std::size_t from = 0) {
+    for (auto pos = u.find(kw, from); pos != std::string::npos; pos = u.find(kw, pos + 1)) {
+        const bool before = pos == 0 || !isIdentChar(u[pos - 1]);
+        const auto after = pos + kw.size();
+        if (before && (after >= u.size() || !isIdentChar(u[after]))) return pos;
+    }
+    return std::string::npos;
+}
+
+// Identificador a partir de pos (sem prefixo de schema/tabela e sem aspas)
+std::string identAt(const std::string& s, std::size_t pos) {
+    while (pos < s.size() && s[pos] == ' ') ++pos;
+    std::string id;
+    while (pos < s.size() && (isIdentChar(s[pos]) || s[pos] == '.' || s[pos] == '"' || s[pos] == '`')) {
+        if (s[pos] == '.') id.clear();
+        else if (s[pos] != '"' && s[pos] != '`') id += s[pos];
+        ++pos;
+    }
+    return id;
+}
+
+std::vector<std::string> splitTopLevel(const std::string& s, char sep) {
+    std::vector<std::string> out;
+    int depth = 0;
+    std::string cur;
+    for (char c : s) {
+        if (c == '(') ++depth;
+        if (c == ')') --depth;
+        if (c == sep && depth == 0) {
+            out.push_back(trim(cur));
+            cur.clear();
+        } else {
+            cur += c;
+        }
+    }
+    if (!trim(cur).empty()) out.push_back(trim(cur));
+    return out;
+}
+
+// Fim de uma cláusula: a primeira das palavras-chave seguintes que aparecer depois de from
+std::size_t clauseEnd(const std::string& u, std::size_t from, std::initializer_list<std::string_view> next) {
+    std::size_t end = u.size();
+    for (auto kw : next) end = std::min(end, findKeyword(u, kw, from));
+    return end;
+}
+
+void pushUnique(std::vector<std::string>& v, const std::string& s) {
+    if (std::find(v.begin(), v.end(), s) == v.end()) v.push_back(s);
+}
+
+Shape parseShape(const std::string& s) {
+    Shape shape;
+    const auto u = upper(s);
+    shape.verb = identAt(u, 0);
+
+    std::size_t tablePos = std::string::npos;
+    if (shape.verb == "UPDATE") tablePos = 6;
+    else if (shape.verb == "SELECT" || shape.verb == "DELETE") {
+        const auto from = findKeyword(u, "FROM");
+        if (from != std::string::npos) tablePos = from + 4;
+    }
+    if (tablePos == std::string::npos) return shape;
+    shape.table = identAt(s, tablePos);
+
+    if (shape.verb == "SELECT") {
+        auto list = s.substr(6, findKeyword(u, "FROM") - 6);
+        if (findKeyword(upper(list), "DISTINCT") != std::string::npos) list = list.substr(upper(list).find("DISTINCT") + 8);
+        for (const auto& item : splitTopLevel(list, ',')) {
+            const auto col = identAt(item, 0);
+            if (col.empty() || item.find('(') != std::string::npos || item.find('*') != std::string::npos) {
+                shape.selectAll = true;
+            } else {
+                pushUnique(shape.select, col);
+            }
+        }
+    }
+
+    const auto where = findKeyword(u, "WHERE");
+    if (where != std::string::npos) {
+        const auto end = clauseEnd(u, where, {"ORDER", "GROUP", "LIMIT", "RETURNING"});
+        const auto clause = s.substr(where + 5, end - where - 5);
+        const auto uc = upper(clause);
+        shape.hasOr = findKeyword(uc, "OR") != std::string::npos;
+
+        static const std::regex term(
+            R"(^\(?\s*(?:[A-Za-z_][A-Za-z0-9_]*\.)?([A-Za-z_][A-Za-z0-9_]*)\s*(==|=|<=|>=|<>|!=|<|>|IS\s+NOT\b|IS\b|IN\b|BETWEEN\b))",
+            std::regex::icase);
+        bool skipNext = false; // o AND do BETWEEN não separa termos
+        std::size_t start = 0;
+        while (start <= clause.size()) {
+            auto andPos = findKeyword(uc, "AND", start);
+            if (andPos == std::string::npos) andPos = clause.size();
+            const auto part = trim(std::string_view(clause).substr(start, andPos - start));
+            start = andPos + 3;
+
+            if (skipNext) { skipNext = false; continue; }
+            std::smatch m;
+            if (!std::regex_search(part, m, term)) continue;
+            const auto op = upper(m[2].str());
+            if (op == "=" || op == "==" || op == "IN" || op == "IS") pushUnique(shape.eq, m[1].str());
+            else if (op == "<" || op == "<=" || op == ">" || op == ">=" || op == "BETWEEN") pushUnique(shape.range, m[1].str());
+            if (op == "BETWEEN") skipNext = true;
+        }
+    }
+
+    const auto orderPos = findKeyword(u, "ORDER");
+    if (orderPos != std::string::npos) {
+        const auto by = findKeyword(u, "BY", orderPos);
+        const auto end = clauseEnd(u, by, {"LIMIT", "RETURNING"});
+        for (const auto& item : splitTopLevel(s.substr(by + 2, end - by - 2), ',')) {
+            const auto col = identAt(item, 0);
+            const auto rest = upper(trim(std::string_view(item).substr(item.find(col) + col.size())));
+            if (col.empty() || item.find('(') != std::string::npos || !(rest.empty() || rest == "ASC" || rest == "DESC")) {
+                shape.order.clear(); // ORDER BY por expressão: nenhum índice simples atende
+                break;
+            }
+            shape.order.emplace_back(col, rest == "DESC");
+        }
+    }
+    return shape;
+}
+
+// Executa sql e chama onRow para cada linha; lança std::runtime_error se o SQL não preparar
+template <class F>
+void query(sqlite3* db, const std::string& sql, F&& onRow) {
+    sqlite3_stmt* st = nullptr;
+    if (sqlite3_prepare_v2(db, sql.c_str(), -1, &st, nullptr) != SQLITE_OK) {
+        const std::string msg = sqlite3_errmsg(db);
+        sqlite3_finalize(st);
+        throw std::runtime_error("index advisor: " + msg + " @ " + sql);
+    }
+    while (sqlite3_step(st) == SQLITE_ROW) onRow(st);
+    sqlite3_finalize(st);
+}
+
+std::string text(sqlite3_stmt* st, int col) {
+    const auto* p = reinterpret_cast<const char*>(sqlite3_column_text(st, col));
+    return p ? p : "";
+}
+
+// Plano com a mesma indentação do QueryProfiler (profundidade pela cadeia de parents)
+PlanText explain(sqlite3* db, const std::string& sql) {
+    PlanText plan;
+    std::unordered_map<int, int> depth;
+    query(db, "EXPLAIN QUERY PLAN " + sql, [&](sqlite3_stmt* st) {
+        const int id = sqlite3_column_int(st, 0);
+        const int parent = sqlite3_column_int(st, 1);
+        const int d = parent == 0 ? 0 : depth[parent] + 1;
+        depth[id] = d;
+        const auto detail = text(st, 3);
+        if (!plan.text.empty()) plan.text += '\n';
+        plan.text.append(static_cast<std::size_t>(2 * d + 2), ' ');
+        plan.text += detail;
+        plan.details.push_back(detail);
+    });
+    return plan;
+}
+
+// Tabela varrida por inteiro numa linha "SCAN ..." do plano (vazio se a linha não for uma varredura de tabela)
+std::string scannedTable(const std::string& detail) {
+    if (detail.rfind("SCAN ", 0) != 0) return {};
+    auto rest = detail.substr(5);
+    if (rest.rfind("TABLE ", 0) == 0) rest = rest.substr(6); // formato anterior ao SQLite 3.36
+    if (rest.empty() || rest[0] == '(' || rest.rfind("CONSTANT ROW", 0) == 0 || rest.rfind("SUBQUERY", 0) == 0) return {};
+    auto name = identAt(rest, 0);
+    if (rest.find("VIRTUAL TABLE") != std::string::npos) return {};
+    return name;
+}
+
+bool isIssue(const std::string& detail) {
+    return !scannedTable(detail).empty()
+        || detail.find("USE TEMP B-TREE") != std::string::npos
+        || detail.find("AUTOMATIC") != std::string::npos;
+}
+
+bool isTable(sqlite3* db, const std::string& name) {
+    bool found = false;
+    query(db, "SELECT 1 FROM sqlite_master WHERE type='table' AND name='" + name + "'",
+          [&](sqlite3_stmt*) { found = true; });
+    return found;
+}
+
+// Coluna INTEGER PRIMARY KEY (apelido do rowid), que todo índice já carrega no final
+std::string rowidAlias(sqlite3* db, const std::string& table) {
+    std::string alias;
+    int pkCols = 0;
+    query(db, "PRAGMA table_info(" + table + ")", [&](sqlite3_stmt* st) {
+        if (sqlite3_column_int(st, 5) == 0) return;
+        ++pkCols;
+        if (upper(text(st, 2)) == "INTEGER") alias = text(st, 1);
+    });
+    return pkCols == 1 ? alias : std::string{};
+}
+
+std::vector<ExistingIndex> indexesOf(sqlite3* db, const std::string& table) {
+    std::vector<ExistingIndex> out;
+    query(db, "PRAGMA index_list(" + table + ")", [&](sqlite3_stmt* st) {
+        ExistingIndex ix;
+        ix.name = text(st, 1);
+        ix.removable = sqlite3_column_int(st, 2) == 0 && text(st, 3) == "c" && sqlite3_column_int(st, 4) == 0;
+        out.push_back(std::move(ix));
+    });
+    for (auto& ix : out) {
+        query(db, "PRAGMA index_info(" + ix.name + ")", [&](sqlite3_stmt* st) { ix.columns.push_back(text(st, 2)); });
+    }
+    return out;
+}
+
+std::string columnName(const std::string& indexColumn) {
+    return indexColumn.substr(0, indexColumn.find(' '));
+}
+
+IndexSuggestion makeSuggestion(const std::string& table, std::vector<std::string> columns, bool covering) {
+    IndexSuggestion s;
+    s.name = "idx_" + table;
+    for (const auto& c : columns) s.name += "_" + columnName(c);
+    s.table = table;
+    s.columns = std::move(columns);
+    s.covering = covering;
+    return s;
+}
+
+// Índice composto para a própria consulta: igualdades, depois o intervalo ou o ORDER BY.
+// Devolve nullopt quando não há nada a indexar (a consulta pede a tabela inteira).
+std::optional<IndexSuggestion> suggestFor(sqlite3* db, const Shape& shape) {
+    const auto rowid = rowidAlias(db, shape.table);
+    std::vector<std::string> cols;
+    for (const auto& c : shape.eq) if (c != rowid) pushUnique(cols, c);
+
+    if (!shape.range.empty() && shape.range.front() != rowid) {
+        pushUnique(cols, shape.range.front());
+    } else if (shape.range.empty() && !shape.order.empty()) {
+        auto order = shape.order;
+        // O rowid já é a última coluna de todo índice, sempre ascendente: as direções das outras colunas
+        // são escritas em relação a ele (assim a varredura reversa do índice atende "x DESC, id DESC")
+        bool rowidDesc = order.front().second;
+        bool droppedRowid = false;
+        if (order.back().first == rowid) {
+            rowidDesc = order.back().second;
+            order.pop_back();
+            droppedRowid = true;
+        }
+        const bool uniform = std::all_of(order.begin(), order.end(),
+                                         [&](const auto& o) { return o.second == order.front().second; });
+        for (const auto& [col, desc] : order) {
+            if (col == rowid || std::find(shape.eq.begin(), shape.eq.end(), col) != shape.eq.end()) continue;
+            const bool markDesc = droppedRowid ? desc != rowidDesc : (!uniform && desc);
+            if (std::find(cols.begin(), cols.end(), col) == cols.end()) cols.push_back(markDesc ? col + " DESC" : col);
+        }
+    }
+    if (cols.empty()) return std::nullopt;
+
+    // Covering: se a consulta lê poucas colunas, elas vão para o fim do índice e a tabela nem é visitada
+    bool covering = false;
+    if (shape.verb == "SELECT" && !shape.selectAll) {
+        std::vector<std::string> extra;
+        auto consider = [&](const std::string& c) {
+            if (c == rowid) return;
+            if (std::none_of(cols.begin(), cols.end(), [&](const std::string& k) { return columnName(k) == c; })) pushUnique(extra, c);
+        };
+        for (const auto& c : shape.select) consider(c);
+        for (const auto& c : shape.range) consider(c);
+        for (const auto& o : shape.order) consider(o.first);
+        if (cols.size() + extra.size() <= 5) {
+            cols.insert(cols.end(), extra.begin(), extra.end());
+            covering = true;
+        }
+    }
+    return makeSuggestion(shape.table, std::move(cols), covering);
+}
+
+// Varredura de uma tabela filha disparada pela verificação de chave estrangeira de um DELETE/UPDATE
+// na tabela pai: o índice certo é a coluna da FK na filha
+std::optional<IndexSuggestion> suggestForeignKey(sqlite3* db, const std::string& child, const std::string& parent) {
+    std::vector<std::string> cols;
+    query(db, "PRAGMA foreign_key_list(" + child + ")", [&](sqlite3_stmt* st) {
+        if (text(st, 2) == parent) pushUnique(cols, text(st, 3));
+    });
+    if (cols.size() != 1) return std::nullopt; // várias FKs para a mesma tabela: o plano não diz qual
+    return makeSuggestion(child, std::move(cols), false);
+}
+
+} // namespace
+
+std::string IndexSuggestion::createSql() const {
+    std::string sql = "CREATE INDEX IF NOT EXISTS " + name + " ON " + table + "(";
+    for (std::size_t i = 0; i < columns.size(); ++i) {
+        if (i) sql += ", ";
+        sql += columns[i];
+    }
+    return sql + ")";
+}
+
+std::string AdvisorReport::migrationSql() const {
+    std::string sql;
+    for (const auto& ix : indexes) sql += ix.createSql() + ";\n";
+    for (const auto& name : redundant) sql += "DROP INDEX IF EXISTS " + name + ";\n";
+    if (!sql.empty()) sql += "ANALYZE;\n";
+    return sql;
+}
+
+IndexAdvisor::IndexAdvisor(SqliteConnection& cx) : cx_(cx) {}
+
+IndexAdvisor::~IndexAdvisor() {
+    stopCapture();
+}
+
+void IndexAdvisor::startCapture() {
+    sqlite3_trace_v2(cx_.raw(), SQLITE_TRACE_STMT, &IndexAdvisor::onTrace, this);
+    capturing_ = true;
+}
+
+void IndexAdvisor::stopCapture() {
+    if (!capturing_) return;
+    sqlite3_trace_v2(cx_.raw(), 0, nullptr, nullptr);
+    capturing_ = false;
+}
+
+int IndexAdvisor::onTrace(unsigned type, void* ctx, void* p, void* x) {
+    if (type != SQLITE_TRACE_STMT) return 0;
+    // Subprogramas de triggers/FKs chegam como comentários ("-- TRIGGER ..."): ficam no plano da instrução pai
+    const auto* traced = static_cast<const char*>(x);
+    if (traced && traced[0] == '-' && traced[1] == '-') return 0;
+    if (const char* sql = sqlite3_sql(static_cast<sqlite3_stmt*>(p))) {
+        static_cast<IndexAdvisor*>(ctx)->addShape(sql);
+    }
+    return 0;
+}
+
+void IndexAdvisor::addShape(const std::string& sql) {
+    auto shape = collapse(sql);
+    if (!shape.empty() && seen_.insert(shape).second) shapes_.push_back(std::move(shape));
+}
+
+AdvisorReport IndexAdvisor::audit(bool analyze) {
+    stopCapture();
+    auto* db = cx_.raw();
+    AdvisorReport report;
+
+    cx_.exec("SAVEPOINT index_advisor");
+    try {
+        if (analyze) cx_.exec("ANALYZE");
+
+        for (const auto& sql : shapes_) {
+            const auto shape = parseShape(sql);
+            if (shape.table.empty() || (shape.verb != "SELECT" && shape.verb != "UPDATE" && shape.verb != "DELETE")) continue;
+
+            AdvisorFinding f;
+            f.sql = sql;
+            const auto before = explain(db, sql);
+            f.plan = before.text;
+            for (const auto& d : before.details) if (isIssue(d)) f.issues.push_back(d);
+            if (f.issues.empty()) {
+                report.findings.push_back(std::move(f));
+                continue;
+            }
+
+            bool needsOwnIndex = false;
+            for (const auto& d : f.issues) {
+                const auto scanned = scannedTable(d);
+                if (!scanned.empty() && scanned != shape.table) {
+                    if (auto s = isTable(db, scanned) ? suggestForeignKey(db, scanned, shape.table) : std::nullopt) {
+                        f.suggestions.push_back(std::move(*s));
+                    }
+                } else {
+                    needsOwnIndex = true;
+                }
+            }
+            if (needsOwnIndex && isTable(db, shape.table)) {
+                if (auto s = suggestFor(db, shape)) f.suggestions.push_back(std::move(*s));
+                else if (!shape.hasOr) f.expected = f.suggestions.empty();
+            }
+
+            if (!f.suggestions.empty()) {
+                // Confirma no próprio planejador: cria os índices, replaneja e desfaz
+                cx_.exec("SAVEPOINT index_advisor_try");
+                try {
+                    // Cada índice novo recebe estatísticas próprias; sem elas o planejador compara um
+                    // índice com sqlite_stat1 contra outro sem e costuma ficar com o antigo
+                    for (const auto& s : f.suggestions) {
+                        cx_.exec(s.createSql().c_str());
+                        if (analyze) cx_.exec(("ANALYZE " + s.name).c_str());
+                    }
+                    const auto after = explain(db, sql);
+                    f.planAfter = after.text;
+                    f.verified = std::none_of(after.details.begin(), after.details.end(), isIssue);
+                } catch (...) {
+                    cx_.exec("ROLLBACK TO index_advisor_try; RELEASE index_advisor_try");
+                    throw;
+                }
+                cx_.exec("ROLLBACK TO index_advisor_try; RELEASE index_advisor_try");
+            }
+            report.findings.push_back(std::move(f));
+        }
+
+        // Índices verificados, sem repetição e sem os que são prefixo de outro sugerido na mesma tabela
+        std::vector<IndexSuggestion> all;
+        for (const auto& f : report.findings) {
+            if (!f.verified) continue;
+            for (const auto& s : f.suggestions) {
+                if (std::none_of(all.begin(), all.end(), [&](const IndexSuggestion& o) { return o.name == s.name; })) all.push_back(s);
+            }
+        }
+        auto isPrefix = [](const std::vector<std::string>& a, const std::vector<std::string>& b) {
+            return a.size() < b.size() && std::equal(a.begin(), a.end(), b.begin());
+        };
+        for (const auto& s : all) {
+            const bool shadowed = std::any_of(all.begin(), all.end(), [&](const IndexSuggestion& o) {
+                return o.table == s.table && isPrefix(s.columns, o.columns);
+            });
+            if (!shadowed) report.indexes.push_back(s);
+        }
+
+        // Índices existentes que viram prefixo de um sugerido: a consulta que os usava passa a usar o novo
+        for (const auto& s : report.indexes) {
+            std::vector<std::string> names;
+            for (const auto& c : s.columns) names.push_back(columnName(c));
+            for (const auto& ix : indexesOf(db, s.table)) {
+                if (ix.removable && ix.name != s.name && isPrefix(ix.columns, names)) pushUnique(report.redundant, ix.name);
+            }
+        }
+    } catch (...) {
+        sqlite3_exec(db, "ROLLBACK TO index_advisor; RELEASE index_advisor", nullptr, nullptr, nullptr);
+        throw;
+    }
+    cx_.exec("ROLLBACK TO index_advisor; RELEASE index_advisor");
+    return report;
+}
+
+void IndexAdvisor::apply(SqliteConnection& cx, const AdvisorReport& report) {
+    const auto sql = report.migrationSql();
+    if (sql.empty()) return;
+    Transaction tx(cx);
+    cx.exec(sql.c_str());
+    tx.commit();
+}
+
+} // namespace ecocin::infra::db
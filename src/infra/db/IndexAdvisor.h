@@ -0,0 +1,90 @@
+#ifndef ECOCIN_INFRA_DB_INDEXADVISOR_H
+#define ECOCIN_INFRA_DB_INDEXADVISOR_H
+
+#include "SqliteConnection.h"
+
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace ecocin::infra::db {
+
+// Índice proposto pelo advisor
+struct IndexSuggestion {
+    std::string name;                 // idx_<tabela>_<colunas>
+    std::string table;
+    std::vector<std::string> columns; // na ordem do índice; podem trazer " DESC"
+    bool covering{false};             // inclui todas as colunas que a consulta lê
+
+    std::string createSql() const;    // CREATE INDEX IF NOT EXISTS ...
+};
+
+// Resultado da auditoria de um SQL
+struct AdvisorFinding {
+    std::string sql;
+    std::string plan;                 // EXPLAIN QUERY PLAN com o esquema atual
+    std::vector<std::string> issues;  // linhas do plano com varredura completa, B-tree temporária ou índice automático
+    bool expected{false};             // varredura pedida pela própria consulta (ex.: listAll sem WHERE)
+    std::vector<IndexSuggestion> suggestions; // na tabela da consulta ou, em DELETE/UPDATE, na tabela filha da FK
+    std::string planAfter;            // plano com os índices sugeridos criados (e desfeitos) na mesma conexão
+    bool verified{false};             // os índices sugeridos eliminaram os problemas do plano
+
+    bool ok() const { return issues.empty() || expected; }
+};
+
+struct AdvisorReport {
+    std::vector<AdvisorFinding> findings;   // um por SQL auditado, na ordem de captura
+    std::vector<IndexSuggestion> indexes;   // índices verificados, sem repetição
+    std::vector<std::string> redundant;     // índices existentes que viram prefixo de um sugerido
+
+    // Migração com os índices verificados e a remoção dos redundantes (idempotente)
+    std::string migrationSql() const;
+};
+
+// Advisor de índices: audita os SQL que os repositórios realmente executam contra o plano do SQLite.
+//
+// Durante a captura, um gancho de sqlite3_trace_v2 (SQLITE_TRACE_STMT) guarda o texto de cada
+// instrução preparada executada na conexão — o SQL com "?", não os valores —, então basta exercitar
+// os repositórios para levantar todos os formatos de consulta. audit() roda ANALYZE e EXPLAIN QUERY PLAN
+// para cada SELECT/UPDATE/DELETE e aponta varreduras completas, ordenações em B-tree temporária e
+// índices automáticos. Para cada problema monta o índice composto que o resolveria (igualdades do WHERE,
+// depois o intervalo ou o ORDER BY; covering quando a consulta lê poucas colunas) e o confirma criando
+// o índice dentro de um SAVEPOINT e olhando o plano de novo. Tudo é desfeito no final: o banco só muda
+// com apply().
+//
+// O gancho de trace substitui o do QueryProfiler na mesma conexão; use uma conexão própria.
+class IndexAdvisor {
+private:
+    SqliteConnection& cx_;
+    std::vector<std::string> shapes_;
+    std::unordered_set<std::string> seen_;
+    bool capturing_{false};
+
+    static int onTrace(unsigned type, void* ctx, void* p, void* x);
+
+public:
+    explicit IndexAdvisor(SqliteConnection& cx);
+    ~IndexAdvisor();
+
+    IndexAdvisor(const IndexAdvisor&) = delete;
+    IndexAdvisor& operator=(const IndexAdvisor&) = delete;
+
+    // Liga/desliga a captura dos SQL executados na conexão
+    void startCapture();
+    void stopCapture();
+
+    // Acrescenta um SQL à auditoria sem executá-lo
+    void addShape(const std::string& sql);
+    const std::vector<std::string>& shapes() const { return shapes_; }
+
+    // Audita os SQL capturados. Com analyze, roda ANALYZE antes (estatísticas reais da massa de dados).
+    // Não deixa nada no banco: índices de teste e estatísticas são desfeitos ao final.
+    AdvisorReport audit(bool analyze = true);
+
+    // Aplica a migração do relatório (índices sugeridos, remoção dos redundantes e ANALYZE)
+    static void apply(SqliteConnection& cx, const AdvisorReport& report);
+};
+
+} // namespace ecocin::infra::db
+
+#endif // ECOCIN_INFRA_DB_INDEXADVISOR_H
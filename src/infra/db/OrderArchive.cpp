@@ -0,0 +1,520 @@
+#include "OrderArchive.h"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <filesystem>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+
+namespace ecocin::infra::db {
+
+namespace {
+
+namespace fs = std::filesystem;
+
+constexpr const char* kColumns =
+    "id,client_id,product_id,shipping_address_id,quantity,unit_price,total_price,status,create_date";
+
+// Nome do esquema anexado usado pelo job para a partição que está recebendo pedidos
+constexpr const char* kTargetSchema = "archive_target";
+// E para o mês que está sendo consolidado no arquivo frio
+constexpr const char* kSourceSchema = "archive_source";
+
+// Quanto o job espera as conexões de leitura anexarem uma partição nova
+constexpr auto kPublishTimeout = std::chrono::seconds(5);
+
+std::string schemaFor(const std::string& partition) { return "archive_" + partition; }
+
+// "orders_2024_03.db" -> "2024_03", "orders_cold.db" -> "cold" (vazio se o nome não segue o padrão)
+std::string partitionOfFile(const std::string& name) {
+    if (name == std::string("orders_") + OrderArchive::kCold + ".db") return OrderArchive::kCold;
+    if (name.size() != 17 || name.rfind("orders_", 0) != 0 || name.substr(14) != ".db") return {};
+    const auto p = name.substr(7, 7);
+    for (std::size_t i = 0; i < p.size(); ++i) {
+        if (i == 4 ? p[i] != '_' : !std::isdigit(static_cast<unsigned char>(p[i]))) return {};
+    }
+    return p;
+}
+
+void check(int rc, sqlite3* db, const char* where) {
+    if (rc != SQLITE_OK && rc != SQLITE_ROW && rc != SQLITE_DONE) {
+        throw std::runtime_error(std::string("SQLite error @ ") + where + ": " + sqlite3_errmsg(db));
+    }
+}
+
+// ATTACH com o caminho passado como parâmetro (sem montar aspas na mão)
+void attach(SqliteConnection& cx, const std::string& file, const std::string& schema) {
+    const auto sql = "ATTACH DATABASE ? AS " + schema;
+    sqlite3_stmt* st = nullptr;
+    check(sqlite3_prepare_v2(cx.raw(), sql.c_str(), -1, &st, nullptr), cx.raw(), "prepare attach");
+    sqlite3_bind_text(st, 1, file.c_str(), -1, SQLITE_TRANSIENT);
+    const int rc = sqlite3_step(st);
+    sqlite3_finalize(st);
+    check(rc, cx.raw(), "attach archive");
+}
+
+// Mesma tabela de main.orders, sem as chaves estrangeiras (que não atravessam arquivos)
+// e só com os índices usados nas leituras
+void ensureSchema(SqliteConnection& cx, const std::string& schema) {
+    const auto sql =
+        "CREATE TABLE IF NOT EXISTS " + schema + ".orders ("
+        " id INTEGER PRIMARY KEY, client_id INTEGER NOT NULL, product_id INTEGER NOT NULL,"
+        " shipping_address_id INTEGER, quantity INTEGER NOT NULL, unit_price REAL NOT NULL,"
+        " total_price REAL NOT NULL, status TEXT NOT NULL, create_date INTEGER NOT NULL);"
+        "CREATE INDEX IF NOT EXISTS " + schema + ".idx_orders_client_id_create_date ON orders(client_id, create_date);"
+        "DROP INDEX IF EXISTS " + schema + ".idx_orders_client_id;"
+        "CREATE INDEX IF NOT EXISTS " + schema + ".idx_orders_create_date ON orders(create_date);";
+    cx.exec(sql.c_str());
+}
+
+void detachQuietly(SqliteConnection& cx, const char* schema) {
+    sqlite3_exec(cx.raw(), (std::string("DETACH DATABASE ") + schema).c_str(), nullptr, nullptr, nullptr);
+}
+
+// Partições mensais do diretório (sem o arquivo frio), da mais recente para a mais antiga
+std::vector<std::string> monthlyPartitions(const std::string& dir) {
+    std::vector<std::string> parts;
+    for (const auto& entry : fs::directory_iterator(dir)) {
+        auto p = partitionOfFile(entry.path().filename().string());
+        if (!p.empty() && p != OrderArchive::kCold) parts.push_back(std::move(p));
+    }
+    std::sort(parts.begin(), parts.end(), std::greater<>());
+    return parts;
+}
+
+// Quantas partições mensais uma conexão mantém anexadas: o limite de anexos menos o arquivo frio
+std::size_t monthlyBudget(SqliteConnection& cx) {
+    const auto limit = sqlite3_limit(cx.raw(), SQLITE_LIMIT_ATTACHED, -1);
+    return limit > 1 ? static_cast<std::size_t>(limit - 1) : 0;
+}
+
+// Mês do pedido mais recente do arquivo frio (vazio se ele não existe ou não tem pedidos)
+std::string coldNewest(SqliteConnection& jobCx, const std::string& dir) {
+    const auto file = OrderArchive::fileFor(dir, OrderArchive::kCold);
+    if (!fs::exists(file)) return {};
+    attach(jobCx, file, kSourceSchema);
+    std::string newest;
+    sqlite3_stmt* st = nullptr;
+    const auto sql = std::string("SELECT MAX(create_date) FROM ") + kSourceSchema + ".orders";
+    if (sqlite3_prepare_v2(jobCx.raw(), sql.c_str(), -1, &st, nullptr) == SQLITE_OK &&
+        sqlite3_step(st) == SQLITE_ROW && sqlite3_column_type(st, 0) != SQLITE_NULL) {
+        newest = OrderArchive::partitionFor(sqlite3_column_int64(st, 0));
+    }
+    sqlite3_finalize(st);
+    jobCx.exec((std::string("DETACH DATABASE ") + kSourceSchema).c_str());
+    return newest;
+}
+
+// Pedidos removidos da tabela quente entre a cópia de um lote e a saída dele (ver archiveBefore):
+// a cópia na partição precisa sair também. A pendência fica em main até a partição confirmar.
+constexpr const char* kPurgeTable = "main.archive_purge";
+
+// Mesmo pedido, coluna a coluna, na partição (a) e na tabela quente (h)
+std::string sameOrder() {
+    static constexpr const char* kCompared[] = {"client_id", "product_id", "shipping_address_id", "quantity",
+                                                "unit_price", "total_price", "status", "create_date"};
+    std::string sql;
+    for (const auto* c : kCompared) {
+        if (!sql.empty()) sql += " AND ";
+        sql += std::string("a.") + c + " IS h." + c;
+    }
+    return sql;
+}
+
+// Tira de schema (a partição, já anexada) os pedidos pendentes de partition e depois a pendência.
+// Uma transação por arquivo: uma queda entre as duas só faz a remoção se repetir.
+void purgeFrom(SqliteConnection& jobCx, const std::string& schema, const std::string& partition) {
+    {
+        Transaction tx(jobCx, "BEGIN IMMEDIATE");
+        {
+            Statement st(jobCx, "DELETE FROM " + schema + ".orders WHERE id IN (SELECT id FROM " +
+                                    kPurgeTable + " WHERE month = ?1)", "prepare archive purge");
+            sqlite3_bind_text(st, 1, partition.c_str(), -1, SQLITE_TRANSIENT);
+            check(sqlite3_step(st), jobCx.raw(), "step archive purge");
+        }
+        tx.commit();
+    }
+    Transaction tx(jobCx, "BEGIN IMMEDIATE");
+    {
+        Statement st(jobCx, std::string("DELETE FROM ") + kPurgeTable + " WHERE month = ?1",
+                     "prepare archive purge done");
+        sqlite3_bind_text(st, 1, partition.c_str(), -1, SQLITE_TRANSIENT);
+        check(sqlite3_step(st), jobCx.raw(), "step archive purge done");
+    }
+    tx.commit();
+}
+
+// Pendências deixadas por uma execução que caiu no meio de um lote. O mês pode ter sido
+// consolidado no arquivo frio depois disso; se nenhum dos dois existe, não há cópia a tirar.
+void purgeVanished(SqliteConnection& jobCx, const std::string& dir) {
+    std::vector<std::string> parts;
+    {
+        Statement st(jobCx, std::string("SELECT DISTINCT month FROM ") + kPurgeTable, "prepare archive purge list");
+        while (sqlite3_step(st) == SQLITE_ROW) parts.emplace_back(reinterpret_cast<const char*>(sqlite3_column_text(st, 0)));
+    }
+    for (const auto& p : parts) {
+        auto file = OrderArchive::fileFor(dir, p);
+        if (!fs::exists(file)) file = OrderArchive::fileFor(dir, OrderArchive::kCold);
+        if (!fs::exists(file)) {
+            Statement st(jobCx, std::string("DELETE FROM ") + kPurgeTable + " WHERE month = ?1",
+                         "prepare archive purge done");
+            sqlite3_bind_text(st, 1, p.c_str(), -1, SQLITE_TRANSIENT);
+            check(sqlite3_step(st), jobCx.raw(), "step archive purge done");
+            continue;
+        }
+        attach(jobCx, file, kSourceSchema);
+        try {
+            ensureSchema(jobCx, kSourceSchema);
+            purgeFrom(jobCx, kSourceSchema, p);
+        } catch (...) {
+            detachQuietly(jobCx, kSourceSchema);
+            throw;
+        }
+        jobCx.exec((std::string("DETACH DATABASE ") + kSourceSchema).c_str());
+    }
+}
+
+// OrderArchive vivos no processo (um por conexão de leitura), para o job avisar de partições novas
+std::mutex& registryMutex() {
+    static std::mutex m;
+    return m;
+}
+
+std::vector<OrderArchive*>& registry() {
+    static std::vector<OrderArchive*> r;
+    return r;
+}
+
+// Faz todas as conexões de leitura anexarem as partições atuais; false se alguma não conseguiu a tempo
+bool publish() {
+    const auto deadline = std::chrono::steady_clock::now() + kPublishTimeout;
+    while (true) {
+        bool all = true;
+        {
+            std::lock_guard<std::mutex> lock(registryMutex());
+            for (auto* archive : registry()) all = archive->refresh() && all;
+        }
+        if (all) return true;
+        if (std::chrono::steady_clock::now() >= deadline) return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+}
+
+} // namespace
+
+// A primeira leitura do diretório também acontece sob o mutex do registro: o job só apaga um mês
+// consolidado segurando esse mutex, então nenhuma conexão anexa (e recria vazio) um arquivo removido.
+OrderArchive::OrderArchive(SqliteConnection& cx, std::string dir) : cx_(cx), dir_(std::move(dir)) {
+    fs::create_directories(dir_);
+    std::lock_guard<std::mutex> lock(registryMutex());
+    if (!refresh()) throw std::runtime_error("não foi possível anexar as partições de " + dir_);
+    registry().push_back(this);
+}
+
+OrderArchive::~OrderArchive() {
+    std::lock_guard<std::mutex> lock(registryMutex());
+    auto& r = registry();
+    r.erase(std::remove(r.begin(), r.end(), this), r.end());
+}
+
+std::string OrderArchive::partitionFor(std::int64_t epochSeconds) {
+    using namespace std::chrono;
+    const year_month_day ymd{floor<days>(sys_seconds{seconds{epochSeconds}})};
+    char buf[16];
+    std::snprintf(buf, sizeof(buf), "%04d_%02u", static_cast<int>(ymd.year()), static_cast<unsigned>(ymd.month()));
+    return buf;
+}
+
+std::pair<std::int64_t, std::int64_t> OrderArchive::monthRange(const std::string& partition) {
+    using namespace std::chrono;
+    const year_month first{year{std::stoi(partition.substr(0, 4))}, month{static_cast<unsigned>(std::stoi(partition.substr(5, 2)))}};
+    const auto from = sys_days{first / 1}.time_since_epoch();
+    const auto to = sys_days{(first + months{1}) / 1}.time_since_epoch();
+    return {duration_cast<seconds>(from).count(), duration_cast<seconds>(to).count()};
+}
+
+std::string OrderArchive::fileFor(const std::string& dir, const std::string& partition) {
+    return (fs::path(dir) / ("orders_" + partition + ".db")).string();
+}
+
+// Partições do diretório (meses e arquivo frio). Todas precisam caber na conexão: se não cabem
+// (meses ainda não consolidados), o refresh falha e as leituras continuam com o conjunto anterior,
+// em vez de perder meses de vista.
+std::vector<std::string> OrderArchive::visiblePartitions() {
+    auto parts = monthlyPartitions(dir_);
+    if (fs::exists(fileFor(dir_, kCold))) parts.push_back(kCold);
+
+    const auto limit = static_cast<std::size_t>(sqlite3_limit(cx_.raw(), SQLITE_LIMIT_ATTACHED, -1));
+    if (parts.size() > limit) {
+        if (!warnedLimit_) {
+            spdlog::warn("arquivo de pedidos: {} partições, mas a conexão anexa no máximo {} (SQLITE_MAX_ATTACHED); "
+                         "aguardando o job consolidar os meses mais antigos no arquivo frio", parts.size(), limit);
+            warnedLimit_ = true;
+        }
+        throw std::runtime_error("partições além do limite de anexos");
+    }
+    warnedLimit_ = false;
+    return parts;
+}
+
+// Uma partição entra sem os pedidos que ainda estão em main.orders: enquanto o job move um lote
+// (ver archiveBefore) o pedido existe nos dois arquivos, e vale o da tabela quente (busca pela chave
+// primária). O arquivo frio entra também sem os meses que ainda têm arquivo próprio na view: durante
+// a consolidação um mês existe nos dois lugares, e vale o arquivo mensal até ele ser apagado.
+void OrderArchive::rebuildView(const std::vector<std::string>& parts) {
+    std::string sql = std::string("DROP VIEW IF EXISTS temp.") + kView + ";"
+                    + "CREATE TEMP VIEW " + kView + " AS SELECT " + kColumns + " FROM main.orders";
+    for (const auto& p : parts) {
+        const auto table = schemaFor(p) + ".orders";
+        sql += std::string(" UNION ALL SELECT ") + kColumns + " FROM " + table +
+               " WHERE NOT EXISTS (SELECT 1 FROM main.orders h WHERE h.id = " + table + ".id)";
+        if (p != kCold) continue;
+        for (const auto& month : parts) {
+            if (month == kCold) continue;
+            const auto [from, to] = monthRange(month);
+            sql += " AND NOT (create_date >= " + std::to_string(from) + " AND create_date < " + std::to_string(to) + ")";
+        }
+    }
+    // sqlite3_exec segura o mutex da conexão do início ao fim: nenhuma outra thread vê a view ausente
+    cx_.exec(sql.c_str());
+    inView_ = parts;
+    viewReady_ = true;
+}
+
+// Ordem pensada para a view nunca citar um esquema desanexado e para caber no limite de anexos:
+// (1) tira da view o que vai sair, (2) desanexa, (3) anexa o que é novo, (4) view completa.
+bool OrderArchive::refresh() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    try {
+        const auto want = visiblePartitions();
+        if (viewReady_ && inView_ == want) return true;
+
+        std::vector<std::string> kept;
+        for (const auto& p : attached_) {
+            if (std::find(want.begin(), want.end(), p) != want.end()) kept.push_back(p);
+        }
+        if (!viewReady_ || kept != inView_) rebuildView(kept);
+
+        for (auto it = attached_.begin(); it != attached_.end();) {
+            if (std::find(want.begin(), want.end(), *it) != want.end()) { ++it; continue; }
+            cx_.exec(("DETACH DATABASE " + schemaFor(*it)).c_str());
+            it = attached_.erase(it);
+        }
+        for (const auto& p : want) {
+            if (std::find(attached_.begin(), attached_.end(), p) != attached_.end()) continue;
+            attach(cx_, fileFor(dir_, p), schemaFor(p));
+            attached_.push_back(p);
+            ensureSchema(cx_, schemaFor(p));
+        }
+        std::sort(attached_.begin(), attached_.end(), std::greater<>());
+
+        rebuildView(want);
+        return true;
+    } catch (const std::exception& e) {
+        spdlog::debug("arquivo de pedidos: refresh adiado ({})", e.what());
+        return false;
+    }
+}
+
+std::vector<std::string> OrderArchive::partitions() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return inView_;
+}
+
+ArchiveRunStats OrderArchive::archiveBefore(SqliteConnection& jobCx, const std::string& dir,
+                                            std::int64_t cutoffEpoch, std::size_t batchSize) {
+    ArchiveRunStats stats;
+    fs::create_directories(dir);
+    jobCx.exec("CREATE TEMP TABLE IF NOT EXISTS archive_batch(id INTEGER PRIMARY KEY)");
+    jobCx.exec((std::string("CREATE TABLE IF NOT EXISTS ") + kPurgeTable +
+                "(id INTEGER PRIMARY KEY, month TEXT NOT NULL)").c_str());
+    purgeVanished(jobCx, dir);
+
+    const std::string selectBatch =
+        "INSERT INTO temp.archive_batch SELECT id FROM main.orders "
+        "WHERE create_date >= ?1 AND create_date < ?2 ORDER BY create_date LIMIT ?3";
+    // REPLACE: um lote repetido (queda entre as transações, ou pedido alterado no meio) leva a
+    // versão atual da tabela quente
+    const std::string copyBatch =
+        std::string("INSERT OR REPLACE INTO ") + kTargetSchema + ".orders(" + kColumns + ") "
+        "SELECT " + kColumns + " FROM main.orders WHERE id IN (SELECT id FROM temp.archive_batch)";
+    const std::string markVanished =
+        std::string("INSERT OR REPLACE INTO ") + kPurgeTable + "(id, month) "
+        "SELECT id, ?1 FROM temp.archive_batch WHERE id NOT IN (SELECT id FROM main.orders)";
+    // Só sai da tabela quente o que a partição tem gravado igual
+    const std::string deleteBatch =
+        std::string("DELETE FROM main.orders WHERE id IN (SELECT a.id FROM ") + kTargetSchema + ".orders a "
+        "JOIN main.orders h ON h.id = a.id WHERE a.id IN (SELECT id FROM temp.archive_batch) AND " + sameOrder() + ")";
+
+    while (true) {
+        // Pedido quente mais antigo (idx_orders_create_date): define o próximo mês a arquivar
+        std::int64_t oldest = 0;
+        {
+            Statement st(jobCx, "SELECT MIN(create_date) FROM main.orders", "prepare oldest order");
+            if (sqlite3_step(st) != SQLITE_ROW || sqlite3_column_type(st, 0) == SQLITE_NULL) break;
+            oldest = sqlite3_column_int64(st, 0);
+        }
+        if (oldest >= cutoffEpoch) break;
+
+        const auto month = partitionFor(oldest);
+        auto [from, to] = monthRange(month);
+        to = std::min(to, cutoffEpoch);
+
+        const auto partition = targetFor(jobCx, dir, month);
+        if (!partition) {
+            spdlog::warn("arquivo de pedidos: consolidação no arquivo frio pendente; arquivamento de {} adiado", month);
+            break;
+        }
+
+        attach(jobCx, fileFor(dir, *partition), kTargetSchema);
+        try {
+            ensureSchema(jobCx, kTargetSchema);
+            jobCx.exec((std::string("PRAGMA ") + kTargetSchema + ".journal_mode = WAL").c_str());
+
+            // As leituras precisam enxergar a partição antes de os pedidos saírem da tabela quente
+            if (!publish()) {
+                spdlog::warn("arquivo de pedidos: conexões de leitura não anexaram {} a tempo; arquivamento adiado", *partition);
+                jobCx.exec((std::string("DETACH DATABASE ") + kTargetSchema).c_str());
+                break;
+            }
+
+            // O SQLite não faz commit atômico entre bancos anexados em WAL, então cada transação
+            // grava um arquivo só: (1) a cópia chega à partição; (2) saem da tabela quente os
+            // pedidos que a partição tem iguais, e os que sumiram da quente no meio ficam marcados;
+            // (3) as cópias marcadas saem da partição. Uma queda em qualquer ponto deixa o pedido
+            // nos dois arquivos (a view mostra o da quente) ou marcado, e a próxima execução termina.
+            std::size_t movedHere = 0;
+            while (true) {
+                {
+                    Transaction tx(jobCx, "BEGIN IMMEDIATE");
+                    jobCx.exec("DELETE FROM temp.archive_batch");
+                    {
+                        Statement st(jobCx, selectBatch, "prepare archive batch");
+                        sqlite3_bind_int64(st, 1, from);
+                        sqlite3_bind_int64(st, 2, to);
+                        sqlite3_bind_int64(st, 3, static_cast<sqlite3_int64>(batchSize));
+                        check(sqlite3_step(st), jobCx.raw(), "step archive batch");
+                    }
+                    if (sqlite3_changes(jobCx.raw()) == 0) { tx.commit(); break; }
+                    {
+                        Statement st(jobCx, copyBatch, "prepare copy archive batch");
+                        check(sqlite3_step(st), jobCx.raw(), "step copy archive batch");
+                    }
+                    tx.commit();
+                }
+                std::size_t n = 0;
+                bool vanished = false;
+                {
+                    Transaction tx(jobCx, "BEGIN IMMEDIATE");
+                    {
+                        Statement st(jobCx, markVanished, "prepare mark vanished orders");
+                        sqlite3_bind_text(st, 1, partition->c_str(), -1, SQLITE_TRANSIENT);
+                        check(sqlite3_step(st), jobCx.raw(), "step mark vanished orders");
+                        vanished = sqlite3_changes(jobCx.raw()) > 0;
+                    }
+                    {
+                        Statement st(jobCx, deleteBatch, "prepare delete archive batch");
+                        check(sqlite3_step(st), jobCx.raw(), "step delete archive batch");
+                        n = static_cast<std::size_t>(sqlite3_changes(jobCx.raw()));
+                    }
+                    tx.commit();
+                }
+                if (vanished) purgeFrom(jobCx, kTargetSchema, *partition);
+                // Pedidos alterados depois da cópia continuam na quente e voltam no próximo lote
+                movedHere += n;
+                ++stats.batches;
+            }
+            stats.moved += movedHere;
+            stats.partitions.push_back(*partition);
+        } catch (...) {
+            detachQuietly(jobCx, kTargetSchema);
+            throw;
+        }
+        jobCx.exec((std::string("DETACH DATABASE ") + kTargetSchema).c_str());
+    }
+    return stats;
+}
+
+std::optional<std::string> OrderArchive::targetFor(SqliteConnection& jobCx, const std::string& dir,
+                                                   const std::string& month) {
+    auto monthly = monthlyPartitions(dir);
+    if (std::find(monthly.begin(), monthly.end(), month) != monthly.end()) return month;
+
+    // O arquivo frio já cobre este mês (ou um mais recente): os pedidos vão para lá, senão o mês
+    // novo esconderia das leituras a parte dele que já está no frio
+    const auto newest = coldNewest(jobCx, dir);
+    if (!newest.empty() && month <= newest) return std::string(kCold);
+
+    // Mês novo: abre espaço consolidando os mais antigos (ou vai direto para o frio, se for o mais antigo)
+    const auto budget = monthlyBudget(jobCx);
+    while (!monthly.empty() && monthly.size() + 1 > budget) {
+        if (month < monthly.back()) return std::string(kCold);
+        if (!rollUp(jobCx, dir, monthly.back())) return std::nullopt;
+        monthly.pop_back();
+    }
+    return month;
+}
+
+bool OrderArchive::rollUp(SqliteConnection& jobCx, const std::string& dir, const std::string& month) {
+    attach(jobCx, fileFor(dir, month), kSourceSchema);
+    try {
+        attach(jobCx, fileFor(dir, kCold), kTargetSchema);
+        ensureSchema(jobCx, kTargetSchema);
+        jobCx.exec((std::string("PRAGMA ") + kTargetSchema + ".journal_mode = WAL").c_str());
+        ensureSchema(jobCx, kSourceSchema);
+        // Só o arquivo frio é gravado aqui: o arquivo do mês sai depois, com unlink, já com o frio
+        // commitado. Uma queda no meio deixa o mês nos dois lugares, e a view fica com o mensal.
+        Transaction tx(jobCx, "BEGIN IMMEDIATE");
+        jobCx.exec((std::string("INSERT OR IGNORE INTO ") + kTargetSchema + ".orders(" + kColumns + ") SELECT " +
+                    kColumns + " FROM " + kSourceSchema + ".orders").c_str());
+        tx.commit();
+    } catch (...) {
+        detachQuietly(jobCx, kTargetSchema);
+        detachQuietly(jobCx, kSourceSchema);
+        throw;
+    }
+    jobCx.exec((std::string("DETACH DATABASE ") + kTargetSchema).c_str());
+    jobCx.exec((std::string("DETACH DATABASE ") + kSourceSchema).c_str());
+
+    // Enquanto o arquivo do mês existe, ele vale nas leituras e o frio entra sem esse mês.
+    // As conexões precisam ter o frio anexado antes de o mês sumir.
+    if (!publish()) {
+        spdlog::warn("arquivo de pedidos: conexões de leitura não anexaram o arquivo frio a tempo; {} continua mensal", month);
+        return false;
+    }
+    {
+        // Sob o mutex do registro nenhuma conexão está listando o diretório; quem já tem o mês
+        // anexado segue lendo pelo descritor aberto até o próximo refresh
+        std::lock_guard<std::mutex> lock(registryMutex());
+        const auto file = fileFor(dir, month);
+        std::error_code ec;
+        if (!fs::remove(file, ec) || ec) {
+            spdlog::warn("arquivo de pedidos: {} consolidado no arquivo frio, mas não foi apagado ({})", file, ec.message());
+            return false;
+        }
+        fs::remove(file + "-wal", ec);
+        fs::remove(file + "-shm", ec);
+    }
+    publish();
+    spdlog::info("arquivo de pedidos: {} consolidado no arquivo frio", month);
+    return true;
+}
+
+std::size_t OrderArchive::consolidate(SqliteConnection& jobCx, const std::string& dir) {
+    fs::create_directories(dir);
+    auto monthly = monthlyPartitions(dir);
+    const auto budget = monthlyBudget(jobCx);
+    std::size_t rolled = 0;
+    while (monthly.size() > budget) {
+        if (!rollUp(jobCx, dir, monthly.back())) break;
+        monthly.pop_back();
+        ++rolled;
+    }
+    return rolled;
+}
+
+} // namespace ecocin::infra::db
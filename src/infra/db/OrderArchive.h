@@ -0,0 +1,97 @@
+#ifndef ECOCIN_INFRA_DB_ORDERARCHIVE_H
+#define ECOCIN_INFRA_DB_ORDERARCHIVE_H
+
+#include "SqliteConnection.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ecocin::infra::db {
+
+// Resultado de uma execução do job de arquivamento
+struct ArchiveRunStats {
+    std::size_t moved{0};
+    std::size_t batches{0};
+    std::vector<std::string> partitions; // meses que receberam pedidos (ex.: "2024_03")
+};
+
+// Arquivo frio dos pedidos, particionado por mês de create_date.
+// Cada mês vira um arquivo SQLite próprio (<dir>/orders_YYYY_MM.db) com a mesma tabela orders,
+// anexado à conexão com ATTACH DATABASE como "archive_YYYY_MM". A view temporária orders_all
+// junta main.orders e as partições com UNION ALL; o SQLite empurra o WHERE para cada parte, então
+// listByClientId e findById usam o índice de cada arquivo. A tabela quente (e seus cinco índices)
+// fica só com os pedidos recentes e cabe no cache.
+//
+// O limite de bancos anexados por conexão é de compilação (SQLITE_MAX_ATTACHED, 10 no padrão).
+// Para nenhum mês sair das leituras, só os meses mais recentes (limite - 1) têm arquivo próprio; os
+// mais antigos são consolidados pelo job num único arquivo frio (<dir>/orders_cold.db, "archive_cold").
+// Pedidos arquivados são somente leitura: update/remove/updateStatus atuam apenas em main.orders.
+class OrderArchive {
+private:
+    SqliteConnection& cx_;
+    std::string dir_;
+    mutable std::mutex mutex_;
+    std::vector<std::string> attached_; // partições anexadas, da mais recente para a mais antiga
+    std::vector<std::string> inView_;   // partições que a view orders_all inclui hoje
+    bool viewReady_{false};
+    bool warnedLimit_{false};
+
+    std::vector<std::string> visiblePartitions();
+    void rebuildView(const std::vector<std::string>& parts);
+
+    // Partição que recebe os pedidos de month: o próprio mês, ou o arquivo frio se ele já cobre o
+    // mês ou se não há espaço para mais um mês. Consolida meses antigos para abrir espaço;
+    // nullopt se a consolidação ficou para a próxima execução.
+    static std::optional<std::string> targetFor(SqliteConnection& jobCx, const std::string& dir,
+                                                const std::string& month);
+    // Copia o mês para o arquivo frio, espera as leituras anexarem o frio e apaga o arquivo do mês
+    static bool rollUp(SqliteConnection& jobCx, const std::string& dir, const std::string& month);
+
+public:
+    // Nome da view que as leituras de pedidos usam quando o arquivo está ligado
+    static constexpr const char* kView = "orders_all";
+    // Partição que junta os meses consolidados
+    static constexpr const char* kCold = "cold";
+
+    OrderArchive(SqliteConnection& cx, std::string dir);
+    ~OrderArchive();
+
+    OrderArchive(const OrderArchive&) = delete;
+    OrderArchive& operator=(const OrderArchive&) = delete;
+
+    // Anexa as partições presentes no diretório e recria a view.
+    // Devolve false se a conexão estava ocupada (ex.: DETACH com leitura em andamento) ou se há
+    // mais partições do que anexos; nesse caso o estado anterior continua valendo e basta tentar de novo.
+    bool refresh();
+
+    std::vector<std::string> partitions() const;
+
+    // "2024_03" para um create_date (epoch em segundos, UTC) de março de 2024
+    static std::string partitionFor(std::int64_t epochSeconds);
+    // [início, fim) do mês da partição, em epoch segundos
+    static std::pair<std::int64_t, std::int64_t> monthRange(const std::string& partition);
+    static std::string fileFor(const std::string& dir, const std::string& partition);
+
+    // Move para as partições os pedidos com create_date < cutoff, mês a mês e em lotes de
+    // batchSize (cada lote copiado numa transação e apagado da quente em outra, sem commit entre
+    // arquivos; retoma o que uma execução interrompida deixou). Roda na conexão própria do job; antes de apagar
+    // pedidos da tabela quente, espera as conexões de leitura (cada OrderArchive vivo) anexarem
+    // a partição de destino, para que nenhum pedido some das consultas no meio do caminho.
+    // Meses além do limite de anexos vão para o arquivo frio (ver consolidate).
+    static ArchiveRunStats archiveBefore(SqliteConnection& jobCx, const std::string& dir,
+                                         std::int64_t cutoffEpoch, std::size_t batchSize);
+
+    // Consolida no arquivo frio os meses além do limite de anexos (ex.: diretório de uma versão
+    // que não consolidava). Roda no boot, antes das conexões de leitura; devolve quantos meses moveu.
+    static std::size_t consolidate(SqliteConnection& jobCx, const std::string& dir);
+};
+
+} // namespace ecocin::infra::db
+
+#endif // ECOCIN_INFRA_DB_ORDERARCHIVE_H
@@ -0,0 +1,223 @@
+#include "QueryProfiler.h"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <cctype>
+
+namespace ecocin::infra::db {
+
+namespace {
+
+// Linhas devolvidas por cada instrução em execução nesta thread (SQLITE_TRACE_ROW chega
+// linha a linha; o total é consumido no SQLITE_TRACE_PROFILE da mesma instrução)
+thread_local std::unordered_map<sqlite3_stmt*, std::uint64_t> rowsInFlight;
+
+bool isIdentChar(char c) {
+    return std::isalnum(static_cast<unsigned char>(c)) || c == '_' || c == '$';
+}
+
+std::uint64_t takeStatus(sqlite3_stmt* stmt, int op) {
+    // resetFlag = 1: o próximo uso da instrução (cache de statements) começa do zero
+    return static_cast<std::uint64_t>(sqlite3_stmt_status(stmt, op, 1));
+}
+
+} // namespace
+
+QueryProfiler& QueryProfiler::instance() {
+    static QueryProfiler profiler;
+    return profiler;
+}
+
+QueryProfiler::~QueryProfiler() {
+    for (auto& [path, db] : planDbs_) sqlite3_close(db);
+}
+
+void QueryProfiler::setSlowThreshold(std::chrono::nanoseconds threshold) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    slowThreshold_ = threshold;
+}
+
+void QueryProfiler::attach(sqlite3* db) {
+    sqlite3_trace_v2(db, SQLITE_TRACE_PROFILE | SQLITE_TRACE_ROW, &QueryProfiler::onTrace, this);
+}
+
+int QueryProfiler::onTrace(unsigned type, void* ctx, void* p, void* x) {
+    auto* stmt = static_cast<sqlite3_stmt*>(p);
+    if (type == SQLITE_TRACE_ROW) {
+        ++rowsInFlight[stmt];
+    } else if (type == SQLITE_TRACE_PROFILE) {
+        static_cast<QueryProfiler*>(ctx)->onProfile(stmt, *static_cast<sqlite3_int64*>(x));
+    }
+    return 0;
+}
+
+void QueryProfiler::onProfile(sqlite3_stmt* stmt, std::int64_t ns) {
+    const char* text = sqlite3_sql(stmt);
+    if (!text) return;
+
+    std::uint64_t rows = 0;
+    if (auto it = rowsInFlight.find(stmt); it != rowsInFlight.end()) {
+        rows = it->second;
+        rowsInFlight.erase(it);
+    }
+    const auto vmSteps   = takeStatus(stmt, SQLITE_STMTSTATUS_VM_STEP);
+    const auto fullScan  = takeStatus(stmt, SQLITE_STMTSTATUS_FULLSCAN_STEP);
+    const auto sorts     = takeStatus(stmt, SQLITE_STMTSTATUS_SORT);
+    const auto autoIndex = takeStatus(stmt, SQLITE_STMTSTATUS_AUTOINDEX);
+    const double ms = static_cast<double>(ns) / 1e6;
+
+    auto key = normalize(text);
+    std::string slowPlan;
+    bool slow = false;
+    bool computePlan = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto& s = stats_[key];
+        if (s.calls == 0) s.sql = key;
+        ++s.calls;
+        s.totalMs += ms;
+        s.maxMs = std::max(s.maxMs, ms);
+        s.rows += rows;
+        s.vmSteps += vmSteps;
+        s.fullScanSteps += fullScan;
+        s.sortSteps += sorts;
+        s.autoIndexes += autoIndex;
+
+        if (slowThreshold_.count() > 0 && ns >= slowThreshold_.count()) {
+            slow = true;
+            if (!s.plan.empty()) slowPlan = s.plan;
+            else computePlan = planPending_.insert(key).second;
+        }
+    }
+
+    // O plano sai fora de mutex_: as outras instruções seguem contando enquanto o EXPLAIN roda,
+    // e só a primeira thread lenta de cada SQL o calcula
+    if (computePlan) {
+        try {
+            slowPlan = planFor(sqlite3_db_handle(stmt), key);
+        } catch (...) {
+            slowPlan = "(plano indisponível)";
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        planPending_.erase(key);
+        if (auto it = stats_.find(key); it != stats_.end()) it->second.plan = slowPlan;
+    }
+
+    if (slow) {
+        spdlog::warn("consulta lenta ({:.2f} ms, {} linhas, {} passos de varredura completa, {} ordenações): {}\n{}",
+                     ms, rows, fullScan, sorts, key, slowPlan.empty() ? "  (plano em cálculo)" : slowPlan);
+    }
+}
+
+// EXPLAIN QUERY PLAN roda numa conexão somente leitura separada para o mesmo arquivo: a conexão
+// original está no meio de um callback de trace e não deve executar outras instruções aqui.
+// Chamado sem mutex_; planMutex_ serializa a conexão de plano e o cache.
+std::string QueryProfiler::planFor(sqlite3* db, const std::string& sql) {
+    std::lock_guard<std::mutex> lock(planMutex_);
+    if (auto it = plans_.find(sql); it != plans_.end()) return it->second;
+
+    const char* file = sqlite3_db_filename(db, "main");
+    if (!file || !*file) return plans_[sql] = "(plano indisponível: banco em memória)";
+
+    auto& planDb = planDbs_[file];
+    if (!planDb && sqlite3_open_v2(file, &planDb, SQLITE_OPEN_READONLY, nullptr) != SQLITE_OK) {
+        sqlite3_close(planDb);
+        planDb = nullptr;
+        return plans_[sql] = "(plano indisponível: falha ao abrir o banco)";
+    }
+
+    std::string plan;
+    sqlite3_stmt* st = nullptr;
+    const std::string explain = "EXPLAIN QUERY PLAN " + sql;
+    if (sqlite3_prepare_v2(planDb, explain.c_str(), -1, &st, nullptr) != SQLITE_OK) {
+        plan = std::string("(plano indisponível: ") + sqlite3_errmsg(planDb) + ")";
+    } else {
+        // Colunas: id, parent, notused, detail. A profundidade vem da cadeia de parents.
+        std::unordered_map<int, int> depth;
+        while (sqlite3_step(st) == SQLITE_ROW) {
+            const int id = sqlite3_column_int(st, 0);
+            const int parent = sqlite3_column_int(st, 1);
+            const int d = parent == 0 ? 0 : depth[parent] + 1;
+            depth[id] = d;
+            const auto* detail = reinterpret_cast<const char*>(sqlite3_column_text(st, 3));
+            if (!plan.empty()) plan += '\n';
+            plan.append(static_cast<std::size_t>(2 * d + 2), ' ');
+            plan += detail ? detail : "";
+        }
+    }
+    sqlite3_finalize(st);
+    return plans_[sql] = plan;
+}
+
+std::vector<QueryStats> QueryProfiler::top(std::size_t n) const {
+    std::vector<QueryStats> out;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        out.reserve(stats_.size());
+        for (const auto& [sql, s] : stats_) out.push_back(s);
+    }
+    const auto count = std::min(n, out.size());
+    std::partial_sort(out.begin(), out.begin() + static_cast<std::ptrdiff_t>(count), out.end(),
+                      [](const QueryStats& a, const QueryStats& b) { return a.totalMs > b.totalMs; });
+    out.resize(count);
+    return out;
+}
+
+void QueryProfiler::reset() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_.clear();
+}
+
+std::string QueryProfiler::normalize(std::string_view sql) {
+    std::string out;
+    out.reserve(sql.size());
+    bool pendingSpace = false;
+
+    for (std::size_t i = 0; i < sql.size();) {
+        const char c = sql[i];
+        if (std::isspace(static_cast<unsigned char>(c))) {
+            pendingSpace = !out.empty();
+            ++i;
+            continue;
+        }
+        if (pendingSpace) {
+            out += ' ';
+            pendingSpace = false;
+        }
+
+        if (c == '\'') {
+            // String literal ('' é o escape de aspas dentro dela)
+            ++i;
+            while (i < sql.size()) {
+                if (sql[i] == '\'') {
+                    if (i + 1 < sql.size() && sql[i + 1] == '\'') { i += 2; continue; }
+                    ++i;
+                    break;
+                }
+                ++i;
+            }
+            out += '?';
+        } else if (std::isdigit(static_cast<unsigned char>(c)) &&
+                   (out.empty() || (!isIdentChar(out.back()) && out.back() != '?'))) {
+            // Número solto (não faz parte de um identificador nem de um parâmetro ?NNN)
+            while (i < sql.size() && (isIdentChar(sql[i]) || sql[i] == '.')) ++i;
+            out += '?';
+        } else if (c == '"' || c == '`' || c == '[') {
+            // Identificador entre aspas: copiado como está
+            const char close = c == '[' ? ']' : c;
+            const auto end = sql.find(close, i + 1);
+            const auto stop = end == std::string_view::npos ? sql.size() : end + 1;
+            out.append(sql.substr(i, stop - i));
+            i = stop;
+        } else {
+            out += c;
+            ++i;
+        }
+    }
+
+    while (!out.empty() && (out.back() == ';' || out.back() == ' ')) out.pop_back();
+    return out;
+}
+
+} // namespace ecocin::infra::db
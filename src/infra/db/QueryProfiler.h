@@ -0,0 +1,80 @@
+#ifndef ECOCIN_INFRA_DB_QUERYPROFILER_H
+#define ECOCIN_INFRA_DB_QUERYPROFILER_H
+
+#include <sqlite3.h>
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace ecocin::infra::db {
+
+// Estatísticas acumuladas de um texto SQL normalizado
+struct QueryStats {
+    std::string sql;
+    std::uint64_t calls{0};
+    double totalMs{0};
+    double maxMs{0};
+    std::uint64_t rows{0};          // linhas devolvidas (SQLITE_TRACE_ROW)
+    std::uint64_t vmSteps{0};       // instruções da VM do SQLite
+    std::uint64_t fullScanSteps{0}; // passos de varredura completa de tabela
+    std::uint64_t sortSteps{0};     // ordenações feitas sem índice
+    std::uint64_t autoIndexes{0};   // índices automáticos (temporários) criados
+    std::string plan;               // EXPLAIN QUERY PLAN (preenchido quando a consulta foi lenta)
+
+    double meanMs() const { return calls ? totalMs / static_cast<double>(calls) : 0.0; }
+};
+
+// Profiler de consultas do SQLite (opcional, ECOCIN_SQL_PROFILE=on).
+// Cada conexão anexada recebe callbacks de sqlite3_trace_v2: ao fim de cada execução lemos o tempo
+// medido pelo próprio SQLite e os contadores de sqlite3_stmt_status, e acumulamos tudo por SQL
+// normalizado (espaços colapsados, literais trocados por "?"). Consultas acima do limite são
+// registradas em log junto com o EXPLAIN QUERY PLAN, calculado uma vez por SQL e guardado em cache.
+class QueryProfiler {
+private:
+    mutable std::mutex mutex_; // stats_ e planPending_: só contadores, nunca com E/S dentro
+    std::unordered_map<std::string, QueryStats> stats_;
+    std::unordered_set<std::string> planPending_; // SQLs com EXPLAIN em andamento em alguma thread
+
+    std::mutex planMutex_; // plans_ e planDbs_; só quem calcula um plano novo passa por aqui
+    std::unordered_map<std::string, std::string> plans_;
+    std::unordered_map<std::string, sqlite3*> planDbs_; // conexões somente leitura, por arquivo
+    std::chrono::nanoseconds slowThreshold_{std::chrono::milliseconds(50)};
+
+    QueryProfiler() = default;
+    ~QueryProfiler();
+
+    static int onTrace(unsigned type, void* ctx, void* p, void* x);
+    void onProfile(sqlite3_stmt* stmt, std::int64_t ns);
+    std::string planFor(sqlite3* db, const std::string& sql);
+
+public:
+    static QueryProfiler& instance();
+
+    QueryProfiler(const QueryProfiler&) = delete;
+    QueryProfiler& operator=(const QueryProfiler&) = delete;
+
+    // Tempo a partir do qual uma consulta é considerada lenta (0 desliga o log)
+    void setSlowThreshold(std::chrono::nanoseconds threshold);
+
+    // Passa a perfilar todas as instruções executadas na conexão
+    void attach(sqlite3* db);
+
+    // As n consultas com maior tempo total, da maior para a menor
+    std::vector<QueryStats> top(std::size_t n) const;
+
+    void reset();
+
+    // Normaliza o texto SQL: colapsa espaços, troca literais numéricos e strings por "?"
+    // e remove o ";" final. Consultas que só diferem nos valores caem na mesma entrada.
+    static std::string normalize(std::string_view sql);
+};
+
+} // namespace ecocin::infra::db
+
+#endif // ECOCIN_INFRA_DB_QUERYPROFILER_H
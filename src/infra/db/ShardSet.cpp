@@ -0,0 +1,117 @@
+#include "ShardSet.h"
+
+#include <memory>
+#include <stdexcept>
+
+namespace ecocin::infra::db {
+
+namespace {
+
+void step(SqliteConnection& cx, sqlite3_stmt* st, const char* where) {
+    const int rc = sqlite3_step(st);
+    if (rc != SQLITE_DONE && rc != SQLITE_ROW) {
+        throw std::runtime_error(std::string("SQLite error @ ") + where + ": " + sqlite3_errmsg(cx.raw()));
+    }
+}
+
+std::optional<long long> readMeta(SqliteConnection& cx, const char* key) {
+    Statement st(cx, "SELECT value FROM shard_meta WHERE key = ?", "prepare shard meta");
+    sqlite3_bind_text(st, 1, key, -1, SQLITE_STATIC);
+    if (sqlite3_step(st) != SQLITE_ROW) return std::nullopt;
+    return static_cast<long long>(sqlite3_column_int64(st, 0));
+}
+
+void writeMeta(SqliteConnection& cx, const char* key, long long value) {
+    Statement st(cx, "INSERT INTO shard_meta(key, value) VALUES(?, ?)", "prepare shard meta insert");
+    sqlite3_bind_text(st, 1, key, -1, SQLITE_STATIC);
+    sqlite3_bind_int64(st, 2, value);
+    step(cx, st, "step shard meta insert");
+}
+
+} // namespace
+
+ShardSet::ShardSet(const std::string& basePath, std::size_t count) {
+    if (count == 0 || count > kMaxShards) {
+        throw std::invalid_argument("número de shards deve estar entre 1 e " + std::to_string(kMaxShards));
+    }
+    shards_.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        shards_.push_back(std::make_unique<SqliteConnection>(shardPath(basePath, i)));
+    }
+}
+
+// FNV-1a de 64 bits: estável entre execuções, compiladores e plataformas (std::hash não é),
+// porque decide em que arquivo o cliente está gravado.
+std::size_t ShardSet::shardForCpf(std::string_view cpf) const {
+    std::uint64_t h = 14695981039346656037ull;
+    for (unsigned char c : cpf) {
+        h ^= c;
+        h *= 1099511628211ull;
+    }
+    return static_cast<std::size_t>(h % shards_.size());
+}
+
+std::optional<std::size_t> ShardSet::shardOfId(long long id) const {
+    if (id <= 0) return std::nullopt;
+    const auto shard = static_cast<std::size_t>(id >> kShardIdBits);
+    if (shard >= shards_.size()) return std::nullopt;
+    return shard;
+}
+
+std::string ShardSet::shardPath(const std::string& basePath, std::size_t shard) {
+    if (shard == 0) return basePath;
+    const auto dot = basePath.rfind('.');
+    const auto slash = basePath.find_last_of("/\\");
+    const bool hasExt = dot != std::string::npos && (slash == std::string::npos || dot > slash);
+    const std::string stem = hasExt ? basePath.substr(0, dot) : basePath;
+    const std::string ext = hasExt ? basePath.substr(dot) : std::string(".db");
+    return stem + ".shard" + std::to_string(shard) + ext;
+}
+
+void ShardSet::prepare(SqliteConnection& cx, std::size_t shard, std::size_t count) {
+    Transaction tx(cx, "BEGIN IMMEDIATE");
+    cx.exec("CREATE TABLE IF NOT EXISTS shard_meta (key TEXT PRIMARY KEY, value INTEGER NOT NULL)");
+
+    const auto storedCount = readMeta(cx, "shard_count");
+    if (!storedCount) {
+        // Banco sem marca: só vira shard de um conjunto maior se ainda não tem clientes
+        // (os existentes estariam no arquivo errado para o hash do CPF).
+        if (count > 1) {
+            Statement st(cx, "SELECT EXISTS(SELECT 1 FROM clients)", "prepare shard clients check");
+            step(cx, st, "step shard clients check");
+            if (sqlite3_column_int(st, 0)) {
+                throw std::runtime_error("o banco " + std::to_string(shard) +
+                                         " já tem clientes de antes do sharding; redistribua-os antes de usar " +
+                                         std::to_string(count) + " shards");
+            }
+        }
+        writeMeta(cx, "shard_count", static_cast<long long>(count));
+        writeMeta(cx, "shard_index", static_cast<long long>(shard));
+    } else if (*storedCount != static_cast<long long>(count) ||
+               readMeta(cx, "shard_index").value_or(-1) != static_cast<long long>(shard)) {
+        throw std::runtime_error("shard " + std::to_string(shard) + " foi criado para " +
+                                 std::to_string(*storedCount) + " shards; configurado com " + std::to_string(count));
+    }
+
+    // AUTOINCREMENT continua de max(seq, maior id): com seq no início da faixa, os ids novos
+    // deste shard não colidem com os dos outros
+    const long long base = static_cast<long long>(shard) << kShardIdBits;
+    if (base > 0) {
+        for (const char* table : {"clients", "addresses", "orders"}) {
+            Statement up(cx, "UPDATE sqlite_sequence SET seq = ?2 WHERE name = ?1 AND seq < ?2", "prepare shard sequence");
+            sqlite3_bind_text(up, 1, table, -1, SQLITE_STATIC);
+            sqlite3_bind_int64(up, 2, base);
+            step(cx, up, "step shard sequence");
+
+            Statement ins(cx, "INSERT INTO sqlite_sequence(name, seq) SELECT ?1, ?2 "
+                              "WHERE NOT EXISTS (SELECT 1 FROM sqlite_sequence WHERE name = ?1)",
+                          "prepare shard sequence insert");
+            sqlite3_bind_text(ins, 1, table, -1, SQLITE_STATIC);
+            sqlite3_bind_int64(ins, 2, base);
+            step(cx, ins, "step shard sequence insert");
+        }
+    }
+    tx.commit();
+}
+
+} // namespace ecocin::infra::db
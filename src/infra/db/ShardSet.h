@@ -0,0 +1,60 @@
+#ifndef ECOCIN_INFRA_DB_SHARDSET_H
+#define ECOCIN_INFRA_DB_SHARDSET_H
+
+#include "SqliteConnection.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ecocin::infra::db {
+
+// Conjunto de bancos (shards) com os dados particionados por cliente.
+// Cada arquivo tem o seu próprio escritor, então N shards gravam em paralelo em vez de todos
+// esperarem o lock de escrita de um único e-cocin.db.
+//
+//   - clientes vão para o shard do hash do CPF (shardForCpf); os endereços e pedidos de um cliente
+//     ficam no shard dele, então as chaves estrangeiras e as consultas por cliente continuam locais;
+//   - cada shard gera ids numa faixa própria (shard << kShardIdBits em diante), e o id sozinho diz
+//     em que shard a linha está (shardOfId): findById/update/remove vão direto ao shard certo;
+//   - o shard 0 também é o catálogo de produtos (ver ShardedProductRepository).
+//
+// Com um shard só, nada muda: o shard 0 é o e-cocin.db de sempre, com a faixa de ids começando em 1.
+// O número de shards fica gravado em cada arquivo e não pode mudar depois (o hash dos CPFs mudaria):
+// abrir com outro número lança std::runtime_error.
+class ShardSet {
+public:
+    static constexpr int kShardIdBits = 40; // ~1,1 trilhão de ids por shard
+    static constexpr std::size_t kMaxShards = 64;
+
+    // Abre os arquivos shardPath(basePath, 0..count-1), uma conexão por shard.
+    // As migrações e prepare() já precisam ter rodado em cada um (no boot, antes das pilhas).
+    ShardSet(const std::string& basePath, std::size_t count);
+
+    ShardSet(const ShardSet&) = delete;
+    ShardSet& operator=(const ShardSet&) = delete;
+
+    std::size_t size() const { return shards_.size(); }
+    SqliteConnection& shard(std::size_t i) { return *shards_[i]; }
+
+    std::size_t shardForCpf(std::string_view cpf) const;
+    std::optional<std::size_t> shardOfId(long long id) const;
+
+    // e-cocin.db -> e-cocin.db, e-cocin.shard1.db, e-cocin.shard2.db...
+    static std::string shardPath(const std::string& basePath, std::size_t shard);
+
+    // Marca o shard (número e total) e posiciona o sqlite_sequence de clients, addresses e orders
+    // no início da faixa do shard. Idempotente; chamado na abertura de cada shard.
+    static void prepare(SqliteConnection& cx, std::size_t shard, std::size_t count);
+
+private:
+    std::vector<std::unique_ptr<SqliteConnection>> shards_;
+};
+
+} // namespace ecocin::infra::db
+
+#endif // ECOCIN_INFRA_DB_SHARDSET_H
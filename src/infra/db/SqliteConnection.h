@@ -2,8 +2,13 @@
 #define ECOCIN_INFRA_DB_SQLITECONNECTION_H
 
 #include <sqlite3.h>
+#include <functional>
+#include <mutex>
 #include <string>
+#include <string_view>
 #include <stdexcept>
+#include <unordered_map>
+#include <vector>
 
 namespace ecocin::infra::db {
 
@@ -12,24 +17,129 @@ class SqliteConnection {
 private:
     sqlite3* db_{nullptr}; // Ponteiro para a conexão SQLite
 
+    // Cache de instruções preparadas, indexado pelo texto SQL. Cada entrada guarda as instruções
+    // livres daquele SQL: quem pede recebe uma exclusiva (ou uma nova, se todas estiverem em uso),
+    // então várias threads podem usar a mesma conexão e o mesmo SQL ao mesmo tempo.
+    struct SqlHash {
+        using is_transparent = void;
+        std::size_t operator()(std::string_view s) const noexcept { return std::hash<std::string_view>{}(s); }
+    };
+    static constexpr std::size_t kMaxIdlePerSql = 16;
+    std::mutex cacheMutex_;
+    std::unordered_map<std::string, std::vector<sqlite3_stmt*>, SqlHash, std::equal_to<>> cache_;
+
 public:
     explicit SqliteConnection(const std::string& path) {
         if (sqlite3_open(path.c_str(), &db_) != SQLITE_OK) { // Abre a conexão com o banco de dados
             throw std::runtime_error(std::string("SQLite open failed: ") + sqlite3_errmsg(db_)); // Lança exceção em caso de falha
         }
-        char* err = nullptr;
-        sqlite3_exec(db_, "PRAGMA foreign_keys = ON;", nullptr, nullptr, &err); // Habilita chaves estrangeiras
-        if (err) { std::string e = err; sqlite3_free(err); throw std::runtime_error(e); }
+        exec("PRAGMA foreign_keys = ON;"); // Habilita chaves estrangeiras
     }
 
-    ~SqliteConnection() { if (db_) sqlite3_close(db_); } // Fecha a conexão ao destruir o objeto
+    ~SqliteConnection() { // Finaliza as instruções em cache e fecha a conexão ao destruir o objeto
+        for (auto& [sql, idle] : cache_) {
+            for (auto* st : idle) sqlite3_finalize(st);
+        }
+        if (db_) sqlite3_close(db_);
+    }
 
     SqliteConnection(const SqliteConnection&) = delete;
     SqliteConnection& operator=(const SqliteConnection&) = delete;
 
+    // Executa SQL sem resultado (PRAGMA, BEGIN/COMMIT, DDL); lança std::runtime_error em caso de falha
+    void exec(const char* sql) {
+        char* err = nullptr;
+        sqlite3_exec(db_, sql, nullptr, nullptr, &err);
+        if (err) { std::string e = err; sqlite3_free(err); throw std::runtime_error(e); }
+    }
+
+    // Prepara a conexão para dividir o arquivo com outras conexões/threads:
+    // WAL deixa leitores rodarem junto com o escritor e o busy timeout faz
+    // quem encontrar o banco travado esperar em vez de falhar com SQLITE_BUSY.
+    void enableConcurrentAccess(int busyTimeoutMs = 5000) {
+        sqlite3_busy_timeout(db_, busyTimeoutMs);
+        exec("PRAGMA journal_mode = WAL; PRAGMA synchronous = NORMAL;");
+    }
+
+    // Empresta uma instrução preparada para sql (do cache ou recém-preparada).
+    // Prefira a classe Statement, que devolve a instrução ao cache ao sair do escopo.
+    sqlite3_stmt* acquireStatement(std::string_view sql, const char* where) {
+        {
+            std::lock_guard<std::mutex> lock(cacheMutex_);
+            auto it = cache_.find(sql);
+            if (it != cache_.end() && !it->second.empty()) {
+                auto* st = it->second.back();
+                it->second.pop_back();
+                return st;
+            }
+        }
+        sqlite3_stmt* st = nullptr;
+        if (sqlite3_prepare_v3(db_, sql.data(), static_cast<int>(sql.size()), SQLITE_PREPARE_PERSISTENT, &st, nullptr) != SQLITE_OK) {
+            throw std::runtime_error(std::string("SQLite error @ ") + where + ": " + sqlite3_errmsg(db_));
+        }
+        return st;
+    }
+
+    // Limpa a instrução (reset + bindings) e a devolve ao cache
+    void releaseStatement(sqlite3_stmt* st) {
+        if (!st) return;
+        sqlite3_reset(st);
+        sqlite3_clear_bindings(st);
+        std::lock_guard<std::mutex> lock(cacheMutex_);
+        auto& idle = cache_[sqlite3_sql(st)];
+        if (idle.size() < kMaxIdlePerSql) {
+            idle.push_back(st);
+        } else {
+            sqlite3_finalize(st);
+        }
+    }
+
     sqlite3* raw() const { return db_; }
 };
 
+// Instrução preparada emprestada do cache da conexão durante um escopo.
+// Converte implicitamente para sqlite3_stmt*, então sqlite3_bind_* / sqlite3_step / sqlite3_column_*
+// são usados como antes; no destrutor a instrução volta ao cache em vez de ser finalizada,
+// inclusive quando o escopo termina por exceção.
+class Statement {
+private:
+    SqliteConnection& cx_;
+    sqlite3_stmt* st_;
+
+public:
+    Statement(SqliteConnection& cx, std::string_view sql, const char* where)
+        : cx_(cx), st_(cx.acquireStatement(sql, where)) {}
+    ~Statement() { cx_.releaseStatement(st_); }
+
+    Statement(const Statement&) = delete;
+    Statement& operator=(const Statement&) = delete;
+
+    operator sqlite3_stmt*() const { return st_; }
+};
+
+// Transação explícita: BEGIN no construtor, COMMIT em commit() e ROLLBACK se o escopo
+// terminar antes disso. Vale para a conexão inteira, então só deve ser usada por quem tem
+// a conexão só para si (ex.: ferramentas de carga em massa).
+class Transaction {
+private:
+    SqliteConnection& cx_;
+    bool open_{true};
+
+public:
+    explicit Transaction(SqliteConnection& cx, const char* begin = "BEGIN") : cx_(cx) { cx_.exec(begin); }
+    ~Transaction() {
+        if (open_) sqlite3_exec(cx_.raw(), "ROLLBACK", nullptr, nullptr, nullptr);
+    }
+
+    Transaction(const Transaction&) = delete;
+    Transaction& operator=(const Transaction&) = delete;
+
+    void commit() {
+        cx_.exec("COMMIT");
+        open_ = false;
+    }
+};
+
 } // namespace ecocin::infra::db
 
 #endif // ECOCIN_INFRA_DB_SQLITECONNECTION_H
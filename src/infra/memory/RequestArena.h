@@ -0,0 +1,45 @@
+#ifndef ECOCIN_INFRA_MEMORY_REQUESTARENA_H
+#define ECOCIN_INFRA_MEMORY_REQUESTARENA_H
+
+#include <cstddef>
+#include <memory_resource>
+
+namespace ecocin::infra::memory {
+
+// Arena de alocação de uma requisição.
+// Listagens (repositórios e serviços que recebem std::pmr::memory_resource*) pegam os vetores e
+// estruturas intermediárias daqui: cada alocação só avança um ponteiro (monotonic_buffer_resource),
+// desalocar não faz nada e tudo é devolvido de uma vez quando a arena sai de escopo.
+//
+// Os primeiros kInlineBytes vêm de um buffer dentro do próprio objeto (na pilha de quem atende a
+// requisição). Quando não cabe, a arena pede blocos a um pool da própria thread, sem trava: as threads
+// do HttpConnectionHandler não disputam o alocador global, e os blocos voltam ao pool da thread para a
+// próxima requisição em vez de irem e voltarem do heap.
+//
+// Só vale na thread que a criou e enquanto estiver viva: nada alocado nela pode sair do escopo
+// da requisição (o corpo da resposta, por exemplo, é um std::string comum).
+class RequestArena {
+public:
+    static constexpr std::size_t kInlineBytes = 8 * 1024;
+
+    RequestArena() : arena_(inline_, sizeof(inline_), threadPool()) {}
+
+    RequestArena(const RequestArena&) = delete;
+    RequestArena& operator=(const RequestArena&) = delete;
+
+    std::pmr::memory_resource* resource() { return &arena_; }
+
+private:
+    alignas(std::max_align_t) std::byte inline_[kInlineBytes];
+    std::pmr::monotonic_buffer_resource arena_;
+
+    // Pool sem sincronização, um por thread. Blocos grandes demais para o pool vão direto ao heap.
+    static std::pmr::memory_resource* threadPool() {
+        thread_local std::pmr::unsynchronized_pool_resource pool{std::pmr::new_delete_resource()};
+        return &pool;
+    }
+};
+
+} // namespace ecocin::infra::memory
+
+#endif // ECOCIN_INFRA_MEMORY_REQUESTARENA_H
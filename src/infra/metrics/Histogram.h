@@ -0,0 +1,89 @@
+#ifndef ECOCIN_INFRA_METRICS_HISTOGRAM_H
+#define ECOCIN_INFRA_METRICS_HISTOGRAM_H
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+namespace ecocin::infra::metrics {
+
+// Histograma de latências no estilo HDR (log-linear), sem locks.
+// Cada potência de 2 é dividida em 16 faixas lineares, então o erro relativo de qualquer
+// valor registrado fica abaixo de ~6%, de 1ns até ~18 minutos, com um array fixo de contadores.
+// record() é um único fetch_add relaxado (mais dois para soma e total): pode ser chamado
+// de qualquer thread no caminho quente; a leitura (snapshot) é aproximada, o que basta para métricas.
+class Histogram {
+public:
+    static constexpr int kSubBits = 4;                          // 2^4 = 16 faixas por potência de 2
+    static constexpr int kSubCount = 1 << kSubBits;
+    static constexpr int kMaxExponent = 40;                      // 2^40 ns ~ 18 min
+    static constexpr std::size_t kBuckets = kSubCount + (kMaxExponent - kSubBits + 1) * kSubCount;
+
+private:
+    std::array<std::atomic<std::uint64_t>, kBuckets> counts_{};
+    std::atomic<std::uint64_t> total_{0};
+    std::atomic<std::uint64_t> sum_{0};
+
+public:
+    static std::size_t bucketOf(std::uint64_t v) {
+        if (v < static_cast<std::uint64_t>(kSubCount)) return static_cast<std::size_t>(v);
+        const int e = static_cast<int>(std::bit_width(v)) - 1;
+        if (e > kMaxExponent) return kBuckets - 1;
+        const auto sub = (v >> (e - kSubBits)) - kSubCount;
+        return static_cast<std::size_t>(kSubCount + (e - kSubBits) * kSubCount + static_cast<int>(sub));
+    }
+
+    // Limite superior (exclusivo) dos valores que caem no bucket b
+    static std::uint64_t upperBound(std::size_t b) {
+        if (b < static_cast<std::size_t>(kSubCount)) return b + 1;
+        const auto rel = b - kSubCount;
+        const auto e = static_cast<int>(rel / kSubCount) + kSubBits;
+        const auto sub = rel % kSubCount;
+        return (static_cast<std::uint64_t>(kSubCount) + sub + 1) << (e - kSubBits);
+    }
+
+    void record(std::uint64_t value) {
+        counts_[bucketOf(value)].fetch_add(1, std::memory_order_relaxed);
+        total_.fetch_add(1, std::memory_order_relaxed);
+        sum_.fetch_add(value, std::memory_order_relaxed);
+    }
+
+    // Soma as contagens de outro histograma a este (ex.: total de várias rotas)
+    void merge(const Histogram& other) {
+        for (std::size_t b = 0; b < kBuckets; ++b) {
+            if (const auto c = other.bucketCount(b)) counts_[b].fetch_add(c, std::memory_order_relaxed);
+        }
+        total_.fetch_add(other.count(), std::memory_order_relaxed);
+        sum_.fetch_add(other.sum(), std::memory_order_relaxed);
+    }
+
+    std::uint64_t count() const { return total_.load(std::memory_order_relaxed); }
+    std::uint64_t sum() const { return sum_.load(std::memory_order_relaxed); }
+    std::uint64_t bucketCount(std::size_t b) const { return counts_[b].load(std::memory_order_relaxed); }
+
+    // Quantidade de valores abaixo de limit (limit alinhado para baixo à faixa que o contém)
+    std::uint64_t countBelow(std::uint64_t limit) const {
+        std::uint64_t c = 0;
+        for (std::size_t b = 0; b < kBuckets && upperBound(b) <= limit; ++b) c += bucketCount(b);
+        return c;
+    }
+
+    // Valor aproximado do quantil q (0..1): limite superior do bucket que contém o q-ésimo valor
+    std::uint64_t quantile(double q) const {
+        const auto n = count();
+        if (n == 0) return 0;
+        const auto target = static_cast<std::uint64_t>(q * static_cast<double>(n - 1)) + 1;
+        std::uint64_t seen = 0;
+        for (std::size_t b = 0; b < kBuckets; ++b) {
+            seen += bucketCount(b);
+            if (seen >= target) return upperBound(b);
+        }
+        return upperBound(kBuckets - 1);
+    }
+};
+
+} // namespace ecocin::infra::metrics
+
+#endif // ECOCIN_INFRA_METRICS_HISTOGRAM_H
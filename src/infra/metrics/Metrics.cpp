@@ -0,0 +1,187 @@
+#include "Metrics.h"
+
+#include <array>
+#include <cstdio>
+
+namespace ecocin::infra::metrics {
+
+namespace {
+
+// Limites (em segundos) publicados como buckets "le" do Prometheus. Internamente o histograma
+// é bem mais fino; aqui somamos as faixas internas até cada limite.
+constexpr double kLeSeconds[] = {0.0001, 0.00025, 0.0005, 0.001, 0.0025, 0.005, 0.01,
+                                 0.025,  0.05,    0.1,    0.25,  0.5,    1.0,   2.5, 5.0, 10.0};
+
+constexpr const char* kUnmatchedRoute = "unmatched";
+
+std::vector<std::string> splitPath(std::string_view path) {
+    std::vector<std::string> out;
+    std::size_t start = 0;
+    while (start < path.size()) {
+        if (path[start] == '/') { ++start; continue; }
+        const auto end = path.find('/', start);
+        out.emplace_back(path.substr(start, end == std::string_view::npos ? std::string_view::npos : end - start));
+        if (end == std::string_view::npos) break;
+        start = end + 1;
+    }
+    return out;
+}
+
+void appendNumber(std::string& out, double v) {
+    char buf[32];
+    const int n = std::snprintf(buf, sizeof(buf), "%.9g", v);
+    out.append(buf, static_cast<std::size_t>(n));
+}
+
+void appendNumber(std::string& out, std::uint64_t v) {
+    out += std::to_string(v);
+}
+
+// Escreve _bucket/_sum/_count de um histograma em nanossegundos, convertendo para segundos
+void appendHistogram(std::string& out, const char* name, const std::string& labels, const Histogram& h) {
+    for (double le : kLeSeconds) {
+        out += name; out += "_bucket{"; out += labels; out += ",le=\"";
+        appendNumber(out, le);
+        out += "\"} ";
+        appendNumber(out, h.countBelow(static_cast<std::uint64_t>(le * 1e9)));
+        out += '\n';
+    }
+    out += name; out += "_bucket{"; out += labels; out += ",le=\"+Inf\"} ";
+    appendNumber(out, h.count());
+    out += '\n';
+    out += name; out += "_sum{"; out += labels; out += "} ";
+    appendNumber(out, static_cast<double>(h.sum()) / 1e9);
+    out += '\n';
+    out += name; out += "_count{"; out += labels; out += "} ";
+    appendNumber(out, h.count());
+    out += '\n';
+}
+
+} // namespace
+
+Registry::Registry() {
+    routes_.emplace_back("", kUnmatchedRoute); // índice 0
+}
+
+Registry& Registry::instance() {
+    static Registry registry;
+    return registry;
+}
+
+std::size_t Registry::registerRoute(const std::string& method, const std::string& pathTemplate) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (std::size_t i = 0; i < routes_.size(); ++i) {
+        if (routes_[i].method == method && routes_[i].route == pathTemplate) return i;
+    }
+    routes_.emplace_back(method, pathTemplate);
+
+    RouteTemplate t;
+    t.segments = splitPath(pathTemplate);
+    for (const auto& s : t.segments) {
+        if (s.empty() || s.front() != '{') ++t.literals;
+    }
+    t.index = routes_.size() - 1;
+    templates_.push_back(std::move(t));
+    return routes_.size() - 1;
+}
+
+std::size_t Registry::match(std::string_view method, std::string_view path) const {
+    const auto q = path.find('?');
+    if (q != std::string_view::npos) path = path.substr(0, q);
+
+    // Segmentos do caminho concreto, sem alocar (caminhos mais longos que isso não são rotas da API)
+    constexpr std::size_t kMaxSegments = 16;
+    std::array<std::string_view, kMaxSegments> segments;
+    std::size_t count = 0;
+    for (std::size_t start = 0; start < path.size();) {
+        if (path[start] == '/') { ++start; continue; }
+        if (count == kMaxSegments) return 0;
+        auto end = path.find('/', start);
+        if (end == std::string_view::npos) end = path.size();
+        segments[count++] = path.substr(start, end - start);
+        start = end;
+    }
+
+    // Entre as rotas que casam, vence a com mais segmentos literais (ex.: /products/sku/{sku} antes de /products/{id})
+    std::size_t best = 0;
+    int bestLiterals = -1;
+    for (const auto& t : templates_) {
+        if (t.segments.size() != count || t.literals <= bestLiterals) continue;
+        if (routes_[t.index].method != method) continue;
+        bool ok = true;
+        for (std::size_t i = 0; i < count && ok; ++i) {
+            const auto& s = t.segments[i];
+            ok = (!s.empty() && s.front() == '{') || s == segments[i];
+        }
+        if (ok) {
+            best = t.index;
+            bestLiterals = t.literals;
+        }
+    }
+    return best;
+}
+
+RouteMetrics& Registry::route(std::size_t index) {
+    return routes_[index];
+}
+
+DbOpMetrics& Registry::dbOp(const std::string& table, const std::string& op) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& m : dbOps_) {
+        if (m.table == table && m.op == op) return m;
+    }
+    return dbOps_.emplace_back(table, op);
+}
+
+std::string Registry::renderPrometheus() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::string out;
+    out.reserve(16 * 1024);
+
+    out += "# HELP ecocin_http_request_duration_seconds Latência das requisições HTTP por rota.\n";
+    out += "# TYPE ecocin_http_request_duration_seconds histogram\n";
+    for (const auto& r : routes_) {
+        if (r.latencyNs.count() == 0) continue;
+        appendHistogram(out, "ecocin_http_request_duration_seconds",
+                        "method=\"" + r.method + "\",route=\"" + r.route + "\"", r.latencyNs);
+    }
+
+    out += "# HELP ecocin_http_requests_total Requisições HTTP concluídas por rota e status.\n";
+    out += "# TYPE ecocin_http_requests_total counter\n";
+    for (const auto& r : routes_) {
+        for (std::size_t code = 0; code < r.byStatus.size(); ++code) {
+            const auto n = r.byStatus[code].load(std::memory_order_relaxed);
+            if (n == 0) continue;
+            out += "ecocin_http_requests_total{method=\"" + r.method + "\",route=\"" + r.route +
+                   "\",code=\"" + std::to_string(code) + "\"} ";
+            appendNumber(out, n);
+            out += '\n';
+        }
+    }
+
+    out += "# HELP ecocin_http_requests_in_flight Requisições HTTP em andamento por rota.\n";
+    out += "# TYPE ecocin_http_requests_in_flight gauge\n";
+    for (const auto& r : routes_) {
+        out += "ecocin_http_requests_in_flight{method=\"" + r.method + "\",route=\"" + r.route + "\"} ";
+        out += std::to_string(r.inFlight.load(std::memory_order_relaxed));
+        out += '\n';
+    }
+
+    out += "# HELP ecocin_db_operation_duration_seconds Latência das operações dos repositórios.\n";
+    out += "# TYPE ecocin_db_operation_duration_seconds histogram\n";
+    for (const auto& m : dbOps_) {
+        appendHistogram(out, "ecocin_db_operation_duration_seconds",
+                        "table=\"" + m.table + "\",op=\"" + m.op + "\"", m.latencyNs);
+    }
+
+    out += "# HELP ecocin_db_operation_errors_total Operações dos repositórios que terminaram em erro.\n";
+    out += "# TYPE ecocin_db_operation_errors_total counter\n";
+    for (const auto& m : dbOps_) {
+        out += "ecocin_db_operation_errors_total{table=\"" + m.table + "\",op=\"" + m.op + "\"} ";
+        appendNumber(out, m.errors.load(std::memory_order_relaxed));
+        out += '\n';
+    }
+    return out;
+}
+
+} // namespace ecocin::infra::metrics
@@ -0,0 +1,109 @@
+#ifndef ECOCIN_INFRA_METRICS_METRICS_H
+#define ECOCIN_INFRA_METRICS_METRICS_H
+
+#include "Histogram.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ecocin::infra::metrics {
+
+// Métricas de uma rota HTTP (método + caminho com variáveis, ex.: GET /products/{id})
+struct RouteMetrics {
+    std::string method;
+    std::string route;
+    Histogram latencyNs;
+    std::atomic<std::int64_t> inFlight{0};
+    std::array<std::atomic<std::uint64_t>, 600> byStatus{}; // índice = código HTTP
+
+    RouteMetrics(std::string m, std::string r) : method(std::move(m)), route(std::move(r)) {}
+};
+
+// Métricas de uma operação de repositório (tabela + operação, ex.: products/findById)
+struct DbOpMetrics {
+    std::string table;
+    std::string op;
+    Histogram latencyNs;
+    std::atomic<std::uint64_t> errors{0};
+
+    DbOpMetrics(std::string t, std::string o) : table(std::move(t)), op(std::move(o)) {}
+};
+
+// Registro global das métricas do processo (compartilhado por todos os acceptors).
+// As estruturas ficam em std::deque para que os endereços não mudem quando algo novo é registrado;
+// quem obtém uma referência pode guardá-la (ex.: em uma variável static) e atualizá-la sem lock.
+class Registry {
+private:
+    struct RouteTemplate {
+        std::vector<std::string> segments; // "{...}" casa com qualquer segmento
+        int literals{0};
+        std::size_t index{0};
+    };
+
+    mutable std::mutex mutex_;
+    std::deque<RouteMetrics> routes_;
+    std::vector<RouteTemplate> templates_;
+    std::deque<DbOpMetrics> dbOps_;
+
+    Registry();
+
+public:
+    static Registry& instance();
+
+    // Registra uma rota (idempotente). Todas as rotas são registradas na montagem da aplicação,
+    // antes de o servidor aceitar conexões; depois disso match() só lê.
+    std::size_t registerRoute(const std::string& method, const std::string& pathTemplate);
+
+    // Rota registrada que casa com o caminho concreto da requisição (sem query string).
+    // Requisições que não casam com nenhuma rota vão para a entrada "unmatched",
+    // o que mantém a cardinalidade das séries limitada.
+    std::size_t match(std::string_view method, std::string_view path) const;
+    RouteMetrics& route(std::size_t index);
+
+    DbOpMetrics& dbOp(const std::string& table, const std::string& op);
+
+    // Texto no formato de exposição do Prometheus (versão 0.0.4)
+    std::string renderPrometheus() const;
+};
+
+// Atalho para os repositórios: static auto& m = metrics::dbOp("products", "findById");
+inline DbOpMetrics& dbOp(const std::string& table, const std::string& op) {
+    return Registry::instance().dbOp(table, op);
+}
+
+// Mede o tempo de uma operação de repositório do construtor ao destrutor.
+// Se o escopo terminar por exceção (ex.: sqlite_check falhou), conta também como erro.
+class DbOpTimer {
+private:
+    DbOpMetrics& op_;
+    std::chrono::steady_clock::time_point start_;
+    int exceptionsAtStart_;
+
+public:
+    explicit DbOpTimer(DbOpMetrics& op)
+        : op_(op), start_(std::chrono::steady_clock::now()), exceptionsAtStart_(std::uncaught_exceptions()) {}
+
+    ~DbOpTimer() {
+        const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start_).count();
+        op_.latencyNs.record(static_cast<std::uint64_t>(ns));
+        if (std::uncaught_exceptions() > exceptionsAtStart_) {
+            op_.errors.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    DbOpTimer(const DbOpTimer&) = delete;
+    DbOpTimer& operator=(const DbOpTimer&) = delete;
+};
+
+} // namespace ecocin::infra::metrics
+
+#endif // ECOCIN_INFRA_METRICS_METRICS_H
@@ -0,0 +1,182 @@
+#include "ReusePortConnectionProvider.h"
+
+#include <stdexcept>
+
+#if defined(_WIN32)
+// Windows não tem SO_REUSEPORT; o provedor existe apenas para manter a compilação portátil.
+#else
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#endif
+
+namespace ecocin::infra::net {
+
+#if defined(_WIN32) || !defined(SO_REUSEPORT)
+
+bool ReusePortConnectionProvider::isSupported() { return false; }
+
+oatpp::v_io_handle ReusePortConnectionProvider::openListeningSocket(const std::string&, unsigned short) {
+    throw std::runtime_error("SO_REUSEPORT is not supported on this platform");
+}
+
+void ReusePortConnectionProvider::ConnectionInvalidator::invalidate(
+    const std::shared_ptr<oatpp::data::stream::IOStream>&) {}
+
+ReusePortConnectionProvider::ReusePortConnectionProvider(const std::string& host, unsigned short port)
+    : invalidator_(std::make_shared<ConnectionInvalidator>()),
+      serverHandle_(openListeningSocket(host, port)) {}
+
+ReusePortConnectionProvider::~ReusePortConnectionProvider() = default;
+
+void ReusePortConnectionProvider::stop() { closed_ = true; }
+
+oatpp::provider::ResourceHandle<oatpp::data::stream::IOStream> ReusePortConnectionProvider::get() {
+    return nullptr;
+}
+
+#else
+
+bool ReusePortConnectionProvider::isSupported() { return true; }
+
+// Cria o socket de escuta IPv4 com SO_REUSEADDR + SO_REUSEPORT.
+oatpp::v_io_handle ReusePortConnectionProvider::openListeningSocket(const std::string& host, unsigned short port) {
+    const int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) {
+        throw std::runtime_error(std::string("socket() failed: ") + std::strerror(errno));
+    }
+
+    const int yes = 1;
+    if (::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &yes, sizeof(yes)) != 0 ||
+        ::setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &yes, sizeof(yes)) != 0) {
+        const std::string err = std::strerror(errno);
+        ::close(fd);
+        throw std::runtime_error("setsockopt(SO_REUSEPORT) failed: " + err);
+    }
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port   = htons(port);
+    if (host.empty() || host == "0.0.0.0") {
+        addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    } else if (::inet_pton(AF_INET, host.c_str(), &addr.sin_addr) != 1) {
+        ::close(fd);
+        throw std::runtime_error("invalid IPv4 address: " + host);
+    }
+
+    if (::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 ||
+        ::listen(fd, SOMAXCONN) != 0) {
+        const std::string err = std::strerror(errno);
+        ::close(fd);
+        throw std::runtime_error("bind/listen on port " + std::to_string(port) + " failed: " + err);
+    }
+    return fd;
+}
+
+// Fecha a conexão nos dois sentidos; o descritor é liberado pelo destrutor da tcp::Connection.
+void ReusePortConnectionProvider::ConnectionInvalidator::invalidate(
+    const std::shared_ptr<oatpp::data::stream::IOStream>& connection) {
+    auto c = std::static_pointer_cast<oatpp::network::tcp::Connection>(connection);
+    ::shutdown(c->getHandle(), SHUT_RDWR);
+}
+
+ReusePortConnectionProvider::ReusePortConnectionProvider(const std::string& host, unsigned short port)
+    : invalidator_(std::make_shared<ConnectionInvalidator>()),
+      serverHandle_(openListeningSocket(host, port)) {
+    setProperty("host", oatpp::String(host.c_str()));
+    setProperty("port", oatpp::String(std::to_string(port).c_str()));
+}
+
+ReusePortConnectionProvider::~ReusePortConnectionProvider() {
+    stop();
+}
+
+// O shutdown faz o poll dos get() voltar na hora (o socket fica legível e o accept falha); eles
+// veem closed_ e saem. O close espera o último deles.
+void ReusePortConnectionProvider::stop() {
+    if (closed_.exchange(true)) return;
+    ::shutdown(serverHandle_, SHUT_RDWR);
+    std::unique_lock<std::mutex> lock(getMutex_);
+    getDone_.wait(lock, [this] { return inGet_ == 0; });
+    ::close(serverHandle_);
+}
+
+namespace {
+
+using ExtendedConnection = oatpp::network::tcp::server::ConnectionProvider::ExtendedConnection;
+
+// Mesmas propriedades que o provedor padrão do oatpp põe nas conexões estendidas
+oatpp::data::stream::Context::Properties peerProperties(const sockaddr_storage& peer) {
+    oatpp::data::stream::Context::Properties properties;
+    char ip[INET6_ADDRSTRLEN] = {0};
+    if (peer.ss_family == AF_INET) {
+        const auto* a = reinterpret_cast<const sockaddr_in*>(&peer);
+        ::inet_ntop(AF_INET, &a->sin_addr, ip, sizeof(ip));
+        properties.put_LockFree(ExtendedConnection::PROPERTY_PEER_ADDRESS, oatpp::String(ip));
+        properties.put_LockFree(ExtendedConnection::PROPERTY_PEER_ADDRESS_FORMAT, oatpp::String("ipv4"));
+        properties.put_LockFree(ExtendedConnection::PROPERTY_PEER_PORT, oatpp::String(std::to_string(ntohs(a->sin_port))));
+    } else if (peer.ss_family == AF_INET6) {
+        const auto* a = reinterpret_cast<const sockaddr_in6*>(&peer);
+        ::inet_ntop(AF_INET6, &a->sin6_addr, ip, sizeof(ip));
+        properties.put_LockFree(ExtendedConnection::PROPERTY_PEER_ADDRESS, oatpp::String(ip));
+        properties.put_LockFree(ExtendedConnection::PROPERTY_PEER_ADDRESS_FORMAT, oatpp::String("ipv6"));
+        properties.put_LockFree(ExtendedConnection::PROPERTY_PEER_PORT, oatpp::String(std::to_string(ntohs(a->sin6_port))));
+    }
+    return properties;
+}
+
+} // namespace
+
+// Espera por uma conexão em fatias de 1s para perceber stop(); devolve handle vazio se parado.
+oatpp::provider::ResourceHandle<oatpp::data::stream::IOStream> ReusePortConnectionProvider::get() {
+    {
+        std::lock_guard<std::mutex> lock(getMutex_);
+        if (closed_) return nullptr;
+        ++inGet_;
+    }
+    struct Leave {
+        ReusePortConnectionProvider& self;
+        ~Leave() {
+            std::lock_guard<std::mutex> lock(self.getMutex_);
+            if (--self.inGet_ == 0) self.getDone_.notify_all();
+        }
+    } leave{*this};
+
+    pollfd pfd{};
+    pfd.fd = serverHandle_;
+    pfd.events = POLLIN;
+
+    while (!closed_) {
+        const int ready = ::poll(&pfd, 1, 1000);
+        if (ready < 0 && errno != EINTR) return nullptr;
+        if (ready <= 0) continue;
+
+        // Com SO_REUSEPORT cada socket tem sua própria fila; se a conexão foi abortada antes do accept, volta a esperar
+        sockaddr_storage peer{};
+        socklen_t peerLen = sizeof(peer);
+        const int client = ::accept(serverHandle_, reinterpret_cast<sockaddr*>(&peer), &peerLen);
+        if (client < 0) continue;
+
+        const int yes = 1;
+        ::setsockopt(client, IPPROTO_TCP, TCP_NODELAY, &yes, sizeof(yes));
+        return oatpp::provider::ResourceHandle<oatpp::data::stream::IOStream>(
+            std::make_shared<ExtendedConnection>(client, peerProperties(peer)), invalidator_);
+    }
+    return nullptr;
+}
+
+#endif
+
+oatpp::async::CoroutineStarterForResult<const oatpp::provider::ResourceHandle<oatpp::data::stream::IOStream>&>
+ReusePortConnectionProvider::getAsync() {
+    // Assim como no provedor TCP padrão do oatpp, o accept assíncrono não é suportado:
+    // o AsyncHttpConnectionHandler recebe as conexões aceitas por get().
+    throw std::runtime_error("[ReusePortConnectionProvider::getAsync()]: not implemented");
+}
+
+} // namespace ecocin::infra::net
@@ -0,0 +1,66 @@
+#ifndef ECOCIN_INFRA_NET_REUSEPORTCONNECTIONPROVIDER_H
+#define ECOCIN_INFRA_NET_REUSEPORTCONNECTIONPROVIDER_H
+
+#include "oatpp/network/ConnectionProvider.hpp"
+#include "oatpp/network/tcp/Connection.hpp"
+#include "oatpp/network/tcp/server/ConnectionProvider.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace ecocin::infra::net {
+
+// Provedor de conexões TCP para servidor que abre o socket de escuta com SO_REUSEPORT.
+// Vários provedores (um por acceptor) podem escutar na mesma porta; o kernel
+// distribui as conexões novas entre eles, então o accept deixa de ser um gargalo de uma thread só.
+// O restante do comportamento (accept com timeout para permitir stop(), conexões tcp::Connection
+// do oatpp) segue o oatpp::network::tcp::server::ConnectionProvider padrão, no modo de conexões
+// estendidas: cada conexão leva as propriedades peer_address, peer_address_format e peer_port.
+class ReusePortConnectionProvider : public oatpp::network::ServerConnectionProvider {
+private:
+    // Encerra a conexão quando o oatpp a invalida (mesma estratégia do provedor padrão)
+    class ConnectionInvalidator : public oatpp::provider::Invalidator<oatpp::data::stream::IOStream> {
+    public:
+        void invalidate(const std::shared_ptr<oatpp::data::stream::IOStream>& connection) override;
+    };
+
+    std::shared_ptr<ConnectionInvalidator> invalidator_;
+    std::atomic<bool> closed_{false};
+    oatpp::v_io_handle serverHandle_;
+
+    // get() em andamento: stop() só fecha o descritor depois que todos saíram, senão o número
+    // poderia ser reaproveitado por outro open() e um poll/accept atrasado cairia nele
+    std::mutex getMutex_;
+    std::condition_variable getDone_;
+    std::size_t inGet_{0};
+
+    static oatpp::v_io_handle openListeningSocket(const std::string& host, unsigned short port);
+
+public:
+    ReusePortConnectionProvider(const std::string& host, unsigned short port);
+    ~ReusePortConnectionProvider() override;
+
+    static std::shared_ptr<ReusePortConnectionProvider> createShared(const std::string& host, unsigned short port) {
+        return std::make_shared<ReusePortConnectionProvider>(host, port);
+    }
+
+    // Indica se a plataforma oferece SO_REUSEPORT (Linux, BSD, macOS)
+    static bool isSupported();
+
+    // Acorda os get() bloqueados, espera que saiam e só então fecha o socket de escuta
+    void stop() override;
+
+    // Bloqueia até uma nova conexão chegar (ou o provedor ser parado)
+    oatpp::provider::ResourceHandle<oatpp::data::stream::IOStream> get() override;
+
+    // Servidores assíncronos do oatpp também usam get() para aceitar conexões
+    oatpp::async::CoroutineStarterForResult<const oatpp::provider::ResourceHandle<oatpp::data::stream::IOStream>&> getAsync() override;
+};
+
+} // namespace ecocin::infra::net
+
+#endif // ECOCIN_INFRA_NET_REUSEPORTCONNECTIONPROVIDER_H
@@ -0,0 +1,127 @@
+#ifndef ECOCIN_INFRA_REPOSITORIES_MEMORY_CONCURRENTMAP_H
+#define ECOCIN_INFRA_REPOSITORIES_MEMORY_CONCURRENTMAP_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <unordered_map>
+#include <utility>
+
+namespace ecocin::infra::repositories::memory {
+
+// Mapa de hash dividido em kStripes partes, cada uma com o seu std::shared_mutex.
+// Leituras de chaves diferentes não disputam nada além do lock compartilhado da sua parte, e uma
+// escrita só bloqueia a parte da chave que muda (1/64 do mapa), em vez do mapa inteiro.
+// As operações valem por chave; forEach percorre as partes uma de cada vez (não é um retrato
+// instantâneo do mapa inteiro).
+template <class K, class V, class Hash = std::hash<K>>
+class ConcurrentMap {
+public:
+    static constexpr std::size_t kStripes = 64;
+
+    std::optional<V> find(const K& key) const {
+        const auto& s = stripeFor(key);
+        std::shared_lock<std::shared_mutex> lock(s.mu);
+        auto it = s.map.find(key);
+        if (it == s.map.end()) return std::nullopt;
+        return it->second;
+    }
+
+    bool contains(const K& key) const {
+        const auto& s = stripeFor(key);
+        std::shared_lock<std::shared_mutex> lock(s.mu);
+        return s.map.find(key) != s.map.end();
+    }
+
+    void insertOrAssign(const K& key, V value) {
+        auto& s = stripeFor(key);
+        std::unique_lock<std::shared_mutex> lock(s.mu);
+        s.map.insert_or_assign(key, std::move(value));
+    }
+
+    bool erase(const K& key) {
+        auto& s = stripeFor(key);
+        std::unique_lock<std::shared_mutex> lock(s.mu);
+        return s.map.erase(key) > 0;
+    }
+
+    // Altera o valor no lugar com fn(V&) sob o lock exclusivo da parte; false se a chave não existe
+    template <class F>
+    bool modify(const K& key, F fn) {
+        auto& s = stripeFor(key);
+        std::unique_lock<std::shared_mutex> lock(s.mu);
+        auto it = s.map.find(key);
+        if (it == s.map.end()) return false;
+        fn(it->second);
+        return true;
+    }
+
+    // Como modify, mas cria o valor (V{}) se a chave não existe
+    template <class F>
+    void upsert(const K& key, F fn) {
+        auto& s = stripeFor(key);
+        std::unique_lock<std::shared_mutex> lock(s.mu);
+        fn(s.map[key]);
+    }
+
+    // Remove a chave se pred(V&) devolver true (ex.: a lista do índice ficou vazia)
+    template <class Pred>
+    void eraseIf(const K& key, Pred pred) {
+        auto& s = stripeFor(key);
+        std::unique_lock<std::shared_mutex> lock(s.mu);
+        auto it = s.map.find(key);
+        if (it != s.map.end() && pred(it->second)) s.map.erase(it);
+    }
+
+    // Chama fn(const K&, const V&) para cada par, parte por parte, sob o lock compartilhado da parte
+    template <class F>
+    void forEach(F fn) const {
+        for (const auto& s : stripes_) {
+            std::shared_lock<std::shared_mutex> lock(s.mu);
+            for (const auto& [k, v] : s.map) fn(k, v);
+        }
+    }
+
+    std::size_t size() const {
+        std::size_t n = 0;
+        for (const auto& s : stripes_) {
+            std::shared_lock<std::shared_mutex> lock(s.mu);
+            n += s.map.size();
+        }
+        return n;
+    }
+
+    void clear() {
+        for (auto& s : stripes_) {
+            std::unique_lock<std::shared_mutex> lock(s.mu);
+            s.map.clear();
+        }
+    }
+
+private:
+    // Cada parte numa linha de cache própria: locks de partes vizinhas não disputam a mesma linha
+    struct alignas(64) Stripe {
+        mutable std::shared_mutex mu;
+        std::unordered_map<K, V, Hash> map;
+    };
+    std::array<Stripe, kStripes> stripes_;
+
+    // std::hash de inteiros é a identidade: embaralha antes de escolher a parte, para ids
+    // sequenciais se espalharem pelas partes sem padrão
+    static std::size_t stripeIndex(std::size_t h) {
+        std::uint64_t x = h;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+        return static_cast<std::size_t>((x ^ (x >> 31)) % kStripes);
+    }
+    Stripe& stripeFor(const K& key) { return stripes_[stripeIndex(Hash{}(key))]; }
+    const Stripe& stripeFor(const K& key) const { return stripes_[stripeIndex(Hash{}(key))]; }
+};
+
+} // namespace ecocin::infra::repositories::memory
+
+#endif // ECOCIN_INFRA_REPOSITORIES_MEMORY_CONCURRENTMAP_H
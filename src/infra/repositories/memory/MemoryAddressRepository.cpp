@@ -0,0 +1,104 @@
+#include "MemoryAddressRepository.h"
+#include "MemoryHelpers.h"
+#include "../../metrics/Metrics.h"
+
+namespace ecocin::infra::repositories::memory {
+
+// client_id precisa existir (chave estrangeira), como no SQLite
+Address MemoryAddressRepository::create(const Address& in) {
+    static auto& metric = ecocin::infra::metrics::dbOp("addresses", "create");
+    ecocin::infra::metrics::DbOpTimer timer{metric};
+    std::lock_guard<std::mutex> lock(store_.writeMutex);
+    if (!store_.clients.contains(in.getClientId())) MemoryStore::fail("insert address", "FOREIGN KEY constraint failed");
+
+    Address a = in;
+    a.setId(store_.nextAddressId++);
+    a.setCreateDate(MemoryStore::now());
+    a.clearDirty();
+    store_.addresses.insertOrAssign(a.getId(), a);
+    MemoryStore::addToIndex(store_.addressIdsByClient, a.getClientId(), a.getId());
+    return a;
+}
+
+std::optional<Address> MemoryAddressRepository::findById(long long id) {
+    static auto& metric = ecocin::infra::metrics::dbOp("addresses", "findById");
+    ecocin::infra::metrics::DbOpTimer timer{metric};
+    return store_.addresses.find(id);
+}
+
+std::vector<Address> MemoryAddressRepository::findByIds(const std::vector<long long>& ids) {
+    static auto& metric = ecocin::infra::metrics::dbOp("addresses", "findByIds");
+    ecocin::infra::metrics::DbOpTimer timer{metric};
+    return rows_by_ids(store_.addresses, ids);
+}
+
+template <class Vec>
+Vec MemoryAddressRepository::listAllInto(Vec out) {
+    static auto& metric = ecocin::infra::metrics::dbOp("addresses", "listAll");
+    ecocin::infra::metrics::DbOpTimer timer{metric};
+    return rows_by_id_desc(store_.addresses, std::move(out));
+}
+
+std::vector<Address> MemoryAddressRepository::listAll() {
+    return listAllInto(std::vector<Address>{});
+}
+
+std::pmr::vector<Address> MemoryAddressRepository::listAll(std::pmr::memory_resource* mr) {
+    return listAllInto(std::pmr::vector<Address>(mr));
+}
+
+// Nenhuma das colunas graváveis é única ou estrangeira: basta o lock da linha
+bool MemoryAddressRepository::update(const Address& addr) {
+    static auto& metric = ecocin::infra::metrics::dbOp("addresses", "update");
+    ecocin::infra::metrics::DbOpTimer timer{metric};
+    const std::uint32_t mask = addr.dirtyFields();
+    return store_.addresses.modify(addr.getId(), [&](Address& row) {
+        if (mask & Address::kStreet)      row.setStreet(addr.getStreet());
+        if (mask & Address::kNumber)      row.setNumber(addr.getNumber());
+        if (mask & Address::kCity)        row.setCity(addr.getCity());
+        if (mask & Address::kState)       row.setState(addr.getState());
+        if (mask & Address::kZip)         row.setZip(addr.getZip());
+        if (mask & Address::kAddressType) row.setAddressType(addr.getAddressType());
+        row.clearDirty();
+    });
+}
+
+// Endereço usado como entrega de algum pedido não sai (chave estrangeira)
+bool MemoryAddressRepository::remove(long long id) {
+    static auto& metric = ecocin::infra::metrics::dbOp("addresses", "remove");
+    ecocin::infra::metrics::DbOpTimer timer{metric};
+    std::lock_guard<std::mutex> lock(store_.writeMutex);
+    auto current = store_.addresses.find(id);
+    if (!current) return false;
+    if (store_.ordersByAddress.count(id)) MemoryStore::fail("delete address", "FOREIGN KEY constraint failed");
+    store_.addresses.erase(id);
+    MemoryStore::removeFromIndex(store_.addressIdsByClient, current->getClientId(), id);
+    return true;
+}
+
+template <class Vec>
+Vec MemoryAddressRepository::listByClientIdInto(long long clientId, Vec out) {
+    static auto& metric = ecocin::infra::metrics::dbOp("addresses", "listByClientId");
+    ecocin::infra::metrics::DbOpTimer timer{metric};
+    return rows_of_client(store_.addresses, store_.addressIdsByClient, clientId, std::move(out));
+}
+
+std::vector<Address> MemoryAddressRepository::listByClientId(long long clientId) {
+    return listByClientIdInto(clientId, std::vector<Address>{});
+}
+
+std::pmr::vector<Address> MemoryAddressRepository::listByClientId(long long clientId, std::pmr::memory_resource* mr) {
+    return listByClientIdInto(clientId, std::pmr::vector<Address>(mr));
+}
+
+// Mais recente do tipo (create_date DESC, id DESC)
+std::optional<Address> MemoryAddressRepository::findByClientIdAndType(long long clientId, const std::string& type) {
+    static auto& metric = ecocin::infra::metrics::dbOp("addresses", "findByClientIdAndType");
+    ecocin::infra::metrics::DbOpTimer timer{metric};
+    for (auto& a : rows_of_client(store_.addresses, store_.addressIdsByClient, clientId, std::vector<Address>{})) {
+        if (a.getAddressType() == type) return std::move(a);
+    }
+    return std::nullopt;
+}
+
+} // namespace ecocin::infra::repositories::memory
@@ -0,0 +1,34 @@
+#ifndef ECOCIN_INFRA_REPOSITORIES_MEMORY_MEMORYADDRESSREPOSITORY_H
+#define ECOCIN_INFRA_REPOSITORIES_MEMORY_MEMORYADDRESSREPOSITORY_H
+
+#include "MemoryStore.h"
+#include "domain/repositories/IAddressRepository.h"
+
+namespace ecocin::infra::repositories::memory {
+
+// Repositório de endereços sobre o MemoryStore (índice por client_id)
+class MemoryAddressRepository : public ecocin::domain::repositories::IAddressRepository {
+private:
+    MemoryStore& store_;
+
+    template <class Vec> Vec listAllInto(Vec out);
+    template <class Vec> Vec listByClientIdInto(long long clientId, Vec out);
+
+public:
+    explicit MemoryAddressRepository(MemoryStore& store) : store_(store) {}
+
+    Address create(const Address& in) override;
+    std::optional<Address> findById(long long id) override;
+    std::vector<Address> findByIds(const std::vector<long long>& ids) override;
+    std::vector<Address> listAll() override;
+    std::pmr::vector<Address> listAll(std::pmr::memory_resource* mr) override;
+    bool update(const Address& addr) override;
+    bool remove(long long id) override;
+    std::vector<Address> listByClientId(long long clientId) override;
+    std::pmr::vector<Address> listByClientId(long long clientId, std::pmr::memory_resource* mr) override;
+    std::optional<Address> findByClientIdAndType(long long clientId, const std::string& type) override;
+};
+
+} // namespace ecocin::infra::repositories::memory
+
+#endif // ECOCIN_INFRA_REPOSITORIES_MEMORY_MEMORYADDRESSREPOSITORY_H
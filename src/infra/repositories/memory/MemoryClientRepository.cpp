@@ -0,0 +1,117 @@
+#include "MemoryClientRepository.h"
+#include "MemoryHelpers.h"
+#include "../../metrics/Metrics.h"
+
+namespace ecocin::infra::repositories::memory {
+
+// Mesmas regras do INSERT no SQLite: cpf e email únicos; id do próximo valor da sequência
+Client MemoryClientRepository::create(const Client& in) {
+    static auto& metric = ecocin::infra::metrics::dbOp("clients", "create");
+    ecocin::infra::metrics::DbOpTimer timer{metric};
+    std::lock_guard<std::mutex> lock(store_.writeMutex);
+    if (store_.clientIdByCpf.contains(in.getCpf())) MemoryStore::fail("insert client", "UNIQUE constraint failed: clients.cpf");
+    if (store_.clientIdByEmail.count(in.getEmail())) MemoryStore::fail("insert client", "UNIQUE constraint failed: clients.email");
+
+    Client c = in;
+    c.setId(store_.nextClientId++);
+    c.setCreateDate(MemoryStore::now());
+    c.clearDirty();
+    store_.clients.insertOrAssign(c.getId(), c);
+    store_.clientIdByCpf.insertOrAssign(c.getCpf(), c.getId());
+    store_.clientIdByEmail.emplace(c.getEmail(), c.getId());
+    return c;
+}
+
+std::optional<Client> MemoryClientRepository::findById(long long id) {
+    static auto& metric = ecocin::infra::metrics::dbOp("clients", "findById");
+    ecocin::infra::metrics::DbOpTimer timer{metric};
+    return store_.clients.find(id);
+}
+
+std::optional<Client> MemoryClientRepository::findByCpf(const std::string& cpf) {
+    static auto& metric = ecocin::infra::metrics::dbOp("clients", "findByCpf");
+    ecocin::infra::metrics::DbOpTimer timer{metric};
+    return row_by_key(store_.clients, store_.clientIdByCpf, cpf, [](const Client& c) -> const std::string& { return c.getCpf(); });
+}
+
+std::vector<Client> MemoryClientRepository::findByIds(const std::vector<long long>& ids) {
+    static auto& metric = ecocin::infra::metrics::dbOp("clients", "findByIds");
+    ecocin::infra::metrics::DbOpTimer timer{metric};
+    return rows_by_ids(store_.clients, ids);
+}
+
+std::vector<Client> MemoryClientRepository::findByCpfs(const std::vector<std::string>& cpfs) {
+    static auto& metric = ecocin::infra::metrics::dbOp("clients", "findByCpfs");
+    ecocin::infra::metrics::DbOpTimer timer{metric};
+    std::vector<Client> out;
+    for (const auto& cpf : distinct_keys(cpfs)) {
+        auto c = row_by_key(store_.clients, store_.clientIdByCpf, cpf, [](const Client& c) -> const std::string& { return c.getCpf(); });
+        if (c) out.push_back(std::move(*c));
+    }
+    return out;
+}
+
+template <class Vec>
+Vec MemoryClientRepository::listAllInto(Vec out) {
+    static auto& metric = ecocin::infra::metrics::dbOp("clients", "listAll");
+    ecocin::infra::metrics::DbOpTimer timer{metric};
+    return rows_by_id_desc(store_.clients, std::move(out));
+}
+
+std::vector<Client> MemoryClientRepository::listAll() {
+    return listAllInto(std::vector<Client>{});
+}
+
+std::pmr::vector<Client> MemoryClientRepository::listAll(std::pmr::memory_resource* mr) {
+    return listAllInto(std::pmr::vector<Client>(mr));
+}
+
+// Grava só os campos marcados (Client::dirtyFields), como o UPDATE do SQLite
+bool MemoryClientRepository::update(const Client& c) {
+    static auto& metric = ecocin::infra::metrics::dbOp("clients", "update");
+    ecocin::infra::metrics::DbOpTimer timer{metric};
+    std::lock_guard<std::mutex> lock(store_.writeMutex);
+    auto current = store_.clients.find(c.getId());
+    if (!current) return false;
+
+    const std::uint32_t mask = c.dirtyFields();
+    Client next = *current;
+    if (mask & Client::kName)  next.setName(c.getName());
+    if (mask & Client::kEmail) next.setEmail(c.getEmail());
+    if (mask & Client::kCpf)   next.setCpf(c.getCpf());
+    next.clearDirty();
+
+    const bool cpfChanged = next.getCpf() != current->getCpf();
+    const bool emailChanged = next.getEmail() != current->getEmail();
+    if (cpfChanged && store_.clientIdByCpf.contains(next.getCpf())) MemoryStore::fail("update client", "UNIQUE constraint failed: clients.cpf");
+    if (emailChanged && store_.clientIdByEmail.count(next.getEmail())) MemoryStore::fail("update client", "UNIQUE constraint failed: clients.email");
+
+    store_.clients.insertOrAssign(next.getId(), next);
+    if (cpfChanged) {
+        store_.clientIdByCpf.insertOrAssign(next.getCpf(), next.getId());
+        store_.clientIdByCpf.erase(current->getCpf());
+    }
+    if (emailChanged) {
+        store_.clientIdByEmail.emplace(next.getEmail(), next.getId());
+        store_.clientIdByEmail.erase(current->getEmail());
+    }
+    return true;
+}
+
+// Cliente com endereços ou pedidos não sai (chave estrangeira), como no SQLite
+bool MemoryClientRepository::remove(long long id) {
+    static auto& metric = ecocin::infra::metrics::dbOp("clients", "remove");
+    ecocin::infra::metrics::DbOpTimer timer{metric};
+    std::lock_guard<std::mutex> lock(store_.writeMutex);
+    auto current = store_.clients.find(id);
+    if (!current) return false;
+    if (store_.addressIdsByClient.contains(id) || store_.orderIdsByClient.contains(id)) {
+        MemoryStore::fail("delete client", "FOREIGN KEY constraint failed");
+    }
+    store_.clientIdByCpf.erase(current->getCpf());
+    store_.clientIdByEmail.erase(current->getEmail());
+    store_.clients.erase(id);
+    return true;
+}
+
+} // namespace ecocin::infra::repositories::memory
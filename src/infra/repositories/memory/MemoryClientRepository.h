@@ -0,0 +1,32 @@
+#ifndef ECOCIN_INFRA_REPOSITORIES_MEMORY_MEMORYCLIENTREPOSITORY_H
+#define ECOCIN_INFRA_REPOSITORIES_MEMORY_MEMORYCLIENTREPOSITORY_H
+
+#include "MemoryStore.h"
+#include "domain/repositories/IClientRepository.h"
+
+namespace ecocin::infra::repositories::memory {
+
+// Repositório de clientes sobre o MemoryStore (índices por cpf e, para os escritores, por email)
+class MemoryClientRepository : public ecocin::domain::repositories::IClientRepository {
+private:
+    MemoryStore& store_;
+
+    template <class Vec> Vec listAllInto(Vec out);
+
+public:
+    explicit MemoryClientRepository(MemoryStore& store) : store_(store) {}
+
+    Client create(const Client& in) override;
+    std::optional<Client> findById(long long id) override;
+    std::optional<Client> findByCpf(const std::string& cpf) override;
+    std::vector<Client> findByIds(const std::vector<long long>& ids) override;
+    std::vector<Client> findByCpfs(const std::vector<std::string>& cpfs) override;
+    std::vector<Client> listAll() override;
+    std::pmr::vector<Client> listAll(std::pmr::memory_resource* mr) override;
+    bool update(const Client& c) override;
+    bool remove(long long id) override;
+};
+
+} // namespace ecocin::infra::repositories::memory
+
+#endif // ECOCIN_INFRA_REPOSITORIES_MEMORY_MEMORYCLIENTREPOSITORY_H
@@ -0,0 +1,65 @@
+#ifndef ECOCIN_INFRA_REPOSITORIES_MEMORY_MEMORYHELPERS_H
+#define ECOCIN_INFRA_REPOSITORIES_MEMORY_MEMORYHELPERS_H
+
+#include "ConcurrentMap.h"
+#include "infra/repositories/sqlite/Helpers.h"
+
+#include <algorithm>
+#include <optional>
+#include <vector>
+
+namespace ecocin::infra::repositories::memory {
+
+// listAll: todas as linhas em out, por id decrescente (como o ORDER BY id DESC do SQLite)
+template <class Vec, class T>
+Vec rows_by_id_desc(const ConcurrentMap<long long, T>& table, Vec out) {
+    out.reserve(table.size());
+    table.forEach([&](long long, const T& row) { out.push_back(row); });
+    std::sort(out.begin(), out.end(), [](const T& a, const T& b) { return a.getId() > b.getId(); });
+    return out;
+}
+
+// listByClientId: as linhas do cliente pelo índice, por create_date DESC, id DESC
+template <class Vec, class T>
+Vec rows_of_client(const ConcurrentMap<long long, T>& table,
+                   const ConcurrentMap<long long, std::vector<long long>>& index, long long clientId, Vec out) {
+    const auto ids = index.find(clientId);
+    if (!ids) return out;
+    out.reserve(ids->size());
+    for (const long long id : *ids) {
+        // Removida entre a leitura do índice e a da linha: fica de fora
+        if (auto row = table.find(id); row && row->getClientId() == clientId) out.push_back(std::move(*row));
+    }
+    std::sort(out.begin(), out.end(), [](const T& a, const T& b) {
+        if (a.getCreateDate() != b.getCreateDate()) return a.getCreateDate() > b.getCreateDate();
+        return a.getId() > b.getId();
+    });
+    return out;
+}
+
+// findByIds: na ordem pedida, sem repetidos; os que não existem ficam de fora
+template <class T>
+std::vector<T> rows_by_ids(const ConcurrentMap<long long, T>& table, const std::vector<long long>& ids) {
+    std::vector<T> out;
+    const auto keys = distinct_keys(ids);
+    out.reserve(keys.size());
+    for (const long long id : keys) {
+        if (auto row = table.find(id)) out.push_back(std::move(*row));
+    }
+    return out;
+}
+
+// findByCpf/findBySku: pelo índice, conferindo a chave na linha (pode ter mudado entre as duas leituras)
+template <class T, class KeyOf>
+std::optional<T> row_by_key(const ConcurrentMap<long long, T>& table, const ConcurrentMap<std::string, long long>& index,
+                            const std::string& key, KeyOf keyOf) {
+    const auto id = index.find(key);
+    if (!id) return std::nullopt;
+    auto row = table.find(*id);
+    if (!row || keyOf(*row) != key) return std::nullopt;
+    return row;
+}
+
+} // namespace ecocin::infra::repositories::memory
+
+#endif // ECOCIN_INFRA_REPOSITORIES_MEMORY_MEMORYHELPERS_H
@@ -0,0 +1,161 @@
+#include "MemoryOrderRepository.h"
+#include "MemoryHelpers.h"
+#include "../../metrics/Metrics.h"
+
+namespace ecocin::infra::repositories::memory {
+
+namespace {
+
+void addRef(std::unordered_map<long long, std::size_t>& refs, long long id) { ++refs[id]; }
+
+void dropRef(std::unordered_map<long long, std::size_t>& refs, long long id) {
+    auto it = refs.find(id);
+    if (it != refs.end() && --it->second == 0) refs.erase(it);
+}
+
+// CHECK e chaves estrangeiras de orders (app/Migrations.h), na ordem em que o SQLite as confere
+void checkRow(MemoryStore& store, const Order& o, const char* where) {
+    if (o.getQuantity() <= 0) MemoryStore::fail(where, "CHECK constraint failed: quantity > 0");
+    if (o.getUnitPrice() < 0.0) MemoryStore::fail(where, "CHECK constraint failed: unit_price >= 0.0");
+    if (o.getTotalPrice() < 0.0) MemoryStore::fail(where, "CHECK constraint failed: total_price >= 0.0");
+    if (!store.clients.contains(o.getClientId()) || !store.products.contains(o.getProductId()) ||
+        !store.addresses.contains(o.getShippingAddressId())) {
+        MemoryStore::fail(where, "FOREIGN KEY constraint failed");
+    }
+}
+
+} // namespace
+
+Order MemoryOrderRepository::create(const Order& in) {
+    static auto& metric = ecocin::infra::metrics::dbOp("orders", "create");
+    ecocin::infra::metrics::DbOpTimer timer{metric};
+    Order o = in;
+    o.calculateTotal();
+    std::lock_guard<std::mutex> lock(store_.writeMutex);
+    checkRow(store_, o, "insert order");
+
+    o.setId(store_.nextOrderId++);
+    o.setCreateDate(MemoryStore::now());
+    o.clearDirty();
+    store_.orders.insertOrAssign(o.getId(), o);
+    MemoryStore::addToIndex(store_.orderIdsByClient, o.getClientId(), o.getId());
+    addRef(store_.ordersByProduct, o.getProductId());
+    addRef(store_.ordersByAddress, o.getShippingAddressId());
+    return o;
+}
+
+std::optional<Order> MemoryOrderRepository::findById(long long id) {
+    static auto& metric = ecocin::infra::metrics::dbOp("orders", "findById");
+    ecocin::infra::metrics::DbOpTimer timer{metric};
+    return store_.orders.find(id);
+}
+
+template <class Vec>
+Vec MemoryOrderRepository::listAllInto(Vec out) {
+    static auto& metric = ecocin::infra::metrics::dbOp("orders", "listAll");
+    ecocin::infra::metrics::DbOpTimer timer{metric};
+    return rows_by_id_desc(store_.orders, std::move(out));
+}
+
+std::vector<Order> MemoryOrderRepository::listAll() {
+    return listAllInto(std::vector<Order>{});
+}
+
+std::pmr::vector<Order> MemoryOrderRepository::listAll(std::pmr::memory_resource* mr) {
+    return listAllInto(std::pmr::vector<Order>(mr));
+}
+
+// Só os campos marcados; trocar cliente, produto ou endereço confere a chave estrangeira e move os índices
+bool MemoryOrderRepository::update(const Order& oIn) {
+    static auto& metric = ecocin::infra::metrics::dbOp("orders", "update");
+    ecocin::infra::metrics::DbOpTimer timer{metric};
+    std::lock_guard<std::mutex> lock(store_.writeMutex);
+    auto current = store_.orders.find(oIn.getId());
+    if (!current) return false;
+
+    const std::uint32_t mask = oIn.dirtyFields();
+    if (mask == 0) return true;
+    Order next = *current;
+    if (mask & Order::kClientId)          next.setClientId(oIn.getClientId());
+    if (mask & Order::kProductId)         next.setProductId(oIn.getProductId());
+    if (mask & Order::kShippingAddressId) next.setShippingAddressId(oIn.getShippingAddressId());
+    if (mask & Order::kQuantity)          next.setQuantity(oIn.getQuantity());
+    if (mask & Order::kUnitPrice)         next.setUnitPrice(oIn.getUnitPrice());
+    if (mask & Order::kStatus)            next.setStatus(oIn.getStatus());
+    next.calculateTotal();
+    next.clearDirty();
+    checkRow(store_, next, "update order");
+
+    // O status pode ter mudado por updateStatus desde a leitura acima: sem kStatus, fica o da linha
+    store_.orders.modify(next.getId(), [&](Order& row) {
+        const std::string status = (mask & Order::kStatus) ? next.getStatus() : row.getStatus();
+        row = next;
+        row.setStatus(status);
+        row.clearDirty();
+    });
+    if (next.getClientId() != current->getClientId()) {
+        MemoryStore::removeFromIndex(store_.orderIdsByClient, current->getClientId(), next.getId());
+        MemoryStore::addToIndex(store_.orderIdsByClient, next.getClientId(), next.getId());
+    }
+    dropRef(store_.ordersByProduct, current->getProductId());
+    addRef(store_.ordersByProduct, next.getProductId());
+    dropRef(store_.ordersByAddress, current->getShippingAddressId());
+    addRef(store_.ordersByAddress, next.getShippingAddressId());
+    return true;
+}
+
+bool MemoryOrderRepository::remove(long long id) {
+    static auto& metric = ecocin::infra::metrics::dbOp("orders", "remove");
+    ecocin::infra::metrics::DbOpTimer timer{metric};
+    std::lock_guard<std::mutex> lock(store_.writeMutex);
+    auto current = store_.orders.find(id);
+    if (!current) return false;
+    store_.orders.erase(id);
+    MemoryStore::removeFromIndex(store_.orderIdsByClient, current->getClientId(), id);
+    dropRef(store_.ordersByProduct, current->getProductId());
+    dropRef(store_.ordersByAddress, current->getShippingAddressId());
+    return true;
+}
+
+template <class Vec>
+Vec MemoryOrderRepository::listByClientIdInto(long long clientId, Vec out) {
+    static auto& metric = ecocin::infra::metrics::dbOp("orders", "listByClientId");
+    ecocin::infra::metrics::DbOpTimer timer{metric};
+    return rows_of_client(store_.orders, store_.orderIdsByClient, clientId, std::move(out));
+}
+
+std::vector<Order> MemoryOrderRepository::listByClientId(long long clientId) {
+    return listByClientIdInto(clientId, std::vector<Order>{});
+}
+
+std::pmr::vector<Order> MemoryOrderRepository::listByClientId(long long clientId, std::pmr::memory_resource* mr) {
+    return listByClientIdInto(clientId, std::pmr::vector<Order>(mr));
+}
+
+// status não é único nem estrangeiro: só o lock da linha
+bool MemoryOrderRepository::updateStatus(long long id, const std::string& newStatus) {
+    static auto& metric = ecocin::infra::metrics::dbOp("orders", "updateStatus");
+    ecocin::infra::metrics::DbOpTimer timer{metric};
+    return store_.orders.modify(id, [&](Order& row) {
+        row.setStatus(newStatus);
+        row.clearDirty();
+    });
+}
+
+bool MemoryOrderRepository::updateShippingAddress(long long id, long long newAddressId) {
+    static auto& metric = ecocin::infra::metrics::dbOp("orders", "updateShippingAddress");
+    ecocin::infra::metrics::DbOpTimer timer{metric};
+    std::lock_guard<std::mutex> lock(store_.writeMutex);
+    auto current = store_.orders.find(id);
+    if (!current) return false;
+    if (!store_.addresses.contains(newAddressId)) MemoryStore::fail("update order address", "FOREIGN KEY constraint failed");
+    store_.orders.modify(id, [&](Order& row) {
+        row.setShippingAddressId(newAddressId);
+        row.clearDirty();
+    });
+    dropRef(store_.ordersByAddress, current->getShippingAddressId());
+    addRef(store_.ordersByAddress, newAddressId);
+    return true;
+}
+
+} // namespace ecocin::infra::repositories::memory
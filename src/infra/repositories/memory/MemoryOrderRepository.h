@@ -0,0 +1,35 @@
+#ifndef ECOCIN_INFRA_REPOSITORIES_MEMORY_MEMORYORDERREPOSITORY_H
+#define ECOCIN_INFRA_REPOSITORIES_MEMORY_MEMORYORDERREPOSITORY_H
+
+#include "MemoryStore.h"
+#include "domain/repositories/IOrderRepository.h"
+
+namespace ecocin::infra::repositories::memory {
+
+// Repositório de pedidos sobre o MemoryStore (índice por client_id)
+class MemoryOrderRepository : public ecocin::domain::repositories::IOrderRepository {
+private:
+    MemoryStore& store_;
+
+    template <class Vec> Vec listAllInto(Vec out);
+    template <class Vec> Vec listByClientIdInto(long long clientId, Vec out);
+
+public:
+    explicit MemoryOrderRepository(MemoryStore& store) : store_(store) {}
+
+    Order create(const Order& in) override;
+    std::optional<Order> findById(long long id) override;
+    std::vector<Order> listAll() override;
+    std::pmr::vector<Order> listAll(std::pmr::memory_resource* mr) override;
+    bool update(const Order& o) override;
+    bool remove(long long id) override;
+
+    std::vector<Order> listByClientId(long long clientId) override;
+    std::pmr::vector<Order> listByClientId(long long clientId, std::pmr::memory_resource* mr) override;
+    bool updateStatus(long long id, const std::string& newStatus) override;
+    bool updateShippingAddress(long long id, long long newAddressId) override;
+};
+
+} // namespace ecocin::infra::repositories::memory
+
+#endif // ECOCIN_INFRA_REPOSITORIES_MEMORY_MEMORYORDERREPOSITORY_H
@@ -0,0 +1,149 @@
+#include "MemoryProductRepository.h"
+#include "MemoryHelpers.h"
+#include "../../metrics/Metrics.h"
+
+#include <climits>
+
+namespace ecocin::infra::repositories::memory {
+
+namespace {
+
+std::optional<Product> findBySkuIn(MemoryStore& store, const std::string& sku) {
+    return row_by_key(store.products, store.productIdBySku, sku, [](const Product& p) { return p.getSku().str(); });
+}
+
+} // namespace
+
+Product MemoryProductRepository::create(const Product& in) {
+    static auto& metric = ecocin::infra::metrics::dbOp("products", "create");
+    ecocin::infra::metrics::DbOpTimer timer{metric};
+    const std::string sku = in.getSku().str();
+    std::lock_guard<std::mutex> lock(store_.writeMutex);
+    if (store_.productIdBySku.contains(sku)) MemoryStore::fail("insert product", "UNIQUE constraint failed: products.sku");
+
+    Product p = in;
+    p.setId(store_.nextProductId++);
+    p.setCreateDate(MemoryStore::now());
+    p.clearDirty();
+    store_.products.insertOrAssign(p.getId(), p);
+    store_.productIdBySku.insertOrAssign(sku, p.getId());
+    return p;
+}
+
+std::optional<Product> MemoryProductRepository::findById(long long id) {
+    static auto& metric = ecocin::infra::metrics::dbOp("products", "findById");
+    ecocin::infra::metrics::DbOpTimer timer{metric};
+    return store_.products.find(id);
+}
+
+std::optional<Product> MemoryProductRepository::findBySku(const std::string& sku) {
+    static auto& metric = ecocin::infra::metrics::dbOp("products", "findBySku");
+    ecocin::infra::metrics::DbOpTimer timer{metric};
+    return findBySkuIn(store_, sku);
+}
+
+std::vector<Product> MemoryProductRepository::findByIds(const std::vector<long long>& ids) {
+    static auto& metric = ecocin::infra::metrics::dbOp("products", "findByIds");
+    ecocin::infra::metrics::DbOpTimer timer{metric};
+    return rows_by_ids(store_.products, ids);
+}
+
+std::vector<Product> MemoryProductRepository::findBySkus(const std::vector<std::string>& skus) {
+    static auto& metric = ecocin::infra::metrics::dbOp("products", "findBySkus");
+    ecocin::infra::metrics::DbOpTimer timer{metric};
+    std::vector<Product> out;
+    for (const auto& sku : distinct_keys(skus)) {
+        if (auto p = findBySkuIn(store_, sku)) out.push_back(std::move(*p));
+    }
+    return out;
+}
+
+template <class Vec>
+Vec MemoryProductRepository::listAllInto(Vec out) {
+    static auto& metric = ecocin::infra::metrics::dbOp("products", "listAll");
+    ecocin::infra::metrics::DbOpTimer timer{metric};
+    return rows_by_id_desc(store_.products, std::move(out));
+}
+
+std::vector<Product> MemoryProductRepository::listAll() {
+    return listAllInto(std::vector<Product>{});
+}
+
+std::pmr::vector<Product> MemoryProductRepository::listAll(std::pmr::memory_resource* mr) {
+    return listAllInto(std::pmr::vector<Product>(mr));
+}
+
+// Só os campos marcados, aplicados na linha guardada: um adjustStock concorrente não é desfeito
+// por um update que não mexeu no estoque
+bool MemoryProductRepository::update(const Product& p) {
+    static auto& metric = ecocin::infra::metrics::dbOp("products", "update");
+    ecocin::infra::metrics::DbOpTimer timer{metric};
+    std::lock_guard<std::mutex> lock(store_.writeMutex);
+    auto current = store_.products.find(p.getId());
+    if (!current) return false;
+
+    const std::uint32_t mask = p.dirtyFields();
+    const std::string oldSku = current->getSku().str();
+    const std::string newSku = (mask & Product::kSku) ? p.getSku().str() : oldSku;
+    const bool skuChanged = newSku != oldSku;
+    if (skuChanged && store_.productIdBySku.contains(newSku)) MemoryStore::fail("update product", "UNIQUE constraint failed: products.sku");
+
+    store_.products.modify(p.getId(), [&](Product& row) {
+        if (mask & Product::kName)          row.setName(p.getName());
+        if (mask & Product::kDescription)   row.setDescription(p.getDescription());
+        if (mask & Product::kSku)           row.setSku(p.getSku());
+        if (mask & Product::kPrice)         row.setPrice(p.getPrice());
+        if (mask & Product::kStockQuantity) row.setStockQuantity(p.getStockQuantity());
+        if (mask & Product::kIsActive)      row.setIsActive(p.getIsActive());
+        row.clearDirty();
+    });
+    if (skuChanged) {
+        store_.productIdBySku.insertOrAssign(newSku, p.getId());
+        store_.productIdBySku.erase(oldSku);
+    }
+    return true;
+}
+
+// Soma e confere o limite sob o lock da linha: duas chamadas concorrentes nunca perdem uma à outra
+std::optional<ecocin::domain::repositories::ProductFieldUpdate<int>>
+MemoryProductRepository::adjustStock(long long id, int delta) {
+    static auto& metric = ecocin::infra::metrics::dbOp("products", "adjustStock");
+    ecocin::infra::metrics::DbOpTimer timer{metric};
+    std::optional<ecocin::domain::repositories::ProductFieldUpdate<int>> out;
+    store_.products.modify(id, [&](Product& row) {
+        const long long next = static_cast<long long>(row.getStockQuantity()) + delta;
+        if (next < 0 || next > INT_MAX) return;
+        row.setStockQuantity(static_cast<int>(next));
+        row.clearDirty();
+        out.emplace(ecocin::domain::repositories::ProductFieldUpdate<int>{static_cast<int>(next), row.getSku().str()});
+    });
+    return out;
+}
+
+std::optional<ecocin::domain::repositories::ProductFieldUpdate<double>>
+MemoryProductRepository::updatePrice(long long id, double price) {
+    static auto& metric = ecocin::infra::metrics::dbOp("products", "updatePrice");
+    ecocin::infra::metrics::DbOpTimer timer{metric};
+    std::optional<ecocin::domain::repositories::ProductFieldUpdate<double>> out;
+    store_.products.modify(id, [&](Product& row) {
+        row.setPrice(price);
+        row.clearDirty();
+        out.emplace(ecocin::domain::repositories::ProductFieldUpdate<double>{price, row.getSku().str()});
+    });
+    return out;
+}
+
+// Produto com pedidos não sai (chave estrangeira de orders.product_id)
+bool MemoryProductRepository::remove(long long id) {
+    static auto& metric = ecocin::infra::metrics::dbOp("products", "remove");
+    ecocin::infra::metrics::DbOpTimer timer{metric};
+    std::lock_guard<std::mutex> lock(store_.writeMutex);
+    auto current = store_.products.find(id);
+    if (!current) return false;
+    if (store_.ordersByProduct.count(id)) MemoryStore::fail("delete product", "FOREIGN KEY constraint failed");
+    store_.productIdBySku.erase(current->getSku().str());
+    store_.products.erase(id);
+    return true;
+}
+
+} // namespace ecocin::infra::repositories::memory
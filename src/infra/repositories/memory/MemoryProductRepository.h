@@ -0,0 +1,35 @@
+#ifndef ECOCIN_INFRA_REPOSITORIES_MEMORY_MEMORYPRODUCTREPOSITORY_H
+#define ECOCIN_INFRA_REPOSITORIES_MEMORY_MEMORYPRODUCTREPOSITORY_H
+
+#include "MemoryStore.h"
+#include "domain/repositories/IProductRepository.h"
+
+namespace ecocin::infra::repositories::memory {
+
+// Repositório de produtos sobre o MemoryStore (índice por sku).
+// adjustStock e updatePrice alteram a linha no lugar, sem o lock dos escritores.
+class MemoryProductRepository : public ecocin::domain::repositories::IProductRepository {
+private:
+    MemoryStore& store_;
+
+    template <class Vec> Vec listAllInto(Vec out);
+
+public:
+    explicit MemoryProductRepository(MemoryStore& store) : store_(store) {}
+
+    Product create(const Product& in) override;
+    std::optional<Product> findById(long long id) override;
+    std::optional<Product> findBySku(const std::string& sku) override;
+    std::vector<Product> findByIds(const std::vector<long long>& ids) override;
+    std::vector<Product> findBySkus(const std::vector<std::string>& skus) override;
+    std::vector<Product> listAll() override;
+    std::pmr::vector<Product> listAll(std::pmr::memory_resource* mr) override;
+    bool update(const Product& p) override;
+    std::optional<ecocin::domain::repositories::ProductFieldUpdate<int>> adjustStock(long long id, int delta) override;
+    std::optional<ecocin::domain::repositories::ProductFieldUpdate<double>> updatePrice(long long id, double price) override;
+    bool remove(long long id) override;
+};
+
+} // namespace ecocin::infra::repositories::memory
+
+#endif // ECOCIN_INFRA_REPOSITORIES_MEMORY_MEMORYPRODUCTREPOSITORY_H
@@ -0,0 +1,245 @@
+#include "MemoryStore.h"
+
+#include "app/Migrations.h"
+#include "infra/repositories/sqlite/AddressRepositorySqlite.h"
+#include "infra/repositories/sqlite/ClientRepositorySqlite.h"
+#include "infra/repositories/sqlite/Helpers.h"
+#include "infra/repositories/sqlite/OrderRepositorySqlite.h"
+#include "infra/repositories/sqlite/ProductRepositorySqlite.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <stdexcept>
+
+namespace ecocin::infra::repositories::memory {
+
+namespace {
+
+long long epochSeconds(std::chrono::system_clock::time_point t) {
+    return std::chrono::duration_cast<std::chrono::seconds>(t.time_since_epoch()).count();
+}
+
+// Próximo id de cada tabela: como o AUTOINCREMENT, nunca reaproveita um id já usado
+void readSequences(ecocin::infra::db::SqliteConnection& cx, MemoryStore& store) {
+    ecocin::infra::db::Statement st(cx, "SELECT name, seq FROM sqlite_sequence", "prepare read snapshot sequence");
+    while (sqlite3_step(st) == SQLITE_ROW) {
+        const std::string name = reinterpret_cast<const char*>(sqlite3_column_text(st, 0));
+        const long long next = static_cast<long long>(sqlite3_column_int64(st, 1)) + 1;
+        if (name == "clients") store.nextClientId = std::max(store.nextClientId, next);
+        else if (name == "products") store.nextProductId = std::max(store.nextProductId, next);
+        else if (name == "addresses") store.nextAddressId = std::max(store.nextAddressId, next);
+        else if (name == "orders") store.nextOrderId = std::max(store.nextOrderId, next);
+    }
+}
+
+void writeSequence(ecocin::infra::db::SqliteConnection& cx, const char* table, long long nextId) {
+    ecocin::infra::db::Statement del(cx, "DELETE FROM sqlite_sequence WHERE name = ?", "prepare snapshot sequence");
+    sqlite3_bind_text(del, 1, table, -1, SQLITE_STATIC);
+    sqlite_check(sqlite3_step(del), cx.raw(), "step snapshot sequence");
+    ecocin::infra::db::Statement ins(cx, "INSERT INTO sqlite_sequence(name, seq) VALUES(?, ?)", "prepare snapshot sequence");
+    sqlite3_bind_text(ins, 1, table, -1, SQLITE_STATIC);
+    sqlite3_bind_int64(ins, 2, nextId - 1);
+    sqlite_check(sqlite3_step(ins), cx.raw(), "step snapshot sequence");
+}
+
+template <class T>
+std::vector<T> copyRows(const ConcurrentMap<long long, T>& table) {
+    std::vector<T> rows;
+    rows.reserve(table.size());
+    table.forEach([&](long long, const T& row) { rows.push_back(row); });
+    return rows;
+}
+
+} // namespace
+
+std::chrono::system_clock::time_point MemoryStore::now() {
+    return std::chrono::floor<std::chrono::seconds>(std::chrono::system_clock::now());
+}
+
+void MemoryStore::fail(const char* where, const std::string& what) {
+    throw std::runtime_error(std::string("Memory store error @ ") + where + ": " + what);
+}
+
+void MemoryStore::addToIndex(ConcurrentMap<long long, std::vector<long long>>& index, long long key, long long id) {
+    index.upsert(key, [&](std::vector<long long>& ids) { ids.push_back(id); });
+}
+
+void MemoryStore::removeFromIndex(ConcurrentMap<long long, std::vector<long long>>& index, long long key, long long id) {
+    index.eraseIf(key, [&](std::vector<long long>& ids) {
+        ids.erase(std::remove(ids.begin(), ids.end(), id), ids.end());
+        return ids.empty();
+    });
+}
+
+// Lê as tabelas pelos próprios repositórios SQLite e refaz os índices
+void MemoryStore::load(ecocin::infra::db::SqliteConnection& cx) {
+    std::lock_guard<std::mutex> lock(writeMutex);
+    clients.clear();
+    products.clear();
+    addresses.clear();
+    orders.clear();
+    clientIdByCpf.clear();
+    productIdBySku.clear();
+    addressIdsByClient.clear();
+    orderIdsByClient.clear();
+    clientIdByEmail.clear();
+    ordersByProduct.clear();
+    ordersByAddress.clear();
+    nextClientId = nextProductId = nextAddressId = nextOrderId = 1;
+
+    // listAll vem por id decrescente; os índices por cliente guardam os ids em ordem de inserção
+    auto clientRows = ecocin::infra::repositories::sqlite::ClientRepositorySqlite(cx).listAll();
+    for (auto& c : clientRows) {
+        nextClientId = std::max(nextClientId, c.getId() + 1);
+        clientIdByCpf.insertOrAssign(c.getCpf(), c.getId());
+        clientIdByEmail.emplace(c.getEmail(), c.getId());
+        clients.insertOrAssign(c.getId(), std::move(c));
+    }
+
+    auto productRows = ecocin::infra::repositories::sqlite::ProductRepositorySqlite(cx).listAll();
+    for (auto& p : productRows) {
+        nextProductId = std::max(nextProductId, p.getId() + 1);
+        productIdBySku.insertOrAssign(p.getSku().str(), p.getId());
+        products.insertOrAssign(p.getId(), std::move(p));
+    }
+
+    auto addressRows = ecocin::infra::repositories::sqlite::AddressRepositorySqlite(cx).listAll();
+    for (auto it = addressRows.rbegin(); it != addressRows.rend(); ++it) {
+        nextAddressId = std::max(nextAddressId, it->getId() + 1);
+        addToIndex(addressIdsByClient, it->getClientId(), it->getId());
+        addresses.insertOrAssign(it->getId(), std::move(*it));
+    }
+
+    auto orderRows = ecocin::infra::repositories::sqlite::OrderRepositorySqlite(cx).listAll();
+    for (auto it = orderRows.rbegin(); it != orderRows.rend(); ++it) {
+        nextOrderId = std::max(nextOrderId, it->getId() + 1);
+        addToIndex(orderIdsByClient, it->getClientId(), it->getId());
+        ++ordersByProduct[it->getProductId()];
+        ++ordersByAddress[it->getShippingAddressId()];
+        orders.insertOrAssign(it->getId(), std::move(*it));
+    }
+
+    readSequences(cx, *this);
+}
+
+// As linhas são copiadas com writeMutex travado (nenhum create/remove no meio da cópia) e gravadas
+// depois, sem travar nada. Estoque, preço e status mudam sem writeMutex: cada linha sai coerente,
+// mas pode refletir uma dessas atualizações feitas durante a cópia.
+void MemoryStore::save(ecocin::infra::db::SqliteConnection& cx) {
+    std::vector<Client> clientRows;
+    std::vector<Product> productRows;
+    std::vector<Address> addressRows;
+    std::vector<Order> orderRows;
+    long long seqClients, seqProducts, seqAddresses, seqOrders;
+    {
+        std::lock_guard<std::mutex> lock(writeMutex);
+        clientRows = copyRows(clients);
+        productRows = copyRows(products);
+        addressRows = copyRows(addresses);
+        orderRows = copyRows(orders);
+        seqClients = nextClientId;
+        seqProducts = nextProductId;
+        seqAddresses = nextAddressId;
+        seqOrders = nextOrderId;
+    }
+
+    ecocin::infra::db::Transaction tx(cx);
+    cx.exec("DELETE FROM orders; DELETE FROM addresses; DELETE FROM clients; DELETE FROM products;");
+
+    {
+        ecocin::infra::db::Statement st(cx, "INSERT INTO clients(id,name,email,cpf,create_date) VALUES(?,?,?,?,?)",
+                                        "prepare snapshot client");
+        for (const auto& c : clientRows) {
+            sqlite3_bind_int64(st, 1, c.getId());
+            sqlite3_bind_text(st, 2, c.getName().c_str(), -1, SQLITE_STATIC);
+            sqlite3_bind_text(st, 3, c.getEmail().c_str(), -1, SQLITE_STATIC);
+            sqlite3_bind_text(st, 4, c.getCpf().c_str(), -1, SQLITE_STATIC);
+            sqlite3_bind_int64(st, 5, epochSeconds(c.getCreateDate()));
+            sqlite_check(sqlite3_step(st), cx.raw(), "step snapshot client");
+            sqlite3_reset(st);
+        }
+    }
+    {
+        ecocin::infra::db::Statement st(cx,
+            "INSERT INTO products(id,name,description,sku,price,stock_quantity,is_active,create_date) "
+            "VALUES(?,?,?,?,?,?,?,?)", "prepare snapshot product");
+        for (const auto& p : productRows) {
+            const std::string sku = p.getSku().str();
+            sqlite3_bind_int64(st, 1, p.getId());
+            sqlite3_bind_text(st, 2, p.getName().c_str(), -1, SQLITE_STATIC);
+            sqlite3_bind_text(st, 3, p.getDescription().c_str(), -1, SQLITE_STATIC);
+            sqlite3_bind_text(st, 4, sku.c_str(), -1, SQLITE_STATIC);
+            sqlite3_bind_double(st, 5, p.getPrice());
+            sqlite3_bind_int(st, 6, p.getStockQuantity());
+            sqlite3_bind_int(st, 7, p.getIsActive() ? 1 : 0);
+            sqlite3_bind_int64(st, 8, epochSeconds(p.getCreateDate()));
+            sqlite_check(sqlite3_step(st), cx.raw(), "step snapshot product");
+            sqlite3_reset(st);
+        }
+    }
+    {
+        ecocin::infra::db::Statement st(cx,
+            "INSERT INTO addresses(id,client_id,street,number,city,state,zip,address_type,create_date) "
+            "VALUES(?,?,?,?,?,?,?,?,?)", "prepare snapshot address");
+        for (const auto& a : addressRows) {
+            sqlite3_bind_int64(st, 1, a.getId());
+            sqlite3_bind_int64(st, 2, a.getClientId());
+            sqlite3_bind_text(st, 3, a.getStreet().c_str(), -1, SQLITE_STATIC);
+            sqlite3_bind_text(st, 4, a.getNumber().c_str(), -1, SQLITE_STATIC);
+            sqlite3_bind_text(st, 5, a.getCity().c_str(), -1, SQLITE_STATIC);
+            sqlite3_bind_text(st, 6, a.getState().c_str(), -1, SQLITE_STATIC);
+            sqlite3_bind_text(st, 7, a.getZip().c_str(), -1, SQLITE_STATIC);
+            sqlite3_bind_text(st, 8, a.getAddressType().c_str(), -1, SQLITE_STATIC);
+            sqlite3_bind_int64(st, 9, epochSeconds(a.getCreateDate()));
+            sqlite_check(sqlite3_step(st), cx.raw(), "step snapshot address");
+            sqlite3_reset(st);
+        }
+    }
+    {
+        ecocin::infra::db::Statement st(cx,
+            "INSERT INTO orders(id,client_id,product_id,shipping_address_id,quantity,unit_price,total_price,status,create_date) "
+            "VALUES(?,?,?,?,?,?,?,?,?)", "prepare snapshot order");
+        for (const auto& o : orderRows) {
+            sqlite3_bind_int64(st, 1, o.getId());
+            sqlite3_bind_int64(st, 2, o.getClientId());
+            sqlite3_bind_int64(st, 3, o.getProductId());
+            sqlite3_bind_int64(st, 4, o.getShippingAddressId());
+            sqlite3_bind_int(st, 5, o.getQuantity());
+            sqlite3_bind_double(st, 6, o.getUnitPrice());
+            sqlite3_bind_double(st, 7, o.getTotalPrice());
+            sqlite3_bind_text(st, 8, o.getStatus().c_str(), -1, SQLITE_STATIC);
+            sqlite3_bind_int64(st, 9, epochSeconds(o.getCreateDate()));
+            sqlite_check(sqlite3_step(st), cx.raw(), "step snapshot order");
+            sqlite3_reset(st);
+        }
+    }
+
+    writeSequence(cx, "clients", seqClients);
+    writeSequence(cx, "products", seqProducts);
+    writeSequence(cx, "addresses", seqAddresses);
+    writeSequence(cx, "orders", seqOrders);
+    tx.commit();
+}
+
+bool MemoryStore::loadSnapshot(const std::string& path) {
+    if (!std::filesystem::exists(path)) return false;
+    ecocin::infra::db::SqliteConnection cx(path);
+    ecocin::app::runMigrations(cx.raw());
+    load(cx);
+    return true;
+}
+
+void MemoryStore::saveSnapshot(const std::string& path) {
+    std::lock_guard<std::mutex> lock(snapshotMutex_);
+    const std::string tmp = path + ".tmp";
+    std::remove(tmp.c_str());
+    {
+        ecocin::infra::db::SqliteConnection cx(tmp);
+        ecocin::app::runMigrations(cx.raw());
+        save(cx);
+    }
+    std::filesystem::rename(tmp, path);
+}
+
+} // namespace ecocin::infra::repositories::memory
@@ -0,0 +1,84 @@
+#ifndef ECOCIN_INFRA_REPOSITORIES_MEMORY_MEMORYSTORE_H
+#define ECOCIN_INFRA_REPOSITORIES_MEMORY_MEMORYSTORE_H
+
+#include "ConcurrentMap.h"
+#include "domain/entities/Address.h"
+#include "domain/entities/Client.h"
+#include "domain/entities/Order.h"
+#include "domain/entities/Product.h"
+#include "infra/db/SqliteConnection.h"
+
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ecocin::infra::repositories::memory {
+
+// Banco em memória compartilhado pelos quatro repositórios Memory*Repository: uma instância por
+// processo, usada pelas pilhas de todos os acceptors (thread-safe). Sem E/S de SQLite no caminho
+// das requisições; serve para implantações em que os dados cabem na memória e para benchmarks.
+//
+// Cada tabela é um ConcurrentMap id -> linha, e as consultas por cpf, sku e client_id usam
+// índices secundários do mesmo tipo: leituras não passam por lock global nenhum.
+// As mesmas regras do esquema SQLite (app/Migrations.h) valem aqui, com as mesmas mensagens:
+// cpf, email e sku únicos, chaves estrangeiras (não dá para remover um cliente com endereços ou
+// pedidos, por exemplo) e os CHECK de orders. Para conferir essas regras sem corrida, as escritas
+// que tocam colunas únicas ou chaves estrangeiras passam por writeMutex (um escritor por vez, como
+// no SQLite); as demais (estoque, preço, status, campos de endereço) só travam a parte do mapa
+// que guarda a linha.
+//
+// Persistência opcional por snapshot: saveSnapshot grava tudo num arquivo SQLite com o esquema
+// normal (o mesmo e-cocin.db que os repositórios SQLite abrem) e loadSnapshot o carrega no boot.
+// O que mudou depois do último snapshot se perde se o processo cair.
+struct MemoryStore {
+    ConcurrentMap<long long, Client>  clients;
+    ConcurrentMap<long long, Product> products;
+    ConcurrentMap<long long, Address> addresses;
+    ConcurrentMap<long long, Order>   orders;
+
+    // Índices secundários usados nas leituras. Para listas por cliente, os ids (ordem de inserção)
+    ConcurrentMap<std::string, long long> clientIdByCpf;
+    ConcurrentMap<std::string, long long> productIdBySku;
+    ConcurrentMap<long long, std::vector<long long>> addressIdsByClient;
+    ConcurrentMap<long long, std::vector<long long>> orderIdsByClient;
+
+    // Só os escritores usam o que vem abaixo, sempre com writeMutex travado
+    std::mutex writeMutex;
+    std::unordered_map<std::string, long long> clientIdByEmail;
+    std::unordered_map<long long, std::size_t> ordersByProduct; // pedidos que apontam para o produto
+    std::unordered_map<long long, std::size_t> ordersByAddress; // e para o endereço de entrega
+    long long nextClientId{1};
+    long long nextProductId{1};
+    long long nextAddressId{1};
+    long long nextOrderId{1};
+
+    // create_date com a precisão do esquema (segundos), para listagens e snapshots baterem
+    static std::chrono::system_clock::time_point now();
+
+    // Viola uma regra do esquema: lança std::runtime_error "Memory store error @ where: what"
+    [[noreturn]] static void fail(const char* where, const std::string& what);
+
+    static void addToIndex(ConcurrentMap<long long, std::vector<long long>>& index, long long key, long long id);
+    static void removeFromIndex(ConcurrentMap<long long, std::vector<long long>>& index, long long key, long long id);
+
+    // Troca todo o conteúdo pelo do banco em cx (já migrado)
+    void load(ecocin::infra::db::SqliteConnection& cx);
+    // Grava todo o conteúdo em cx (já migrado) numa transação, substituindo o que houver lá
+    void save(ecocin::infra::db::SqliteConnection& cx);
+
+    // Carrega path se ele existir (false se não existe). O arquivo é migrado antes, então um
+    // e-cocin.db de uma versão anterior também serve.
+    bool loadSnapshot(const std::string& path);
+    // Grava em path + ".tmp" e renomeia por cima de path: um snapshot interrompido não estraga o anterior
+    void saveSnapshot(const std::string& path);
+
+private:
+    std::mutex snapshotMutex_; // um saveSnapshot por vez
+};
+
+} // namespace ecocin::infra::repositories::memory
+
+#endif // ECOCIN_INFRA_REPOSITORIES_MEMORY_MEMORYSTORE_H
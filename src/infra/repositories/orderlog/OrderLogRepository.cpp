@@ -0,0 +1,427 @@
+#include "OrderLogRepository.h"
+#include "../../metrics/Metrics.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <mutex>
+#include <stdexcept>
+
+namespace ecocin::infra::repositories::orderlog {
+
+using ecocin::domain::repositories::OrderReference;
+using ecocin::domain::repositories::OrderReferenceConflict;
+
+namespace {
+
+[[noreturn]] void fail(const char* where, const std::string& what) {
+    throw std::runtime_error(std::string("log de pedidos @ ") + where + ": " + what);
+}
+
+const char* referenceName(OrderReference kind) {
+    switch (kind) {
+    case OrderReference::Client: return "client";
+    case OrderReference::Product: return "product";
+    case OrderReference::Address: return "address";
+    }
+    return "?";
+}
+
+std::string segmentPath(const std::string& dir, std::size_t number) {
+    char name[32];
+    std::snprintf(name, sizeof(name), "orders-%06zu.seg", number);
+    return (std::filesystem::path(dir) / name).string();
+}
+
+// Os mesmos CHECK da tabela orders (app/Migrations.h), mais o limite do campo status no registro
+void checkRow(const Order& o, const char* where) {
+    if (o.getQuantity() <= 0) fail(where, "CHECK constraint failed: quantity > 0");
+    if (o.getUnitPrice() < 0.0) fail(where, "CHECK constraint failed: unit_price >= 0.0");
+    if (o.getTotalPrice() < 0.0) fail(where, "CHECK constraint failed: total_price >= 0.0");
+    if (o.getStatus().size() > OrderRecord::kStatusCapacity) fail(where, "status maior que 39 bytes");
+}
+
+OrderRecord makeRecord(RecordKind kind, long long id) {
+    OrderRecord r{};
+    r.magic = OrderRecord::kMagic;
+    r.kind = kind;
+    r.id = id;
+    return r;
+}
+
+void setStatus(OrderRecord& r, const std::string& status) {
+    r.statusLength = static_cast<std::uint8_t>(status.size());
+    std::memcpy(r.status, status.data(), status.size());
+}
+
+OrderRecord putRecord(const Order& o) {
+    OrderRecord r = makeRecord(RecordKind::Put, o.getId());
+    r.clientId = o.getClientId();
+    r.productId = o.getProductId();
+    r.shippingAddressId = o.getShippingAddressId();
+    r.createDate = std::chrono::duration_cast<std::chrono::seconds>(o.getCreateDate().time_since_epoch()).count();
+    r.unitPrice = o.getUnitPrice();
+    r.totalPrice = o.getTotalPrice();
+    r.quantity = o.getQuantity();
+    setStatus(r, o.getStatus());
+    return r;
+}
+
+void eraseId(std::vector<long long>& ids, long long id) {
+    ids.erase(std::remove(ids.begin(), ids.end(), id), ids.end());
+}
+
+void addRef(std::unordered_map<long long, std::size_t>& refs, long long key) {
+    if (key > 0) ++refs[key];
+}
+
+void dropRef(std::unordered_map<long long, std::size_t>& refs, long long key) {
+    auto it = refs.find(key);
+    if (it == refs.end()) return;
+    if (--it->second == 0) refs.erase(it);
+}
+
+} // namespace
+
+OrderLogRepository::OrderLogRepository(const std::string& dir, std::size_t segmentRecords, bool syncWrites)
+    : dir_(dir), segmentRecords_(segmentRecords), syncWrites_(syncWrites) {
+    if (segmentRecords_ == 0 || segmentRecords_ > UINT32_MAX) fail("open", "tamanho de segmento inválido");
+    std::filesystem::create_directories(dir_);
+    for (std::size_t n = 0; std::filesystem::exists(segmentPath(dir_, n)); ++n) openSegment(n);
+    if (segments_.empty()) openSegment(0);
+    replay();
+}
+
+void OrderLogRepository::openSegment(std::size_t number) {
+    segments_.push_back(std::make_unique<OrderSegment>(segmentPath(dir_, number), segmentRecords_));
+}
+
+// Refaz os índices relendo o log inteiro. Os segmentos fechados foram gravados no disco antes do
+// seguinte ser aberto, então só o último pode terminar num registro incompleto
+void OrderLogRepository::replay() {
+    for (std::size_t s = 0; s < segments_.size(); ++s) {
+        auto& segment = *segments_[s];
+        const bool last = s + 1 == segments_.size();
+        std::size_t slot = 0;
+        for (; slot < segment.capacity() && segment.valid(slot); ++slot) {
+            apply(segment.at(slot), Location{static_cast<std::uint32_t>(s), static_cast<std::uint32_t>(slot)});
+            ++records_;
+        }
+        if (slot == segment.capacity()) continue;
+        if (!last) fail("replay", "registro inválido no meio do log (" + segment.path() + ")");
+        segment.clear(slot); // descarta a gravação interrompida e o que veio depois dela
+        writeSlot_ = syncedSlot_ = slot;
+        return;
+    }
+    // Último segmento cheio: o próximo append abre outro
+    writeSlot_ = syncedSlot_ = segments_.back()->capacity();
+}
+
+void OrderLogRepository::apply(const OrderRecord& r, Location at) {
+    const long long id = r.id;
+    switch (r.kind) {
+    case RecordKind::Put: {
+        auto it = index_.find(id);
+        if (it != index_.end()) {
+            const OrderRecord& previous = segments_[it->second.segment]->at(it->second.slot);
+            if (previous.clientId != r.clientId) {
+                auto ids = idsByClient_.find(previous.clientId);
+                if (ids != idsByClient_.end()) {
+                    eraseId(ids->second, id);
+                    if (ids->second.empty()) idsByClient_.erase(ids);
+                }
+                idsByClient_[r.clientId].push_back(id);
+            }
+            dropRef(ordersByProduct_, previous.productId);
+            dropRef(ordersByAddress_, addressOf(id, it->second));
+            it->second = at;
+        } else {
+            index_.emplace(id, at);
+            idsByClient_[r.clientId].push_back(id);
+        }
+        addRef(ordersByProduct_, r.productId);
+        addRef(ordersByAddress_, r.shippingAddressId);
+        overlay_.erase(id);
+        nextId_ = std::max(nextId_, id + 1);
+        break;
+    }
+    case RecordKind::Status:
+        if (index_.count(id)) overlay_[id].status = std::string(r.status, r.statusLength);
+        break;
+    case RecordKind::Shipping: {
+        auto it = index_.find(id);
+        if (it == index_.end()) break;
+        dropRef(ordersByAddress_, addressOf(id, it->second));
+        addRef(ordersByAddress_, r.shippingAddressId);
+        overlay_[id].shippingAddressId = r.shippingAddressId;
+        break;
+    }
+    case RecordKind::Remove: {
+        auto it = index_.find(id);
+        if (it == index_.end()) break;
+        const OrderRecord& current = segments_[it->second.segment]->at(it->second.slot);
+        auto ids = idsByClient_.find(current.clientId);
+        if (ids != idsByClient_.end()) {
+            eraseId(ids->second, id);
+            if (ids->second.empty()) idsByClient_.erase(ids);
+        }
+        dropRef(ordersByProduct_, current.productId);
+        dropRef(ordersByAddress_, addressOf(id, it->second));
+        index_.erase(it);
+        overlay_.erase(id);
+        break;
+    }
+    default:
+        fail("replay", "tipo de registro desconhecido");
+    }
+}
+
+// Chamado com mutex_ exclusivo: grava no fim do log e aplica aos índices
+void OrderLogRepository::append(OrderRecord& r) {
+    if (writeSlot_ == segments_.back()->capacity()) {
+        // Segmento cheio: vai para o disco antes de abrir o próximo (só o último fica sem sync)
+        segments_.back()->sync(syncedSlot_, writeSlot_);
+        openSegment(segments_.size());
+        writeSlot_ = syncedSlot_ = 0;
+    }
+    r.checksum = r.computeChecksum();
+    auto& segment = *segments_.back();
+    segment.write(writeSlot_, r);
+    apply(r, Location{static_cast<std::uint32_t>(segments_.size() - 1), static_cast<std::uint32_t>(writeSlot_)});
+    ++writeSlot_;
+    ++records_;
+    if (syncWrites_) {
+        segment.sync(syncedSlot_, writeSlot_);
+        syncedSlot_ = writeSlot_;
+    }
+}
+
+// Endereço de entrega em vigor: o da sobreposição, se houver, senão o do registro
+long long OrderLogRepository::addressOf(long long id, Location at) const {
+    if (auto it = overlay_.find(id); it != overlay_.end() && it->second.shippingAddressId) {
+        return *it->second.shippingAddressId;
+    }
+    return segments_[at.segment]->at(at.slot).shippingAddressId;
+}
+
+Order OrderLogRepository::read(long long id, Location at) const {
+    const OrderRecord& r = segments_[at.segment]->at(at.slot);
+    Order o(r.clientId, r.productId, r.shippingAddressId, r.quantity, r.unitPrice, std::string(r.status, r.statusLength));
+    o.setId(id);
+    o.setCreateDate(ecocin::core::Timestamp{std::chrono::seconds{r.createDate}});
+    if (auto it = overlay_.find(id); it != overlay_.end()) {
+        if (it->second.status) o.setStatus(*it->second.status);
+        if (it->second.shippingAddressId) o.setShippingAddressId(*it->second.shippingAddressId);
+    }
+    o.clearDirty(); // igual ao SQLite: o próximo update grava só o que mudar
+    return o;
+}
+
+std::optional<Order> OrderLogRepository::findLocked(long long id) const {
+    auto it = index_.find(id);
+    if (it == index_.end()) return std::nullopt;
+    return read(id, it->second);
+}
+
+Order OrderLogRepository::create(const Order& in) {
+    static auto& metric = ecocin::infra::metrics::dbOp("orders", "create");
+    ecocin::infra::metrics::DbOpTimer timer{metric};
+    Order o = in;
+    o.calculateTotal();
+    checkRow(o, "insert order");
+    // create_date com a precisão da coluna (segundos), para as listagens baterem com o SQLite
+    o.setCreateDate(std::chrono::floor<std::chrono::seconds>(std::chrono::system_clock::now()));
+
+    std::unique_lock lock(mutex_);
+    requireLive(o, "insert order");
+    o.setId(nextId_);
+    OrderRecord r = putRecord(o);
+    append(r);
+    o.clearDirty();
+    return o;
+}
+
+std::optional<Order> OrderLogRepository::findById(long long id) {
+    static auto& metric = ecocin::infra::metrics::dbOp("orders", "findById");
+    ecocin::infra::metrics::DbOpTimer timer{metric};
+    std::shared_lock lock(mutex_);
+    return findLocked(id);
+}
+
+template <class Vec>
+Vec OrderLogRepository::listAllInto(Vec out) {
+    static auto& metric = ecocin::infra::metrics::dbOp("orders", "listAll");
+    ecocin::infra::metrics::DbOpTimer timer{metric};
+    {
+        std::shared_lock lock(mutex_);
+        out.reserve(index_.size());
+        for (const auto& [id, at] : index_) out.push_back(read(id, at));
+    }
+    std::sort(out.begin(), out.end(), [](const Order& a, const Order& b) { return a.getId() > b.getId(); });
+    return out;
+}
+
+std::vector<Order> OrderLogRepository::listAll() {
+    return listAllInto(std::vector<Order>{});
+}
+
+std::pmr::vector<Order> OrderLogRepository::listAll(std::pmr::memory_resource* mr) {
+    return listAllInto(std::pmr::vector<Order>(mr));
+}
+
+// Só status e/ou endereço marcados: registros de sobreposição. Outra coluna: regrava o pedido inteiro
+bool OrderLogRepository::update(const Order& oIn) {
+    static auto& metric = ecocin::infra::metrics::dbOp("orders", "update");
+    ecocin::infra::metrics::DbOpTimer timer{metric};
+    std::unique_lock lock(mutex_);
+    auto current = findLocked(oIn.getId());
+    if (!current) return false;
+
+    const std::uint32_t mask = oIn.dirtyFields();
+    if (mask == 0) return true;
+    if ((mask & ~(Order::kStatus | Order::kShippingAddressId)) == 0) {
+        if (mask & Order::kStatus) {
+            checkRow(oIn, "update order");
+            OrderRecord r = makeRecord(RecordKind::Status, oIn.getId());
+            setStatus(r, oIn.getStatus());
+            append(r);
+        }
+        if (mask & Order::kShippingAddressId) {
+            requireLive(OrderReference::Address, oIn.getShippingAddressId(), "update order");
+            OrderRecord r = makeRecord(RecordKind::Shipping, oIn.getId());
+            r.shippingAddressId = oIn.getShippingAddressId();
+            append(r);
+        }
+        return true;
+    }
+
+    Order next = *current;
+    if (mask & Order::kClientId)          next.setClientId(oIn.getClientId());
+    if (mask & Order::kProductId)         next.setProductId(oIn.getProductId());
+    if (mask & Order::kShippingAddressId) next.setShippingAddressId(oIn.getShippingAddressId());
+    if (mask & Order::kQuantity)          next.setQuantity(oIn.getQuantity());
+    if (mask & Order::kUnitPrice)         next.setUnitPrice(oIn.getUnitPrice());
+    if (mask & Order::kStatus)            next.setStatus(oIn.getStatus());
+    next.calculateTotal();
+    checkRow(next, "update order");
+    requireLive(next, "update order");
+    OrderRecord r = putRecord(next);
+    append(r);
+    return true;
+}
+
+bool OrderLogRepository::remove(long long id) {
+    static auto& metric = ecocin::infra::metrics::dbOp("orders", "remove");
+    ecocin::infra::metrics::DbOpTimer timer{metric};
+    std::unique_lock lock(mutex_);
+    if (!index_.count(id)) return false;
+    OrderRecord r = makeRecord(RecordKind::Remove, id);
+    append(r);
+    return true;
+}
+
+template <class Vec>
+Vec OrderLogRepository::listByClientIdInto(long long clientId, Vec out) {
+    static auto& metric = ecocin::infra::metrics::dbOp("orders", "listByClientId");
+    ecocin::infra::metrics::DbOpTimer timer{metric};
+    {
+        std::shared_lock lock(mutex_);
+        auto ids = idsByClient_.find(clientId);
+        if (ids == idsByClient_.end()) return out;
+        out.reserve(ids->second.size());
+        for (const long long id : ids->second) out.push_back(read(id, index_.at(id)));
+    }
+    std::sort(out.begin(), out.end(), [](const Order& a, const Order& b) {
+        if (a.getCreateDate() != b.getCreateDate()) return a.getCreateDate() > b.getCreateDate();
+        return a.getId() > b.getId();
+    });
+    return out;
+}
+
+std::vector<Order> OrderLogRepository::listByClientId(long long clientId) {
+    return listByClientIdInto(clientId, std::vector<Order>{});
+}
+
+std::pmr::vector<Order> OrderLogRepository::listByClientId(long long clientId, std::pmr::memory_resource* mr) {
+    return listByClientIdInto(clientId, std::pmr::vector<Order>(mr));
+}
+
+bool OrderLogRepository::updateStatus(long long id, const std::string& newStatus) {
+    static auto& metric = ecocin::infra::metrics::dbOp("orders", "updateStatus");
+    ecocin::infra::metrics::DbOpTimer timer{metric};
+    if (newStatus.size() > OrderRecord::kStatusCapacity) fail("update order status", "status maior que 39 bytes");
+    std::unique_lock lock(mutex_);
+    if (!index_.count(id)) return false;
+    OrderRecord r = makeRecord(RecordKind::Status, id);
+    setStatus(r, newStatus);
+    append(r);
+    return true;
+}
+
+bool OrderLogRepository::updateShippingAddress(long long id, long long newAddressId) {
+    static auto& metric = ecocin::infra::metrics::dbOp("orders", "updateShippingAddress");
+    ecocin::infra::metrics::DbOpTimer timer{metric};
+    std::unique_lock lock(mutex_);
+    if (!index_.count(id)) return false;
+    requireLive(OrderReference::Address, newAddressId, "update order shipping address");
+    OrderRecord r = makeRecord(RecordKind::Shipping, id);
+    r.shippingAddressId = newAddressId;
+    append(r);
+    return true;
+}
+
+bool OrderLogRepository::referencesClient(long long clientId) const {
+    std::shared_lock lock(mutex_);
+    return idsByClient_.count(clientId) > 0;
+}
+
+bool OrderLogRepository::referencesProduct(long long productId) const {
+    std::shared_lock lock(mutex_);
+    return ordersByProduct_.count(productId) > 0;
+}
+
+bool OrderLogRepository::referencesAddress(long long addressId) const {
+    std::shared_lock lock(mutex_);
+    return ordersByAddress_.count(addressId) > 0;
+}
+
+// A remoção roda com o lock exclusivo: nenhum pedido é gravado entre a conferência e o DELETE
+bool OrderLogRepository::removeUnreferenced(OrderReference kind, long long id, const std::function<bool()>& remove) {
+    std::unique_lock lock(mutex_);
+    const bool referenced = kind == OrderReference::Client    ? idsByClient_.count(id) > 0
+                          : kind == OrderReference::Product   ? ordersByProduct_.count(id) > 0
+                                                              : ordersByAddress_.count(id) > 0;
+    if (referenced) throw OrderReferenceConflict(std::string("log de pedidos @ delete ") + referenceName(kind) +
+                                                 ": há pedidos que apontam para ele");
+    const bool removed = remove();
+    if (removed) removed_[static_cast<std::size_t>(kind)].insert(id);
+    return removed;
+}
+
+// Chamado com mutex_ exclusivo
+void OrderLogRepository::requireLive(OrderReference kind, long long id, const char* where) const {
+    if (id > 0 && removed_[static_cast<std::size_t>(kind)].count(id)) {
+        throw OrderReferenceConflict(std::string("log de pedidos @ ") + where + ": " + referenceName(kind) + " removido");
+    }
+}
+
+void OrderLogRepository::requireLive(const Order& o, const char* where) const {
+    requireLive(OrderReference::Client, o.getClientId(), where);
+    requireLive(OrderReference::Product, o.getProductId(), where);
+    requireLive(OrderReference::Address, o.getShippingAddressId(), where);
+}
+
+void OrderLogRepository::sync() {
+    std::unique_lock lock(mutex_);
+    segments_.back()->sync(syncedSlot_, writeSlot_);
+    syncedSlot_ = writeSlot_;
+}
+
+OrderLogRepository::Stats OrderLogRepository::stats() const {
+    std::shared_lock lock(mutex_);
+    return Stats{segments_.size(), records_, index_.size(), overlay_.size()};
+}
+
+} // namespace ecocin::infra::repositories::orderlog
@@ -0,0 +1,126 @@
+#ifndef ECOCIN_INFRA_REPOSITORIES_ORDERLOG_ORDERLOGREPOSITORY_H
+#define ECOCIN_INFRA_REPOSITORIES_ORDERLOG_ORDERLOGREPOSITORY_H
+
+#include "OrderSegment.h"
+#include "domain/repositories/IOrderReferences.h"
+#include "domain/repositories/IOrderRepository.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace ecocin::infra::repositories::orderlog {
+
+// Pedidos num log só de acréscimo, em segmentos de tamanho fixo mapeados em memória (OrderSegment),
+// em vez da tabela orders do SQLite. Pedido é gravado uma vez e quase nunca muda: cada create é uma
+// cópia de 128 bytes para o fim do log, sem árvore B nem os quatro índices secundários de orders.
+//
+//   - Em memória ficam só os índices: id -> posição do registro e client_id -> ids.
+//   - updateStatus e updateShippingAddress acrescentam um registro pequeno e guardam o valor numa
+//     sobreposição por id, aplicada nas leituras; update de outras colunas regrava o pedido inteiro
+//     (um Put novo, que também limpa a sobreposição) e remove acrescenta uma marca de exclusão.
+//   - Na abertura, os segmentos são relidos em ordem para refazer índices e sobreposição. O log
+//     termina no primeiro registro inválido do último segmento (gravação interrompida).
+//
+// Uma instância por processo (o fim do log é um só), compartilhada pelas pilhas de todos os
+// acceptors: escritas em série sob um lock exclusivo, leituras em paralelo sob o compartilhado.
+// Sem chaves estrangeiras: clientes, produtos e endereços continuam no SQLite e o OrderService é
+// quem confere que existem ao criar o pedido. No outro sentido, o log conta os pedidos por cliente,
+// produto e endereço (IOrderReferences): os serviços removem sob o lock exclusivo do log, que recusa
+// a remoção do que ainda é referenciado e, depois dela, pedidos que apontem para o removido.
+// Segmentos antigos não são compactados.
+class OrderLogRepository : public ecocin::domain::repositories::IOrderRepository,
+                           public ecocin::domain::repositories::IOrderReferences {
+public:
+    static constexpr std::size_t kDefaultSegmentRecords = std::size_t{1} << 19; // 64 MiB por segmento
+
+    // Abre (criando se preciso) o diretório dir e relê os segmentos existentes.
+    // segmentRecords só vale para segmentos novos. Com syncWrites, cada gravação espera o disco
+    // (msync); sem, os registros ficam no cache de páginas do SO até o segmento encher, sync() ou o fim.
+    explicit OrderLogRepository(const std::string& dir, std::size_t segmentRecords = kDefaultSegmentRecords,
+                                bool syncWrites = false);
+
+    // IOrderRepository
+    Order create(const Order& in) override;
+    std::optional<Order> findById(long long id) override;
+    std::vector<Order> listAll() override;
+    std::pmr::vector<Order> listAll(std::pmr::memory_resource* mr) override;
+    bool update(const Order& o) override;
+    bool remove(long long id) override;
+
+    std::vector<Order> listByClientId(long long clientId) override;
+    std::pmr::vector<Order> listByClientId(long long clientId, std::pmr::memory_resource* mr) override;
+    bool updateStatus(long long id, const std::string& newStatus) override;
+    bool updateShippingAddress(long long id, long long newAddressId) override;
+
+    // IOrderReferences
+    bool referencesClient(long long clientId) const override;
+    bool referencesProduct(long long productId) const override;
+    bool referencesAddress(long long addressId) const override;
+    bool removeUnreferenced(ecocin::domain::repositories::OrderReference kind, long long id,
+                            const std::function<bool()>& remove) override;
+
+    // Grava no disco o que ainda está só no cache de páginas
+    void sync();
+
+    struct Stats {
+        std::size_t segments{0};
+        std::size_t records{0};  // registros no log (pedidos, sobreposições e exclusões)
+        std::size_t orders{0};   // pedidos existentes
+        std::size_t overlays{0}; // pedidos com status/endereço vindos da sobreposição
+    };
+    Stats stats() const;
+
+private:
+    struct Location {
+        std::uint32_t segment;
+        std::uint32_t slot;
+    };
+    struct Overlay {
+        std::optional<std::string> status;
+        std::optional<long long> shippingAddressId;
+    };
+
+    std::string dir_;
+    std::size_t segmentRecords_;
+    bool syncWrites_;
+
+    mutable std::shared_mutex mutex_;
+    std::vector<std::unique_ptr<OrderSegment>> segments_;
+    std::size_t writeSlot_{0};  // próximo slot livre do último segmento
+    std::size_t syncedSlot_{0}; // slots do último segmento já gravados no disco
+    std::size_t records_{0};
+    std::unordered_map<long long, Location> index_;
+    std::unordered_map<long long, std::vector<long long>> idsByClient_;
+    std::unordered_map<long long, Overlay> overlay_;
+    std::unordered_map<long long, std::size_t> ordersByProduct_; // pedidos existentes por produto
+    std::unordered_map<long long, std::size_t> ordersByAddress_; // e por endereço de entrega (com a sobreposição)
+    long long nextId_{1};
+    // Chaves removidas por removeUnreferenced, por OrderReference: um pedido validado antes da
+    // remoção e gravado depois dela é recusado. Só do processo atual (os ids não são reutilizados).
+    std::unordered_set<long long> removed_[3];
+
+    void replay();
+    void apply(const OrderRecord& r, Location at);
+    void append(OrderRecord& r);
+    void openSegment(std::size_t number);
+    long long addressOf(long long id, Location at) const;
+    Order read(long long id, Location at) const;
+    std::optional<Order> findLocked(long long id) const;
+    void requireLive(ecocin::domain::repositories::OrderReference kind, long long id, const char* where) const;
+    void requireLive(const Order& o, const char* where) const;
+
+    template <class Vec> Vec listAllInto(Vec out);
+    template <class Vec> Vec listByClientIdInto(long long clientId, Vec out);
+};
+
+} // namespace ecocin::infra::repositories::orderlog
+
+#endif // ECOCIN_INFRA_REPOSITORIES_ORDERLOG_ORDERLOGREPOSITORY_H
@@ -0,0 +1,213 @@
+#include "OrderSegment.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+
+#if defined(_WIN32)
+// Sem mmap POSIX: o log de pedidos existe apenas para manter a compilação portátil.
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+namespace ecocin::infra::repositories::orderlog {
+
+namespace {
+
+// Cabeçalho no lugar do registro 0 de cada segmento
+struct SegmentHeader {
+    char signature[8];
+    std::uint32_t version;
+    std::uint32_t recordSize;
+    std::uint64_t capacity;
+    std::uint8_t reserved[104];
+};
+static_assert(sizeof(SegmentHeader) == sizeof(OrderRecord), "o cabeçalho ocupa um registro");
+
+constexpr char kSignature[8] = {'E', 'C', 'O', 'C', 'I', 'N', 'O', 'L'};
+constexpr std::uint32_t kVersion = 1;
+
+} // namespace
+
+std::uint32_t OrderRecord::computeChecksum() const {
+    const auto* bytes = reinterpret_cast<const unsigned char*>(this);
+    std::uint32_t h = 2166136261u;
+    for (std::size_t i = offsetof(OrderRecord, kind); i < sizeof(OrderRecord); ++i) {
+        h ^= bytes[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+bool OrderSegment::valid(std::size_t slot) const {
+    const auto& r = at(slot);
+    return r.magic == OrderRecord::kMagic && r.checksum == r.computeChecksum();
+}
+
+#if defined(_WIN32)
+
+bool OrderSegment::isSupported() { return false; }
+
+OrderSegment::OrderSegment(const std::string& path, std::size_t) : path_(path) {
+    throw std::runtime_error("log de pedidos (mmap) não é suportado nesta plataforma");
+}
+
+OrderSegment::~OrderSegment() = default;
+
+void OrderSegment::write(std::size_t, const OrderRecord&) {}
+
+void OrderSegment::sync(std::size_t, std::size_t) {}
+
+void OrderSegment::clear(std::size_t) {}
+
+#else
+
+namespace {
+
+[[noreturn]] void fail(const std::string& path, const char* what) {
+    throw std::runtime_error(std::string("log de pedidos @ ") + path + ": " + what + " (" + std::strerror(errno) + ")");
+}
+
+// Arquivo que existe mas nunca recebeu cabeçalho (versão que criava o segmento no lugar e caiu
+// antes do msync): nenhum pedido chegou a ser gravado nele, então pode ser criado de novo
+bool missingHeader(const std::string& path) {
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    static constexpr SegmentHeader kZero{};
+    SegmentHeader header{};
+    const bool zero = ::pread(fd, &header, sizeof(header), 0) == static_cast<ssize_t>(sizeof(header)) &&
+                      std::memcmp(&header, &kZero, sizeof(header)) == 0;
+    ::close(fd);
+    return zero;
+}
+
+// Monta o segmento (tamanho final, blocos reservados e cabeçalho) em <path>.tmp, grava no disco e
+// só então renomeia para path: uma queda no meio deixa no máximo o .tmp, que o próximo boot
+// sobrescreve, e nunca um segmento sem cabeçalho.
+void createSegment(const std::string& path, std::size_t capacity) {
+    const auto tmp = path + ".tmp";
+    const int fd = ::open(tmp.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) fail(tmp, "open");
+    const auto abandon = [&](const char* what) {
+        const int saved = errno;
+        ::close(fd);
+        ::unlink(tmp.c_str());
+        errno = saved;
+        fail(tmp, what);
+    };
+
+    const auto bytes = static_cast<off_t>((capacity + 1) * sizeof(OrderRecord));
+    if (::ftruncate(fd, bytes) != 0) abandon("ftruncate");
+#if defined(__linux__)
+    // Reserva os blocos agora: com o disco cheio, falha aqui em vez de SIGBUS numa escrita no mapeamento
+    if (const int rc = ::posix_fallocate(fd, 0, bytes); rc != 0) {
+        errno = rc;
+        abandon("posix_fallocate");
+    }
+#endif
+    SegmentHeader header{};
+    std::memcpy(header.signature, kSignature, sizeof(kSignature));
+    header.version = kVersion;
+    header.recordSize = sizeof(OrderRecord);
+    header.capacity = capacity;
+    if (::pwrite(fd, &header, sizeof(header), 0) != static_cast<ssize_t>(sizeof(header))) abandon("pwrite");
+    if (::fsync(fd) != 0) abandon("fsync");
+    ::close(fd);
+
+    if (::rename(tmp.c_str(), path.c_str()) != 0) {
+        const int saved = errno;
+        ::unlink(tmp.c_str());
+        errno = saved;
+        fail(path, "rename");
+    }
+    // O rename só sobrevive a uma queda do sistema com o diretório gravado
+    auto dir = std::filesystem::path(path).parent_path().string();
+    if (dir.empty()) dir = ".";
+    const int dirFd = ::open(dir.c_str(), O_RDONLY | O_DIRECTORY);
+    if (dirFd >= 0) {
+        ::fsync(dirFd);
+        ::close(dirFd);
+    }
+}
+
+} // namespace
+
+bool OrderSegment::isSupported() { return true; }
+
+OrderSegment::OrderSegment(const std::string& path, std::size_t capacity) : path_(path) {
+    struct stat st{};
+    if (::stat(path.c_str(), &st) != 0 || st.st_size == 0 || missingHeader(path)) createSegment(path, capacity);
+
+    fd_ = ::open(path.c_str(), O_RDWR);
+    if (fd_ < 0) fail(path, "open");
+    if (::fstat(fd_, &st) != 0) {
+        ::close(fd_);
+        fail(path, "fstat");
+    }
+    bytes_ = static_cast<std::size_t>(st.st_size);
+
+    void* base = ::mmap(nullptr, bytes_, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+    if (base == MAP_FAILED) {
+        ::close(fd_);
+        fail(path, "mmap");
+    }
+    records_ = static_cast<OrderRecord*>(base);
+
+    const auto* header = reinterpret_cast<const SegmentHeader*>(records_);
+    if (bytes_ < sizeof(SegmentHeader) || std::memcmp(header->signature, kSignature, sizeof(kSignature)) != 0 ||
+        header->version != kVersion || header->recordSize != sizeof(OrderRecord) ||
+        (header->capacity + 1) * sizeof(OrderRecord) != bytes_) {
+        ::munmap(records_, bytes_);
+        ::close(fd_);
+        throw std::runtime_error("log de pedidos @ " + path + ": não é um segmento deste formato");
+    }
+    capacity_ = static_cast<std::size_t>(header->capacity);
+}
+
+OrderSegment::~OrderSegment() {
+    if (records_) {
+        ::msync(records_, bytes_, MS_SYNC);
+        ::munmap(records_, bytes_);
+    }
+    if (fd_ >= 0) ::close(fd_);
+}
+
+// Corpo primeiro, magic por último (com release): quem achar o magic encontra o registro inteiro
+void OrderSegment::write(std::size_t slot, const OrderRecord& record) {
+    auto* dst = &records_[slot + 1];
+    constexpr std::size_t kBody = offsetof(OrderRecord, checksum);
+    std::memcpy(reinterpret_cast<char*>(dst) + kBody, reinterpret_cast<const char*>(&record) + kBody,
+                sizeof(OrderRecord) - kBody);
+    std::atomic_ref<std::uint32_t>(dst->magic).store(record.magic, std::memory_order_release);
+}
+
+void OrderSegment::sync(std::size_t from, std::size_t to) {
+    if (from >= to) return;
+    static const auto page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    const std::size_t begin = (from + 1) * sizeof(OrderRecord) / page * page;
+    const std::size_t end = (to + 1) * sizeof(OrderRecord);
+    if (::msync(reinterpret_cast<char*>(records_) + begin, end - begin, MS_SYNC) != 0) fail(path_, "msync");
+}
+
+// Só regrava os slots que não estão zerados: o resto de um segmento novo nem chega a sujar páginas
+void OrderSegment::clear(std::size_t from) {
+    static constexpr OrderRecord kEmpty{};
+    std::size_t last = from;
+    for (std::size_t slot = from; slot < capacity_; ++slot) {
+        auto* r = &records_[slot + 1];
+        if (std::memcmp(r, &kEmpty, sizeof(OrderRecord)) == 0) continue;
+        std::memset(r, 0, sizeof(OrderRecord));
+        last = slot + 1;
+    }
+    sync(from, last);
+}
+
+#endif
+
+} // namespace ecocin::infra::repositories::orderlog
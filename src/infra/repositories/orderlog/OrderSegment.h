@@ -0,0 +1,82 @@
+#ifndef ECOCIN_INFRA_REPOSITORIES_ORDERLOG_ORDERSEGMENT_H
+#define ECOCIN_INFRA_REPOSITORIES_ORDERLOG_ORDERSEGMENT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace ecocin::infra::repositories::orderlog {
+
+// Registro do log de pedidos: layout fixo de 128 bytes, gravado uma vez e nunca alterado.
+// Um pedido novo ou regravado (Put) leva todas as colunas; Status e Shipping levam só o campo que
+// muda (a sobreposição, ver OrderLogRepository) e Remove só o id.
+enum class RecordKind : std::uint8_t { Put = 1, Status = 2, Shipping = 3, Remove = 4 };
+
+struct OrderRecord {
+    static constexpr std::uint32_t kMagic = 0x4C4F4345; // "ECOL"; 0 = espaço ainda não usado
+    static constexpr std::size_t kStatusCapacity = 39;
+
+    std::uint32_t magic;    // gravado por último: registro pela metade não tem magic (ou não bate o checksum)
+    std::uint32_t checksum; // FNV-1a dos bytes depois deste campo
+    RecordKind kind;
+    std::uint8_t statusLength;
+    std::uint8_t reserved[6];
+    std::int64_t id;
+    std::int64_t clientId;
+    std::int64_t productId;
+    std::int64_t shippingAddressId;
+    std::int64_t createDate; // epoch em segundos, como a coluna create_date
+    double unitPrice;
+    double totalPrice;
+    std::int32_t quantity;
+    char status[kStatusCapacity + 1];
+    std::uint8_t padding[12];
+
+    std::uint32_t computeChecksum() const;
+};
+static_assert(sizeof(OrderRecord) == 128, "OrderRecord precisa de 128 bytes");
+
+// Um arquivo de segmento mapeado em memória: o registro 0 é o cabeçalho (formato e capacidade) e
+// os demais são pedidos, gravados em sequência. O arquivo é criado já com o tamanho final e mapeado
+// uma vez: append é uma cópia de 128 bytes para a memória, sem chamada de sistema.
+// Os dados chegam ao cache de páginas do SO na hora (sobrevivem a uma queda do processo); sync()
+// força a gravação no disco.
+// Só em sistemas POSIX (mmap); no Windows isSupported() é false e o construtor lança.
+class OrderSegment {
+public:
+    static bool isSupported();
+
+    // Abre o segmento em path ou, se não existe, cria com capacity registros de pedido (montado em
+    // <path>.tmp e renomeado já com o cabeçalho no disco).
+    // Lança std::runtime_error se o arquivo existe mas não é um segmento deste formato.
+    OrderSegment(const std::string& path, std::size_t capacity);
+    ~OrderSegment();
+
+    OrderSegment(const OrderSegment&) = delete;
+    OrderSegment& operator=(const OrderSegment&) = delete;
+
+    std::size_t capacity() const { return capacity_; }
+    const std::string& path() const { return path_; }
+
+    // slot em [0, capacity)
+    const OrderRecord& at(std::size_t slot) const { return records_[slot + 1]; }
+    bool valid(std::size_t slot) const;
+    void write(std::size_t slot, const OrderRecord& record);
+
+    // Grava no disco os registros [from, to)
+    void sync(std::size_t from, std::size_t to);
+
+    // Zera os registros a partir de from (recuperação: descarta o que veio depois de um registro inválido)
+    void clear(std::size_t from);
+
+private:
+    std::string path_;
+    std::size_t capacity_{0};
+    OrderRecord* records_{nullptr}; // mapeamento do arquivo inteiro (cabeçalho incluído)
+    std::size_t bytes_{0};
+    int fd_{-1};
+};
+
+} // namespace ecocin::infra::repositories::orderlog
+
+#endif // ECOCIN_INFRA_REPOSITORIES_ORDERLOG_ORDERSEGMENT_H
@@ -0,0 +1,79 @@
+#include "ShardedAddressRepository.h"
+#include "ShardedHelpers.h"
+
+#include <stdexcept>
+
+namespace ecocin::infra::repositories::sharded {
+
+ShardedAddressRepository::ShardedAddressRepository(ecocin::infra::db::ShardSet& shards) : shards_(shards) {
+    for (std::size_t i = 0; i < shards_.size(); ++i) {
+        repos_.push_back(std::make_unique<sqlite::AddressRepositorySqlite>(shards_.shard(i)));
+    }
+}
+
+sqlite::AddressRepositorySqlite* ShardedAddressRepository::byId(long long id) {
+    const auto shard = shards_.shardOfId(id);
+    return shard ? repos_[*shard].get() : nullptr;
+}
+
+// Um client_id fora de todas as faixas não existe em shard nenhum: falha como a chave
+// estrangeira falharia num banco único
+Address ShardedAddressRepository::create(const Address& in) {
+    auto* repo = byId(in.getClientId());
+    if (!repo) throw std::runtime_error("client_id " + std::to_string(in.getClientId()) + " não pertence a nenhum shard");
+    return repo->create(in);
+}
+
+std::optional<Address> ShardedAddressRepository::findById(long long id) {
+    auto* repo = byId(id);
+    if (!repo) return std::nullopt;
+    return repo->findById(id);
+}
+
+std::vector<Address> ShardedAddressRepository::findByIds(const std::vector<long long>& ids) {
+    return gather_by_shard(
+        repos_.size(), ids, [&](long long id) { return shards_.shardOfId(id); },
+        [&](std::size_t s, const std::vector<long long>& part) { return repos_[s]->findByIds(part); },
+        [](const Address& a) { return a.getId(); });
+}
+
+std::vector<Address> ShardedAddressRepository::listAll() {
+    return merge_shards(repos_, std::vector<Address>{}, [](auto& repo) { return repo.listAll(); },
+                        [](const Address& x) { return x.getId(); });
+}
+
+std::pmr::vector<Address> ShardedAddressRepository::listAll(std::pmr::memory_resource* mr) {
+    return merge_shards(repos_, std::pmr::vector<Address>(mr), [&](auto& repo) { return repo.listAll(mr); },
+                        [](const Address& x) { return x.getId(); });
+}
+
+bool ShardedAddressRepository::update(const Address& addr) {
+    auto* repo = byId(addr.getId());
+    if (!repo || repo != byId(addr.getClientId())) return false;
+    return repo->update(addr);
+}
+
+bool ShardedAddressRepository::remove(long long id) {
+    auto* repo = byId(id);
+    return repo && repo->remove(id);
+}
+
+std::vector<Address> ShardedAddressRepository::listByClientId(long long clientId) {
+    auto* repo = byId(clientId);
+    if (!repo) return {};
+    return repo->listByClientId(clientId);
+}
+
+std::pmr::vector<Address> ShardedAddressRepository::listByClientId(long long clientId, std::pmr::memory_resource* mr) {
+    auto* repo = byId(clientId);
+    if (!repo) return std::pmr::vector<Address>(mr);
+    return repo->listByClientId(clientId, mr);
+}
+
+std::optional<Address> ShardedAddressRepository::findByClientIdAndType(long long clientId, const std::string& type) {
+    auto* repo = byId(clientId);
+    if (!repo) return std::nullopt;
+    return repo->findByClientIdAndType(clientId, type);
+}
+
+} // namespace ecocin::infra::repositories::sharded
@@ -0,0 +1,40 @@
+#ifndef ECOCIN_INFRA_REPOSITORIES_SHARDED_SHARDEDADDRESSREPOSITORY_H
+#define ECOCIN_INFRA_REPOSITORIES_SHARDED_SHARDEDADDRESSREPOSITORY_H
+
+#include "domain/repositories/IAddressRepository.h"
+#include "infra/db/ShardSet.h"
+#include "infra/repositories/sqlite/AddressRepositorySqlite.h"
+
+#include <memory>
+
+namespace ecocin::infra::repositories::sharded {
+
+// Endereços no shard do cliente dono (o shard do client_id), junto com a linha de clients
+// que a chave estrangeira exige. Trocar o endereço para um cliente de outro shard não é
+// permitido: update devolve false.
+class ShardedAddressRepository : public ecocin::domain::repositories::IAddressRepository {
+private:
+    ecocin::infra::db::ShardSet& shards_;
+    std::vector<std::unique_ptr<sqlite::AddressRepositorySqlite>> repos_;
+
+    sqlite::AddressRepositorySqlite* byId(long long id);
+
+public:
+    explicit ShardedAddressRepository(ecocin::infra::db::ShardSet& shards);
+
+    Address create(const Address& in) override;
+    std::optional<Address> findById(long long id) override;
+    std::vector<Address> findByIds(const std::vector<long long>& ids) override;
+    std::vector<Address> listAll() override;
+    std::pmr::vector<Address> listAll(std::pmr::memory_resource* mr) override;
+    bool update(const Address& addr) override;
+    bool remove(long long id) override;
+
+    std::vector<Address> listByClientId(long long clientId) override;
+    std::pmr::vector<Address> listByClientId(long long clientId, std::pmr::memory_resource* mr) override;
+    std::optional<Address> findByClientIdAndType(long long clientId, const std::string& type) override;
+};
+
+} // namespace ecocin::infra::repositories::sharded
+
+#endif // ECOCIN_INFRA_REPOSITORIES_SHARDED_SHARDEDADDRESSREPOSITORY_H
@@ -0,0 +1,126 @@
+#include "ShardedClientRepository.h"
+#include "ShardedHelpers.h"
+
+namespace ecocin::infra::repositories::sharded {
+
+ShardedClientRepository::ShardedClientRepository(ecocin::infra::db::ShardSet& shards) : shards_(shards) {
+    for (std::size_t i = 0; i < shards_.size(); ++i) {
+        repos_.push_back(std::make_unique<sqlite::ClientRepositorySqlite>(shards_.shard(i)));
+    }
+}
+
+void ShardedClientRepository::rebuildEmailRegistry(ecocin::infra::db::ShardSet& shards) {
+    auto& registry = shards.shard(0);
+    ecocin::infra::db::Transaction tx(registry, "BEGIN IMMEDIATE");
+    registry.exec("CREATE TABLE IF NOT EXISTS client_emails (email TEXT PRIMARY KEY) WITHOUT ROWID");
+    registry.exec("DELETE FROM client_emails");
+    for (std::size_t i = 0; i < shards.size(); ++i) {
+        ecocin::infra::db::Statement read(shards.shard(i), "SELECT email FROM clients", "prepare client emails scan");
+        int rc;
+        while ((rc = sqlite3_step(read)) == SQLITE_ROW) {
+            // OR IGNORE: um email repetido entre shards (gravado antes do registro existir) fica com
+            // uma reserva só, e os updates seguintes passam a ser conferidos
+            ecocin::infra::db::Statement ins(registry, "INSERT OR IGNORE INTO client_emails(email) VALUES(?)",
+                                             "prepare client email registry");
+            sqlite3_bind_text(ins, 1, reinterpret_cast<const char*>(sqlite3_column_text(read, 0)), -1, SQLITE_TRANSIENT);
+            sqlite_check(sqlite3_step(ins), registry.raw(), "step client email registry");
+        }
+        sqlite_check(rc, shards.shard(i).raw(), "step client emails scan");
+    }
+    tx.commit();
+}
+
+void ShardedClientRepository::reserveEmail(const std::string& email, const char* where) {
+    ecocin::infra::db::Statement st(registry(), "INSERT INTO client_emails(email) VALUES(?)", "prepare client email reserve");
+    sqlite3_bind_text(st, 1, email.c_str(), -1, SQLITE_TRANSIENT);
+    sqlite_check(sqlite3_step(st), registry().raw(), where);
+}
+
+// Chamado com um erro já a caminho ou depois de a gravação valer: uma falha aqui só deixa a
+// reserva presa até o próximo boot (rebuildEmailRegistry)
+void ShardedClientRepository::releaseEmail(const std::string& email) noexcept {
+    try {
+        ecocin::infra::db::Statement st(registry(), "DELETE FROM client_emails WHERE email = ?", "prepare client email release");
+        sqlite3_bind_text(st, 1, email.c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_step(st);
+    } catch (...) {
+    }
+}
+
+Client ShardedClientRepository::create(const Client& in) {
+    const auto shard = shards_.shardForCpf(in.getCpf());
+    if (shards_.size() == 1) return repos_[shard]->create(in);
+    reserveEmail(in.getEmail(), "step insert client");
+    try {
+        return repos_[shard]->create(in);
+    } catch (...) {
+        releaseEmail(in.getEmail());
+        throw;
+    }
+}
+
+std::optional<Client> ShardedClientRepository::findById(long long id) {
+    const auto shard = shards_.shardOfId(id);
+    if (!shard) return std::nullopt;
+    return repos_[*shard]->findById(id);
+}
+
+std::optional<Client> ShardedClientRepository::findByCpf(const std::string& cpf) {
+    return repos_[shards_.shardForCpf(cpf)]->findByCpf(cpf);
+}
+
+std::vector<Client> ShardedClientRepository::findByIds(const std::vector<long long>& ids) {
+    return gather_by_shard(
+        repos_.size(), ids, [&](long long id) { return shards_.shardOfId(id); },
+        [&](std::size_t s, const std::vector<long long>& part) { return repos_[s]->findByIds(part); },
+        [](const Client& c) { return c.getId(); });
+}
+
+std::vector<Client> ShardedClientRepository::findByCpfs(const std::vector<std::string>& cpfs) {
+    return gather_by_shard(
+        repos_.size(), cpfs, [&](const std::string& cpf) { return std::optional<std::size_t>(shards_.shardForCpf(cpf)); },
+        [&](std::size_t s, const std::vector<std::string>& part) { return repos_[s]->findByCpfs(part); },
+        [](const Client& c) { return c.getCpf(); });
+}
+
+std::vector<Client> ShardedClientRepository::listAll() {
+    return merge_shards(repos_, std::vector<Client>{}, [](auto& repo) { return repo.listAll(); },
+                        [](const Client& x) { return x.getId(); });
+}
+
+std::pmr::vector<Client> ShardedClientRepository::listAll(std::pmr::memory_resource* mr) {
+    return merge_shards(repos_, std::pmr::vector<Client>(mr), [&](auto& repo) { return repo.listAll(mr); },
+                        [](const Client& x) { return x.getId(); });
+}
+
+bool ShardedClientRepository::update(const Client& c) {
+    const auto shard = shards_.shardOfId(c.getId());
+    if (!shard || *shard != shards_.shardForCpf(c.getCpf())) return false;
+    if (shards_.size() == 1 || !(c.dirtyFields() & Client::kEmail)) return repos_[*shard]->update(c);
+
+    const auto before = repos_[*shard]->findById(c.getId());
+    if (!before) return false;
+    if (before->getEmail() == c.getEmail()) return repos_[*shard]->update(c);
+    reserveEmail(c.getEmail(), "step update client");
+    bool updated = false;
+    try {
+        updated = repos_[*shard]->update(c);
+    } catch (...) {
+        releaseEmail(c.getEmail());
+        throw;
+    }
+    releaseEmail(updated ? before->getEmail() : c.getEmail());
+    return updated;
+}
+
+bool ShardedClientRepository::remove(long long id) {
+    const auto shard = shards_.shardOfId(id);
+    if (!shard) return false;
+    if (shards_.size() == 1) return repos_[*shard]->remove(id);
+    const auto before = repos_[*shard]->findById(id);
+    if (!before || !repos_[*shard]->remove(id)) return false;
+    releaseEmail(before->getEmail());
+    return true;
+}
+
+} // namespace ecocin::infra::repositories::sharded
@@ -0,0 +1,48 @@
+#ifndef ECOCIN_INFRA_REPOSITORIES_SHARDED_SHARDEDCLIENTREPOSITORY_H
+#define ECOCIN_INFRA_REPOSITORIES_SHARDED_SHARDEDCLIENTREPOSITORY_H
+
+#include "domain/repositories/IClientRepository.h"
+#include "infra/db/ShardSet.h"
+#include "infra/repositories/sqlite/ClientRepositorySqlite.h"
+
+#include <memory>
+#include <string>
+
+namespace ecocin::infra::repositories::sharded {
+
+// Clientes distribuídos pelo hash do CPF (ShardSet::shardForCpf); por id, o shard sai do próprio id.
+// O CPF não pode mudar de shard: update com um CPF que pertence a outro shard devolve false.
+// O CPF, por decidir o shard, é único no conjunto pelo UNIQUE de cada arquivo. O email não: com mais
+// de um shard ele é reservado antes na tabela client_emails do shard 0 (email PRIMARY KEY), e é o
+// UNIQUE dela que recusa um email já usado em qualquer shard, por qualquer processo. A reserva sai
+// se a gravação no shard falhar e, num update que troca o email, o antigo é liberado depois.
+class ShardedClientRepository : public ecocin::domain::repositories::IClientRepository {
+private:
+    ecocin::infra::db::ShardSet& shards_;
+    std::vector<std::unique_ptr<sqlite::ClientRepositorySqlite>> repos_;
+
+    ecocin::infra::db::SqliteConnection& registry() { return shards_.shard(0); }
+    void reserveEmail(const std::string& email, const char* where);
+    void releaseEmail(const std::string& email) noexcept;
+
+public:
+    explicit ShardedClientRepository(ecocin::infra::db::ShardSet& shards);
+
+    // Recria client_emails a partir dos clientes de todos os shards. Roda no boot, antes das pilhas:
+    // descarta reservas que ficaram para trás numa queda entre a reserva e a gravação no shard.
+    static void rebuildEmailRegistry(ecocin::infra::db::ShardSet& shards);
+
+    Client create(const Client& in) override;
+    std::optional<Client> findById(long long id) override;
+    std::optional<Client> findByCpf(const std::string& cpf) override;
+    std::vector<Client> findByIds(const std::vector<long long>& ids) override;
+    std::vector<Client> findByCpfs(const std::vector<std::string>& cpfs) override;
+    std::vector<Client> listAll() override;
+    std::pmr::vector<Client> listAll(std::pmr::memory_resource* mr) override;
+    bool update(const Client& c) override;
+    bool remove(long long id) override;
+};
+
+} // namespace ecocin::infra::repositories::sharded
+
+#endif // ECOCIN_INFRA_REPOSITORIES_SHARDED_SHARDEDCLIENTREPOSITORY_H
@@ -0,0 +1,73 @@
+#ifndef ECOCIN_INFRA_REPOSITORIES_SHARDED_SHARDEDHELPERS_H
+#define ECOCIN_INFRA_REPOSITORIES_SHARDED_SHARDEDHELPERS_H
+
+#include "infra/repositories/sqlite/Helpers.h"
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <queue>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace ecocin::infra::repositories::sharded {
+
+// findBy* em lista sobre vários shards: separa as chaves pelo shard de cada uma (shardOf devolve
+// std::nullopt para chaves que não podem existir), faz uma consulta em lista por shard com
+// fetch(shard, chaves) e devolve tudo na ordem da primeira ocorrência em keys, como no SQLite.
+template <class Key, class ShardOf, class Fetch, class KeyOf>
+auto gather_by_shard(std::size_t shardCount, const std::vector<Key>& keys, ShardOf shardOf, Fetch fetch, KeyOf keyOf) {
+    using T = typename decltype(fetch(std::size_t{0}, keys))::value_type;
+    const auto distinct = distinct_keys(keys);
+    std::vector<std::vector<Key>> perShard(shardCount);
+    for (const auto& k : distinct) {
+        if (auto s = shardOf(k)) perShard[*s].push_back(k);
+    }
+
+    std::unordered_map<Key, T> found;
+    found.reserve(distinct.size());
+    for (std::size_t s = 0; s < shardCount; ++s) {
+        if (perShard[s].empty()) continue;
+        for (auto& item : fetch(s, perShard[s])) {
+            Key key = keyOf(item);
+            found.emplace(std::move(key), std::move(item));
+        }
+    }
+    return in_key_order(distinct, found);
+}
+
+// listAll de todos os shards (std::vector ou std::pmr::vector) na ordem de um banco só: cada shard
+// devolve a sua lista em ordem decrescente de keyOf (id DESC) e as listas são intercaladas por um heap.
+template <class Vec, class Repo, class List, class KeyOf>
+Vec merge_shards(const std::vector<std::unique_ptr<Repo>>& repos, Vec out, List list, KeyOf keyOf) {
+    using Part = decltype(list(*repos.front()));
+    std::vector<Part> parts;
+    parts.reserve(repos.size());
+    std::size_t total = 0;
+    for (const auto& repo : repos) {
+        parts.push_back(list(*repo));
+        total += parts.back().size();
+    }
+    out.reserve(out.size() + total);
+
+    // (chave da cabeça, shard); o maior sai primeiro
+    using Head = std::pair<decltype(keyOf(parts.front().front())), std::size_t>;
+    std::priority_queue<Head> heads;
+    std::vector<std::size_t> next(parts.size(), 0);
+    for (std::size_t s = 0; s < parts.size(); ++s) {
+        if (!parts[s].empty()) heads.emplace(keyOf(parts[s].front()), s);
+    }
+    while (!heads.empty()) {
+        const auto s = heads.top().second;
+        heads.pop();
+        out.push_back(std::move(parts[s][next[s]++]));
+        if (next[s] < parts[s].size()) heads.emplace(keyOf(parts[s][next[s]]), s);
+    }
+    return out;
+}
+
+} // namespace ecocin::infra::repositories::sharded
+
+#endif // ECOCIN_INFRA_REPOSITORIES_SHARDED_SHARDEDHELPERS_H
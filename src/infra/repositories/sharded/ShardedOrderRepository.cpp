@@ -0,0 +1,75 @@
+#include "ShardedOrderRepository.h"
+#include "ShardedHelpers.h"
+
+#include <stdexcept>
+
+namespace ecocin::infra::repositories::sharded {
+
+ShardedOrderRepository::ShardedOrderRepository(ecocin::infra::db::ShardSet& shards) : shards_(shards) {
+    for (std::size_t i = 0; i < shards_.size(); ++i) {
+        repos_.push_back(std::make_unique<sqlite::OrderRepositorySqlite>(shards_.shard(i)));
+    }
+}
+
+sqlite::OrderRepositorySqlite* ShardedOrderRepository::byId(long long id) {
+    const auto shard = shards_.shardOfId(id);
+    return shard ? repos_[*shard].get() : nullptr;
+}
+
+Order ShardedOrderRepository::create(const Order& in) {
+    auto* repo = byId(in.getClientId());
+    if (!repo) throw std::runtime_error("client_id " + std::to_string(in.getClientId()) + " não pertence a nenhum shard");
+    return repo->create(in);
+}
+
+std::optional<Order> ShardedOrderRepository::findById(long long id) {
+    auto* repo = byId(id);
+    if (!repo) return std::nullopt;
+    return repo->findById(id);
+}
+
+std::vector<Order> ShardedOrderRepository::listAll() {
+    return merge_shards(repos_, std::vector<Order>{}, [](auto& repo) { return repo.listAll(); },
+                        [](const Order& x) { return x.getId(); });
+}
+
+std::pmr::vector<Order> ShardedOrderRepository::listAll(std::pmr::memory_resource* mr) {
+    return merge_shards(repos_, std::pmr::vector<Order>(mr), [&](auto& repo) { return repo.listAll(mr); },
+                        [](const Order& x) { return x.getId(); });
+}
+
+// O pedido não muda de shard: trocar o cliente para um de outro shard devolve false
+bool ShardedOrderRepository::update(const Order& o) {
+    auto* repo = byId(o.getId());
+    if (!repo || repo != byId(o.getClientId())) return false;
+    return repo->update(o);
+}
+
+bool ShardedOrderRepository::remove(long long id) {
+    auto* repo = byId(id);
+    return repo && repo->remove(id);
+}
+
+std::vector<Order> ShardedOrderRepository::listByClientId(long long clientId) {
+    auto* repo = byId(clientId);
+    if (!repo) return {};
+    return repo->listByClientId(clientId);
+}
+
+std::pmr::vector<Order> ShardedOrderRepository::listByClientId(long long clientId, std::pmr::memory_resource* mr) {
+    auto* repo = byId(clientId);
+    if (!repo) return std::pmr::vector<Order>(mr);
+    return repo->listByClientId(clientId, mr);
+}
+
+bool ShardedOrderRepository::updateStatus(long long id, const std::string& newStatus) {
+    auto* repo = byId(id);
+    return repo && repo->updateStatus(id, newStatus);
+}
+
+bool ShardedOrderRepository::updateShippingAddress(long long id, long long newAddressId) {
+    auto* repo = byId(id);
+    return repo && repo->updateShippingAddress(id, newAddressId);
+}
+
+} // namespace ecocin::infra::repositories::sharded
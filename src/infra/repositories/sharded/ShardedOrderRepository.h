@@ -0,0 +1,40 @@
+#ifndef ECOCIN_INFRA_REPOSITORIES_SHARDED_SHARDEDORDERREPOSITORY_H
+#define ECOCIN_INFRA_REPOSITORIES_SHARDED_SHARDEDORDERREPOSITORY_H
+
+#include "domain/repositories/IOrderRepository.h"
+#include "infra/db/ShardSet.h"
+#include "infra/repositories/sqlite/OrderRepositorySqlite.h"
+
+#include <memory>
+
+namespace ecocin::infra::repositories::sharded {
+
+// Pedidos no shard do cliente (client_id), ao lado do cliente e do endereço de entrega que as
+// chaves estrangeiras exigem; o produto vem da cópia do catálogo em cada shard. Criar pedidos
+// de clientes diferentes em shards diferentes não disputa o mesmo lock de escrita.
+class ShardedOrderRepository : public ecocin::domain::repositories::IOrderRepository {
+private:
+    ecocin::infra::db::ShardSet& shards_;
+    std::vector<std::unique_ptr<sqlite::OrderRepositorySqlite>> repos_;
+
+    sqlite::OrderRepositorySqlite* byId(long long id);
+
+public:
+    explicit ShardedOrderRepository(ecocin::infra::db::ShardSet& shards);
+
+    Order create(const Order& in) override;
+    std::optional<Order> findById(long long id) override;
+    std::vector<Order> listAll() override;
+    std::pmr::vector<Order> listAll(std::pmr::memory_resource* mr) override;
+    bool update(const Order& o) override;
+    bool remove(long long id) override;
+
+    std::vector<Order> listByClientId(long long clientId) override;
+    std::pmr::vector<Order> listByClientId(long long clientId, std::pmr::memory_resource* mr) override;
+    bool updateStatus(long long id, const std::string& newStatus) override;
+    bool updateShippingAddress(long long id, long long newAddressId) override;
+};
+
+} // namespace ecocin::infra::repositories::sharded
+
+#endif // ECOCIN_INFRA_REPOSITORIES_SHARDED_SHARDEDORDERREPOSITORY_H
@@ -0,0 +1,75 @@
+#include "ShardedProductRepository.h"
+
+namespace ecocin::infra::repositories::sharded {
+
+ShardedProductRepository::ShardedProductRepository(ecocin::infra::db::ShardSet& shards) {
+    for (std::size_t i = 0; i < shards.size(); ++i) {
+        repos_.push_back(std::make_unique<sqlite::ProductRepositorySqlite>(shards.shard(i)));
+    }
+}
+
+void ShardedProductRepository::replicate(const Product& p) {
+    for (std::size_t i = 1; i < repos_.size(); ++i) repos_[i]->upsert(p);
+}
+
+// Se uma cópia falhar, o produto sai das cópias já gravadas e do catálogo antes de propagar o erro:
+// ainda não foi devolvido a ninguém, e um produto só no catálogo recusaria pedidos nos outros shards
+// pela chave estrangeira. A limpeza é melhor esforço; o erro que sobe é o da cópia.
+Product ShardedProductRepository::create(const Product& in) {
+    auto p = catalog().create(in);
+    std::size_t copied = 1;
+    try {
+        for (; copied < repos_.size(); ++copied) repos_[copied]->upsert(p);
+    } catch (...) {
+        try {
+            for (std::size_t i = 1; i < copied; ++i) repos_[i]->remove(p.getId());
+            catalog().remove(p.getId());
+        } catch (...) {
+        }
+        throw;
+    }
+    return p;
+}
+
+std::optional<Product> ShardedProductRepository::findById(long long id) { return catalog().findById(id); }
+std::optional<Product> ShardedProductRepository::findBySku(const std::string& sku) { return catalog().findBySku(sku); }
+std::vector<Product> ShardedProductRepository::findByIds(const std::vector<long long>& ids) { return catalog().findByIds(ids); }
+std::vector<Product> ShardedProductRepository::findBySkus(const std::vector<std::string>& skus) { return catalog().findBySkus(skus); }
+std::vector<Product> ShardedProductRepository::listAll() { return catalog().listAll(); }
+std::pmr::vector<Product> ShardedProductRepository::listAll(std::pmr::memory_resource* mr) { return catalog().listAll(mr); }
+
+// As cópias recebem a linha como ficou no catálogo (o update só grava as colunas alteradas)
+bool ShardedProductRepository::update(const Product& p) {
+    if (!catalog().update(p)) return false;
+    if (repos_.size() > 1) {
+        if (auto fresh = catalog().findById(p.getId())) replicate(*fresh);
+    }
+    return true;
+}
+
+std::optional<ecocin::domain::repositories::ProductFieldUpdate<int>>
+ShardedProductRepository::adjustStock(long long id, int delta) {
+    return catalog().adjustStock(id, delta);
+}
+
+std::optional<ecocin::domain::repositories::ProductFieldUpdate<double>>
+ShardedProductRepository::updatePrice(long long id, double price) {
+    return catalog().updatePrice(id, price);
+}
+
+// Cópias primeiro, catálogo por último: um produto com pedidos num shard falha ali pela chave
+// estrangeira, e as cópias já apagadas em outros shards são regravadas antes de propagar o erro.
+bool ShardedProductRepository::remove(long long id) {
+    const auto found = catalog().findById(id);
+    if (!found) return false;
+    std::size_t removed = 1;
+    try {
+        for (; removed < repos_.size(); ++removed) repos_[removed]->remove(id);
+        return catalog().remove(id);
+    } catch (...) {
+        for (std::size_t i = 1; i < removed; ++i) repos_[i]->upsert(*found);
+        throw;
+    }
+}
+
+} // namespace ecocin::infra::repositories::sharded
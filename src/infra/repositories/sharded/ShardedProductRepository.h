@@ -0,0 +1,42 @@
+#ifndef ECOCIN_INFRA_REPOSITORIES_SHARDED_SHARDEDPRODUCTREPOSITORY_H
+#define ECOCIN_INFRA_REPOSITORIES_SHARDED_SHARDEDPRODUCTREPOSITORY_H
+
+#include "domain/repositories/IProductRepository.h"
+#include "infra/db/ShardSet.h"
+#include "infra/repositories/sqlite/ProductRepositorySqlite.h"
+
+#include <memory>
+
+namespace ecocin::infra::repositories::sharded {
+
+// Produtos não são particionados: o shard 0 é o catálogo, fonte de verdade de todas as leituras
+// e das escritas de estoque e preço. Os demais shards guardam uma cópia de cada produto (mesmo id)
+// só para que orders.product_id tenha a linha que a chave estrangeira exige; create e update
+// regravam a cópia inteira, enquanto adjustStock/updatePrice ficam só no catálogo (ninguém lê
+// estoque nem preço das cópias). Escritas no catálogo são raras perto das de pedidos.
+class ShardedProductRepository : public ecocin::domain::repositories::IProductRepository {
+private:
+    std::vector<std::unique_ptr<sqlite::ProductRepositorySqlite>> repos_;
+
+    sqlite::ProductRepositorySqlite& catalog() { return *repos_.front(); }
+    void replicate(const Product& p);
+
+public:
+    explicit ShardedProductRepository(ecocin::infra::db::ShardSet& shards);
+
+    Product create(const Product& in) override;
+    std::optional<Product> findById(long long id) override;
+    std::optional<Product> findBySku(const std::string& sku) override;
+    std::vector<Product> findByIds(const std::vector<long long>& ids) override;
+    std::vector<Product> findBySkus(const std::vector<std::string>& skus) override;
+    std::vector<Product> listAll() override;
+    std::pmr::vector<Product> listAll(std::pmr::memory_resource* mr) override;
+    bool update(const Product& p) override;
+    std::optional<ecocin::domain::repositories::ProductFieldUpdate<int>> adjustStock(long long id, int delta) override;
+    std::optional<ecocin::domain::repositories::ProductFieldUpdate<double>> updatePrice(long long id, double price) override;
+    bool remove(long long id) override;
+};
+
+} // namespace ecocin::infra::repositories::sharded
+
+#endif // ECOCIN_INFRA_REPOSITORIES_SHARDED_SHARDEDPRODUCTREPOSITORY_H
@@ -1,5 +1,6 @@
 #include "AddressRepositorySqlite.h"
 #include "Helpers.h"
+#include "../../metrics/Metrics.h"
 #include <chrono>
 
 
@@ -16,6 +17,7 @@ static Address row_to_address(sqlite3_stmt* s) {
 
     long long secs = sqlite3_column_int64(s, 8);
     address.setCreateDate(std::chrono::system_clock::time_point{std::chrono::seconds{secs}});
+    address.clearDirty(); // igual ao banco: o próximo update grava só o que mudar
     return address;
 }
 
@@ -25,12 +27,13 @@ static Address row_to_address(sqlite3_stmt* s) {
 // O encapsulamento aqui garante que a lógica de acesso a dados está isolada,
 // um princípio fundamental para a manutenibilidade do código.
 Address ecocin::infra::repositories::sqlite::AddressRepositorySqlite::create(const Address& in) {
+    static auto& metric = ecocin::infra::metrics::dbOp("addresses", "create");
+    ecocin::infra::metrics::DbOpTimer timer{metric};
     Address address = in;
     const char* sql = "INSERT INTO addresses(client_id,street,number,city,state,zip,address_type,create_date) VALUES(?,?,?,?,?,?,?,?)";
-    sqlite3_stmt* st = nullptr;
     auto now = std::chrono::system_clock::now();
     address.setCreateDate(now);
-    sqlite_check(sqlite3_prepare_v2(connection_.raw(), sql, -1, &st, nullptr), connection_.raw(), "prepare insert address");
+    ecocin::infra::db::Statement st(connection_, sql, "prepare insert address");
     sqlite3_bind_int64(st, 1, address.getClientId());
     sqlite3_bind_text(st, 2, address.getStreet().c_str(), -1, SQLITE_TRANSIENT);
     sqlite3_bind_text(st, 3, address.getNumber().c_str(), -1, SQLITE_TRANSIENT);
@@ -40,8 +43,8 @@ Address ecocin::infra::repositories::sqlite::AddressRepositorySqlite::create(con
     sqlite3_bind_text(st, 7, address.getAddressType().c_str(), -1, SQLITE_TRANSIENT);
     sqlite3_bind_int64(st, 8, std::chrono::duration_cast<std::chrono::seconds>(address.getCreateDate().time_since_epoch()).count());
     sqlite_check(sqlite3_step(st), connection_.raw(), "step insert address");
-    sqlite3_finalize(st);
     address.setId(static_cast<long long>(sqlite3_last_insert_rowid(connection_.raw())));
+    address.clearDirty();
     return address;
 }
 
@@ -50,71 +53,130 @@ Address ecocin::infra::repositories::sqlite::AddressRepositorySqlite::create(con
 // sabe como consultar e construir um objeto 'Address' a partir de uma linha do banco de dados.
 // O uso de std::optional indica claramente que um endereço pode não ser encontrado.
 std::optional<Address> ecocin::infra::repositories::sqlite::AddressRepositorySqlite::findById(long long id) {
+    static auto& metric = ecocin::infra::metrics::dbOp("addresses", "findById");
+    ecocin::infra::metrics::DbOpTimer timer{metric};
     const char* sql = "SELECT id,client_id,street,number,city,state,zip,address_type,create_date FROM addresses WHERE id=?";
-    sqlite3_stmt* st = nullptr;
-    sqlite_check(sqlite3_prepare_v2(connection_.raw(), sql, -1, &st, nullptr), connection_.raw(), "prepare get address");
+    ecocin::infra::db::Statement st(connection_, sql, "prepare get address");
     sqlite3_bind_int64(st, 1, id);
     if (sqlite3_step(st) == SQLITE_ROW) {
         auto addr = row_to_address(st);
-        sqlite3_finalize(st);
         return addr;
     }
-    sqlite3_finalize(st);
     return std::nullopt;
 }
 
+// Busca vários endereços pelo ID numa única consulta (IN)
+std::vector<Address> ecocin::infra::repositories::sqlite::AddressRepositorySqlite::findByIds(const std::vector<long long>& ids) {
+    static auto& metric = ecocin::infra::metrics::dbOp("addresses", "findByIds");
+    ecocin::infra::metrics::DbOpTimer timer{metric};
+    const auto keys = distinct_keys(ids);
+    std::unordered_map<long long, Address> found;
+    found.reserve(keys.size());
+    query_in_list(connection_,
+        "SELECT id,client_id,street,number,city,state,zip,address_type,create_date FROM addresses WHERE id IN ",
+        keys, "get addresses by ids",
+        [](sqlite3_stmt* s, int i, long long id) { sqlite3_bind_int64(s, i, id); },
+        [&](sqlite3_stmt* s) { auto a = row_to_address(s); found.emplace(a.getId(), std::move(a)); });
+    return in_key_order(keys, found);
+}
 
 // Retorna uma lista de todos os endereços associados a um cliente específico.
 // A consulta SQL é otimizada para ordenar os resultados, e o método abstrai
 // completamente a complexidade dessa operação para a camada de serviço.
-std::vector<Address> ecocin::infra::repositories::sqlite::AddressRepositorySqlite::listByClientId(long long clientId) {
+template <class Vec>
+Vec ecocin::infra::repositories::sqlite::AddressRepositorySqlite::listByClientIdInto(long long clientId, Vec out) {
+    static auto& metric = ecocin::infra::metrics::dbOp("addresses", "listByClientId");
+    ecocin::infra::metrics::DbOpTimer timer{metric};
     const char* sql =
         "SELECT id,client_id,street,number,city,state,zip,address_type,create_date "
         "FROM addresses WHERE client_id=? ORDER BY create_date DESC, id DESC";
-    sqlite3_stmt* st = nullptr;
-    sqlite_check(sqlite3_prepare_v2(connection_.raw(), sql, -1, &st, nullptr),
-                 connection_.raw(), "prepare list addresses by client");
+    ecocin::infra::db::Statement st(connection_, sql, "prepare list addresses by client");
     sqlite3_bind_int64(st, 1, clientId);
 
-    std::vector<Address> out;
     while (sqlite3_step(st) == SQLITE_ROW) {
         out.emplace_back(row_to_address(st));
     }
-    sqlite3_finalize(st);
     return out;
 }
 
+std::vector<Address> ecocin::infra::repositories::sqlite::AddressRepositorySqlite::listByClientId(long long clientId) {
+    return listByClientIdInto(clientId, std::vector<Address>{});
+}
+
+// Mesma listagem, com o vetor alocado em mr (ex.: a arena da requisição)
+std::pmr::vector<Address> ecocin::infra::repositories::sqlite::AddressRepositorySqlite::listByClientId(long long clientId, std::pmr::memory_resource* mr) {
+    return listByClientIdInto(clientId, std::pmr::vector<Address>(mr));
+}
+
+// Endereço mais recente de um tipo (ex.: "CASA") para o cliente.
+// O filtro por address_type fica no SQL, com a mesma ordem de listByClientId, para que o
+// índice (client_id, address_type, create_date) entregue direto a primeira linha.
+std::optional<Address> ecocin::infra::repositories::sqlite::AddressRepositorySqlite::findByClientIdAndType(long long clientId, const std::string& type) {
+    static auto& metric = ecocin::infra::metrics::dbOp("addresses", "findByClientIdAndType");
+    ecocin::infra::metrics::DbOpTimer timer{metric};
+    const char* sql =
+        "SELECT id,client_id,street,number,city,state,zip,address_type,create_date "
+        "FROM addresses WHERE client_id=? AND address_type=? ORDER BY create_date DESC, id DESC LIMIT 1";
+    ecocin::infra::db::Statement st(connection_, sql, "prepare get address by client and type");
+    sqlite3_bind_int64(st, 1, clientId);
+    sqlite3_bind_text(st, 2, type.c_str(), -1, SQLITE_TRANSIENT);
+    if (sqlite3_step(st) == SQLITE_ROW) {
+        return row_to_address(st);
+    }
+    return std::nullopt;
+}
+
 
 // Lista todos os endereços cadastrados no sistema.
 // Embora simples, este método mantém a consistência da interface do repositório,
 // fornecendo uma forma padronizada de acessar coleções de entidades.
-std::vector<Address> ecocin::infra::repositories::sqlite::AddressRepositorySqlite::listAll() {
+template <class Vec>
+Vec ecocin::infra::repositories::sqlite::AddressRepositorySqlite::listAllInto(Vec out) {
+    static auto& metric = ecocin::infra::metrics::dbOp("addresses", "listAll");
+    ecocin::infra::metrics::DbOpTimer timer{metric};
     const char* sql = "SELECT id,client_id,street,number,city,state,zip,address_type,create_date FROM addresses ORDER BY id DESC";
-    sqlite3_stmt* st = nullptr;
-    sqlite_check(sqlite3_prepare_v2(connection_.raw(), sql, -1, &st, nullptr), connection_.raw(), "prepare list addresses");
-    std::vector<Address> out;
+    ecocin::infra::db::Statement st(connection_, sql, "prepare list addresses");
     while (sqlite3_step(st) == SQLITE_ROW) out.push_back(row_to_address(st));
-    sqlite3_finalize(st);
     return out;
+}
+
+std::vector<Address> ecocin::infra::repositories::sqlite::AddressRepositorySqlite::listAll() {
+    return listAllInto(std::vector<Address>{});
+}
+
+std::pmr::vector<Address> ecocin::infra::repositories::sqlite::AddressRepositorySqlite::listAll(std::pmr::memory_resource* mr) {
+    return listAllInto(std::pmr::vector<Address>(mr));
 }   
 
 // Atualiza os dados de um endereço existente. O método recebe um objeto 'Address'
 // e persiste suas alterações no banco de dados. A separação de interesses é clara:
 // o objeto de domínio contém os dados, e o repositório sabe como salvá-los.
+// Grava só as colunas alteradas desde o carregamento (Address::dirtyFields).
 bool ecocin::infra::repositories::sqlite::AddressRepositorySqlite::update(const Address& addr) {
-    const char* sql = "UPDATE addresses SET street=?, number=?, city=?, state=?, zip=?, address_type=? WHERE id=?";
-    sqlite3_stmt* st = nullptr;
-    sqlite_check(sqlite3_prepare_v2(connection_.raw(), sql, -1, &st, nullptr), connection_.raw(), "prepare update address");
-    sqlite3_bind_text(st, 1, addr.getStreet().c_str(), -1, SQLITE_TRANSIENT);
-    sqlite3_bind_text(st, 2, addr.getNumber().c_str(), -1, SQLITE_TRANSIENT);
-    sqlite3_bind_text(st, 3, addr.getCity().c_str(), -1, SQLITE_TRANSIENT);
-    sqlite3_bind_text(st, 4, addr.getState().c_str(), -1, SQLITE_TRANSIENT);
-    sqlite3_bind_text(st, 5, addr.getZip().c_str(), -1 , SQLITE_TRANSIENT);
-    sqlite3_bind_text(st, 6, addr.getAddressType().c_str(), -1, SQLITE_TRANSIENT);
-    sqlite3_bind_int64(st, 7, addr.getId());
+    static auto& metric = ecocin::infra::metrics::dbOp("addresses", "update");
+    ecocin::infra::metrics::DbOpTimer timer{metric};
+    static MaskedUpdate updates("addresses", {"street", "number", "city", "state", "zip", "address_type"});
+
+    const std::uint32_t mask = addr.dirtyFields();
+    if (mask == 0) {
+        ecocin::infra::db::Statement st(connection_, updates.existsSql(), "prepare update address");
+        sqlite3_bind_int64(st, 1, addr.getId());
+        const int rc = sqlite3_step(st);
+        sqlite_check(rc, connection_.raw(), "step update address");
+        return rc == SQLITE_ROW;
+    }
+
+    ecocin::infra::db::Statement st(connection_, updates.sql(mask), "prepare update address");
+    int i = 1;
+    if (mask & Address::kStreet)      sqlite3_bind_text(st, i++, addr.getStreet().c_str(), -1, SQLITE_TRANSIENT);
+    if (mask & Address::kNumber)      sqlite3_bind_text(st, i++, addr.getNumber().c_str(), -1, SQLITE_TRANSIENT);
+    if (mask & Address::kCity)        sqlite3_bind_text(st, i++, addr.getCity().c_str(), -1, SQLITE_TRANSIENT);
+    if (mask & Address::kState)       sqlite3_bind_text(st, i++, addr.getState().c_str(), -1, SQLITE_TRANSIENT);
+    if (mask & Address::kZip)         sqlite3_bind_text(st, i++, addr.getZip().c_str(), -1, SQLITE_TRANSIENT);
+    if (mask & Address::kAddressType) sqlite3_bind_text(st, i++, addr.getAddressType().c_str(), -1, SQLITE_TRANSIENT);
+    sqlite3_bind_int64(st, i, addr.getId());
     sqlite_check(sqlite3_step(st), connection_.raw(), "step update address");
     int changes = sqlite3_changes(connection_.raw());
-    sqlite3_finalize(st);
     return changes > 0;
 }   
 
@@ -122,12 +184,22 @@ bool ecocin::infra::repositories::sqlite::AddressRepositorySqlite::update(const
 // Esta operação é encapsulada para garantir que a remoção seja feita de forma segura
 // e que a lógica de negócio não precise se preocupar com os detalhes da exclusão no banco.
 bool ecocin::infra::repositories::sqlite::AddressRepositorySqlite::remove(long long id) {
+    static auto& metric = ecocin::infra::metrics::dbOp("addresses", "remove");
+    ecocin::infra::metrics::DbOpTimer timer{metric};
     const char* sql = "DELETE FROM addresses WHERE id=?";
-    sqlite3_stmt* st = nullptr;
-    sqlite_check(sqlite3_prepare_v2(connection_.raw(), sql, -1, &st, nullptr), connection_.raw(), "prepare delete address");
+    ecocin::infra::db::Statement st(connection_, sql, "prepare delete address");
     sqlite3_bind_int64(st, 1, id);
     sqlite_check(sqlite3_step(st), connection_.raw(), "step delete address");
     int changes = sqlite3_changes(connection_.raw());
-    sqlite3_finalize(st);
     return changes > 0;
 }
+
+// Varredura colunar de endereços (ver infra/db/ColumnBatch.h)
+ecocin::infra::db::ColumnBatch ecocin::infra::repositories::sqlite::AddressRepositorySqlite::scanColumns(
+    const std::vector<std::string>& columns, long long afterId, std::size_t limit) {
+    static auto& metric = ecocin::infra::metrics::dbOp("addresses", "scanColumns");
+    ecocin::infra::metrics::DbOpTimer timer{metric};
+    return ecocin::infra::db::ColumnBatch::scan(connection_, "addresses",
+        {"id", "client_id", "street", "number", "city", "state", "zip", "address_type", "create_date"},
+        columns, afterId, limit);
+}
@@ -2,6 +2,7 @@
 #define ECOCIN_INFRA_REPOSITORIES_SQLITE_ADDRESSREPOSITORYSQLITE_H
 
 #include "domain/repositories/IAddressRepository.h"
+#include "infra/db/ColumnBatch.h"
 #include "infra/db/SqliteConnection.h"
 
 namespace ecocin::infra::repositories::sqlite {
@@ -10,15 +11,28 @@ namespace ecocin::infra::repositories::sqlite {
 class AddressRepositorySqlite : public ecocin::domain::repositories::IAddressRepository {
 private:
     ecocin::infra::db::SqliteConnection& connection_; 
+
+    // Corpo comum das listagens: preenche out (std::vector ou std::pmr::vector) e o devolve
+    template <class Vec> Vec listAllInto(Vec out);
+    template <class Vec> Vec listByClientIdInto(long long clientId, Vec out);
 public:
     explicit AddressRepositorySqlite(ecocin::infra::db::SqliteConnection& connection) : connection_(connection) {}
 
     Address create(const Address& in) override;
     std::optional<Address> findById(long long id) override;
+    std::vector<Address> findByIds(const std::vector<long long>& ids) override;
     std::vector<Address> listAll() override;
+    std::pmr::vector<Address> listAll(std::pmr::memory_resource* mr) override;
     bool update(const Address& addr) override;
     bool remove(long long id) override;
     std::vector<Address> listByClientId(long long clientId) override;
+    std::pmr::vector<Address> listByClientId(long long clientId, std::pmr::memory_resource* mr) override;
+    std::optional<Address> findByClientIdAndType(long long clientId, const std::string& type) override;
+
+    // Varredura colunar (infra/db/ColumnBatch.h): só as colunas pedidas, em ordem de id e, com
+    // limit, em lotes (o afterId do próximo lote é lastId() do anterior)
+    ecocin::infra::db::ColumnBatch scanColumns(const std::vector<std::string>& columns,
+                                               long long afterId = 0, std::size_t limit = 0);
 };
 }
 #endif
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include "ClientRepositorySqlite.h"
 #include "Helpers.h"
+#include "../../metrics/Metrics.h"
 #include <chrono>
 
 
@@ -11,6 +12,7 @@ static Client row_to_client(sqlite3_stmt* s) {
     client.setCpf(reinterpret_cast<const char*>(sqlite3_column_text(s, 3)));
     long long secs = sqlite3_column_int64(s, 4);
     client.setCreateDate(std::chrono::system_clock::time_point{std::chrono::seconds{secs}});
+    client.clearDirty(); // igual ao banco: o próximo update grava só o que mudar
     return client;
 }
 
@@ -20,6 +22,8 @@ static Client row_to_client(sqlite3_stmt* s) {
 // A abstração do acesso a dados permite que o resto da aplicação
 // manipule objetos 'Client' sem conhecer os detalhes do SQL.
 Client ecocin::infra::repositories::sqlite::ClientRepositorySqlite::create(const Client& in) {
+    static auto& metric = ecocin::infra::metrics::dbOp("clients", "create");
+    ecocin::infra::metrics::DbOpTimer timer{metric};
     Client client = in;
 
     // agora
@@ -29,16 +33,15 @@ Client ecocin::infra::repositories::sqlite::ClientRepositorySqlite::create(const
 
     // use a MESMA coluna da migration (create_date)
     const char* sql = "INSERT INTO clients(name,email,cpf,create_date) VALUES(?,?,?,?)";
-    sqlite3_stmt* st = nullptr;
-    sqlite_check(sqlite3_prepare_v2(connection_.raw(), sql, -1, &st, nullptr), connection_.raw(), "prepare insert client");
+    ecocin::infra::db::Statement st(connection_, sql, "prepare insert client");
     sqlite3_bind_text(st, 1, client.getName().c_str(),  -1, SQLITE_TRANSIENT);
     sqlite3_bind_text(st, 2, client.getEmail().c_str(), -1, SQLITE_TRANSIENT);
     sqlite3_bind_text(st, 3, client.getCpf().c_str(),   -1, SQLITE_TRANSIENT);
     sqlite3_bind_int64(st, 4, epoch);
     sqlite_check(sqlite3_step(st), connection_.raw(), "step insert client");
-    sqlite3_finalize(st);
 
     client.setId(static_cast<long long>(sqlite3_last_insert_rowid(connection_.raw())));
+    client.clearDirty();
     return client;
 }
 
@@ -47,16 +50,15 @@ Client ecocin::infra::repositories::sqlite::ClientRepositorySqlite::create(const
 // O uso de `std::optional` é uma boa prática que torna explícito que o cliente
 // pode não existir, evitando o uso de ponteiros nulos ou exceções para controle de fluxo.
 std::optional<Client> ecocin::infra::repositories::sqlite::ClientRepositorySqlite::findById(long long id) {
+    static auto& metric = ecocin::infra::metrics::dbOp("clients", "findById");
+    ecocin::infra::metrics::DbOpTimer timer{metric};
     const char* sql = "SELECT id,name,email,cpf,create_date FROM clients WHERE id=?";
-    sqlite3_stmt* st = nullptr;
-    sqlite_check(sqlite3_prepare_v2(connection_.raw(), sql, -1, &st, nullptr), connection_.raw(), "prepare get client");
+    ecocin::infra::db::Statement st(connection_, sql, "prepare get client");
     sqlite3_bind_int64(st, 1, id);
     if (sqlite3_step(st) == SQLITE_ROW) {
         auto c = row_to_client(st);
-        sqlite3_finalize(st);
         return c;
     }
-    sqlite3_finalize(st);
     return std::nullopt;
 }
 
@@ -64,50 +66,101 @@ std::optional<Client> ecocin::infra::repositories::sqlite::ClientRepositorySqlit
 // Assim como o `findById`, este método isola a lógica de acesso a dados
 // e utiliza `std::optional` para um retorno seguro e claro.
 std::optional<Client> ecocin::infra::repositories::sqlite::ClientRepositorySqlite::findByCpf(const std::string& cpf) {
+    static auto& metric = ecocin::infra::metrics::dbOp("clients", "findByCpf");
+    ecocin::infra::metrics::DbOpTimer timer{metric};
     const char* sql = "SELECT id,name,email,cpf,create_date FROM clients WHERE cpf=?";
-    sqlite3_stmt* st = nullptr;
-    sqlite_check(sqlite3_prepare_v2(connection_.raw(), sql, -1, &st, nullptr), connection_.raw(), "prepare get client by cpf");
+    ecocin::infra::db::Statement st(connection_, sql, "prepare get client by cpf");
     sqlite3_bind_text(st, 1, cpf.c_str(), -1, SQLITE_TRANSIENT);
     if (sqlite3_step(st) == SQLITE_ROW) {
         auto c = row_to_client(st);
-        sqlite3_finalize(st);
         return c;
     }
-    sqlite3_finalize(st);
     return std::nullopt;
 }
 
+// Busca vários clientes pelo ID numa única consulta (IN)
+std::vector<Client> ecocin::infra::repositories::sqlite::ClientRepositorySqlite::findByIds(const std::vector<long long>& ids) {
+    static auto& metric = ecocin::infra::metrics::dbOp("clients", "findByIds");
+    ecocin::infra::metrics::DbOpTimer timer{metric};
+    const auto keys = distinct_keys(ids);
+    std::unordered_map<long long, Client> found;
+    found.reserve(keys.size());
+    query_in_list(connection_, "SELECT id,name,email,cpf,create_date FROM clients WHERE id IN ", keys,
+        "get clients by ids",
+        [](sqlite3_stmt* s, int i, long long id) { sqlite3_bind_int64(s, i, id); },
+        [&](sqlite3_stmt* s) { auto c = row_to_client(s); found.emplace(c.getId(), std::move(c)); });
+    return in_key_order(keys, found);
+}
+
+// Mesmo que findByIds, pelo CPF
+std::vector<Client> ecocin::infra::repositories::sqlite::ClientRepositorySqlite::findByCpfs(const std::vector<std::string>& cpfs) {
+    static auto& metric = ecocin::infra::metrics::dbOp("clients", "findByCpfs");
+    ecocin::infra::metrics::DbOpTimer timer{metric};
+    const auto keys = distinct_keys(cpfs);
+    std::unordered_map<std::string, Client> found;
+    found.reserve(keys.size());
+    query_in_list(connection_, "SELECT id,name,email,cpf,create_date FROM clients WHERE cpf IN ", keys,
+        "get clients by cpfs",
+        [](sqlite3_stmt* s, int i, const std::string& k) {
+            sqlite3_bind_text(s, i, k.data(), static_cast<int>(k.size()), SQLITE_STATIC);
+        },
+        [&](sqlite3_stmt* s) { auto c = row_to_client(s); found.emplace(c.getCpf(), std::move(c)); });
+    return in_key_order(keys, found);
+}
+
 // Retorna uma lista com todos os clientes cadastrados.
 // A responsabilidade de consultar e montar a coleção de objetos 'Client'
 // é totalmente delegada a este método, simplificando as camadas superiores da aplicação.
-std::vector<Client> ecocin::infra::repositories::sqlite::ClientRepositorySqlite::listAll() {
+template <class Vec>
+Vec ecocin::infra::repositories::sqlite::ClientRepositorySqlite::listAllInto(Vec out) {
+    static auto& metric = ecocin::infra::metrics::dbOp("clients", "listAll");
+    ecocin::infra::metrics::DbOpTimer timer{metric};
     const char* sql = "SELECT id,name,email,cpf,create_date FROM clients ORDER BY id DESC";
-    sqlite3_stmt* st = nullptr;
-    sqlite_check(sqlite3_prepare_v2(connection_.raw(), sql, -1, &st, nullptr), connection_.raw(), "prepare list clients");
-    std::vector<Client> out;
+    ecocin::infra::db::Statement st(connection_, sql, "prepare list clients");
     while (sqlite3_step(st) == SQLITE_ROW) {
         out.push_back(row_to_client(st));
     }
-    sqlite3_finalize(st);
     return out;
 }
 
+std::vector<Client> ecocin::infra::repositories::sqlite::ClientRepositorySqlite::listAll() {
+    return listAllInto(std::vector<Client>{});
+}
+
+// Mesma listagem, com o vetor alocado em mr (ex.: a arena da requisição)
+std::pmr::vector<Client> ecocin::infra::repositories::sqlite::ClientRepositorySqlite::listAll(std::pmr::memory_resource* mr) {
+    return listAllInto(std::pmr::vector<Client>(mr));
+}
+
 
 // Atualiza as informações de um cliente existente no banco de dados.
 // O método recebe um objeto 'Client' com os dados modificados e executa o comando UPDATE.
 // O retorno booleano informa se a operação afetou alguma linha, indicando o sucesso da atualização.
 // Isso demonstra o encapsulamento da lógica de modificação de dados.
+// Só as colunas alteradas (Client::dirtyFields) entram no SET: trocar o nome não toca os
+// índices únicos de email e cpf.
 bool ecocin::infra::repositories::sqlite::ClientRepositorySqlite::update(const Client& c) {
-    const char* sql = "UPDATE clients SET name=?, email=?, cpf=? WHERE id=?";
-    sqlite3_stmt* st = nullptr;
-    sqlite_check(sqlite3_prepare_v2(connection_.raw(), sql, -1, &st, nullptr), connection_.raw(), "prepare update client");
-    sqlite3_bind_text(st, 1, c.getName().c_str(),  -1, SQLITE_TRANSIENT); // getName()
-    sqlite3_bind_text(st, 2, c.getEmail().c_str(), -1, SQLITE_TRANSIENT);
-    sqlite3_bind_text(st, 3, c.getCpf().c_str(),   -1, SQLITE_TRANSIENT);
-    sqlite3_bind_int64(st, 4, c.getId());
+    static auto& metric = ecocin::infra::metrics::dbOp("clients", "update");
+    ecocin::infra::metrics::DbOpTimer timer{metric};
+    static MaskedUpdate updates("clients", {"name", "email", "cpf"});
+
+    const std::uint32_t mask = c.dirtyFields();
+    if (mask == 0) {
+        ecocin::infra::db::Statement st(connection_, updates.existsSql(), "prepare update client");
+        sqlite3_bind_int64(st, 1, c.getId());
+        const int rc = sqlite3_step(st);
+        sqlite_check(rc, connection_.raw(), "step update client");
+        return rc == SQLITE_ROW;
+    }
+
+    ecocin::infra::db::Statement st(connection_, updates.sql(mask), "prepare update client");
+    int i = 1;
+    if (mask & Client::kName)  sqlite3_bind_text(st, i++, c.getName().c_str(),  -1, SQLITE_TRANSIENT);
+    if (mask & Client::kEmail) sqlite3_bind_text(st, i++, c.getEmail().c_str(), -1, SQLITE_TRANSIENT);
+    if (mask & Client::kCpf)   sqlite3_bind_text(st, i++, c.getCpf().c_str(),   -1, SQLITE_TRANSIENT);
+    sqlite3_bind_int64(st, i, c.getId());
     sqlite_check(sqlite3_step(st), connection_.raw(), "step update client");
     int changed = sqlite3_changes(connection_.raw());
-    sqlite3_finalize(st);
     return changed > 0;
 }
 
@@ -115,12 +168,21 @@ bool ecocin::infra::repositories::sqlite::ClientRepositorySqlite::update(const C
 // A complexidade da operação de exclusão no banco de dados é completamente
 // escondida da lógica de negócio, que apenas precisa invocar este método.
 bool ecocin::infra::repositories::sqlite::ClientRepositorySqlite::remove(long long id) {
+    static auto& metric = ecocin::infra::metrics::dbOp("clients", "remove");
+    ecocin::infra::metrics::DbOpTimer timer{metric};
     const char* sql = "DELETE FROM clients WHERE id=?";
-    sqlite3_stmt* st = nullptr;
-    sqlite_check(sqlite3_prepare_v2(connection_.raw(), sql, -1, &st, nullptr), connection_.raw(), "prepare delete client");
+    ecocin::infra::db::Statement st(connection_, sql, "prepare delete client");
     sqlite3_bind_int64(st, 1, id);
     sqlite_check(sqlite3_step(st), connection_.raw(), "step delete client");
     int changed = sqlite3_changes(connection_.raw());
-    sqlite3_finalize(st);
     return changed > 0;
 }
+
+// Varredura colunar de clientes (ver infra/db/ColumnBatch.h)
+ecocin::infra::db::ColumnBatch ecocin::infra::repositories::sqlite::ClientRepositorySqlite::scanColumns(
+    const std::vector<std::string>& columns, long long afterId, std::size_t limit) {
+    static auto& metric = ecocin::infra::metrics::dbOp("clients", "scanColumns");
+    ecocin::infra::metrics::DbOpTimer timer{metric};
+    return ecocin::infra::db::ColumnBatch::scan(connection_, "clients",
+        {"id", "name", "email", "cpf", "create_date"}, columns, afterId, limit);
+}
@@ -2,6 +2,7 @@
 #define ECOCIN_INFRA_REPOSITORIES_SQLITE_CLIENTREPOSITORYSQLITE_H
 
 #include "domain/repositories/IClientRepository.h"
+#include "infra/db/ColumnBatch.h"
 #include "infra/db/SqliteConnection.h"
 
 namespace ecocin::infra::repositories::sqlite {
@@ -11,15 +12,26 @@ class ClientRepositorySqlite : public ecocin::domain::repositories::IClientRepos
 private:
     ecocin::infra::db::SqliteConnection& connection_;
 
+    // Corpo comum das listagens: preenche out (std::vector ou std::pmr::vector) e o devolve
+    template <class Vec> Vec listAllInto(Vec out);
+
 public:
     explicit ClientRepositorySqlite(ecocin::infra::db::SqliteConnection& connection) : connection_(connection) {}
 
     Client create(const Client& in) override;
     std::optional<Client> findById(long long id) override;
     std::optional<Client> findByCpf(const std::string& cpf) override;
+    std::vector<Client> findByIds(const std::vector<long long>& ids) override;
+    std::vector<Client> findByCpfs(const std::vector<std::string>& cpfs) override;
     std::vector<Client> listAll() override;
+    std::pmr::vector<Client> listAll(std::pmr::memory_resource* mr) override;
     bool update(const Client& c) override;
     bool remove(long long id) override;
+
+    // Varredura colunar (infra/db/ColumnBatch.h): só as colunas pedidas, em ordem de id e, com
+    // limit, em lotes (o afterId do próximo lote é lastId() do anterior)
+    ecocin::infra::db::ColumnBatch scanColumns(const std::vector<std::string>& columns,
+                                               long long afterId = 0, std::size_t limit = 0);
 };
 
 } // namespace ecocin::infra::repositories::sqlite
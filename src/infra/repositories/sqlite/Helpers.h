@@ -1,9 +1,21 @@
 #ifndef ECOCIN_INFRA_REPOSITORIES_SQLITE_HELPERS_H
 #define ECOCIN_INFRA_REPOSITORIES_SQLITE_HELPERS_H
 
+#include "infra/db/SqliteConnection.h"
 #include <sqlite3.h>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <mutex>
+#include <algorithm>
+#include <iterator>
 #include <stdexcept>
 #include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 
 // Função auxiliar para verificar erros do SQLite
 inline void sqlite_check(int rc, sqlite3* db, const char* where) {
@@ -12,4 +24,104 @@ inline void sqlite_check(int rc, sqlite3* db, const char* where) {
     }
 }
 
+// Consultas com lista IN (?,?,...) de tamanho variável (findByIds, findBySkus...).
+// O número de marcadores é arredondado para um de kInListSizes e as posições que sobram repetem a
+// última chave (IN ignora repetidas): cada consulta gera no máximo quatro textos SQL diferentes no
+// cache de instruções da conexão, em vez de um por tamanho de lista. Listas maiores que o último
+// tamanho vão em blocos, bem abaixo do limite de parâmetros do SQLite (999 nas versões antigas).
+inline constexpr std::size_t kInListSizes[] = {8, 32, 128, 512};
+
+// Chaves sem repetição, na ordem da primeira ocorrência (resultado dos findBy* em lista segue essa ordem)
+template <class Key>
+std::vector<Key> distinct_keys(const std::vector<Key>& keys) {
+    std::vector<Key> out;
+    out.reserve(keys.size());
+    std::unordered_set<Key> seen;
+    seen.reserve(keys.size());
+    for (const auto& k : keys) {
+        if (seen.insert(k).second) out.push_back(k);
+    }
+    return out;
+}
+
+// Resultado de uma consulta em lista na ordem de keys (já sem repetidas); as que não vieram ficam de fora
+template <class Key, class T>
+std::vector<T> in_key_order(const std::vector<Key>& keys, std::unordered_map<Key, T>& found) {
+    std::vector<T> out;
+    out.reserve(found.size());
+    for (const auto& k : keys) {
+        auto it = found.find(k);
+        if (it != found.end()) out.push_back(std::move(it->second));
+    }
+    return out;
+}
+
+// Roda prefix + "(?,...)" para cada bloco de keys. bind(st, i, key) liga a chave no
+// parâmetro i (base 1); onRow(st) é chamado para cada linha. keys precisam viver até o fim.
+template <class Key, class Bind, class OnRow>
+void query_in_list(ecocin::infra::db::SqliteConnection& cx, std::string_view prefix, const std::vector<Key>& keys, const char* where, Bind bind, OnRow onRow) {
+    constexpr std::size_t kMax = kInListSizes[std::size(kInListSizes) - 1];
+    for (std::size_t begin = 0; begin < keys.size(); begin += kMax) {
+        const std::size_t count = std::min(kMax, keys.size() - begin);
+        std::size_t slots = kMax;
+        for (auto size : kInListSizes) {
+            if (count <= size) { slots = size; break; }
+        }
+
+        std::string sql(prefix);
+        sql += '(';
+        for (std::size_t i = 0; i < slots; ++i) sql += i ? ",?" : "?";
+        sql += ')';
+
+        ecocin::infra::db::Statement st(cx, sql, where);
+        for (std::size_t i = 0; i < slots; ++i) {
+            bind(static_cast<sqlite3_stmt*>(st), static_cast<int>(i + 1), keys[begin + std::min(i, count - 1)]);
+        }
+        int rc;
+        while ((rc = sqlite3_step(st)) == SQLITE_ROW) onRow(static_cast<sqlite3_stmt*>(st));
+        sqlite_check(rc, cx.raw(), where);
+    }
+}
+
+// UPDATE só das colunas alteradas (máscara dirtyFields() das entidades).
+// columns segue a ordem dos bits de Field: o bit i corresponde a columns[i]. O texto de cada máscara
+// é montado na primeira vez e guardado; como é sempre o mesmo texto, a instrução preparada também
+// é reaproveitada pelo cache da conexão. Os parâmetros são as colunas marcadas, na ordem dos bits,
+// e por último o id.
+class MaskedUpdate {
+private:
+    std::string table_;
+    std::vector<std::string> columns_;
+    std::mutex mutex_;
+    std::vector<std::string> sql_; // por máscara; vazio = ainda não montado
+    std::string exists_;
+
+public:
+    MaskedUpdate(std::string table, std::initializer_list<const char*> columns)
+        : table_(std::move(table)), columns_(columns.begin(), columns.end()), sql_(std::size_t{1} << columns.size()),
+          exists_("SELECT 1 FROM " + table_ + " WHERE id=?") {}
+
+    // "UPDATE table SET c1=?,c3=? WHERE id=?" para mask != 0
+    const std::string& sql(std::uint32_t mask) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto& sql = sql_.at(mask);
+        if (sql.empty()) {
+            sql = "UPDATE " + table_ + " SET ";
+            bool first = true;
+            for (std::size_t i = 0; i < columns_.size(); ++i) {
+                if (!(mask & (1u << i))) continue;
+                if (!first) sql += ',';
+                sql += columns_[i];
+                sql += "=?";
+                first = false;
+            }
+            sql += " WHERE id=?";
+        }
+        return sql;
+    }
+
+    // Nada a gravar (mask == 0): o update só confirma que a linha existe
+    const std::string& existsSql() const { return exists_; }
+};
+
 #endif // ECOCIN_INFRA_REPOSITORIES_SQLITE_HELPERS_H
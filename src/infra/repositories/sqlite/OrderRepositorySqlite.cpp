@@ -1,5 +1,6 @@
 #include "OrderRepositorySqlite.h"
 #include "Helpers.h"
+#include "../../metrics/Metrics.h"
 #include <chrono>
 
 static Order row_to_order(sqlite3_stmt* s) {
@@ -28,16 +29,30 @@ static Order row_to_order(sqlite3_stmt* s) {
     o.setQuantity(o.getQuantity());
     o.setUnitPrice(o.getUnitPrice());
 
+    o.clearDirty(); // igual ao banco: o próximo update grava só o que mudar
     return o;
 }
 
 namespace ecocin::infra::repositories::sqlite {
 
+static constexpr const char* kOrderColumns =
+    "SELECT id,client_id,product_id,shipping_address_id,quantity,unit_price,total_price,status,create_date FROM ";
+
+// As leituras são montadas uma vez aqui; escritas sempre atuam em main.orders (pedidos arquivados são somente leitura)
+OrderRepositorySqlite::OrderRepositorySqlite(ecocin::infra::db::SqliteConnection& connection, const std::string& readSource)
+    : connection_(connection),
+      readSource_(readSource),
+      sqlFindById_(kOrderColumns + readSource + " WHERE id=?"),
+      sqlListAll_(kOrderColumns + readSource + " ORDER BY id DESC"),
+      sqlListByClientId_(kOrderColumns + readSource + " WHERE client_id=? ORDER BY create_date DESC, id DESC") {}
+
 // Persiste um novo pedido no banco de dados.
 // O método recebe um objeto de domínio 'Order', calcula o valor total para garantir consistência,
 // define a data de criação e o insere na tabela 'orders'.
 // Este encapsulamento da lógica de criação assegura que todo pedido salvo seja válido e completo.
 Order OrderRepositorySqlite::create(const Order& in) {
+    static auto& metric = ecocin::infra::metrics::dbOp("orders", "create");
+    ecocin::infra::metrics::DbOpTimer timer{metric};
     Order o = in;
 
     // Garante total antes de persistir
@@ -51,9 +66,7 @@ Order OrderRepositorySqlite::create(const Order& in) {
         " client_id, product_id, shipping_address_id, quantity, unit_price, total_price, status, create_date"
         ") VALUES (?,?,?,?,?,?,?,?)";
 
-    sqlite3_stmt* st = nullptr;
-    sqlite_check(sqlite3_prepare_v2(connection_.raw(), sql, -1, &st, nullptr),
-                 connection_.raw(), "prepare insert order");
+    ecocin::infra::db::Statement st(connection_, sql, "prepare insert order");
 
     sqlite3_bind_int64(st, 1, o.getClientId());
     sqlite3_bind_int64(st, 2, o.getProductId());
@@ -65,9 +78,9 @@ Order OrderRepositorySqlite::create(const Order& in) {
     sqlite3_bind_int64(st, 8, static_cast<sqlite3_int64>(epoch));
 
     sqlite_check(sqlite3_step(st), connection_.raw(), "step insert order");
-    sqlite3_finalize(st);
 
     o.setId(static_cast<long long>(sqlite3_last_insert_rowid(connection_.raw())));
+    o.clearDirty();
     return o;
 }
 
@@ -76,75 +89,79 @@ Order OrderRepositorySqlite::create(const Order& in) {
 // está contida neste método, seguindo o princípio de responsabilidade única.
 // O uso de `std::optional` comunica de forma clara a possibilidade de o pedido não ser encontrado.
 std::optional<Order> OrderRepositorySqlite::findById(long long id) {
-    const char* sql =
-        "SELECT id,client_id,product_id,shipping_address_id,quantity,unit_price,total_price,status,create_date "
-        "FROM orders WHERE id=?";
-
-    sqlite3_stmt* st = nullptr;
-    sqlite_check(sqlite3_prepare_v2(connection_.raw(), sql, -1, &st, nullptr),
-                 connection_.raw(), "prepare get order by id");
+    static auto& metric = ecocin::infra::metrics::dbOp("orders", "findById");
+    ecocin::infra::metrics::DbOpTimer timer{metric};
+    ecocin::infra::db::Statement st(connection_, sqlFindById_, "prepare get order by id");
 
     sqlite3_bind_int64(st, 1, id);
 
     if (sqlite3_step(st) == SQLITE_ROW) {
         auto o = row_to_order(st);
-        sqlite3_finalize(st);
         return o;
     }
-    sqlite3_finalize(st);
     return std::nullopt;
 }
 
 // Retorna uma lista de todos os pedidos existentes no sistema.
 // Este método abstrai a complexidade de consultar e mapear múltiplos registros do banco de dados,
 // fornecendo uma interface simples para a camada de serviço.
-std::vector<Order> OrderRepositorySqlite::listAll() {
-    const char* sql =
-        "SELECT id,client_id,product_id,shipping_address_id,quantity,unit_price,total_price,status,create_date "
-        "FROM orders ORDER BY id DESC";
+template <class Vec>
+Vec OrderRepositorySqlite::listAllInto(Vec out) {
+    static auto& metric = ecocin::infra::metrics::dbOp("orders", "listAll");
+    ecocin::infra::metrics::DbOpTimer timer{metric};
+    ecocin::infra::db::Statement st(connection_, sqlListAll_, "prepare list orders");
 
-    sqlite3_stmt* st = nullptr;
-    sqlite_check(sqlite3_prepare_v2(connection_.raw(), sql, -1, &st, nullptr),
-                 connection_.raw(), "prepare list orders");
-
-    std::vector<Order> out;
     while (sqlite3_step(st) == SQLITE_ROW) {
         out.emplace_back(row_to_order(st));
     }
-    sqlite3_finalize(st);
     return out;
 }
 
+std::vector<Order> OrderRepositorySqlite::listAll() {
+    return listAllInto(std::vector<Order>{});
+}
+
+// Mesma listagem, com o vetor alocado em mr (ex.: a arena da requisição)
+std::pmr::vector<Order> OrderRepositorySqlite::listAll(std::pmr::memory_resource* mr) {
+    return listAllInto(std::pmr::vector<Order>(mr));
+}
+
 // Atualiza os dados de um pedido existente.
 // O método garante que o preço total seja recalculado antes de persistir as alterações,
 // mantendo a integridade dos dados. A lógica de atualização fica isolada nesta camada,
 // o que facilita a manutenção e evita duplicação de código.
+// Grava só as colunas alteradas desde o carregamento (Order::dirtyFields); mudar o status não
+// regrava as chaves estrangeiras nem os índices de client_id e shipping_address_id.
 bool OrderRepositorySqlite::update(const Order& oIn) {
+    static auto& metric = ecocin::infra::metrics::dbOp("orders", "update");
+    ecocin::infra::metrics::DbOpTimer timer{metric};
+    static MaskedUpdate updates("orders", {"client_id", "product_id", "shipping_address_id", "quantity",
+                                           "unit_price", "total_price", "status"});
     Order o = oIn;
     o.calculateTotal();
 
-    const char* sql =
-        "UPDATE orders "
-        "SET client_id=?, product_id=?, shipping_address_id=?, quantity=?, "
-        "    unit_price=?, total_price=?, status=? "
-        "WHERE id=?";
+    const std::uint32_t mask = o.dirtyFields();
+    if (mask == 0) {
+        ecocin::infra::db::Statement st(connection_, updates.existsSql(), "prepare update order");
+        sqlite3_bind_int64(st, 1, o.getId());
+        const int rc = sqlite3_step(st);
+        sqlite_check(rc, connection_.raw(), "step update order");
+        return rc == SQLITE_ROW;
+    }
 
-    sqlite3_stmt* st = nullptr;
-    sqlite_check(sqlite3_prepare_v2(connection_.raw(), sql, -1, &st, nullptr),
-                 connection_.raw(), "prepare update order");
-
-    sqlite3_bind_int64(st, 1, o.getClientId());
-    sqlite3_bind_int64(st, 2, o.getProductId());
-    sqlite3_bind_int64(st, 3, o.getShippingAddressId());
-    sqlite3_bind_int(st,   4, o.getQuantity());
-    sqlite3_bind_double(st,5, o.getUnitPrice());
-    sqlite3_bind_double(st,6, o.getUnitPrice() * o.getQuantity());
-    sqlite3_bind_text(st,  7, o.getStatus().c_str(), -1, SQLITE_TRANSIENT);
-    sqlite3_bind_int64(st, 8, o.getId());
+    ecocin::infra::db::Statement st(connection_, updates.sql(mask), "prepare update order");
+    int i = 1;
+    if (mask & Order::kClientId)          sqlite3_bind_int64(st, i++, o.getClientId());
+    if (mask & Order::kProductId)         sqlite3_bind_int64(st, i++, o.getProductId());
+    if (mask & Order::kShippingAddressId) sqlite3_bind_int64(st, i++, o.getShippingAddressId());
+    if (mask & Order::kQuantity)          sqlite3_bind_int(st, i++, o.getQuantity());
+    if (mask & Order::kUnitPrice)         sqlite3_bind_double(st, i++, o.getUnitPrice());
+    if (mask & Order::kTotalPrice)        sqlite3_bind_double(st, i++, o.getUnitPrice() * o.getQuantity());
+    if (mask & Order::kStatus)            sqlite3_bind_text(st, i++, o.getStatus().c_str(), -1, SQLITE_TRANSIENT);
+    sqlite3_bind_int64(st, i, o.getId());
 
     sqlite_check(sqlite3_step(st), connection_.raw(), "step update order");
     const int changed = sqlite3_changes(connection_.raw());
-    sqlite3_finalize(st);
     return changed > 0;
 }
 
@@ -152,55 +169,55 @@ bool OrderRepositorySqlite::update(const Order& oIn) {
 // A operação de exclusão é encapsulada, de modo que a camada de serviço
 // não precisa se preocupar com a sintaxe SQL ou o tratamento de conexões.
 bool OrderRepositorySqlite::remove(long long id) {
+    static auto& metric = ecocin::infra::metrics::dbOp("orders", "remove");
+    ecocin::infra::metrics::DbOpTimer timer{metric};
     const char* sql = "DELETE FROM orders WHERE id=?";
-    sqlite3_stmt* st = nullptr;
-    sqlite_check(sqlite3_prepare_v2(connection_.raw(), sql, -1, &st, nullptr),
-                 connection_.raw(), "prepare delete order");
+    ecocin::infra::db::Statement st(connection_, sql, "prepare delete order");
     sqlite3_bind_int64(st, 1, id);
     sqlite_check(sqlite3_step(st), connection_.raw(), "step delete order");
     const int changed = sqlite3_changes(connection_.raw());
-    sqlite3_finalize(st);
     return changed > 0;
 }
 
 // Lista todos os pedidos associados a um determinado cliente.
 // Este é um exemplo de método de consulta específico do negócio, que abstrai
 // uma necessidade comum da aplicação em uma chamada de método simples e clara.
-std::vector<Order> OrderRepositorySqlite::listByClientId(long long clientId) {
-    const char* sql =
-        "SELECT id,client_id,product_id,shipping_address_id,quantity,unit_price,total_price,status,create_date "
-        "FROM orders WHERE client_id=? "
-        "ORDER BY create_date DESC, id DESC";
-
-    sqlite3_stmt* st = nullptr;
-    sqlite_check(sqlite3_prepare_v2(connection_.raw(), sql, -1, &st, nullptr),
-                 connection_.raw(), "prepare list orders by client_id");
+template <class Vec>
+Vec OrderRepositorySqlite::listByClientIdInto(long long clientId, Vec out) {
+    static auto& metric = ecocin::infra::metrics::dbOp("orders", "listByClientId");
+    ecocin::infra::metrics::DbOpTimer timer{metric};
+    ecocin::infra::db::Statement st(connection_, sqlListByClientId_, "prepare list orders by client_id");
 
     sqlite3_bind_int64(st, 1, clientId);
 
-    std::vector<Order> out;
     while (sqlite3_step(st) == SQLITE_ROW) {
         out.emplace_back(row_to_order(st));
     }
-    sqlite3_finalize(st);
     return out;
 }
 
+std::vector<Order> OrderRepositorySqlite::listByClientId(long long clientId) {
+    return listByClientIdInto(clientId, std::vector<Order>{});
+}
+
+std::pmr::vector<Order> OrderRepositorySqlite::listByClientId(long long clientId, std::pmr::memory_resource* mr) {
+    return listByClientIdInto(clientId, std::pmr::vector<Order>(mr));
+}
+
 // Atualiza apenas o status de um pedido específico.
 // Em vez de carregar e salvar o objeto 'Order' inteiro, este método realiza uma
 // operação mais performática e focada, demonstrando uma otimização comum em repositórios.
 bool OrderRepositorySqlite::updateStatus(long long id, const std::string& newStatus) {
+    static auto& metric = ecocin::infra::metrics::dbOp("orders", "updateStatus");
+    ecocin::infra::metrics::DbOpTimer timer{metric};
     const char* sql = "UPDATE orders SET status=? WHERE id=?";
-    sqlite3_stmt* st = nullptr;
-    sqlite_check(sqlite3_prepare_v2(connection_.raw(), sql, -1, &st, nullptr),
-                 connection_.raw(), "prepare update order status");
+    ecocin::infra::db::Statement st(connection_, sql, "prepare update order status");
 
     sqlite3_bind_text(st, 1, newStatus.c_str(), -1, SQLITE_TRANSIENT);
     sqlite3_bind_int64(st, 2, id);
 
     sqlite_check(sqlite3_step(st), connection_.raw(), "step update order status");
     const int changed = sqlite3_changes(connection_.raw());
-    sqlite3_finalize(st);
     return changed > 0;
 }
 
@@ -208,18 +225,29 @@ bool OrderRepositorySqlite::updateStatus(long long id, const std::string& newSta
 // Assim como `updateStatus`, este método encapsula uma atualização parcial e específica,
 // o que melhora a eficiência e a clareza da intenção do código.
 bool OrderRepositorySqlite::updateShippingAddress(long long id, long long newAddressId) {
+    static auto& metric = ecocin::infra::metrics::dbOp("orders", "updateShippingAddress");
+    ecocin::infra::metrics::DbOpTimer timer{metric};
     const char* sql = "UPDATE orders SET shipping_address_id=? WHERE id=?";
-    sqlite3_stmt* st = nullptr;
-    sqlite_check(sqlite3_prepare_v2(connection_.raw(), sql, -1, &st, nullptr),
-                 connection_.raw(), "prepare update order address");
+    ecocin::infra::db::Statement st(connection_, sql, "prepare update order address");
 
     sqlite3_bind_int64(st, 1, newAddressId);
     sqlite3_bind_int64(st, 2, id);
 
     sqlite_check(sqlite3_step(st), connection_.raw(), "step update order address");
     const int changed = sqlite3_changes(connection_.raw());
-    sqlite3_finalize(st);
     return changed > 0;
 }
 
+// Varredura colunar de pedidos (ver infra/db/ColumnBatch.h); lê da mesma origem que as outras
+// leituras, então com o arquivo ligado cobre também os pedidos arquivados
+ecocin::infra::db::ColumnBatch OrderRepositorySqlite::scanColumns(const std::vector<std::string>& columns,
+                                                                  long long afterId, std::size_t limit) {
+    static auto& metric = ecocin::infra::metrics::dbOp("orders", "scanColumns");
+    ecocin::infra::metrics::DbOpTimer timer{metric};
+    return ecocin::infra::db::ColumnBatch::scan(connection_, readSource_,
+        {"id", "client_id", "product_id", "shipping_address_id", "quantity", "unit_price", "total_price",
+         "status", "create_date"},
+        columns, afterId, limit);
+}
+
 } // namespace ecocin::infra::repositories::sqlite
@@ -2,8 +2,11 @@
 #define ECOCIN_INFRA_REPOSITORIES_SQLITE_ORDERREPOSITORYSQLITE_H
 
 #include "domain/repositories/IOrderRepository.h"
+#include "infra/db/ColumnBatch.h"
 #include "infra/db/SqliteConnection.h"
+#include <memory_resource>
 #include <optional>
+#include <string>
 #include <vector>
 
 namespace ecocin::infra::repositories::sqlite {
@@ -13,20 +16,39 @@ class OrderRepositorySqlite : public ecocin::domain::repositories::IOrderReposit
 private:
     ecocin::infra::db::SqliteConnection& connection_;
 
+    // SQL das leituras: de "orders" ou, com o arquivo de pedidos ligado, da view que também
+    // cobre as partições mensais anexadas (ver infra/db/OrderArchive.h)
+    std::string readSource_;
+    std::string sqlFindById_;
+    std::string sqlListAll_;
+    std::string sqlListByClientId_;
+
+    // Corpo comum das listagens: preenche out (std::vector ou std::pmr::vector) e o devolve
+    template <class Vec> Vec listAllInto(Vec out);
+    template <class Vec> Vec listByClientIdInto(long long clientId, Vec out);
+
 public:
-    explicit OrderRepositorySqlite(ecocin::infra::db::SqliteConnection& connection)
-      : connection_(connection) {}
+    // readSource: tabela ou view de onde as leituras vêm ("orders" ou OrderArchive::kView)
+    explicit OrderRepositorySqlite(ecocin::infra::db::SqliteConnection& connection,
+                                   const std::string& readSource = "orders");
 
     // IOrderRepository
     Order create(const Order& in) override;
     std::optional<Order> findById(long long id) override;
     std::vector<Order> listAll() override;
+    std::pmr::vector<Order> listAll(std::pmr::memory_resource* mr) override;
     bool update(const Order& o) override;
     bool remove(long long id) override;
 
     std::vector<Order> listByClientId(long long clientId) override;
+    std::pmr::vector<Order> listByClientId(long long clientId, std::pmr::memory_resource* mr) override;
     bool updateStatus(long long id, const std::string& newStatus) override;
     bool updateShippingAddress(long long id, long long newAddressId) override;
+
+    // Varredura colunar (infra/db/ColumnBatch.h): só as colunas pedidas, em ordem de id e, com
+    // limit, em lotes (o afterId do próximo lote é lastId() do anterior)
+    ecocin::infra::db::ColumnBatch scanColumns(const std::vector<std::string>& columns,
+                                               long long afterId = 0, std::size_t limit = 0);
 };
 
 } // namespace ecocin::infra::repositories::sqlite
@@ -1,5 +1,6 @@
 #include "ProductRepositorySqlite.h"
 #include "Helpers.h"
+#include "../../metrics/Metrics.h"
 #include <chrono>
 
 // Função auxiliar para converter uma linha do resultado da consulta SQL em um objeto Product.
@@ -25,6 +26,7 @@ static Product row_to_product(sqlite3_stmt* s) {
     p.setCreateDate(std::chrono::system_clock::time_point{
         std::chrono::seconds{sqlite3_column_int64(s, 7)}
     });
+    p.clearDirty(); // igual ao banco: o próximo update grava só o que mudar
     return p;
 }
 
@@ -35,6 +37,8 @@ namespace ecocin::infra::repositories::sqlite {
 // A lógica de conversão de tipos (como Uuid para string) e a montagem da instrução SQL
 // são encapsuladas aqui, mantendo a camada de serviço limpa e focada na regra de negócio.
 Product ProductRepositorySqlite::create(const Product& in) {
+    static auto& metric = ecocin::infra::metrics::dbOp("products", "create");
+    ecocin::infra::metrics::DbOpTimer timer{metric};
     Product p = in;
     const auto now   = std::chrono::system_clock::now();
     const auto epoch = std::chrono::duration_cast<std::chrono::seconds>(now.time_since_epoch()).count();
@@ -44,8 +48,7 @@ Product ProductRepositorySqlite::create(const Product& in) {
         "INSERT INTO products(name, description, sku, price, stock_quantity, is_active, create_date) "
         "VALUES(?,?,?,?,?,?,?)";
 
-    sqlite3_stmt* st = nullptr;
-    sqlite_check(sqlite3_prepare_v2(connection_.raw(), sql, -1, &st, nullptr), connection_.raw(), "prepare insert product");
+    ecocin::infra::db::Statement st(connection_, sql, "prepare insert product");
 
     sqlite3_bind_text(st, 1, p.getName().c_str(), -1, SQLITE_TRANSIENT);
     sqlite3_bind_text(st, 2, p.getDescription().c_str(), -1, SQLITE_TRANSIENT);
@@ -57,9 +60,9 @@ Product ProductRepositorySqlite::create(const Product& in) {
     sqlite3_bind_int64(st, 7, static_cast<sqlite3_int64>(epoch));
 
     sqlite_check(sqlite3_step(st), connection_.raw(), "step insert product");
-    sqlite3_finalize(st);
 
     p.setId(static_cast<long long>(sqlite3_last_insert_rowid(connection_.raw())));
+    p.clearDirty();
     return p;
 }
 
@@ -68,20 +71,19 @@ Product ProductRepositorySqlite::create(const Product& in) {
 // da consulta SQL e do mapeamento de colunas para os atributos do objeto 'Product'.
 // O retorno `std::optional` gerencia de forma elegante o caso em que o produto não é encontrado.
 std::optional<Product> ProductRepositorySqlite::findById(long long id) {
+    static auto& metric = ecocin::infra::metrics::dbOp("products", "findById");
+    ecocin::infra::metrics::DbOpTimer timer{metric};
     const char* sql =
         "SELECT id,name,description,sku,price,stock_quantity AS stock,is_active,create_date "
         "FROM products WHERE id=?";
 
-    sqlite3_stmt* st = nullptr;
-    sqlite_check(sqlite3_prepare_v2(connection_.raw(), sql, -1, &st, nullptr), connection_.raw(), "prepare get product by id");
+    ecocin::infra::db::Statement st(connection_, sql, "prepare get product by id");
     sqlite3_bind_int64(st, 1, id);
 
     if (sqlite3_step(st) == SQLITE_ROW) {
         auto p = row_to_product(st);
-        sqlite3_finalize(st);
         return p;
     }
-    sqlite3_finalize(st);
     return std::nullopt;
 }
 
@@ -89,82 +91,216 @@ std::optional<Product> ProductRepositorySqlite::findById(long long id) {
 // Fornecer métodos de busca por diferentes chaves de negócio é uma prática comum
 // em repositórios para dar flexibilidade à camada de serviço.
 std::optional<Product> ProductRepositorySqlite::findBySku(const std::string& sku) {
+    static auto& metric = ecocin::infra::metrics::dbOp("products", "findBySku");
+    ecocin::infra::metrics::DbOpTimer timer{metric};
     const char* sql =
         "SELECT id,name,description,sku,price,stock_quantity AS stock,is_active,create_date "
         "FROM products WHERE sku=?";
 
-    sqlite3_stmt* st = nullptr;
-    sqlite_check(sqlite3_prepare_v2(connection_.raw(), sql, -1, &st, nullptr), connection_.raw(), "prepare get product by sku");
+    ecocin::infra::db::Statement st(connection_, sql, "prepare get product by sku");
     sqlite3_bind_text(st, 1, sku.c_str(), -1, SQLITE_TRANSIENT);
 
     if (sqlite3_step(st) == SQLITE_ROW) {
         auto p = row_to_product(st);
-        sqlite3_finalize(st);
         return p;
     }
-    sqlite3_finalize(st);
     return std::nullopt;
 }
 
+// Busca vários produtos pelo ID numa única consulta (IN), para quem monta carrinhos e páginas de
+// pedido com muitos itens: uma ida ao banco em vez de um findById por item.
+std::vector<Product> ProductRepositorySqlite::findByIds(const std::vector<long long>& ids) {
+    static auto& metric = ecocin::infra::metrics::dbOp("products", "findByIds");
+    ecocin::infra::metrics::DbOpTimer timer{metric};
+    const auto keys = distinct_keys(ids);
+    std::unordered_map<long long, Product> found;
+    found.reserve(keys.size());
+    query_in_list(connection_,
+        "SELECT id,name,description,sku,price,stock_quantity AS stock,is_active,create_date "
+        "FROM products WHERE id IN ", keys, "get products by ids",
+        [](sqlite3_stmt* s, int i, long long id) { sqlite3_bind_int64(s, i, id); },
+        [&](sqlite3_stmt* s) { auto p = row_to_product(s); found.emplace(p.getId(), std::move(p)); });
+    return in_key_order(keys, found);
+}
+
+// Mesmo que findByIds, pelo SKU
+std::vector<Product> ProductRepositorySqlite::findBySkus(const std::vector<std::string>& skus) {
+    static auto& metric = ecocin::infra::metrics::dbOp("products", "findBySkus");
+    ecocin::infra::metrics::DbOpTimer timer{metric};
+    const auto keys = distinct_keys(skus);
+    std::unordered_map<std::string, Product> found;
+    found.reserve(keys.size());
+    query_in_list(connection_,
+        "SELECT id,name,description,sku,price,stock_quantity AS stock,is_active,create_date "
+        "FROM products WHERE sku IN ", keys, "get products by skus",
+        [](sqlite3_stmt* s, int i, const std::string& k) {
+            sqlite3_bind_text(s, i, k.data(), static_cast<int>(k.size()), SQLITE_STATIC);
+        },
+        [&](sqlite3_stmt* s) {
+            // chave pelo texto gravado, o mesmo que o IN comparou com o pedido
+            std::string sku(reinterpret_cast<const char*>(sqlite3_column_text(s, 3)));
+            found.emplace(std::move(sku), row_to_product(s));
+        });
+    return in_key_order(keys, found);
+}
+
 // Retorna uma lista com todos os produtos cadastrados.
 // O método encapsula a iteração sobre o resultado da consulta e a construção
 // da coleção de objetos 'Product', simplificando o código que o consome.
-std::vector<Product> ProductRepositorySqlite::listAll() {
+template <class Vec>
+Vec ProductRepositorySqlite::listAllInto(Vec out) {
+    static auto& metric = ecocin::infra::metrics::dbOp("products", "listAll");
+    ecocin::infra::metrics::DbOpTimer timer{metric};
     const char* sql =
         "SELECT id,name,description,sku,price,stock_quantity AS stock,is_active,create_date "
         "FROM products ORDER BY id DESC";
 
-    sqlite3_stmt* st = nullptr;
-    sqlite_check(sqlite3_prepare_v2(connection_.raw(), sql, -1, &st, nullptr), connection_.raw(), "prepare list products");
+    ecocin::infra::db::Statement st(connection_, sql, "prepare list products");
 
-    std::vector<Product> out;
     while (sqlite3_step(st) == SQLITE_ROW) {
         out.push_back(row_to_product(st));
     }
-    sqlite3_finalize(st);
     return out;
 }
 
+std::vector<Product> ProductRepositorySqlite::listAll() {
+    return listAllInto(std::vector<Product>{});
+}
+
+// Mesma listagem, com o vetor alocado em mr (ex.: a arena da requisição)
+std::pmr::vector<Product> ProductRepositorySqlite::listAll(std::pmr::memory_resource* mr) {
+    return listAllInto(std::pmr::vector<Product>(mr));
+}
+
 // Atualiza as informações de um produto existente.
 // A responsabilidade de mapear os atributos do objeto 'Product' para os parâmetros
 // da instrução SQL UPDATE está totalmente contida neste método.
 // O retorno booleano fornece um feedback claro sobre o sucesso da operação.
+// Só as colunas alteradas desde o carregamento (Product::dirtyFields) entram no SET: mudar o
+// estoque não regrava sku nem name, então os índices únicos e idx_products_name ficam intactos.
 bool ProductRepositorySqlite::update(const Product& p) {
-    const char* sql =
-        "UPDATE products SET name=?, description=?, sku=?, price=?, stock_quantity=?, is_active=? "
-        "WHERE id=?";
+    static auto& metric = ecocin::infra::metrics::dbOp("products", "update");
+    ecocin::infra::metrics::DbOpTimer timer{metric};
+    static MaskedUpdate updates("products", {"name", "description", "sku", "price", "stock_quantity", "is_active"});
 
-    sqlite3_stmt* st = nullptr;
-    sqlite_check(sqlite3_prepare_v2(connection_.raw(), sql, -1, &st, nullptr), connection_.raw(), "prepare update product");
+    const std::uint32_t mask = p.dirtyFields();
+    if (mask == 0) {
+        ecocin::infra::db::Statement st(connection_, updates.existsSql(), "prepare update product");
+        sqlite3_bind_int64(st, 1, p.getId());
+        const int rc = sqlite3_step(st);
+        sqlite_check(rc, connection_.raw(), "step update product");
+        return rc == SQLITE_ROW;
+    }
 
-    sqlite3_bind_text(st, 1, p.getName().c_str(), -1, SQLITE_TRANSIENT);
-    sqlite3_bind_text(st, 2, p.getDescription().c_str(), -1, SQLITE_TRANSIENT);
-    const std::string skuStr = p.getSku().str();
-    sqlite3_bind_text(st, 3, skuStr.c_str(), -1, SQLITE_TRANSIENT);
-    sqlite3_bind_double(st, 4, p.getPrice());
-    sqlite3_bind_int(st, 5, p.getStockQuantity());
-    sqlite3_bind_int(st, 6, p.getIsActive() ? 1 : 0);
-    sqlite3_bind_int64(st, 7, p.getId());
+    ecocin::infra::db::Statement st(connection_, updates.sql(mask), "prepare update product");
+    int i = 1;
+    if (mask & Product::kName)        sqlite3_bind_text(st, i++, p.getName().c_str(), -1, SQLITE_TRANSIENT);
+    if (mask & Product::kDescription) sqlite3_bind_text(st, i++, p.getDescription().c_str(), -1, SQLITE_TRANSIENT);
+    if (mask & Product::kSku)         sqlite3_bind_text(st, i++, p.getSku().str().c_str(), -1, SQLITE_TRANSIENT);
+    if (mask & Product::kPrice)       sqlite3_bind_double(st, i++, p.getPrice());
+    if (mask & Product::kStockQuantity) sqlite3_bind_int(st, i++, p.getStockQuantity());
+    if (mask & Product::kIsActive)    sqlite3_bind_int(st, i++, p.getIsActive() ? 1 : 0);
+    sqlite3_bind_int64(st, i, p.getId());
 
     sqlite_check(sqlite3_step(st), connection_.raw(), "step update product");
     const int changed = sqlite3_changes(connection_.raw());
 
-    sqlite3_finalize(st);
     return changed > 0;
 }
 
+// INSERT ... ON CONFLICT DO UPDATE em vez de INSERT OR REPLACE: REPLACE apaga a linha antes de
+// regravar, o que esbarraria nas chaves estrangeiras de orders.product_id.
+void ProductRepositorySqlite::upsert(const Product& p) {
+    static auto& metric = ecocin::infra::metrics::dbOp("products", "upsert");
+    ecocin::infra::metrics::DbOpTimer timer{metric};
+    const char* sql =
+        "INSERT INTO products(id, name, description, sku, price, stock_quantity, is_active, create_date) "
+        "VALUES(?,?,?,?,?,?,?,?) "
+        "ON CONFLICT(id) DO UPDATE SET name=excluded.name, description=excluded.description, sku=excluded.sku, "
+        "price=excluded.price, stock_quantity=excluded.stock_quantity, is_active=excluded.is_active, "
+        "create_date=excluded.create_date";
+    ecocin::infra::db::Statement st(connection_, sql, "prepare upsert product");
+
+    const auto epoch = std::chrono::duration_cast<std::chrono::seconds>(p.getCreateDate().time_since_epoch()).count();
+    const std::string skuStr = p.getSku().str();
+    sqlite3_bind_int64(st, 1, p.getId());
+    sqlite3_bind_text(st, 2, p.getName().c_str(), -1, SQLITE_TRANSIENT);
+    sqlite3_bind_text(st, 3, p.getDescription().c_str(), -1, SQLITE_TRANSIENT);
+    sqlite3_bind_text(st, 4, skuStr.c_str(), -1, SQLITE_TRANSIENT);
+    sqlite3_bind_double(st, 5, p.getPrice());
+    sqlite3_bind_int(st, 6, p.getStockQuantity());
+    sqlite3_bind_int(st, 7, p.getIsActive() ? 1 : 0);
+    sqlite3_bind_int64(st, 8, static_cast<sqlite3_int64>(epoch));
+
+    sqlite_check(sqlite3_step(st), connection_.raw(), "step upsert product");
+}
+
+// Soma delta ao estoque num único UPDATE relativo: duas sincronizações de estoque concorrentes não
+// sobrescrevem uma à outra (não há leitura antes da escrita) e o limite é conferido pelo próprio
+// UPDATE, então o estoque nunca fica negativo. RETURNING devolve o valor gravado.
+std::optional<ecocin::domain::repositories::ProductFieldUpdate<int>>
+ProductRepositorySqlite::adjustStock(long long id, int delta) {
+    static auto& metric = ecocin::infra::metrics::dbOp("products", "adjustStock");
+    ecocin::infra::metrics::DbOpTimer timer{metric};
+    const char* sql =
+        "UPDATE products SET stock_quantity = stock_quantity + ?1 "
+        "WHERE id = ?2 AND stock_quantity + ?1 BETWEEN 0 AND 2147483647 "
+        "RETURNING stock_quantity, sku";
+    ecocin::infra::db::Statement st(connection_, sql, "prepare adjust product stock");
+    sqlite3_bind_int64(st, 1, delta);
+    sqlite3_bind_int64(st, 2, id);
+
+    const int rc = sqlite3_step(st);
+    sqlite_check(rc, connection_.raw(), "step adjust product stock");
+    if (rc != SQLITE_ROW) return std::nullopt;
+    ecocin::domain::repositories::ProductFieldUpdate<int> out{
+        sqlite3_column_int(st, 0), reinterpret_cast<const char*>(sqlite3_column_text(st, 1))};
+    sqlite_check(sqlite3_step(st), connection_.raw(), "step adjust product stock"); // conclui o UPDATE
+    return out;
+}
+
+// Troca só o preço (o PUT regrava as seis colunas, inclusive o SKU)
+std::optional<ecocin::domain::repositories::ProductFieldUpdate<double>>
+ProductRepositorySqlite::updatePrice(long long id, double price) {
+    static auto& metric = ecocin::infra::metrics::dbOp("products", "updatePrice");
+    ecocin::infra::metrics::DbOpTimer timer{metric};
+    const char* sql = "UPDATE products SET price = ?1 WHERE id = ?2 RETURNING price, sku";
+    ecocin::infra::db::Statement st(connection_, sql, "prepare update product price");
+    sqlite3_bind_double(st, 1, price);
+    sqlite3_bind_int64(st, 2, id);
+
+    const int rc = sqlite3_step(st);
+    sqlite_check(rc, connection_.raw(), "step update product price");
+    if (rc != SQLITE_ROW) return std::nullopt;
+    ecocin::domain::repositories::ProductFieldUpdate<double> out{
+        sqlite3_column_double(st, 0), reinterpret_cast<const char*>(sqlite3_column_text(st, 1))};
+    sqlite_check(sqlite3_step(st), connection_.raw(), "step update product price");
+    return out;
+}
+
 // Exclui um produto do banco de dados usando seu ID.
 // Este método abstrai a operação de deleção, garantindo que a camada de serviço
 // não precise lidar diretamente com o SQL, o que aumenta a segurança e a manutenibilidade.
 bool ProductRepositorySqlite::remove(long long id) {
+    static auto& metric = ecocin::infra::metrics::dbOp("products", "remove");
+    ecocin::infra::metrics::DbOpTimer timer{metric};
     const char* sql = "DELETE FROM products WHERE id=?";
-    sqlite3_stmt* st = nullptr;
-    sqlite_check(sqlite3_prepare_v2(connection_.raw(), sql, -1, &st, nullptr), connection_.raw(), "prepare delete product");
+    ecocin::infra::db::Statement st(connection_, sql, "prepare delete product");
     sqlite3_bind_int64(st, 1, id);
     sqlite_check(sqlite3_step(st), connection_.raw(), "step delete product");
     const int changed = sqlite3_changes(connection_.raw());
-    sqlite3_finalize(st);
     return changed > 0;
 }
 
+// Varredura colunar de produtos (ver infra/db/ColumnBatch.h): somar price * stock_quantity do
+// catálogo inteiro lê dois arrays em vez de montar um Product (com quatro std::string) por linha
+ecocin::infra::db::ColumnBatch ProductRepositorySqlite::scanColumns(const std::vector<std::string>& columns,
+                                                                    long long afterId, std::size_t limit) {
+    static auto& metric = ecocin::infra::metrics::dbOp("products", "scanColumns");
+    ecocin::infra::metrics::DbOpTimer timer{metric};
+    return ecocin::infra::db::ColumnBatch::scan(connection_, "products",
+        {"id", "name", "description", "sku", "price", "stock_quantity", "is_active", "create_date"},
+        columns, afterId, limit);
+}
+
 }
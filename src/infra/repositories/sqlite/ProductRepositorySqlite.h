@@ -2,6 +2,7 @@
 #define ECOCIN_INFRA_REPOSITORIES_SQLITE_PRODUCTREPOSITORYSQLITE_H
 
 #include "domain/repositories/IProductRepository.h"
+#include "infra/db/ColumnBatch.h"
 #include "infra/db/SqliteConnection.h"
 
 // Implementação do repositório de produtos usando SQLite
@@ -11,15 +12,32 @@ class ProductRepositorySqlite : public ecocin::domain::repositories::IProductRep
 private:
     ecocin::infra::db::SqliteConnection& connection_;
 
+    // Corpo comum das listagens: preenche out (std::vector ou std::pmr::vector) e o devolve
+    template <class Vec> Vec listAllInto(Vec out);
+
 public:
     explicit ProductRepositorySqlite(ecocin::infra::db::SqliteConnection& connection) : connection_(connection) {}
 
     Product create(const Product& in) override;
     std::optional<Product> findById(long long id) override;
     std::optional<Product> findBySku(const std::string& sku) override;
+    std::vector<Product> findByIds(const std::vector<long long>& ids) override;
+    std::vector<Product> findBySkus(const std::vector<std::string>& skus) override;
     std::vector<Product> listAll() override;
+    std::pmr::vector<Product> listAll(std::pmr::memory_resource* mr) override;
     bool update(const Product& p) override;
+    std::optional<ecocin::domain::repositories::ProductFieldUpdate<int>> adjustStock(long long id, int delta) override;
+    std::optional<ecocin::domain::repositories::ProductFieldUpdate<double>> updatePrice(long long id, double price) override;
     bool remove(long long id) override;
+
+    // Grava p com o id dele, inserindo ou sobrescrevendo a linha inteira (cópias do catálogo
+    // nos shards; ver ShardedProductRepository)
+    void upsert(const Product& p);
+
+    // Varredura colunar (infra/db/ColumnBatch.h): só as colunas pedidas, em ordem de id e, com
+    // limit, em lotes (o afterId do próximo lote é lastId() do anterior)
+    ecocin::infra::db::ColumnBatch scanColumns(const std::vector<std::string>& columns,
+                                               long long afterId = 0, std::size_t limit = 0);
 };
 
 }
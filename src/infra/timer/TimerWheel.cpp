@@ -0,0 +1,84 @@
+#include "TimerWheel.h"
+
+namespace ecocin::infra::timer {
+
+TimerWheel::Handle TimerWheel::schedule(Tick expires, std::uint64_t payload) {
+    Handle h;
+    if (!free_.empty()) {
+        h = free_.back();
+        free_.pop_back();
+    } else {
+        h = static_cast<Handle>(nodes_.size());
+        nodes_.emplace_back();
+    }
+    if (expires > next_ && expires - next_ > kMaxDelta) expires = next_ + kMaxDelta;
+    nodes_[h].expires = expires;
+    nodes_[h].payload = payload;
+    link(h);
+    ++size_;
+    return h;
+}
+
+void TimerWheel::cancel(Handle h) {
+    unlink(h);
+    release(h);
+}
+
+// Escolhe o nível pela distância até o vencimento: o nível L guarda distâncias
+// menores que kSlots^(L+1), na posição dada pelos bits do vencimento daquele nível.
+void TimerWheel::link(Handle h) {
+    auto& n = nodes_[h];
+    std::size_t level = 0;
+    std::size_t slot;
+    if (n.expires < next_) {
+        slot = static_cast<std::size_t>(next_ & (kSlots - 1)); // atrasado: sai no próximo tick
+    } else {
+        const Tick delta = n.expires - next_;
+        while (level + 1 < kLevels && delta >= (Tick{1} << (kSlotBits * (level + 1)))) ++level;
+        slot = static_cast<std::size_t>((n.expires >> (kSlotBits * level)) & (kSlots - 1));
+    }
+    n.level = static_cast<std::uint32_t>(level);
+    n.slot = static_cast<std::uint32_t>(slot);
+    n.prev = kNil;
+    n.next = slots_[level][slot];
+    if (n.next != kNil) nodes_[n.next].prev = h;
+    slots_[level][slot] = h;
+}
+
+void TimerWheel::unlink(Handle h) {
+    auto& n = nodes_[h];
+    Handle& head = n.level == kLevels ? firing_ : slots_[n.level][n.slot];
+    if (n.prev != kNil) nodes_[n.prev].next = n.next;
+    else head = n.next;
+    if (n.next != kNil) nodes_[n.next].prev = n.prev;
+    n.prev = n.next = kNil;
+}
+
+void TimerWheel::release(Handle h) {
+    free_.push_back(h);
+    --size_;
+}
+
+// O nível de baixo deu a volta: a posição atual deste nível desce inteira (e, se ele também
+// deu a volta, a do nível de cima antes).
+void TimerWheel::cascade(std::size_t level) {
+    const auto index = static_cast<std::size_t>((next_ >> (kSlotBits * level)) & (kSlots - 1));
+    Handle h = slots_[level][index];
+    slots_[level][index] = kNil;
+    while (h != kNil) {
+        const Handle following = nodes_[h].next;
+        link(h);
+        h = following;
+    }
+    if (index == 0 && level + 1 < kLevels) cascade(level + 1);
+}
+
+// Tira a lista da posição do nível 0 para firing_, de onde advance a consome; um cancel
+// feito dentro de onExpire de um timer do mesmo tick continua valendo.
+void TimerWheel::detach(std::size_t slot) {
+    firing_ = slots_[0][slot];
+    slots_[0][slot] = kNil;
+    for (Handle h = firing_; h != kNil; h = nodes_[h].next) nodes_[h].level = kLevels;
+}
+
+} // namespace ecocin::infra::timer
@@ -0,0 +1,96 @@
+#ifndef ECOCIN_INFRA_TIMER_TIMERWHEEL_H
+#define ECOCIN_INFRA_TIMER_TIMERWHEEL_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ecocin::infra::timer {
+
+// Roda de timers hierárquica (o esquema do kernel Linux): kLevels níveis de kSlots posições. O nível 0
+// tem uma posição por tick; cada nível acima cobre kSlots vezes o anterior. Um timer entra no nível que
+// cobre a sua distância até o vencimento e, quando o nível de baixo dá a volta, a posição correspondente
+// do nível de cima é redistribuída ("cascata") para baixo, cada vez mais perto do tick certo.
+//
+// Agendar e cancelar são O(1) (listas duplamente ligadas intrusivas, nós num vetor reaproveitado);
+// avançar custa O(1) por tick mais os timers que vencem ou descem de nível. Não existe varredura
+// de todos os timers pendentes, então milhões deles não pesam em cada tick.
+//
+// Sem trava: quem usa a roda (StockHoldService) já serializa o acesso.
+class TimerWheel {
+public:
+    using Tick = std::uint64_t;
+    using Handle = std::uint32_t;  // índice do nó; vale até o timer vencer ou ser cancelado
+
+    static constexpr std::size_t kSlotBits = 8;
+    static constexpr std::size_t kSlots = std::size_t{1} << kSlotBits;
+    static constexpr std::size_t kLevels = 4;
+    // Maior distância representável; vencimentos além disso são trazidos para o limite
+    static constexpr Tick kMaxDelta = (Tick{1} << (kSlotBits * kLevels)) - 1;
+
+    explicit TimerWheel(Tick start = 0) : next_(start) { for (auto& level : slots_) level.fill(kNil); }
+
+    // Agenda payload para o tick expires; vencimentos já passados saem no próximo advance
+    Handle schedule(Tick expires, std::uint64_t payload);
+    void cancel(Handle h);
+
+    // Processa todos os ticks até now (inclusive), chamando onExpire(payload) para cada timer vencido.
+    // O nó já foi liberado quando onExpire roda, que pode agendar e cancelar à vontade.
+    template <class F>
+    void advance(Tick now, F&& onExpire) {
+        if (size_ == 0) {
+            if (now >= next_) next_ = now + 1; // roda vazia: nada a cascatear, pula direto
+            return;
+        }
+        while (next_ <= now) {
+            const auto index = static_cast<std::size_t>(next_ & (kSlots - 1));
+            if (index == 0) cascade(1);
+            ++next_;
+            detach(index);
+            while (firing_ != kNil) {
+                const Handle h = firing_;
+                const auto payload = nodes_[h].payload;
+                unlink(h);
+                release(h);
+                onExpire(payload);
+            }
+            if (size_ == 0) {
+                if (now >= next_) next_ = now + 1;
+                return;
+            }
+        }
+    }
+
+    std::size_t size() const { return size_; }
+    Tick nextTick() const { return next_; }
+
+private:
+    static constexpr Handle kNil = 0xFFFFFFFFu;
+
+    struct Node {
+        Tick expires{0};
+        std::uint64_t payload{0};
+        Handle prev{kNil};
+        Handle next{kNil};
+        std::uint32_t level{0};
+        std::uint32_t slot{0};
+    };
+
+    std::array<std::array<Handle, kSlots>, kLevels> slots_{};
+    std::vector<Node> nodes_;
+    std::vector<Handle> free_;
+    Tick next_;              // próximo tick a processar
+    Handle firing_{kNil};    // timers do tick em processamento (nível kLevels)
+    std::size_t size_{0};
+
+    void link(Handle h);
+    void unlink(Handle h);
+    void release(Handle h);
+    void cascade(std::size_t level);
+    void detach(std::size_t slot);
+};
+
+} // namespace ecocin::infra::timer
+
+#endif // ECOCIN_INFRA_TIMER_TIMERWHEEL_H
@@ -1,18 +1,20 @@
 #include "AddressService.h"
 #include <sstream>
+#include <stdexcept>
 
 using namespace ecocin;
-using ecocin::infra::repositories::sqlite::AddressRepositorySqlite;
-using ecocin::infra::repositories::sqlite::ClientRepositorySqlite;
+using ecocin::domain::repositories::IAddressRepository;
+using ecocin::domain::repositories::IClientRepository;
 
 namespace ecocin::services {
     // O construtor utiliza injeção de dependência para receber instâncias dos repositórios.
     // Este é um pilar do design de software SOLID (Inversão de Dependência),
     // que desacopla a camada de serviço da implementação concreta do acesso a dados,
     // facilitando a testabilidade e a manutenção.
-    AddressService::AddressService(AddressRepositorySqlite& addressRepo,
-                                   ClientRepositorySqlite& clientRepo)
-      : addrRepo_(addressRepo), clientRepo_(clientRepo) {}
+    AddressService::AddressService(IAddressRepository& addressRepo,
+                                   IClientRepository& clientRepo,
+                                   domain::repositories::IOrderReferences* orderRefs)
+      : addrRepo_(addressRepo), clientRepo_(clientRepo), orderRefs_(orderRefs) {}
 
     // Cria um novo endereço associado a um cliente, identificado pelo CPF.
     // Este método orquestra a lógica de negócio: primeiro, valida a existência do cliente
@@ -48,6 +50,11 @@ namespace ecocin::services {
         return addrRepo_.listAll();
     }
 
+    // Mesma listagem com o vetor alocado em mr (arena da requisição)
+    std::pmr::vector<Address> AddressService::listAll(std::pmr::memory_resource* mr) {
+        return addrRepo_.listAll(mr);
+    }
+
     // Lista todos os endereços de um cliente específico, buscando-o pelo CPF.
     // Este método exemplifica a orquestração entre diferentes repositórios:
     // primeiro, utiliza o `clientRepo_` para encontrar o cliente e, em seguida,
@@ -59,6 +66,13 @@ namespace ecocin::services {
         return addrRepo_.listByClientId(cli->getId());
     }
 
+    std::pmr::vector<Address> AddressService::listByCpf(const std::string& cpf, std::pmr::memory_resource* mr) {
+        if (cpf.empty()) return std::pmr::vector<Address>(mr);
+        auto cli = clientRepo_.findByCpf(cpf);
+        if (!cli) return std::pmr::vector<Address>(mr);
+        return addrRepo_.listByClientId(cli->getId(), mr);
+    }
+
 
     // Atualiza um endereço existente.
     // A lógica de negócio aqui inclui uma verificação de existência antes da atualização,
@@ -79,7 +93,10 @@ namespace ecocin::services {
     // A camada de serviço delega a operação de exclusão diretamente para o repositório,
     // encapsulando a lógica de acesso a dados e fornecendo uma interface limpa
     // para a camada de apresentação (controllers).
+    // Com o log de pedidos, um endereço usado em pedido é recusado (OrderReferenceConflict).
     bool AddressService::remove(long long id) {
-        return addrRepo_.remove(id);
+        const auto remove = [&] { return addrRepo_.remove(id); };
+        return orderRefs_ ? orderRefs_->removeUnreferenced(domain::repositories::OrderReference::Address, id, remove)
+                          : remove();
     }
 }
@@ -1,30 +1,37 @@
 #ifndef ADDRESS_SERVICE_H
 #define ADDRESS_SERVICE_H
 #include <string>
+#include <memory_resource>
 #include <optional>
 #include <vector>
 
 #include "../domain/entities/Address.h"
-#include "../infra/repositories/sqlite/AddressRepositorySqlite.h" 
-#include "../infra/repositories/sqlite/ClientRepositorySqlite.h"
+#include "domain/repositories/IAddressRepository.h"
+#include "domain/repositories/IClientRepository.h"
+#include "domain/repositories/IOrderReferences.h"
 
 // Classe de serviço para gerenciar operações relacionadas a endereços
 namespace ecocin::services {
     class AddressService {
     public:
-        explicit AddressService(ecocin::infra::repositories::sqlite::AddressRepositorySqlite& addressRepo,
-                                ecocin::infra::repositories::sqlite::ClientRepositorySqlite& clientRepo);
+        // orderRefs, com os pedidos fora do SQLite (log de pedidos), impede remover endereço de entrega
+        explicit AddressService(ecocin::domain::repositories::IAddressRepository& addressRepo,
+                                ecocin::domain::repositories::IClientRepository& clientRepo,
+                                ecocin::domain::repositories::IOrderReferences* orderRefs = nullptr);
         std::optional<Address> create(const std::optional<std::string>& cpf,
                                 const Address& in);
         std::optional<Address> getById(long long id);
         std::vector<Address> listAll();
+        std::pmr::vector<Address> listAll(std::pmr::memory_resource* mr);
         bool update(const long long id, const Address& in);
         bool remove(long long id);
         std::vector<Address> listByCpf(const std::string& cpf);
+        std::pmr::vector<Address> listByCpf(const std::string& cpf, std::pmr::memory_resource* mr);
 
     private:
-        infra::repositories::sqlite::AddressRepositorySqlite& addrRepo_;
-        infra::repositories::sqlite::ClientRepositorySqlite& clientRepo_;
+        domain::repositories::IAddressRepository& addrRepo_;
+        domain::repositories::IClientRepository& clientRepo_;
+        domain::repositories::IOrderReferences* orderRefs_;
 };
 }
 #endif
\ No newline at end of file
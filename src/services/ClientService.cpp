@@ -1,14 +1,14 @@
 #include "ClientService.h"
 #include <stdexcept>
-#include "../infra/repositories/sqlite/ClientRepositorySqlite.h"
 
 namespace ecocin::services {
 
     // O construtor implementa a Inversão de Dependência, recebendo uma referência
     // para o repositório de clientes. Isso desacopla o serviço da implementação
     // concreta do acesso a dados, facilitando testes e futuras modificações.
-    ClientService::ClientService(infra::repositories::sqlite::ClientRepositorySqlite& clientRepo)
-        : clientRepo_(clientRepo) {}
+    ClientService::ClientService(domain::repositories::IClientRepository& clientRepo, LookupFlights& flights,
+                                 domain::repositories::IOrderReferences* orderRefs)
+        : clientRepo_(clientRepo), flights_(flights), orderRefs_(orderRefs) {}
 
     // Orquestra a criação de um novo cliente.
     // A lógica de negócio principal aqui é validar a unicidade do CPF antes de
@@ -19,28 +19,30 @@ namespace ecocin::services {
             throw std::runtime_error("Client with CPF already exists");
         }
         clientRepo_.create(client);
+        flights_.clientByCpf.forget(client.getCpf());
         return "Client created successfully";
     }
 
     // Busca um cliente pelo CPF.
     // O serviço atua como um intermediário, delegando a chamada diretamente
     // ao repositório e mantendo a arquitetura em camadas coesa.
+    // Buscas simultâneas pelo mesmo CPF são agrupadas em uma só consulta (SingleFlight).
     std::optional<Client> ClientService::getClientByCpf(const std::string& cpf) {
-        return clientRepo_.findByCpf(cpf);
+        return flights_.clientByCpf.run(cpf, [&] { return clientRepo_.findByCpf(cpf); });
     }
 
     // Busca um cliente pelo seu ID técnico.
     // Similar à busca por CPF, este método expõe a funcionalidade do repositório
     // através da camada de serviço, garantindo uma interface consistente.
     std::optional<Client> ClientService::getClientById(int64_t id) {
-        return clientRepo_.findById(id);
+        return flights_.clientById.run(id, [&] { return clientRepo_.findById(id); });
     }
 
     // Verifica a existência de um cliente com um determinado CPF.
     // Este método auxiliar encapsula a lógica de verificação, tornando o código
     // de outras operações, como a criação, mais limpo e legível.
     bool ClientService::clientExists(const std::string& cpf) {
-        return clientRepo_.findByCpf(cpf).has_value();
+        return getClientByCpf(cpf).has_value();
     }
 
     // Retorna uma lista de todos os clientes.
@@ -50,6 +52,11 @@ namespace ecocin::services {
         return clientRepo_.listAll();
     }
 
+    // Mesma listagem com o vetor alocado em mr (arena da requisição)
+    std::pmr::vector<Client> ClientService::listAllClients(std::pmr::memory_resource* mr) {
+        return clientRepo_.listAll(mr);
+    }
+
     // Atualiza os dados de um cliente.
     // A lógica de negócio aqui é garantir que o cliente a ser atualizado
     // realmente exista antes de prosseguir com a operação no repositório.
@@ -57,7 +64,10 @@ namespace ecocin::services {
         if (!clientExists(client.getCpf())) {
             throw std::runtime_error("Client does not exist");
         }
-        return clientRepo_.update(client);
+        const bool updated = clientRepo_.update(client);
+        flights_.clientByCpf.forget(client.getCpf());
+        flights_.clientById.forget(client.getId());
+        return updated;
     }
 
     // Remove um cliente com base no seu CPF.
@@ -69,7 +79,15 @@ namespace ecocin::services {
         if (!found) {
             throw std::runtime_error("Client does not exist");
         }
-        clientRepo_.remove(found->getId());   // <-- remove por id
+        // Com o log de pedidos, a conferência de referências e o DELETE acontecem sob o lock do log
+        const auto remove = [&] { return clientRepo_.remove(found->getId()); };   // <-- remove por id
+        if (orderRefs_) {
+            orderRefs_->removeUnreferenced(domain::repositories::OrderReference::Client, found->getId(), remove);
+        } else {
+            remove();
+        }
+        flights_.clientByCpf.forget(cpf);
+        flights_.clientById.forget(found->getId());
         return "Client removed successfully";
     }
 
@@ -2,28 +2,38 @@
 #define ECOCIN_SERVICES_CLIENTSERVICE_H 
 #include "../domain/entities/Client.h"
 #include <string>
+#include <memory_resource>
 #include <vector>
 #include <optional>
 
 
-#include "../infra/repositories/sqlite/ClientRepositorySqlite.h"
+#include "domain/repositories/IClientRepository.h"
+#include "domain/repositories/IOrderReferences.h"
+#include "LookupFlights.h"
 
 namespace ecocin::services {
 
 // Classe de serviço para gerenciar operações relacionadas a clientes
 class ClientService {
 public:
-    explicit ClientService(ecocin::infra::repositories::sqlite::ClientRepositorySqlite& clientRepo);
+    // flights: agrupamentos de buscas do processo, compartilhados com os outros serviços.
+    // orderRefs, com os pedidos fora do SQLite (log de pedidos), impede remover cliente com pedidos
+    ClientService(ecocin::domain::repositories::IClientRepository& clientRepo, LookupFlights& flights,
+                  ecocin::domain::repositories::IOrderReferences* orderRefs = nullptr);
     std::string createClient(const Client& client);
     std::optional<Client> getClientByCpf(const std::string& cpf);
     std::optional<Client> getClientById(int64_t id);
     bool clientExists(const std::string& cpf);
     std::vector<Client> listAllClients();
+    std::pmr::vector<Client> listAllClients(std::pmr::memory_resource* mr); // vetor alocado em mr
     bool updateClient(const Client& client);
     std::string removeClientMessage(const std::string& cpf);
 
 private:
-    ecocin::infra::repositories::sqlite::ClientRepositorySqlite& clientRepo_;
+    ecocin::domain::repositories::IClientRepository& clientRepo_;
+    // Buscas simultâneas pela mesma chave compartilham uma única consulta ao repositório
+    LookupFlights& flights_;
+    ecocin::domain::repositories::IOrderReferences* orderRefs_;
 };
 
 }
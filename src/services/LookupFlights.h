@@ -0,0 +1,28 @@
+#ifndef ECOCIN_SERVICES_LOOKUPFLIGHTS_H
+#define ECOCIN_SERVICES_LOOKUPFLIGHTS_H
+
+#include "../domain/entities/Client.h"
+#include "../domain/entities/Product.h"
+#include "SingleFlight.h"
+
+#include <cstdint>
+#include <optional>
+#include <string>
+
+namespace ecocin::services {
+
+// Agrupamentos (SingleFlight) das buscas por chave, um por processo e compartilhado por todos os
+// serviços de todas as pilhas: ClientService, ProductService e OrderService buscam pelos mesmos
+// objetos, e uma escrita que chama forget() aqui vale para as leituras de qualquer acceptor.
+// Sem isso, um pedido criado depois de um PATCH de preço ainda podia se juntar a uma busca por SKU
+// iniciada antes dele (em outro serviço ou em outra pilha) e sair com o preço antigo.
+struct LookupFlights {
+  SingleFlight<std::string, std::optional<Client>> clientByCpf;
+  SingleFlight<std::int64_t, std::optional<Client>> clientById;
+  SingleFlight<std::string, std::optional<Product>> productBySku;
+  SingleFlight<long long, std::optional<Product>> productById;
+};
+
+} // namespace ecocin::services
+
+#endif // ECOCIN_SERVICES_LOOKUPFLIGHTS_H
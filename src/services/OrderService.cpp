@@ -1,5 +1,7 @@
 #include "OrderService.h"
+#include <iterator>
 #include <sstream>
+#include <unordered_map>
 
 using namespace ecocin;
 using ecocin::services::OrderService;
@@ -10,14 +12,18 @@ using ecocin::services::OrderDetails;
 // orquestre operações complexas que envolvem múltiplas entidades do domínio (Pedidos, Clientes, etc.),
 // sem se preocupar com a implementação do acesso a dados.
 OrderService::OrderService(
-  infra::repositories::sqlite::OrderRepositorySqlite& orderRepo,
-  infra::repositories::sqlite::ClientRepositorySqlite& clientRepo,
-  infra::repositories::sqlite::ProductRepositorySqlite& productRepo,
-  infra::repositories::sqlite::AddressRepositorySqlite& addressRepo)
+  domain::repositories::IOrderRepository& orderRepo,
+  domain::repositories::IClientRepository& clientRepo,
+  domain::repositories::IProductRepository& productRepo,
+  domain::repositories::IAddressRepository& addressRepo,
+  LookupFlights& flights,
+  StockHoldService* holds)
   : orderRepo_(orderRepo)
   , clientRepo_(clientRepo)
   , productRepo_(productRepo)
-  , addressRepo_(addressRepo) {}
+  , addressRepo_(addressRepo)
+  , holds_(holds)
+  , flights_(flights) {}
 
 // Resolve o endereço de entrega para um cliente com base em um tipo preferencial.
 // A lógica de negócio implementada aqui é flexível: primeiro, busca um endereço que
@@ -25,16 +31,11 @@ OrderService::OrderService(
 // um endereço cadastrado, ele é usado como padrão. Isso simplifica a experiência do usuário.
 std::optional<Address> OrderService::resolveAddressForClient(long long clientId,
                                                              const std::string& type) {
-  // 1) tenta por tipo
-  auto list = addressRepo_.listByClientId(clientId);
-  Address only{};
-  bool hasOnly = false;
-
-  for (const auto& a : list) {
-    if (a.getAddressType() == type) {
-      return a;
-    }
+  // 1) tenta por tipo (filtrado no SQL)
+  if (auto byType = addressRepo_.findByClientIdAndType(clientId, type)) {
+    return byType;
   }
+  auto list = addressRepo_.listByClientId(clientId);
   // 2) fallback: se tiver exatamente 1 endereço, usa-o
   if (list.size() == 1) {
     return list.front();
@@ -51,14 +52,16 @@ std::optional<Address> OrderService::resolveAddressForClient(long long clientId,
 std::optional<Order> OrderService::createByCpfSkuAndType(const std::string& cpf,
                                                          const std::string& sku,
                                                          const std::string& shippingAddressType,
-                                                         int quantity) {
-  if (cpf.empty() || sku.empty() || quantity <= 0) return std::nullopt;
+                                                         int quantity,
+                                                         std::optional<std::uint64_t> holdId) {
+  if (cpf.empty() || sku.empty() || (quantity <= 0 && !holdId)) return std::nullopt;
+  if (holdId && !holds_) return std::nullopt;
 
-  auto clientOpt = clientRepo_.findByCpf(cpf);
+  auto clientOpt = flights_.clientByCpf.run(cpf, [&] { return clientRepo_.findByCpf(cpf); });
   if (!clientOpt) return std::nullopt;
   const long long clientId = clientOpt->getId();
 
-  auto productOpt = productRepo_.findBySku(sku);
+  auto productOpt = flights_.productBySku.run(sku, [&] { return productRepo_.findBySku(sku); });
   if (!productOpt) return std::nullopt;
   const long long productId = productOpt->getId();
   const double unitPrice = productOpt->getPrice(); // vem do produto
@@ -69,9 +72,34 @@ std::optional<Order> OrderService::createByCpfSkuAndType(const std::string& cpf,
     return std::nullopt;
   }
 
-  Order o(clientId, productId, addrOpt->getId(), quantity, unitPrice, "PENDING");
+  if (!holdId) {
+    Order o(clientId, productId, addrOpt->getId(), quantity, unitPrice, "PENDING");
+    o.calculateTotal();
+    return orderRepo_.create(o);
+  }
+
+  // Reserva -> baixa, num passo só: a reserva só sai do StockHoldService se for deste produto
+  // (e desta quantidade) e se a baixa passar; a baixa é o UPDATE relativo do repositório, que
+  // recusa estoque negativo, e aí a reserva continua valendo.
+  // Se o INSERT do pedido falhar, o estoque volta; a reserva, já consumida, não.
+  auto hold = holds_->convert(*holdId, productId, quantity, [&](const StockHold& h) {
+    return productRepo_.adjustStock(productId, -h.quantity).has_value();
+  });
+  if (!hold) return std::nullopt;
+  // O estoque mudou: buscas do produto iniciadas antes da baixa não servem mais
+  flights_.productById.forget(productId);
+  flights_.productBySku.forget(sku);
+
+  Order o(clientId, productId, addrOpt->getId(), hold->quantity, unitPrice, "PENDING");
   o.calculateTotal();
-  return orderRepo_.create(o);
+  try {
+    return orderRepo_.create(o);
+  } catch (...) {
+    productRepo_.adjustStock(productId, hold->quantity);
+    flights_.productById.forget(productId);
+    flights_.productBySku.forget(sku);
+    throw;
+  }
 }
 
 // Busca um pedido pelo seu ID.
@@ -87,24 +115,43 @@ std::optional<Order> OrderService::getById(long long id) {
 // `OrderDetails`. Isso demonstra como a camada de serviço pode agregar valor
 // ao combinar e transformar dados de diferentes fontes para atender a uma necessidade específica da aplicação.
 std::vector<OrderDetails> OrderService::listDetailsByCpf(const std::string& cpf) {
-  std::vector<OrderDetails> out;
-  auto clientOpt = clientRepo_.findByCpf(cpf);
+  auto details = listDetailsByCpf(cpf, std::pmr::new_delete_resource());
+  return std::vector<OrderDetails>(std::make_move_iterator(details.begin()), std::make_move_iterator(details.end()));
+}
+
+std::pmr::vector<OrderDetails> OrderService::listDetailsByCpf(const std::string& cpf, std::pmr::memory_resource* mr) {
+  std::pmr::vector<OrderDetails> out(mr);
+  auto clientOpt = flights_.clientByCpf.run(cpf, [&] { return clientRepo_.findByCpf(cpf); });
   if (!clientOpt) return out;
 
   const long long clientId = clientOpt->getId();
-  auto orders = orderRepo_.listByClientId(clientId);
+  auto orders = orderRepo_.listByClientId(clientId, mr);
   if (orders.empty()) return out;
 
   // carrega uma vez o cliente
   const Client client = *clientOpt;
 
-  // para cada order, busca product e address
+  // produtos e endereços de todos os pedidos numa consulta cada (findByIds), em vez de um
+  // findById por pedido; mapas por id também na arena
+  std::vector<long long> productIds, addressIds;
+  productIds.reserve(orders.size());
+  addressIds.reserve(orders.size());
+  for (const auto& o : orders) {
+    productIds.push_back(o.getProductId());
+    addressIds.push_back(o.getShippingAddressId());
+  }
+  std::pmr::unordered_map<long long, Product> products(mr);
+  for (auto& p : productRepo_.findByIds(productIds)) products.emplace(p.getId(), std::move(p));
+  std::pmr::unordered_map<long long, Address> addresses(mr);
+  for (auto& a : addressRepo_.findByIds(addressIds)) addresses.emplace(a.getId(), std::move(a));
+
+  out.reserve(orders.size());
   for (const auto& o : orders) {
-    auto productOpt = productRepo_.findById(o.getProductId());
-    auto addressOpt = addressRepo_.findById(o.getShippingAddressId());
-    if (!productOpt || !addressOpt) continue;
+    auto product = products.find(o.getProductId());
+    auto address = addresses.find(o.getShippingAddressId());
+    if (product == products.end() || address == addresses.end()) continue;
 
-    out.push_back(OrderDetails{ o, client, *productOpt, *addressOpt });
+    out.push_back(OrderDetails{ o, client, product->second, address->second });
   }
   return out;
 }
@@ -1,7 +1,9 @@
 #ifndef ORDER_SERVICE_H
 #define ORDER_SERVICE_H
 
+#include <cstdint>
 #include <string>
+#include <memory_resource>
 #include <optional>
 #include <vector>
 
@@ -9,10 +11,12 @@
 #include "../domain/entities/Client.h"
 #include "../domain/entities/Product.h"
 #include "../domain/entities/Address.h"
-#include "../infra/repositories/sqlite/OrderRepositorySqlite.h"
-#include "../infra/repositories/sqlite/ClientRepositorySqlite.h"
-#include "../infra/repositories/sqlite/ProductRepositorySqlite.h"
-#include "../infra/repositories/sqlite/AddressRepositorySqlite.h"
+#include "domain/repositories/IOrderRepository.h"
+#include "domain/repositories/IClientRepository.h"
+#include "domain/repositories/IProductRepository.h"
+#include "domain/repositories/IAddressRepository.h"
+#include "LookupFlights.h"
+#include "StockHoldService.h"
 
 namespace ecocin::services {
 
@@ -26,28 +30,41 @@ struct OrderDetails {
 class OrderService {
 public:
   OrderService(
-    infra::repositories::sqlite::OrderRepositorySqlite& orderRepo,
-    infra::repositories::sqlite::ClientRepositorySqlite& clientRepo,
-    infra::repositories::sqlite::ProductRepositorySqlite& productRepo,
-    infra::repositories::sqlite::AddressRepositorySqlite& addressRepo);
+    domain::repositories::IOrderRepository& orderRepo,
+    domain::repositories::IClientRepository& clientRepo,
+    domain::repositories::IProductRepository& productRepo,
+    domain::repositories::IAddressRepository& addressRepo,
+    LookupFlights& flights,
+    StockHoldService* holds = nullptr);
 
-  // Cria pedido com cpf + sku + shippingAddressType (unitPrice e status definidos no backend)
+  // Cria pedido com cpf + sku + shippingAddressType (unitPrice e status definidos no backend).
+  // Com holdId, a reserva de estoque vira baixa: o estoque do produto cai em quantity e a reserva
+  // sai do StockHoldService. quantity <= 0 com holdId usa a quantidade reservada.
   std::optional<Order> createByCpfSkuAndType(const std::string& cpf,
                                              const std::string& sku,
                                              const std::string& shippingAddressType,
-                                             int quantity);
+                                             int quantity,
+                                             std::optional<std::uint64_t> holdId = std::nullopt);
 
   // Lista pedidos por CPF já com entidades relacionadas
   std::vector<OrderDetails> listDetailsByCpf(const std::string& cpf);
+  // Idem, com o resultado e as estruturas intermediárias alocados em mr (arena da requisição)
+  std::pmr::vector<OrderDetails> listDetailsByCpf(const std::string& cpf, std::pmr::memory_resource* mr);
 
   // Utilidades
   std::optional<Order> getById(long long id);
 
 private:
-  infra::repositories::sqlite::OrderRepositorySqlite&   orderRepo_;
-  infra::repositories::sqlite::ClientRepositorySqlite&  clientRepo_;
-  infra::repositories::sqlite::ProductRepositorySqlite& productRepo_;
-  infra::repositories::sqlite::AddressRepositorySqlite& addressRepo_;
+  domain::repositories::IOrderRepository&   orderRepo_;
+  domain::repositories::IClientRepository&  clientRepo_;
+  domain::repositories::IProductRepository& productRepo_;
+  domain::repositories::IAddressRepository& addressRepo_;
+  StockHoldService* holds_;
+
+  // Pedidos simultâneos do mesmo produto (ou do mesmo cliente) compartilham a busca
+  // por SKU/CPF em vez de cada um consultar o SQLite. São os mesmos agrupamentos do
+  // ProductService/ClientService: um PATCH de preço invalida também a busca dos pedidos
+  LookupFlights& flights_;
 
   std::optional<Address> resolveAddressForClient(long long clientId,
                                                  const std::string& addressType);
@@ -1,16 +1,24 @@
 #include "ProductService.h"
+#include <cmath>
 #include <sstream>
+#include <stdexcept>
 
 using namespace ecocin;
-using ecocin::infra::repositories::sqlite::ProductRepositorySqlite;
+using ecocin::domain::repositories::IProductRepository;
 
 namespace ecocin::services {
 
 // O construtor aplica o princípio da Inversão de Dependência, recebendo o repositório
 // de produtos como uma dependência externa. Isso torna o serviço mais testável e flexível,
 // pois ele não está acoplado a uma implementação concreta de acesso a dados.
-ProductService::ProductService(ProductRepositorySqlite& productRepo)
-  : productRepo_(productRepo) {}
+ProductService::ProductService(IProductRepository& productRepo, LookupFlights& flights, StockHoldService* holds,
+                               domain::repositories::IOrderReferences* orderRefs)
+  : productRepo_(productRepo), holds_(holds), orderRefs_(orderRefs), flights_(flights) {}
+
+StockHoldService& ProductService::holds() {
+  if (!holds_) throw std::logic_error("ProductService sem StockHoldService: reservas de estoque desligadas");
+  return *holds_;
+}
 
 // Valida as regras de negócio de um objeto 'Product'.
 // Este método privado encapsula a lógica de validação (campos obrigatórios, valores válidos),
@@ -49,21 +57,35 @@ std::string ProductService::createProduct(const Product& in) {
   }
 
   productRepo_.create(p);
+  flights_.productBySku.forget(p.getSku().str());
   return "Product created";
 }
 
 // Busca um produto pelo seu ID.
 // O serviço atua como uma fachada, delegando a chamada diretamente ao repositório.
 // Manter essa camada de passagem é importante para a consistência da arquitetura.
+// Buscas simultâneas pelo mesmo ID são agrupadas em uma só consulta (SingleFlight).
 std::optional<Product> ProductService::getById(long long id) {
-  return productRepo_.findById(id);
+  return flights_.productById.run(id, [&] { return productRepo_.findById(id); });
 }
 
 // Busca um produto pelo seu SKU.
 // Expõe uma funcionalidade de busca por uma chave de negócio, o que é uma
 // responsabilidade comum da camada de serviço para abstrair as necessidades da aplicação.
+// No lançamento de um produto chegam centenas de buscas pelo mesmo SKU ao mesmo tempo;
+// elas são agrupadas e só a primeira vai ao SQLite.
 std::optional<Product> ProductService::getBySku(const std::string& sku) {
-  return productRepo_.findBySku(sku);
+  return flights_.productBySku.run(sku, [&] { return productRepo_.findBySku(sku); });
+}
+
+// Busca vários produtos de uma vez (carrinho, página de pedido): uma consulta IN no repositório
+// em vez de um getById por item. Os que não existem ficam fora da lista.
+std::vector<Product> ProductService::getByIds(const std::vector<long long>& ids) {
+  return productRepo_.findByIds(ids);
+}
+
+std::vector<Product> ProductService::getBySkus(const std::vector<std::string>& skus) {
+  return productRepo_.findBySkus(skus);
 }
 
 // Retorna uma lista com todos os produtos.
@@ -73,6 +95,10 @@ std::vector<Product> ProductService::listAll() {
   return productRepo_.listAll();
 }
 
+std::pmr::vector<Product> ProductService::listAll(std::pmr::memory_resource* mr) {
+  return productRepo_.listAll(mr);
+}
+
 // Atualiza um produto existente.
 // Antes de delegar a atualização para o repositório, o serviço executa a mesma
 // lógica de validação da criação, garantindo a consistência e integridade dos dados.
@@ -81,7 +107,35 @@ bool ProductService::updateProduct(const Product& p) {
   if (!errors.empty()) {
     return false;
   }
-  return productRepo_.update(p);
+  const bool updated = productRepo_.update(p);
+  flights_.productById.forget(p.getId());
+  flights_.productBySku.forget(p.getSku().str());
+  return updated;
+}
+
+// Ajusta o estoque em delta (positivo repõe, negativo baixa).
+// Jobs de sincronização de estoque chamam isto em paralelo; como o repositório faz um único
+// UPDATE relativo, não há janela entre ler e gravar em que um ajuste apague o outro.
+// Só quando o UPDATE não pega nenhuma linha é que lemos o produto, para distinguir
+// "não existe" de "o estoque ficaria negativo".
+PatchResult<int> ProductService::adjustStock(long long id, int delta) {
+  auto updated = productRepo_.adjustStock(id, delta);
+  if (!updated) {
+    return {productRepo_.findById(id) ? PatchStatus::Invalid : PatchStatus::NotFound};
+  }
+  flights_.productById.forget(id);
+  flights_.productBySku.forget(updated->sku);
+  return {PatchStatus::Updated, updated->value};
+}
+
+// Troca o preço de um produto sem regravar as demais colunas.
+PatchResult<double> ProductService::updatePrice(long long id, double price) {
+  if (!std::isfinite(price) || price < 0.0) return {PatchStatus::Invalid};
+  auto updated = productRepo_.updatePrice(id, price);
+  if (!updated) return {PatchStatus::NotFound};
+  flights_.productById.forget(id);
+  flights_.productBySku.forget(updated->sku);
+  return {PatchStatus::Updated, updated->value};
 }
 
 // Remove um produto pelo seu ID.
@@ -90,14 +144,44 @@ bool ProductService::updateProduct(const Product& p) {
 std::string ProductService::removeByIdMessage(long long id) {
   auto found = productRepo_.findById(id);
   if (!found) return "Product not found";
-  return productRepo_.remove(id) ? "Product removed" : "Could not remove product";
+  // Sem pedido novo citando o produto entre a conferência e o DELETE (ver IOrderReferences)
+  const auto remove = [&] { return productRepo_.remove(id); };
+  const bool removed = orderRefs_ ? orderRefs_->removeUnreferenced(domain::repositories::OrderReference::Product, id, remove)
+                                  : remove();
+  flights_.productById.forget(id);
+  flights_.productBySku.forget(found->getSku().str());
+  return removed ? "Product removed" : "Could not remove product";
+}
+
+// Reserva unidades de um produto por ttl. O estoque vem do banco a cada chamada; a conta
+// (estoque menos o já reservado) e a gravação da reserva acontecem juntas no StockHoldService.
+HoldResult ProductService::placeHold(long long id, int quantity, std::chrono::seconds ttl) {
+  auto& h = holds();
+  auto found = getById(id);
+  if (!found) return {HoldStatus::NotFound};
+  return h.hold(id, quantity, found->getStockQuantity(), ttl);
+}
+
+bool ProductService::releaseHold(long long id, std::uint64_t holdId) {
+  return holds().release(holdId, id);
+}
+
+std::optional<StockAvailability> ProductService::availability(long long id) {
+  auto& h = holds();
+  auto found = getById(id);
+  if (!found) return std::nullopt;
+  StockAvailability a;
+  a.stockQuantity = found->getStockQuantity();
+  a.held = h.held(id);
+  a.available = a.stockQuantity > a.held ? a.stockQuantity - a.held : 0;
+  return a;
 }
 
 // Verifica a existência de um produto com base no SKU.
 // Este método auxiliar é útil para lógicas de negócio, como a de criação,
 // para evitar a duplicação de registros com o mesmo identificador de negócio.
 bool ProductService::existsBySku(const std::string& sku) {
-  return static_cast<bool>(productRepo_.findBySku(sku));
+  return static_cast<bool>(getBySku(sku));
 }
 
 } // namespace ecocin::services
@@ -2,33 +2,76 @@
 #define ECOCIN_SERVICES_PRODUCTSERVICE_H
 
 #include "../domain/entities/Product.h"
-#include "../infra/repositories/sqlite/ProductRepositorySqlite.h"
+#include "domain/repositories/IOrderReferences.h"
+#include "domain/repositories/IProductRepository.h"
 #include "../domain/core/Uuid.h"
+#include "LookupFlights.h"
+#include "StockHoldService.h"
+#include <chrono>
+#include <memory_resource>
 #include <optional>
 #include <string>
 #include <vector>
 
 namespace ecocin::services {
 
+// Resultado dos PATCH de estoque e preço: o valor gravado quando status == Updated
+enum class PatchStatus { Updated, NotFound, Invalid };
+template <class T>
+struct PatchResult {
+  PatchStatus status;
+  T value{};
+};
+
+// Estoque de um produto descontadas as reservas ativas
+struct StockAvailability {
+  int stockQuantity{0};
+  long long held{0};
+  long long available{0};
+};
+
 // Classe de serviço para gerenciar operações relacionadas a produtos
 class ProductService {
 public:
-  explicit ProductService(ecocin::infra::repositories::sqlite::ProductRepositorySqlite& productRepo);
+  // flights: agrupamentos de buscas do processo, compartilhados com os outros serviços.
+  // holds é opcional: sem ele os métodos de reserva lançam std::logic_error.
+  // orderRefs, com os pedidos fora do SQLite (log de pedidos), impede remover produto com pedidos
+  ProductService(ecocin::domain::repositories::IProductRepository& productRepo, LookupFlights& flights,
+                 StockHoldService* holds = nullptr,
+                 ecocin::domain::repositories::IOrderReferences* orderRefs = nullptr);
 
 
   std::string createProduct(const Product& in);
   std::optional<Product> getById(long long id);
   std::optional<Product> getBySku(const std::string& sku);
+  std::vector<Product> getByIds(const std::vector<long long>& ids);      // uma consulta para a lista toda
+  std::vector<Product> getBySkus(const std::vector<std::string>& skus);
   std::vector<Product> listAll();
+  std::pmr::vector<Product> listAll(std::pmr::memory_resource* mr); // vetor alocado em mr (arena da requisição)
 
   bool updateProduct(const Product& p);
+  // Atualizações parciais atômicas (um UPDATE relativo, sem ler antes). Invalid: estoque
+  // resultante fora de [0, INT_MAX] ou preço negativo/não finito.
+  PatchResult<int> adjustStock(long long id, int delta);
+  PatchResult<double> updatePrice(long long id, double price);
   std::string removeByIdMessage(long long id);
 
+  // Reservas de estoque com prazo (StockHoldService): NotFound se o produto não existe
+  HoldResult placeHold(long long id, int quantity, std::chrono::seconds ttl);
+  bool releaseHold(long long id, std::uint64_t holdId);
+  std::optional<StockAvailability> availability(long long id);
+
   bool existsBySku(const std::string& sku);
 
 private:
-  ecocin::infra::repositories::sqlite::ProductRepositorySqlite& productRepo_;
+  ecocin::domain::repositories::IProductRepository& productRepo_;
+  StockHoldService* holds_;
+  ecocin::domain::repositories::IOrderReferences* orderRefs_;
+  // Buscas simultâneas pela mesma chave compartilham uma única consulta ao repositório
+  LookupFlights& flights_;
+
   static std::string validate(const Product& p);
+  StockHoldService& holds();
 };
 
 } // namespace ecocin::services
@@ -0,0 +1,75 @@
+#ifndef ECOCIN_SERVICES_SINGLEFLIGHT_H
+#define ECOCIN_SERVICES_SINGLEFLIGHT_H
+
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+namespace ecocin::services {
+
+// Agrupamento de leituras idênticas simultâneas ("single flight").
+// Quando várias threads pedem a mesma chave ao mesmo tempo (ex.: centenas de GET /products/sku/{sku}
+// no lançamento de um produto), só a primeira executa a consulta no repositório; as outras esperam
+// e recebem uma cópia do mesmo resultado (ou a mesma exceção). Nada é guardado depois que a consulta
+// termina: a próxima leitura da chave vai ao banco de novo, então não há cache a invalidar.
+//
+// Uma escrita deve chamar forget(key) para que leituras iniciadas depois dela não se juntem a uma
+// consulta que começou antes e poderia devolver o valor anterior.
+template <class Key, class Value, class Hash = std::hash<Key>>
+class SingleFlight {
+private:
+    struct Call {
+        std::promise<Value> promise;
+        std::shared_future<Value> result{promise.get_future().share()};
+    };
+
+    std::mutex mutex_;
+    std::unordered_map<Key, std::shared_ptr<Call>, Hash> calls_;
+
+    // Remove a chamada do mapa, a menos que forget() já a tenha trocado por outra
+    void finish(const Key& key, const std::shared_ptr<Call>& call) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = calls_.find(key);
+        if (it != calls_.end() && it->second == call) calls_.erase(it);
+    }
+
+public:
+    // Executa fn() para key, ou espera a execução já em andamento para a mesma chave
+    template <class F>
+    Value run(const Key& key, F&& fn) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (auto it = calls_.find(key); it != calls_.end()) {
+            auto result = it->second->result;
+            lock.unlock();
+            return result.get(); // cópia do valor compartilhado (ou relança a exceção)
+        }
+        auto call = std::make_shared<Call>();
+        calls_.emplace(key, call);
+        lock.unlock();
+
+        try {
+            Value value = std::invoke(std::forward<F>(fn));
+            finish(key, call);
+            call->promise.set_value(value);
+            return value;
+        } catch (...) {
+            finish(key, call);
+            call->promise.set_exception(std::current_exception());
+            throw;
+        }
+    }
+
+    // Leituras que começarem a partir de agora não se juntam à chamada em andamento para key
+    void forget(const Key& key) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        calls_.erase(key);
+    }
+};
+
+} // namespace ecocin::services
+
+#endif // ECOCIN_SERVICES_SINGLEFLIGHT_H
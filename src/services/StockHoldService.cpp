@@ -0,0 +1,120 @@
+#include "StockHoldService.h"
+
+namespace ecocin::services {
+
+using infra::timer::TimerWheel;
+
+StockHoldService::StockHoldService(std::function<Clock::time_point()> now)
+  : now_(std::move(now)), epoch_(now_()) {}
+
+TimerWheel::Tick StockHoldService::tickOf(Clock::time_point t) const {
+  if (t <= epoch_) return 0;
+  return static_cast<TimerWheel::Tick>((t - epoch_) / kTick);
+}
+
+// Tira a reserva da soma do produto; o produto sai do mapa quando não tem mais nada reservado
+void StockHoldService::dropLocked(const StockHold& h) {
+  auto it = heldByProduct_.find(h.productId);
+  if (it == heldByProduct_.end()) return;
+  it->second -= h.quantity;
+  if (it->second <= 0) heldByProduct_.erase(it);
+}
+
+// Devolve ao mapa uma reserva retirada por convert; se o prazo passou no meio, vence no próximo avanço
+void StockHoldService::restoreLocked(const Entry& e) {
+  holds_.emplace(e.hold.id, Entry{e.hold, wheel_.schedule(e.expires, e.hold.id), e.expires});
+}
+
+// Processa os ticks vencidos desde a última chamada; cada reserva vencida sai do mapa e da soma
+void StockHoldService::expireLocked() {
+  wheel_.advance(tickOf(now_()), [&](std::uint64_t id) {
+    auto it = holds_.find(id);
+    if (it == holds_.end()) return;
+    dropLocked(it->second.hold);
+    holds_.erase(it);
+  });
+}
+
+// A reserva vence no primeiro tick depois do prazo: nunca antes, no máximo um tick depois.
+HoldResult StockHoldService::hold(long long productId, int quantity, int stockQuantity,
+                                  std::chrono::seconds ttl) {
+  if (quantity <= 0 || ttl <= std::chrono::seconds::zero() || ttl > kMaxTtl) return {HoldStatus::Invalid};
+
+  std::lock_guard<std::mutex> lock(mu_);
+  expireLocked();
+  const auto current = heldByProduct_.find(productId);
+  const long long alreadyHeld = current == heldByProduct_.end() ? 0 : current->second;
+  const long long available = static_cast<long long>(stockQuantity) - alreadyHeld;
+  if (quantity > available) return {HoldStatus::Insufficient, {}, available < 0 ? 0 : available};
+
+  const auto now = now_();
+  StockHold h;
+  h.id = nextId_++;
+  h.productId = productId;
+  h.quantity = quantity;
+  h.expiresAt = std::chrono::system_clock::now() + ttl;
+
+  const auto expires = tickOf(now + ttl) + 1;
+  holds_.emplace(h.id, Entry{h, wheel_.schedule(expires, h.id), expires});
+  heldByProduct_[productId] = alreadyHeld + quantity;
+  return {HoldStatus::Held, h, available - quantity};
+}
+
+std::optional<StockHold> StockHoldService::take(std::uint64_t holdId, long long productId, int quantity) {
+  return convert(holdId, productId, quantity, [](const StockHold&) { return true; });
+}
+
+// A reserva sai do mapa e da roda sob a trava, mas a baixa (um UPDATE no banco) roda sem ela: uma
+// escrita lenta não segura hold/held/release de todos os produtos. As unidades só saem da soma do
+// produto depois que commit confirma.
+std::optional<StockHold> StockHoldService::convert(std::uint64_t holdId, long long productId, int quantity,
+                                                   const std::function<bool(const StockHold&)>& commit) {
+  Entry taken;
+  {
+    std::lock_guard<std::mutex> lock(mu_);
+    expireLocked();
+    auto it = holds_.find(holdId);
+    if (it == holds_.end()) return std::nullopt;
+    const auto& h = it->second.hold;
+    if (h.productId != productId || (quantity > 0 && h.quantity != quantity)) return std::nullopt;
+    taken = it->second;
+    wheel_.cancel(taken.timer);
+    holds_.erase(it);
+  }
+
+  bool committed = false;
+  try {
+    committed = commit(taken.hold);
+  } catch (...) {
+    std::lock_guard<std::mutex> lock(mu_);
+    restoreLocked(taken);
+    throw;
+  }
+
+  std::lock_guard<std::mutex> lock(mu_);
+  if (!committed) {
+    restoreLocked(taken);
+    return std::nullopt;
+  }
+  dropLocked(taken.hold);
+  return taken.hold;
+}
+
+bool StockHoldService::release(std::uint64_t holdId, long long productId) {
+  return take(holdId, productId).has_value();
+}
+
+long long StockHoldService::held(long long productId) {
+  std::lock_guard<std::mutex> lock(mu_);
+  expireLocked();
+  auto it = heldByProduct_.find(productId);
+  return it == heldByProduct_.end() ? 0 : it->second;
+}
+
+std::size_t StockHoldService::activeHolds() {
+  std::lock_guard<std::mutex> lock(mu_);
+  expireLocked();
+  return holds_.size();
+}
+
+} // namespace ecocin::services
@@ -0,0 +1,95 @@
+#ifndef ECOCIN_SERVICES_STOCKHOLDSERVICE_H
+#define ECOCIN_SERVICES_STOCKHOLDSERVICE_H
+
+#include "../infra/timer/TimerWheel.h"
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+
+namespace ecocin::services {
+
+// Reserva temporária de estoque: quantity unidades do produto ficam separadas até expiresAt
+struct StockHold {
+  std::uint64_t id{0};
+  long long productId{0};
+  int quantity{0};
+  std::chrono::system_clock::time_point expiresAt;
+};
+
+enum class HoldStatus { Held, NotFound, Insufficient, Invalid };
+struct HoldResult {
+  HoldStatus status;
+  StockHold hold{};
+  long long available{0}; // estoque livre depois da reserva (ou o que havia, se Insufficient)
+};
+
+// Reservas de estoque com prazo (checkout: o carrinho segura as unidades enquanto o cliente paga).
+// Ficam só em memória: um mapa das reservas por id, a soma reservada por produto e uma roda de
+// timers (TimerWheel) que as expira. O disponível de um produto é stock_quantity menos a soma
+// reservada, em O(1); expirar custa o mesmo com mil ou com milhões de reservas, sem varrer nada.
+//
+// Uma instância por processo, compartilhada pelas pilhas de todos os acceptors (thread-safe).
+// A roda avança sob demanda, no começo de cada chamada: não há thread de expiração.
+// Reiniciar o servidor solta todas as reservas (o estoque gravado no banco não muda).
+class StockHoldService {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  static constexpr std::chrono::milliseconds kTick{100};
+  static constexpr std::chrono::seconds kDefaultTtl{600};
+  static constexpr std::chrono::seconds kMaxTtl{24 * 3600};
+
+  // now só é trocado em testes, para controlar o relógio
+  explicit StockHoldService(std::function<Clock::time_point()> now = Clock::now);
+
+  // Reserva quantity unidades se stockQuantity (lido do banco pelo chamador) menos o já
+  // reservado comportar. Invalid: quantity <= 0 ou ttl fora de (0, kMaxTtl].
+  HoldResult hold(long long productId, int quantity, int stockQuantity,
+                  std::chrono::seconds ttl = kDefaultTtl);
+
+  // Remove e devolve a reserva ativa para virar baixa de estoque (criação do pedido).
+  // Só remove se for do produto e, com quantity > 0, da quantidade informados.
+  std::optional<StockHold> take(std::uint64_t holdId, long long productId, int quantity = 0);
+
+  // Como take, mas num passo só com a baixa: a reserva só é consumida se commit(reserva) devolver
+  // true; se commit recusa ou lança, ela volta a valer, com o mesmo prazo.
+  // commit roda fora da trava do serviço (pode gravar no banco e até chamar o serviço). Enquanto
+  // ele roda, a reserva não está disponível para take/convert/release, mas as suas unidades
+  // continuam contadas em held(), então nenhuma outra reserva as ocupa.
+  std::optional<StockHold> convert(std::uint64_t holdId, long long productId, int quantity,
+                                   const std::function<bool(const StockHold&)>& commit);
+
+  // Solta a reserva antes do prazo; false se não existe (ou já expirou) ou é de outro produto
+  bool release(std::uint64_t holdId, long long productId);
+
+  long long held(long long productId);
+  std::size_t activeHolds();
+
+private:
+  struct Entry {
+    StockHold hold;
+    infra::timer::TimerWheel::Handle timer;
+    infra::timer::TimerWheel::Tick expires; // tick do timer, para reagendar uma reserva devolvida
+  };
+
+  std::function<Clock::time_point()> now_;
+  const Clock::time_point epoch_;
+  std::mutex mu_;
+  infra::timer::TimerWheel wheel_;
+  std::unordered_map<std::uint64_t, Entry> holds_;
+  std::unordered_map<long long, long long> heldByProduct_;
+  std::uint64_t nextId_{1};
+
+  infra::timer::TimerWheel::Tick tickOf(Clock::time_point t) const;
+  void expireLocked();
+  void dropLocked(const StockHold& h);
+  void restoreLocked(const Entry& e);
+};
+
+} // namespace ecocin::services
+
+#endif // ECOCIN_SERVICES_STOCKHOLDSERVICE_H
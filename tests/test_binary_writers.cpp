@@ -0,0 +1,155 @@
+#include <catch2/catch_all.hpp>
+#include "controllers/codec/BinaryWriters.h"
+
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+
+using ecocin::controllers::codec::CborWriter;
+using ecocin::controllers::codec::MsgPackWriter;
+
+namespace {
+
+std::string bytes(std::initializer_list<unsigned> b) {
+  std::string out;
+  for (const unsigned c : b) out.push_back(static_cast<char>(c));
+  return out;
+}
+
+template <class Writer>
+std::string int64(std::int64_t v) {
+  Writer w;
+  w.int64(v);
+  return w.take();
+}
+
+// Só o cabeçalho: o corpo é a própria string, conferida pelo tamanho total
+template <class Writer>
+std::string stringHead(std::size_t n) {
+  Writer w;
+  w.string(std::string(n, 'x'));
+  const auto out = w.take();
+  REQUIRE(out.size() > n);
+  return out.substr(0, out.size() - n);
+}
+
+template <class Writer>
+std::string mapHead(std::size_t n) {
+  Writer w;
+  w.beginMap(n);
+  return w.take();
+}
+
+template <class Writer>
+std::string arrayHead(std::size_t n) {
+  Writer w;
+  w.beginArray(n);
+  return w.take();
+}
+
+} // namespace
+
+TEST_CASE("CBOR: inteiros sem sinal nos limites de cada tamanho") {
+  REQUIRE(int64<CborWriter>(0) == bytes({0x00}));
+  REQUIRE(int64<CborWriter>(23) == bytes({0x17}));
+  REQUIRE(int64<CborWriter>(24) == bytes({0x18, 0x18}));
+  REQUIRE(int64<CborWriter>(255) == bytes({0x18, 0xFF}));
+  REQUIRE(int64<CborWriter>(256) == bytes({0x19, 0x01, 0x00}));
+  REQUIRE(int64<CborWriter>(65535) == bytes({0x19, 0xFF, 0xFF}));
+  REQUIRE(int64<CborWriter>(65536) == bytes({0x1A, 0x00, 0x01, 0x00, 0x00}));
+  REQUIRE(int64<CborWriter>(0xFFFFFFFFll) == bytes({0x1A, 0xFF, 0xFF, 0xFF, 0xFF}));
+  REQUIRE(int64<CborWriter>(0x100000000ll) == bytes({0x1B, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00}));
+  REQUIRE(int64<CborWriter>(INT64_MAX) == bytes({0x1B, 0x7F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF}));
+}
+
+TEST_CASE("CBOR: inteiros negativos (-1 - n no tipo maior 1)") {
+  REQUIRE(int64<CborWriter>(-1) == bytes({0x20}));
+  REQUIRE(int64<CborWriter>(-24) == bytes({0x37}));
+  REQUIRE(int64<CborWriter>(-25) == bytes({0x38, 0x18}));
+  REQUIRE(int64<CborWriter>(-256) == bytes({0x38, 0xFF}));
+  REQUIRE(int64<CborWriter>(-257) == bytes({0x39, 0x01, 0x00}));
+  REQUIRE(int64<CborWriter>(-65537) == bytes({0x3A, 0x00, 0x01, 0x00, 0x00}));
+  REQUIRE(int64<CborWriter>(INT64_MIN) == bytes({0x3B, 0x7F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF}));
+}
+
+TEST_CASE("CBOR: strings, mapas e arrays usam o mesmo cabeçalho") {
+  REQUIRE(stringHead<CborWriter>(0) == bytes({0x60}));
+  REQUIRE(stringHead<CborWriter>(23) == bytes({0x77}));
+  REQUIRE(stringHead<CborWriter>(24) == bytes({0x78, 0x18}));
+  REQUIRE(stringHead<CborWriter>(255) == bytes({0x78, 0xFF}));
+  REQUIRE(stringHead<CborWriter>(256) == bytes({0x79, 0x01, 0x00}));
+  REQUIRE(stringHead<CborWriter>(65535) == bytes({0x79, 0xFF, 0xFF}));
+  REQUIRE(stringHead<CborWriter>(65536) == bytes({0x7A, 0x00, 0x01, 0x00, 0x00}));
+
+  REQUIRE(mapHead<CborWriter>(23) == bytes({0xB7}));
+  REQUIRE(mapHead<CborWriter>(24) == bytes({0xB8, 0x18}));
+  REQUIRE(mapHead<CborWriter>(256) == bytes({0xB9, 0x01, 0x00}));
+  REQUIRE(arrayHead<CborWriter>(23) == bytes({0x97}));
+  REQUIRE(arrayHead<CborWriter>(24) == bytes({0x98, 0x18}));
+  REQUIRE(arrayHead<CborWriter>(65536) == bytes({0x9A, 0x00, 0x01, 0x00, 0x00}));
+}
+
+TEST_CASE("CBOR: float64, booleanos e null") {
+  CborWriter w;
+  w.float64(1.5);
+  w.boolean(true);
+  w.boolean(false);
+  w.null();
+  REQUIRE(w.data() == bytes({0xFB, 0x3F, 0xF8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xF5, 0xF4, 0xF6}));
+}
+
+TEST_CASE("MessagePack: inteiros positivos nos limites de cada tamanho") {
+  REQUIRE(int64<MsgPackWriter>(0) == bytes({0x00}));
+  REQUIRE(int64<MsgPackWriter>(127) == bytes({0x7F}));
+  REQUIRE(int64<MsgPackWriter>(128) == bytes({0xCC, 0x80}));
+  REQUIRE(int64<MsgPackWriter>(255) == bytes({0xCC, 0xFF}));
+  REQUIRE(int64<MsgPackWriter>(256) == bytes({0xCD, 0x01, 0x00}));
+  REQUIRE(int64<MsgPackWriter>(65535) == bytes({0xCD, 0xFF, 0xFF}));
+  REQUIRE(int64<MsgPackWriter>(65536) == bytes({0xCE, 0x00, 0x01, 0x00, 0x00}));
+  REQUIRE(int64<MsgPackWriter>(0xFFFFFFFFll) == bytes({0xCE, 0xFF, 0xFF, 0xFF, 0xFF}));
+  REQUIRE(int64<MsgPackWriter>(0x100000000ll) == bytes({0xCF, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00}));
+}
+
+TEST_CASE("MessagePack: inteiros negativos (fixint e int8/16/32/64)") {
+  REQUIRE(int64<MsgPackWriter>(-1) == bytes({0xFF}));
+  REQUIRE(int64<MsgPackWriter>(-32) == bytes({0xE0}));
+  REQUIRE(int64<MsgPackWriter>(-33) == bytes({0xD0, 0xDF}));
+  REQUIRE(int64<MsgPackWriter>(INT8_MIN) == bytes({0xD0, 0x80}));
+  REQUIRE(int64<MsgPackWriter>(INT8_MIN - 1) == bytes({0xD1, 0xFF, 0x7F}));
+  REQUIRE(int64<MsgPackWriter>(INT16_MIN) == bytes({0xD1, 0x80, 0x00}));
+  REQUIRE(int64<MsgPackWriter>(INT16_MIN - 1) == bytes({0xD2, 0xFF, 0xFF, 0x7F, 0xFF}));
+  REQUIRE(int64<MsgPackWriter>(INT32_MIN) == bytes({0xD2, 0x80, 0x00, 0x00, 0x00}));
+  REQUIRE(int64<MsgPackWriter>(std::int64_t{INT32_MIN} - 1) ==
+          bytes({0xD3, 0xFF, 0xFF, 0xFF, 0xFF, 0x7F, 0xFF, 0xFF, 0xFF}));
+}
+
+TEST_CASE("MessagePack: strings fixstr e str8/16/32") {
+  REQUIRE(stringHead<MsgPackWriter>(31) == bytes({0xBF}));
+  REQUIRE(stringHead<MsgPackWriter>(32) == bytes({0xD9, 0x20}));
+  REQUIRE(stringHead<MsgPackWriter>(255) == bytes({0xD9, 0xFF}));
+  REQUIRE(stringHead<MsgPackWriter>(256) == bytes({0xDA, 0x01, 0x00}));
+  REQUIRE(stringHead<MsgPackWriter>(65535) == bytes({0xDA, 0xFF, 0xFF}));
+  REQUIRE(stringHead<MsgPackWriter>(65536) == bytes({0xDB, 0x00, 0x01, 0x00, 0x00}));
+}
+
+TEST_CASE("MessagePack: mapas e arrays fix e 16/32 bits") {
+  REQUIRE(mapHead<MsgPackWriter>(0) == bytes({0x80}));
+  REQUIRE(mapHead<MsgPackWriter>(15) == bytes({0x8F}));
+  REQUIRE(mapHead<MsgPackWriter>(16) == bytes({0xDE, 0x00, 0x10}));
+  REQUIRE(mapHead<MsgPackWriter>(65535) == bytes({0xDE, 0xFF, 0xFF}));
+  REQUIRE(mapHead<MsgPackWriter>(65536) == bytes({0xDF, 0x00, 0x01, 0x00, 0x00}));
+
+  REQUIRE(arrayHead<MsgPackWriter>(15) == bytes({0x9F}));
+  REQUIRE(arrayHead<MsgPackWriter>(16) == bytes({0xDC, 0x00, 0x10}));
+  REQUIRE(arrayHead<MsgPackWriter>(65535) == bytes({0xDC, 0xFF, 0xFF}));
+  REQUIRE(arrayHead<MsgPackWriter>(65536) == bytes({0xDD, 0x00, 0x01, 0x00, 0x00}));
+}
+
+TEST_CASE("MessagePack: float64, booleanos e nil") {
+  MsgPackWriter w;
+  w.float64(1.5);
+  w.boolean(true);
+  w.boolean(false);
+  w.null();
+  REQUIRE(w.data() == bytes({0xCB, 0x3F, 0xF8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC3, 0xC2, 0xC0}));
+}
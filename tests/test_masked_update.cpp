@@ -0,0 +1,71 @@
+#include <catch2/catch_all.hpp>
+#include "app/Migrations.h"
+#include "domain/core/Uuid.h"
+#include "infra/repositories/sqlite/ClientRepositorySqlite.h"
+#include "infra/repositories/sqlite/Helpers.h"
+#include "infra/repositories/sqlite/ProductRepositorySqlite.h"
+
+#include <string>
+
+using ecocin::infra::db::SqliteConnection;
+using ecocin::infra::repositories::sqlite::ClientRepositorySqlite;
+using ecocin::infra::repositories::sqlite::ProductRepositorySqlite;
+
+namespace {
+
+std::string text(SqliteConnection& cx, const std::string& sql) {
+  sqlite3_stmt* st = nullptr;
+  REQUIRE(sqlite3_prepare_v2(cx.raw(), sql.c_str(), -1, &st, nullptr) == SQLITE_OK);
+  std::string v;
+  if (sqlite3_step(st) == SQLITE_ROW) v = reinterpret_cast<const char*>(sqlite3_column_text(st, 0));
+  sqlite3_finalize(st);
+  return v;
+}
+
+} // namespace
+
+TEST_CASE("MaskedUpdate: o SET tem só as colunas da máscara, na ordem dos bits") {
+  MaskedUpdate updates("clients", {"name", "email", "cpf"});
+  REQUIRE(updates.sql(Client::kEmail) == "UPDATE clients SET email=? WHERE id=?");
+  REQUIRE(updates.sql(Client::kCpf | Client::kName) == "UPDATE clients SET name=?,cpf=? WHERE id=?");
+  REQUIRE(updates.sql(Client::kAll) == "UPDATE clients SET name=?,email=?,cpf=? WHERE id=?");
+  REQUIRE(&updates.sql(Client::kEmail) == &updates.sql(Client::kEmail)); // montado uma vez só
+}
+
+TEST_CASE("MaskedUpdate: update depois de um setter só grava as colunas marcadas") {
+  SqliteConnection cx{":memory:"};
+  ecocin::app::runMigrations(cx.raw());
+  ClientRepositorySqlite clients(cx);
+  ProductRepositorySqlite products(cx);
+
+  const auto created = clients.create(Client("Ana", "ana@example.com", "12345678901"));
+  auto ana = *clients.findById(created.getId());
+  REQUIRE(ana.dirtyFields() == 0);
+  ana.setName("Ana Maria");
+  REQUIRE(ana.dirtyFields() == Client::kName);
+
+  // Outra escrita muda o email por fora: um UPDATE com todas as colunas o sobrescreveria
+  cx.exec("UPDATE clients SET email = 'ana.nova@example.com'");
+  REQUIRE(clients.update(ana));
+  const auto id = std::to_string(ana.getId());
+  REQUIRE(text(cx, "SELECT name FROM clients WHERE id = " + id) == "Ana Maria");
+  REQUIRE(text(cx, "SELECT email FROM clients WHERE id = " + id) == "ana.nova@example.com");
+
+  // Sem nada marcado o update só confere que a linha existe
+  auto clean = *clients.findById(ana.getId());
+  cx.exec("UPDATE clients SET name = 'Por fora'");
+  REQUIRE(clients.update(clean));
+  REQUIRE(text(cx, "SELECT name FROM clients WHERE id = " + id) == "Por fora");
+  clean.setId(ana.getId() + 1000);
+  REQUIRE_FALSE(clients.update(clean));
+
+  const auto caneca = products.create(Product("Caneca", "azul", ecocin::core::Uuid::v4(), 20.0, 5, true));
+  auto p = *products.findById(caneca.getId());
+  p.setDescription("verde");
+  cx.exec("UPDATE products SET stock_quantity = 9, price = 25.0");
+  REQUIRE(products.update(p));
+  const auto fresh = products.findById(caneca.getId());
+  REQUIRE(fresh->getDescription() == "verde");
+  REQUIRE(fresh->getStockQuantity() == 9);
+  REQUIRE(fresh->getPrice() == 25.0);
+}
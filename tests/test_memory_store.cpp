@@ -0,0 +1,176 @@
+#include <catch2/catch_all.hpp>
+#include "domain/core/Uuid.h"
+#include "infra/repositories/memory/ConcurrentMap.h"
+#include "infra/repositories/memory/MemoryAddressRepository.h"
+#include "infra/repositories/memory/MemoryClientRepository.h"
+#include "infra/repositories/memory/MemoryOrderRepository.h"
+#include "infra/repositories/memory/MemoryProductRepository.h"
+#include "infra/repositories/memory/MemoryStore.h"
+
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace memory = ecocin::infra::repositories::memory;
+
+namespace {
+
+namespace fs = std::filesystem;
+
+// Diretório vazio só deste teste, apagado no fim
+struct TempDir {
+  fs::path path;
+  explicit TempDir(const std::string& name) : path(fs::temp_directory_path() / ("ecocin_test_" + name)) {
+    fs::remove_all(path);
+    fs::create_directories(path);
+  }
+  ~TempDir() { fs::remove_all(path); }
+  std::string db() const { return (path / "ecocin.db").string(); }
+};
+
+// Os quatro repositórios sobre um store
+struct Repos {
+  memory::MemoryClientRepository clients;
+  memory::MemoryProductRepository products;
+  memory::MemoryAddressRepository addresses;
+  memory::MemoryOrderRepository orders;
+  explicit Repos(memory::MemoryStore& store) : clients(store), products(store), addresses(store), orders(store) {}
+};
+
+} // namespace
+
+TEST_CASE("Memória: snapshot gravado e recarregado devolve o mesmo conteúdo e os mesmos contadores") {
+  TempDir dir("memory_snapshot");
+  memory::MemoryStore store;
+  Repos repos(store);
+
+  const auto ana = repos.clients.create(Client("Ana", "ana@example.com", "12345678901"));
+  const auto gone = repos.clients.create(Client("Bia", "bia@example.com", "12345678902"));
+  Address address("Rua A", "1", "Recife", "PE", "50000-000", "HOME");
+  address.setClientId(ana.getId());
+  const auto home = repos.addresses.create(address);
+  const auto caneca = repos.products.create(Product("Caneca", "azul", ecocin::core::Uuid::v4(), 20.0, 5, true));
+  const auto order = repos.orders.create(Order(ana.getId(), caneca.getId(), home.getId(), 2, 20.0));
+  repos.orders.updateStatus(order.getId(), "PAID");
+  // O maior id de clientes sai antes do snapshot: o contador não pode voltar para ele
+  REQUIRE(repos.clients.remove(gone.getId()));
+
+  store.saveSnapshot(dir.db());
+
+  memory::MemoryStore reloaded;
+  REQUIRE(reloaded.loadSnapshot(dir.db()));
+  Repos back(reloaded);
+
+  const auto clients = back.clients.listAll();
+  REQUIRE(clients.size() == 1);
+  REQUIRE(clients[0].getId() == ana.getId());
+  REQUIRE(clients[0].getEmail() == "ana@example.com");
+  REQUIRE(clients[0].getCpf() == "12345678901");
+  REQUIRE(back.clients.findByCpf("12345678901")->getId() == ana.getId());
+
+  const auto product = back.products.findBySku(caneca.getSku().str());
+  REQUIRE(product);
+  REQUIRE(product->getId() == caneca.getId());
+  REQUIRE(product->getDescription() == "azul");
+  REQUIRE(product->getPrice() == 20.0);
+  REQUIRE(product->getStockQuantity() == 5);
+
+  const auto addresses = back.addresses.listByClientId(ana.getId());
+  REQUIRE(addresses.size() == 1);
+  REQUIRE(addresses[0].getId() == home.getId());
+  REQUIRE(addresses[0].getZip() == "50000-000");
+
+  const auto orders = back.orders.listByClientId(ana.getId());
+  REQUIRE(orders.size() == 1);
+  REQUIRE(orders[0].getId() == order.getId());
+  REQUIRE(orders[0].getStatus() == "PAID");
+  REQUIRE(orders[0].getTotalPrice() == 40.0);
+
+  // Contadores: os próximos ids continuam de onde o store original pararia
+  REQUIRE(reloaded.nextClientId == store.nextClientId);
+  REQUIRE(reloaded.nextProductId == store.nextProductId);
+  REQUIRE(reloaded.nextAddressId == store.nextAddressId);
+  REQUIRE(reloaded.nextOrderId == store.nextOrderId);
+  REQUIRE(back.clients.create(Client("Caio", "caio@example.com", "12345678903")).getId() == gone.getId() + 1);
+
+  // As regras do esquema também voltam: email e cpf continuam ocupados, o cliente com pedido não sai
+  REQUIRE_THROWS_AS(back.clients.create(Client("Ana 2", "ana@example.com", "12345678904")), std::runtime_error);
+  REQUIRE_THROWS_AS(back.clients.remove(ana.getId()), std::runtime_error);
+}
+
+TEST_CASE("Memória: mapa particionado aguenta escritores e leitores ao mesmo tempo") {
+  memory::ConcurrentMap<long long, long long> map;
+  constexpr int kWriters = 4;
+  constexpr long long kPerWriter = 5000;
+  std::atomic<bool> done{false};
+  std::atomic<long long> torn{0};
+
+  // Cada escritor grava as suas chaves com valor = 2 * chave; os leitores nunca podem ver outro valor
+  std::vector<std::thread> readers;
+  for (int r = 0; r < 2; ++r) {
+    readers.emplace_back([&] {
+      while (!done.load(std::memory_order_acquire)) {
+        for (long long k = 0; k < kWriters * kPerWriter; k += 97) {
+          if (auto v = map.find(k); v && *v != 2 * k) torn.fetch_add(1);
+        }
+      }
+    });
+  }
+  std::vector<std::thread> writers;
+  for (int w = 0; w < kWriters; ++w) {
+    writers.emplace_back([&, w] {
+      for (long long i = 0; i < kPerWriter; ++i) {
+        const long long k = w * kPerWriter + i;
+        map.insertOrAssign(k, 2 * k);
+        map.upsert(-1, [](long long& n) { ++n; }); // contador disputado por todos
+      }
+    });
+  }
+  for (auto& t : writers) t.join();
+  done.store(true, std::memory_order_release);
+  for (auto& t : readers) t.join();
+
+  REQUIRE(torn.load() == 0);
+  REQUIRE(map.size() == static_cast<std::size_t>(kWriters * kPerWriter + 1));
+  REQUIRE(*map.find(-1) == kWriters * kPerWriter);
+  long long sum = 0;
+  map.forEach([&](const long long& k, const long long& v) {
+    if (k >= 0) sum += v - 2 * k;
+  });
+  REQUIRE(sum == 0);
+}
+
+TEST_CASE("Memória: creates e leituras concorrentes de clientes não perdem nem repetem ids") {
+  memory::MemoryStore store;
+  memory::MemoryClientRepository clients(store);
+  constexpr int kThreads = 4;
+  constexpr int kPerThread = 300;
+  std::vector<std::vector<long long>> ids(kThreads);
+  std::atomic<int> missing{0};
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&, t] {
+      for (int i = 0; i < kPerThread; ++i) {
+        const auto n = std::to_string(t * kPerThread + i);
+        const auto c = clients.create(Client("C" + n, "c" + n + "@example.com", std::string(11 - n.size(), '0') + n));
+        ids[t].push_back(c.getId());
+        // O que acabou de ser criado já aparece por id e por cpf
+        if (!clients.findById(c.getId()) || clients.findByCpf(c.getCpf())->getId() != c.getId()) missing.fetch_add(1);
+      }
+    });
+  }
+  for (auto& t : threads) t.join();
+
+  REQUIRE(missing.load() == 0);
+  std::vector<long long> all;
+  for (const auto& part : ids) all.insert(all.end(), part.begin(), part.end());
+  std::sort(all.begin(), all.end());
+  REQUIRE(std::adjacent_find(all.begin(), all.end()) == all.end());
+  REQUIRE(all.size() == static_cast<std::size_t>(kThreads * kPerThread));
+  REQUIRE(clients.listAll().size() == all.size());
+}
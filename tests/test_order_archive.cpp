@@ -0,0 +1,160 @@
+#include <catch2/catch_all.hpp>
+#include "app/Migrations.h"
+#include "infra/db/OrderArchive.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+
+using ecocin::infra::db::OrderArchive;
+using ecocin::infra::db::SqliteConnection;
+
+namespace {
+
+namespace fs = std::filesystem;
+
+// Diretório vazio só deste teste, apagado no fim
+struct TempDir {
+  fs::path path;
+  explicit TempDir(const std::string& name) : path(fs::temp_directory_path() / ("ecocin_test_" + name)) {
+    fs::remove_all(path);
+    fs::create_directories(path);
+  }
+  ~TempDir() { fs::remove_all(path); }
+  std::string db() const { return (path / "ecocin.db").string(); }
+  std::string archive() const { return (path / "archive").string(); }
+};
+
+const std::int64_t kJanuary = OrderArchive::monthRange("2022_01").first;
+const std::int64_t kCutoff = OrderArchive::monthRange("2023_01").first;
+
+long long scalar(SqliteConnection& cx, const std::string& sql) {
+  sqlite3_stmt* st = nullptr;
+  REQUIRE(sqlite3_prepare_v2(cx.raw(), sql.c_str(), -1, &st, nullptr) == SQLITE_OK);
+  long long v = -1;
+  if (sqlite3_step(st) == SQLITE_ROW) v = sqlite3_column_int64(st, 0);
+  sqlite3_finalize(st);
+  return v;
+}
+
+std::string orderRow(long long id, std::int64_t createDate, const std::string& status) {
+  return "(" + std::to_string(id) + ",1,1,NULL,1,1.0,1.0,'" + status + "'," + std::to_string(createDate) + ")";
+}
+
+// Banco com 4 pedidos de janeiro/2022 (ids 1..4) e um recente (id 5), em WAL como no servidor
+void seed(const TempDir& dir) {
+  SqliteConnection cx{dir.db()};
+  cx.enableConcurrentAccess();
+  ecocin::app::runMigrations(cx.raw());
+  cx.exec("INSERT INTO clients(name,email,cpf,create_date) VALUES('Ana','ana@example.com','12345678901',0)");
+  cx.exec("INSERT INTO products(name,sku,price,create_date) VALUES('Caneca','sku-1',1.0,0)");
+  std::string sql = "INSERT INTO orders(id,client_id,product_id,shipping_address_id,quantity,unit_price,"
+                    "total_price,status,create_date) VALUES ";
+  for (int i = 1; i <= 4; ++i) sql += orderRow(i, kJanuary + i, "PENDING") + ",";
+  sql += orderRow(5, kCutoff + 86400, "PENDING");
+  cx.exec(sql.c_str());
+}
+
+// A partição de janeiro/2022 aberta direto, como o job a deixaria no disco
+void withPartition(const TempDir& dir, const std::string& sql) {
+  fs::create_directories(dir.archive());
+  SqliteConnection cx{OrderArchive::fileFor(dir.archive(), "2022_01")};
+  cx.exec("CREATE TABLE IF NOT EXISTS orders (id INTEGER PRIMARY KEY, client_id INTEGER NOT NULL,"
+          " product_id INTEGER NOT NULL, shipping_address_id INTEGER, quantity INTEGER NOT NULL,"
+          " unit_price REAL NOT NULL, total_price REAL NOT NULL, status TEXT NOT NULL, create_date INTEGER NOT NULL)");
+  cx.exec(sql.c_str());
+}
+
+long long inPartition(const TempDir& dir, const std::string& where = "1") {
+  SqliteConnection cx{OrderArchive::fileFor(dir.archive(), "2022_01")};
+  return scalar(cx, "SELECT COUNT(*) FROM orders WHERE " + where);
+}
+
+} // namespace
+
+TEST_CASE("Arquivo de pedidos: lote copiado e não apagado da quente é retomado sem duplicar") {
+  TempDir dir("order_archive_resume");
+  seed(dir);
+  // Queda entre as duas transações: 1..4 já copiados, ainda na quente, e o 2 mudou depois da cópia
+  withPartition(dir, "INSERT INTO orders VALUES " + orderRow(1, kJanuary + 1, "PENDING") + "," +
+                         orderRow(2, kJanuary + 2, "PENDING") + "," + orderRow(3, kJanuary + 3, "PENDING") +
+                         "," + orderRow(4, kJanuary + 4, "PENDING"));
+  {
+    SqliteConnection cx{dir.db()};
+    cx.exec("UPDATE orders SET status = 'PAID' WHERE id = 2");
+  }
+
+  SqliteConnection reader{dir.db()};
+  reader.enableConcurrentAccess();
+  OrderArchive archive(reader, dir.archive());
+  // Antes da retomada a view já não duplica: vale a tabela quente
+  REQUIRE(scalar(reader, "SELECT COUNT(*) FROM orders_all") == 5);
+  REQUIRE(scalar(reader, "SELECT COUNT(*) FROM orders_all WHERE id = 2 AND status = 'PAID'") == 1);
+
+  SqliteConnection job{dir.db()};
+  job.enableConcurrentAccess();
+  const auto stats = OrderArchive::archiveBefore(job, dir.archive(), kCutoff, 2);
+  REQUIRE(stats.moved == 4);
+  REQUIRE(scalar(reader, "SELECT COUNT(*) FROM main.orders") == 1);
+  REQUIRE(scalar(reader, "SELECT COUNT(*) FROM orders_all") == 5);
+  REQUIRE(scalar(reader, "SELECT COUNT(*) FROM orders_all WHERE id = 2 AND status = 'PAID'") == 1);
+  REQUIRE(inPartition(dir) == 4);
+  REQUIRE(inPartition(dir, "id = 2 AND status = 'PAID'") == 1);
+}
+
+TEST_CASE("Arquivo de pedidos: cópia interrompida não tira nada da tabela quente") {
+  TempDir dir("order_archive_abort");
+  seed(dir);
+  // A partição recusa o pedido 3: o segundo lote (3 e 4) cai no meio da cópia
+  withPartition(dir, "CREATE TRIGGER fail_copy BEFORE INSERT ON orders WHEN NEW.id = 3 "
+                     "BEGIN SELECT RAISE(ABORT, 'falha simulada'); END");
+  {
+    SqliteConnection job{dir.db()};
+    job.enableConcurrentAccess();
+    REQUIRE_THROWS_AS(OrderArchive::archiveBefore(job, dir.archive(), kCutoff, 2), std::runtime_error);
+  }
+
+  // Reabrindo os dois arquivos: cada pedido está em exatamente um lugar visível
+  {
+    SqliteConnection reader{dir.db()};
+    OrderArchive archive(reader, dir.archive());
+    REQUIRE(scalar(reader, "SELECT COUNT(*) FROM main.orders") == 3);
+    REQUIRE(scalar(reader, "SELECT COUNT(*) FROM main.orders WHERE id IN (3, 4)") == 2);
+    REQUIRE(scalar(reader, "SELECT COUNT(*) FROM orders_all") == 5);
+    REQUIRE(scalar(reader, "SELECT COUNT(DISTINCT id) FROM orders_all") == 5);
+  }
+  REQUIRE(inPartition(dir) == 2);
+
+  withPartition(dir, "DROP TRIGGER fail_copy");
+  SqliteConnection job{dir.db()};
+  REQUIRE(OrderArchive::archiveBefore(job, dir.archive(), kCutoff, 2).moved == 2);
+  REQUIRE(inPartition(dir) == 4);
+  REQUIRE(scalar(job, "SELECT COUNT(*) FROM main.orders") == 1);
+}
+
+TEST_CASE("Arquivo de pedidos: pedido apagado da quente no meio do lote não volta pela partição") {
+  TempDir dir("order_archive_purge");
+  seed(dir);
+  // Queda depois de o lote sair da quente: o 3 tinha sido apagado entre a cópia e a saída, e a
+  // remoção da cópia dele ficou pendente em main
+  withPartition(dir, "INSERT INTO orders VALUES " + orderRow(1, kJanuary + 1, "PENDING") + "," +
+                         orderRow(3, kJanuary + 3, "PENDING"));
+  {
+    SqliteConnection cx{dir.db()};
+    cx.exec("DELETE FROM orders WHERE id IN (1, 3);"
+            "CREATE TABLE archive_purge(id INTEGER PRIMARY KEY, month TEXT NOT NULL);"
+            "INSERT INTO archive_purge VALUES (3, '2022_01');");
+  }
+
+  SqliteConnection job{dir.db()};
+  job.enableConcurrentAccess();
+  REQUIRE(OrderArchive::archiveBefore(job, dir.archive(), kCutoff, 10).moved == 2);
+  REQUIRE(scalar(job, "SELECT COUNT(*) FROM main.archive_purge") == 0);
+  REQUIRE(inPartition(dir, "id = 3") == 0);
+
+  SqliteConnection reader{dir.db()};
+  OrderArchive archive(reader, dir.archive());
+  REQUIRE(scalar(reader, "SELECT COUNT(*) FROM orders_all") == 4);
+  REQUIRE(scalar(reader, "SELECT COUNT(*) FROM orders_all WHERE id = 3") == 0);
+}
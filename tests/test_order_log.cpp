@@ -0,0 +1,239 @@
+#include <catch2/catch_all.hpp>
+#include "infra/repositories/orderlog/OrderLogRepository.h"
+#include "infra/repositories/orderlog/OrderSegment.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+using ecocin::domain::repositories::OrderReference;
+using ecocin::domain::repositories::OrderReferenceConflict;
+using ecocin::infra::repositories::orderlog::OrderLogRepository;
+using ecocin::infra::repositories::orderlog::OrderRecord;
+using ecocin::infra::repositories::orderlog::OrderSegment;
+
+namespace {
+
+namespace fs = std::filesystem;
+
+// Diretório vazio só deste teste, apagado no fim
+struct TempDir {
+  fs::path path;
+  explicit TempDir(const std::string& name) : path(fs::temp_directory_path() / ("ecocin_test_" + name)) {
+    fs::remove_all(path);
+  }
+  ~TempDir() { fs::remove_all(path); }
+  std::string str() const { return path.string(); }
+};
+
+std::string segmentFile(const TempDir& dir, int number) {
+  char name[32];
+  std::snprintf(name, sizeof(name), "orders-%06d.seg", number);
+  return (dir.path / name).string();
+}
+
+// Sobrescreve bytes do registro slot de um segmento (o registro 0 do arquivo é o cabeçalho)
+void patch(const std::string& file, std::size_t slot, std::size_t offset, const void* bytes, std::size_t n) {
+  std::fstream f(file, std::ios::in | std::ios::out | std::ios::binary);
+  REQUIRE(f);
+  f.seekp(static_cast<std::streamoff>((slot + 1) * sizeof(OrderRecord) + offset));
+  f.write(static_cast<const char*>(bytes), static_cast<std::streamsize>(n));
+}
+
+} // namespace
+
+TEST_CASE("Log de pedidos: status, endereço e exclusões voltam na releitura") {
+  if (!OrderSegment::isSupported()) SKIP("plataforma sem mmap");
+  TempDir dir("order_log_overlay");
+  {
+    OrderLogRepository log(dir.str(), 64);
+    for (int i = 0; i < 4; ++i) REQUIRE(log.create(Order(1 + i % 2, 10, 100, 2, 3.5)).getId() == i + 1);
+    REQUIRE(log.updateStatus(1, "SHIPPED"));
+    REQUIRE(log.updateShippingAddress(2, 200));
+    REQUIRE(log.updateStatus(3, "PAID"));
+    auto third = *log.findById(3);
+    third.setQuantity(5); // regrava o pedido inteiro: o status vai junto e a sobreposição sai
+    REQUIRE(log.update(third));
+    REQUIRE(log.remove(4));
+    REQUIRE_FALSE(log.remove(4));
+    REQUIRE(log.stats().overlays == 2);
+  }
+
+  OrderLogRepository log(dir.str(), 64);
+  const auto stats = log.stats();
+  REQUIRE(stats.records == 9);
+  REQUIRE(stats.orders == 3);
+  REQUIRE(stats.overlays == 2);
+  REQUIRE(log.findById(1)->getStatus() == "SHIPPED");
+  REQUIRE(log.findById(2)->getShippingAddressId() == 200);
+  REQUIRE(log.findById(3)->getStatus() == "PAID");
+  REQUIRE(log.findById(3)->getTotalPrice() == 17.5);
+  REQUIRE_FALSE(log.findById(4));
+  REQUIRE(log.listByClientId(2).size() == 1);
+  REQUIRE(log.create(Order(1, 10, 100, 1, 1.0)).getId() == 5);
+}
+
+TEST_CASE("Log de pedidos: segmento cheio abre o próximo e a releitura atravessa todos") {
+  if (!OrderSegment::isSupported()) SKIP("plataforma sem mmap");
+  TempDir dir("order_log_rollover");
+  {
+    OrderLogRepository log(dir.str(), 8);
+    for (int i = 0; i < 20; ++i) log.create(Order(7, 10, 100, 1, 1.0));
+    REQUIRE(log.stats().segments == 3);
+  }
+  REQUIRE(fs::exists(segmentFile(dir, 2)));
+  REQUIRE_FALSE(fs::exists(segmentFile(dir, 3)));
+
+  OrderLogRepository log(dir.str(), 8);
+  REQUIRE(log.stats().segments == 3);
+  REQUIRE(log.stats().orders == 20);
+  const auto all = log.listAll();
+  REQUIRE(all.size() == 20);
+  REQUIRE(all.front().getId() == 20);
+  REQUIRE(all.back().getId() == 1);
+
+  // O último segmento tem 4 livres: mais 5 abrem o quarto
+  for (int i = 0; i < 5; ++i) log.create(Order(7, 10, 100, 1, 1.0));
+  REQUIRE(log.stats().segments == 4);
+  REQUIRE(log.findById(25));
+}
+
+TEST_CASE("Log de pedidos: gravação interrompida no fim do log é descartada") {
+  if (!OrderSegment::isSupported()) SKIP("plataforma sem mmap");
+  TempDir dir("order_log_torn");
+  {
+    OrderLogRepository log(dir.str(), 8);
+    for (int i = 0; i < 3; ++i) log.create(Order(1, 10, 100, 1, 1.0));
+  }
+  // O magic é o último campo gravado: registro sem magic é um append que não terminou
+  const std::uint32_t zero = 0;
+  patch(segmentFile(dir, 0), 2, 0, &zero, sizeof(zero));
+
+  OrderLogRepository log(dir.str(), 8);
+  REQUIRE(log.stats().records == 2);
+  REQUIRE_FALSE(log.findById(3));
+  // O slot descartado é reaproveitado, e com ele o id
+  REQUIRE(log.create(Order(1, 10, 100, 1, 1.0)).getId() == 3);
+  REQUIRE(log.stats().records == 3);
+}
+
+TEST_CASE("Log de pedidos: checksum errado encerra o log no último segmento e falha no meio") {
+  if (!OrderSegment::isSupported()) SKIP("plataforma sem mmap");
+  TempDir dir("order_log_checksum");
+  {
+    OrderLogRepository log(dir.str(), 4);
+    for (int i = 0; i < 6; ++i) log.create(Order(1, 10, 100, 1, 1.0));
+    REQUIRE(log.stats().segments == 2);
+  }
+  const std::uint8_t junk = 0x5A;
+
+  SECTION("no último segmento, o registro ruim e os seguintes saem") {
+    patch(segmentFile(dir, 1), 0, offsetof(OrderRecord, quantity), &junk, 1);
+    OrderLogRepository log(dir.str(), 4);
+    REQUIRE(log.stats().orders == 4);
+    REQUIRE_FALSE(log.findById(5));
+    REQUIRE_FALSE(log.findById(6));
+    REQUIRE(log.create(Order(1, 10, 100, 1, 1.0)).getId() == 5);
+  }
+
+  SECTION("num segmento fechado, a abertura recusa o log") {
+    patch(segmentFile(dir, 0), 1, offsetof(OrderRecord, quantity), &junk, 1);
+    REQUIRE_THROWS_AS(OrderLogRepository(dir.str(), 4), std::runtime_error);
+  }
+}
+
+TEST_CASE("Log de pedidos: segmento novo interrompido antes do cabeçalho não impede a abertura") {
+  if (!OrderSegment::isSupported()) SKIP("plataforma sem mmap");
+  TempDir dir("order_log_new_segment");
+  {
+    OrderLogRepository log(dir.str(), 8);
+    for (int i = 0; i < 8; ++i) log.create(Order(1, 10, 100, 1, 1.0));
+    REQUIRE(log.stats().segments == 1);
+  }
+
+  SECTION("arquivo zerado no lugar do segmento (criado no lugar, queda antes do cabeçalho)") {
+    std::ofstream(segmentFile(dir, 1), std::ios::binary) << std::string(9 * sizeof(OrderRecord), '\0');
+  }
+  SECTION("só o temporário de criação ficou para trás") {
+    std::ofstream(segmentFile(dir, 1) + ".tmp", std::ios::binary) << "parcial";
+  }
+
+  {
+    OrderLogRepository log(dir.str(), 8);
+    REQUIRE(log.stats().orders == 8);
+    REQUIRE(log.create(Order(1, 10, 100, 1, 1.0)).getId() == 9);
+    REQUIRE(log.stats().segments == 2);
+  }
+  REQUIRE_FALSE(fs::exists(segmentFile(dir, 1) + ".tmp"));
+  OrderLogRepository log(dir.str(), 8);
+  REQUIRE(log.stats().orders == 9);
+  REQUIRE(log.findById(9));
+}
+
+TEST_CASE("Log de pedidos: referências a cliente, produto e endereço seguem o log") {
+  if (!OrderSegment::isSupported()) SKIP("plataforma sem mmap");
+  TempDir dir("order_log_refs");
+  {
+    OrderLogRepository log(dir.str(), 8);
+    log.create(Order(1, 10, 100, 1, 1.0));
+    log.create(Order(2, 11, 101, 1, 1.0));
+    REQUIRE(log.updateShippingAddress(1, 102)); // 100 deixa de ser usado
+    auto second = *log.findById(2);
+    second.setProductId(12); // regravação troca o produto
+    REQUIRE(log.update(second));
+    REQUIRE(log.remove(2));
+
+    REQUIRE(log.referencesClient(1));
+    REQUIRE(log.referencesProduct(10));
+    REQUIRE(log.referencesAddress(102));
+    REQUIRE_FALSE(log.referencesAddress(100));
+    REQUIRE_FALSE(log.referencesClient(2));
+    REQUIRE_FALSE(log.referencesProduct(11));
+    REQUIRE_FALSE(log.referencesProduct(12));
+    REQUIRE_FALSE(log.referencesAddress(101));
+  }
+
+  OrderLogRepository log(dir.str(), 8);
+  REQUIRE(log.referencesClient(1));
+  REQUIRE(log.referencesProduct(10));
+  REQUIRE(log.referencesAddress(102));
+  REQUIRE_FALSE(log.referencesAddress(100));
+  REQUIRE_FALSE(log.referencesClient(2));
+  REQUIRE_FALSE(log.referencesProduct(12));
+}
+
+TEST_CASE("Log de pedidos: remoção conferida sob o lock recusa referência nos dois sentidos") {
+  if (!OrderSegment::isSupported()) SKIP("plataforma sem mmap");
+  TempDir dir("order_log_remove_refs");
+  OrderLogRepository log(dir.str(), 8);
+  const auto order = log.create(Order(1, 10, 100, 1, 1.0));
+
+  // Referenciado: nem chega a chamar o DELETE
+  bool called = false;
+  const auto remove = [&] { called = true; return true; };
+  REQUIRE_THROWS_AS(log.removeUnreferenced(OrderReference::Product, 10, remove), OrderReferenceConflict);
+  REQUIRE_THROWS_AS(log.removeUnreferenced(OrderReference::Client, 1, remove), OrderReferenceConflict);
+  REQUIRE_THROWS_AS(log.removeUnreferenced(OrderReference::Address, 100, remove), OrderReferenceConflict);
+  REQUIRE_FALSE(called);
+
+  // DELETE que não achou nada não trava a chave
+  REQUIRE_FALSE(log.removeUnreferenced(OrderReference::Product, 12, [] { return false; }));
+  REQUIRE(log.create(Order(1, 12, 100, 1, 1.0)).getProductId() == 12);
+
+  // Removidos: pedido validado antes e gravado depois é recusado
+  REQUIRE(log.removeUnreferenced(OrderReference::Product, 11, remove));
+  REQUIRE(log.removeUnreferenced(OrderReference::Address, 101, remove));
+  REQUIRE(called);
+  REQUIRE_THROWS_AS(log.create(Order(1, 11, 100, 1, 1.0)), OrderReferenceConflict);
+  REQUIRE_THROWS_AS(log.create(Order(1, 10, 101, 1, 1.0)), OrderReferenceConflict);
+  REQUIRE_THROWS_AS(log.updateShippingAddress(order.getId(), 101), OrderReferenceConflict);
+  auto changed = *log.findById(order.getId());
+  changed.setProductId(11);
+  REQUIRE_THROWS_AS(log.update(changed), OrderReferenceConflict);
+  REQUIRE(log.findById(order.getId())->getProductId() == 10);
+  REQUIRE(log.stats().orders == 2);
+}
@@ -0,0 +1,141 @@
+#include <catch2/catch_all.hpp>
+#include "infra/admission/AdmissionControl.h"
+#include "infra/net/ReusePortConnectionProvider.h"
+
+using ecocin::infra::admission::AdmissionConfig;
+using ecocin::infra::admission::AdmissionControl;
+using ecocin::infra::admission::Clock;
+using ecocin::infra::admission::Priority;
+using ecocin::infra::admission::Verdict;
+
+#if !defined(_WIN32)
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <set>
+#include <string>
+#include <thread>
+
+using ecocin::infra::net::ReusePortConnectionProvider;
+
+namespace {
+
+constexpr unsigned short kPort = 18097;
+
+// Conecta em 127.0.0.1:kPort saindo de source (no Linux toda a faixa 127/8 é loopback)
+int connectFrom(const char* source) {
+  const int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+  if (fd < 0) return -1;
+  sockaddr_in from{};
+  from.sin_family = AF_INET;
+  ::inet_pton(AF_INET, source, &from.sin_addr);
+  sockaddr_in to{};
+  to.sin_family = AF_INET;
+  to.sin_port = htons(kPort);
+  ::inet_pton(AF_INET, "127.0.0.1", &to.sin_addr);
+  if (::bind(fd, reinterpret_cast<sockaddr*>(&from), sizeof(from)) != 0 ||
+      ::connect(fd, reinterpret_cast<sockaddr*>(&to), sizeof(to)) != 0) {
+    ::close(fd);
+    return -1;
+  }
+  return fd;
+}
+
+// A mesma leitura que o AdmissionRequestInterceptor faz para identificar o cliente
+std::string peerOf(const oatpp::provider::ResourceHandle<oatpp::data::stream::IOStream>& connection) {
+  REQUIRE(connection.object);
+  const auto peer = connection.object->getInputStreamContext().getProperties().get("peer_address");
+  return peer ? std::string(*peer) : std::string("unknown");
+}
+
+} // namespace
+
+TEST_CASE("Conexões aceitas levam o IP do par e cada IP tem o seu balde no limite por cliente") {
+  if (!ReusePortConnectionProvider::isSupported()) SKIP("plataforma sem SO_REUSEPORT");
+
+  ReusePortConnectionProvider provider("127.0.0.1", kPort);
+  const int a = connectFrom("127.0.0.1");
+  const int b = connectFrom("127.0.0.2");
+  REQUIRE(a >= 0);
+  if (b < 0) {
+    ::close(a);
+    SKIP("127.0.0.2 não é loopback nesta máquina");
+  }
+
+  const auto first = provider.get();
+  const auto second = provider.get();
+  const std::string peerA = peerOf(first);
+  const std::string peerB = peerOf(second);
+  REQUIRE(std::set<std::string>{peerA, peerB} == std::set<std::string>{"127.0.0.1", "127.0.0.2"});
+
+  // Taxa de 1/s sem rajada: o segundo pedido do mesmo par é recusado, o do outro par não
+  AdmissionConfig config;
+  config.ratePerSec = 1;
+  config.burst = 1;
+  AdmissionControl admission(config);
+  const auto now = Clock::now();
+  REQUIRE(admission.admit(peerA, Priority::Read, now).verdict == Verdict::Admit);
+  REQUIRE(admission.admit(peerA, Priority::Read, now).verdict == Verdict::RateLimited);
+  REQUIRE(admission.admit(peerB, Priority::Read, now).verdict == Verdict::Admit);
+
+  ::close(a);
+  ::close(b);
+  provider.stop();
+}
+
+TEST_CASE("stop() acorda o get() bloqueado e só fecha o socket depois que ele sai") {
+  if (!ReusePortConnectionProvider::isSupported()) SKIP("plataforma sem SO_REUSEPORT");
+
+  ReusePortConnectionProvider provider("127.0.0.1", kPort + 1);
+  std::atomic<bool> waiting{false};
+  std::atomic<bool> returned{false};
+  std::atomic<bool> gotConnection{false};
+  std::thread acceptor([&] {
+    waiting = true;
+    gotConnection = provider.get().object != nullptr;
+    returned = true;
+  });
+  while (!waiting) std::this_thread::yield();
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  REQUIRE_FALSE(returned);
+
+  const auto before = std::chrono::steady_clock::now();
+  provider.stop();
+  // stop() voltou: o get() já saiu, acordado pelo shutdown e não pelo fim da fatia de 1s do poll
+  REQUIRE(returned);
+  REQUIRE(std::chrono::steady_clock::now() - before < std::chrono::milliseconds(900));
+  acceptor.join();
+  REQUIRE_FALSE(gotConnection);
+  REQUIRE_FALSE(provider.get().object);
+}
+
+#endif
+
+TEST_CASE("X-Forwarded-For forjado pelo cliente não troca o balde do limite por cliente") {
+  // Um proxy: ele acrescenta o IP real à direita, o resto veio do cliente
+  REQUIRE(AdmissionControl::clientFromForwardedFor("203.0.113.9", 1) == "203.0.113.9");
+  REQUIRE(AdmissionControl::clientFromForwardedFor("1.1.1.1, 2.2.2.2, 203.0.113.9", 1) == "203.0.113.9");
+  REQUIRE(AdmissionControl::clientFromForwardedFor("victim, 203.0.113.9 ", 1) == "203.0.113.9");
+
+  // Dois proxies: a entrada mais à direita é o proxy de fora; o cliente é a segunda
+  REQUIRE(AdmissionControl::clientFromForwardedFor("6.6.6.6, 203.0.113.9, 10.0.0.2", 2) == "203.0.113.9");
+  REQUIRE(AdmissionControl::clientFromForwardedFor("203.0.113.9,10.0.0.2", 2) == "203.0.113.9");
+  // Menos entradas que proxies (requisição que não passou por todos): a mais à esquerda
+  REQUIRE(AdmissionControl::clientFromForwardedFor("10.0.0.2", 2) == "10.0.0.2");
+  REQUIRE(AdmissionControl::clientFromForwardedFor(" , ", 1).empty());
+
+  // O mesmo cliente com cabeçalhos forjados diferentes cai sempre no mesmo balde
+  AdmissionConfig config;
+  config.ratePerSec = 1;
+  config.burst = 1;
+  AdmissionControl admission(config);
+  const auto now = Clock::now();
+  const auto spoofed = [](const char* header) { return AdmissionControl::clientFromForwardedFor(header, 1); };
+  REQUIRE(admission.admit(spoofed("1.1.1.1, 203.0.113.9"), Priority::Read, now).verdict == Verdict::Admit);
+  REQUIRE(admission.admit(spoofed("2.2.2.2, 203.0.113.9"), Priority::Read, now).verdict == Verdict::RateLimited);
+  REQUIRE(admission.admit(spoofed("203.0.113.7"), Priority::Read, now).verdict == Verdict::Admit);
+}
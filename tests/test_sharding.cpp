@@ -0,0 +1,162 @@
+#include <catch2/catch_all.hpp>
+#include "app/Migrations.h"
+#include "domain/core/Uuid.h"
+#include "infra/db/ShardSet.h"
+#include "infra/repositories/sharded/ShardedClientRepository.h"
+#include "infra/repositories/sharded/ShardedProductRepository.h"
+
+#include <filesystem>
+#include <memory>
+#include <memory_resource>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using ecocin::infra::db::ShardSet;
+using ecocin::infra::db::SqliteConnection;
+using ecocin::infra::repositories::sharded::ShardedClientRepository;
+using ecocin::infra::repositories::sharded::ShardedProductRepository;
+
+namespace {
+
+namespace fs = std::filesystem;
+
+// Diretório vazio só deste teste, apagado no fim
+struct TempDir {
+  fs::path path;
+  explicit TempDir(const std::string& name) : path(fs::temp_directory_path() / ("ecocin_test_" + name)) {
+    fs::remove_all(path);
+    fs::create_directories(path);
+  }
+  ~TempDir() { fs::remove_all(path); }
+  std::string db() const { return (path / "ecocin.db").string(); }
+};
+
+// Migrações e faixa de ids em cada arquivo, como no boot, e o conjunto aberto por cima
+std::unique_ptr<ShardSet> openShards(const TempDir& dir, std::size_t count) {
+  for (std::size_t i = 0; i < count; ++i) {
+    SqliteConnection cx{ShardSet::shardPath(dir.db(), i)};
+    ecocin::app::runMigrations(cx.raw());
+    ShardSet::prepare(cx, i, count);
+  }
+  auto shards = std::make_unique<ShardSet>(dir.db(), count);
+  ShardedClientRepository::rebuildEmailRegistry(*shards);
+  return shards;
+}
+
+// Primeiro CPF (de 11 dígitos) a partir de from que cai no shard pedido
+std::string cpfIn(const ShardSet& shards, std::size_t shard, long long from = 10000000000) {
+  for (long long n = from;; ++n) {
+    auto cpf = std::to_string(n);
+    if (shards.shardForCpf(cpf) == shard) return cpf;
+  }
+}
+
+long long count(SqliteConnection& cx, const std::string& sql) {
+  sqlite3_stmt* st = nullptr;
+  REQUIRE(sqlite3_prepare_v2(cx.raw(), sql.c_str(), -1, &st, nullptr) == SQLITE_OK);
+  long long v = -1;
+  if (sqlite3_step(st) == SQLITE_ROW) v = sqlite3_column_int64(st, 0);
+  sqlite3_finalize(st);
+  return v;
+}
+
+} // namespace
+
+TEST_CASE("Shards: produto cuja cópia falha não fica só no catálogo") {
+  TempDir dir("sharding_product");
+  auto shards = openShards(dir, 3);
+  ShardedProductRepository products(*shards);
+
+  const auto ok = products.create(Product("Caneca", "", ecocin::core::Uuid::v4(), 20.0, 5, true));
+  for (std::size_t i = 0; i < 3; ++i) {
+    REQUIRE(count(shards->shard(i), "SELECT COUNT(*) FROM products WHERE id = " + std::to_string(ok.getId())) == 1);
+  }
+
+  // O shard 2 recusa a cópia depois de o catálogo e o shard 1 já terem gravado
+  shards->shard(2).exec("CREATE TRIGGER fail_copy BEFORE INSERT ON products "
+                        "BEGIN SELECT RAISE(ABORT, 'falha simulada'); END");
+  REQUIRE_THROWS_AS(products.create(Product("Prato", "", ecocin::core::Uuid::v4(), 30.0, 2, true)),
+                    std::runtime_error);
+  for (std::size_t i = 0; i < 3; ++i) {
+    REQUIRE(count(shards->shard(i), "SELECT COUNT(*) FROM products") == 1);
+  }
+  REQUIRE(products.listAll().size() == 1);
+  REQUIRE(products.findById(ok.getId()));
+}
+
+TEST_CASE("Shards: cada cliente recebe id na faixa do shard do seu CPF") {
+  TempDir dir("sharding_ids");
+  auto shards = openShards(dir, 3);
+  ShardedClientRepository clients(*shards);
+
+  for (std::size_t shard = 0; shard < 3; ++shard) {
+    const auto cpf = cpfIn(*shards, shard);
+    const auto c = clients.create(Client("Cliente", "c" + std::to_string(shard) + "@example.com", cpf));
+    REQUIRE(c.getId() >> ShardSet::kShardIdBits == static_cast<long long>(shard));
+    REQUIRE(shards->shardOfId(c.getId()) == shard);
+    REQUIRE(count(shards->shard(shard), "SELECT COUNT(*) FROM clients WHERE id = " + std::to_string(c.getId())) == 1);
+    REQUIRE(clients.findById(c.getId())->getCpf() == cpf);
+    REQUIRE(clients.findByCpf(cpf)->getId() == c.getId());
+  }
+  REQUIRE_FALSE(shards->shardOfId(3LL << ShardSet::kShardIdBits));
+  REQUIRE_FALSE(clients.findById(3LL << ShardSet::kShardIdBits));
+}
+
+TEST_CASE("Shards: listAll intercala os shards em ordem decrescente de id") {
+  TempDir dir("sharding_merge");
+  auto shards = openShards(dir, 3);
+  ShardedClientRepository clients(*shards);
+
+  // Quantidades diferentes por shard, criadas fora de ordem
+  const std::vector<std::size_t> plan{2, 0, 1, 2, 2, 1, 0, 2};
+  long long next = 10000000000;
+  for (std::size_t i = 0; i < plan.size(); ++i) {
+    const auto cpf = cpfIn(*shards, plan[i], next);
+    next = std::stoll(cpf) + 1;
+    clients.create(Client("Cliente", "m" + std::to_string(i) + "@example.com", cpf));
+  }
+
+  const auto all = clients.listAll();
+  REQUIRE(all.size() == plan.size());
+  for (std::size_t i = 1; i < all.size(); ++i) REQUIRE(all[i - 1].getId() > all[i].getId());
+
+  std::pmr::monotonic_buffer_resource arena;
+  const auto pooled = clients.listAll(&arena);
+  REQUIRE(pooled.size() == all.size());
+  for (std::size_t i = 0; i < all.size(); ++i) REQUIRE(pooled[i].getId() == all[i].getId());
+}
+
+TEST_CASE("Shards: email é único entre shards, no create e no update") {
+  TempDir dir("sharding_email");
+  auto shards = openShards(dir, 2);
+  ShardedClientRepository clients(*shards);
+
+  const auto ana = clients.create(Client("Ana", "ana@example.com", cpfIn(*shards, 0)));
+  const auto bruno = clients.create(Client("Bruno", "bruno@example.com", cpfIn(*shards, 1)));
+
+  // Outro shard, mesmo email: recusado pelo UNIQUE do registro, sem deixar o cliente gravado
+  const auto otherCpf = cpfIn(*shards, 1, std::stoll(bruno.getCpf()) + 1);
+  REQUIRE_THROWS_AS(clients.create(Client("Carla", "ana@example.com", otherCpf)), std::runtime_error);
+  REQUIRE_FALSE(clients.findByCpf(otherCpf));
+
+  auto moved = *clients.findById(bruno.getId());
+  moved.setEmail("ana@example.com");
+  REQUIRE_THROWS_AS(clients.update(moved), std::runtime_error);
+  REQUIRE(clients.findById(bruno.getId())->getEmail() == "bruno@example.com");
+
+  // Troca de email libera o antigo; remover libera o atual
+  moved = *clients.findById(bruno.getId());
+  moved.setEmail("bruno.novo@example.com");
+  REQUIRE(clients.update(moved));
+  REQUIRE(clients.create(Client("Carla", "bruno@example.com", otherCpf)).getId() > 0);
+  REQUIRE(clients.remove(ana.getId()));
+  const auto dora = clients.create(Client("Dora", "ana@example.com", cpfIn(*shards, 1, std::stoll(otherCpf) + 1)));
+  REQUIRE(shards->shardOfId(dora.getId()) == 1u);
+
+  // Uma reserva presa (queda entre a reserva e o INSERT no shard) some no boot seguinte
+  shards->shard(0).exec("INSERT INTO client_emails(email) VALUES('preso@example.com')");
+  ShardedClientRepository::rebuildEmailRegistry(*shards);
+  REQUIRE(count(shards->shard(0), "SELECT COUNT(*) FROM client_emails") == 3);
+  REQUIRE(clients.create(Client("Eva", "preso@example.com", cpfIn(*shards, 0, std::stoll(ana.getCpf()) + 1))).getId() > 0);
+}
@@ -0,0 +1,211 @@
+#include <catch2/catch_all.hpp>
+#include "domain/core/Uuid.h"
+#include "infra/repositories/memory/MemoryAddressRepository.h"
+#include "infra/repositories/memory/MemoryClientRepository.h"
+#include "infra/repositories/memory/MemoryOrderRepository.h"
+#include "infra/repositories/memory/MemoryProductRepository.h"
+#include "infra/repositories/memory/MemoryStore.h"
+#include "infra/timer/TimerWheel.h"
+#include "services/LookupFlights.h"
+#include "services/OrderService.h"
+#include "services/StockHoldService.h"
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <stdexcept>
+#include <vector>
+
+using ecocin::infra::timer::TimerWheel;
+using ecocin::services::HoldStatus;
+using ecocin::services::StockHold;
+using ecocin::services::StockHoldService;
+
+namespace {
+
+// Relógio manual para o StockHoldService: só anda quando o teste manda
+struct FakeClock {
+  StockHoldService::Clock::time_point now{};
+  StockHoldService::Clock::time_point operator()() const { return now; }
+};
+
+} // namespace
+
+TEST_CASE("TimerWheel: timers de todos os níveis vencem no tick certo depois das cascatas") {
+  TimerWheel wheel;
+  // Um timer em cada fronteira de nível (kSlots = 256): nível 0, 1, 2 e 3
+  const std::vector<TimerWheel::Tick> expires{1, 255, 256, 257, 511, 65535, 65536, 65537, 70000,
+                                              (TimerWheel::Tick{1} << 24) - 1, TimerWheel::Tick{1} << 24,
+                                              (TimerWheel::Tick{1} << 24) + 3};
+  for (std::size_t i = 0; i < expires.size(); ++i) wheel.schedule(expires[i], i);
+  REQUIRE(wheel.size() == expires.size());
+
+  std::map<std::uint64_t, TimerWheel::Tick> firedAt;
+  const auto record = [&](std::uint64_t payload) { firedAt[payload] = wheel.nextTick() - 1; };
+
+  // Avança em saltos que não coincidem com as fronteiras: cada timer sai no próprio tick
+  wheel.advance(254, record);
+  REQUIRE(firedAt.size() == 1);
+  wheel.advance(65535, record);
+  wheel.advance(1 << 20, record);
+  wheel.advance((TimerWheel::Tick{1} << 24) + 10, record);
+
+  REQUIRE(firedAt.size() == expires.size());
+  for (std::size_t i = 0; i < expires.size(); ++i) {
+    INFO("timer " << i);
+    REQUIRE(firedAt[i] == expires[i]);
+  }
+  REQUIRE(wheel.size() == 0);
+}
+
+TEST_CASE("TimerWheel: cancelar dentro do disparo vale para o mesmo tick e para os seguintes") {
+  TimerWheel wheel;
+  std::map<std::uint64_t, TimerWheel::Handle> handles;
+  handles[1] = wheel.schedule(10, 1);
+  handles[2] = wheel.schedule(10, 2);
+  handles[3] = wheel.schedule(300, 3);
+
+  std::vector<std::uint64_t> fired;
+  wheel.advance(1000, [&](std::uint64_t payload) {
+    fired.push_back(payload);
+    // O primeiro a disparar cancela o irmão do mesmo tick e o timer do nível de cima
+    if (fired.size() == 1) {
+      wheel.cancel(handles[payload == 1 ? 2 : 1]);
+      wheel.cancel(handles[3]);
+    }
+  });
+  REQUIRE(fired.size() == 1);
+  REQUIRE(wheel.size() == 0);
+
+  // Nós liberados voltam a ser usados, inclusive por um agendamento feito dentro do disparo
+  wheel.schedule(1005, 4);
+  fired.clear();
+  wheel.advance(1004, [&](std::uint64_t payload) { fired.push_back(payload); });
+  REQUIRE(fired.empty());
+  wheel.advance(1005, [&](std::uint64_t payload) {
+    fired.push_back(payload);
+    if (payload == 4) wheel.schedule(1006, 5);
+  });
+  wheel.advance(1006, [&](std::uint64_t payload) { fired.push_back(payload); });
+  REQUIRE(fired == std::vector<std::uint64_t>{4, 5});
+}
+
+TEST_CASE("StockHoldService: reservas vencem no prazo, inclusive as que passam por cascata") {
+  FakeClock clock;
+  StockHoldService holds(std::ref(clock));
+
+  // 10 min = 6000 ticks (nível 1) e 24 h = 864000 ticks (nível 2)
+  const auto shortHold = holds.hold(1, 3, 10, std::chrono::minutes(10));
+  const auto longHold = holds.hold(1, 2, 10, StockHoldService::kMaxTtl);
+  REQUIRE(shortHold.status == HoldStatus::Held);
+  REQUIRE(longHold.status == HoldStatus::Held);
+  REQUIRE(longHold.available == 5);
+  REQUIRE(holds.hold(1, 6, 10).status == HoldStatus::Insufficient);
+
+  clock.now += std::chrono::minutes(10) - StockHoldService::kTick;
+  REQUIRE(holds.held(1) == 5);
+  clock.now += 2 * StockHoldService::kTick;
+  REQUIRE(holds.held(1) == 2);
+  REQUIRE(holds.activeHolds() == 1);
+
+  clock.now = StockHoldService::Clock::time_point{} + StockHoldService::kMaxTtl - StockHoldService::kTick;
+  REQUIRE(holds.held(1) == 2);
+  clock.now += 2 * StockHoldService::kTick;
+  REQUIRE(holds.held(1) == 0);
+  REQUIRE(holds.activeHolds() == 0);
+  REQUIRE_FALSE(holds.release(longHold.hold.id, 1));
+}
+
+TEST_CASE("StockHoldService: convert só consome a reserva se a baixa passar") {
+  FakeClock clock;
+  StockHoldService holds(std::ref(clock));
+  const auto h = holds.hold(7, 4, 10).hold;
+
+  // Outro produto ou outra quantidade: nem chama a baixa
+  bool called = false;
+  const auto commit = [&](const StockHold&) { called = true; return true; };
+  REQUIRE_FALSE(holds.convert(h.id, 8, 4, commit));
+  REQUIRE_FALSE(holds.convert(h.id, 7, 3, commit));
+  REQUIRE_FALSE(called);
+
+  // Baixa recusada ou com erro: a reserva continua separada
+  REQUIRE_FALSE(holds.convert(h.id, 7, 4, [](const StockHold&) { return false; }));
+  REQUIRE_THROWS_AS(holds.convert(h.id, 7, 4, [](const StockHold&) -> bool { throw std::runtime_error("db"); }),
+                    std::runtime_error);
+  REQUIRE(holds.held(7) == 4);
+  REQUIRE(holds.activeHolds() == 1);
+
+  const auto taken = holds.convert(h.id, 7, 0, [](const StockHold& s) { return s.quantity == 4; });
+  REQUIRE(taken);
+  REQUIRE(taken->quantity == 4);
+  REQUIRE(holds.held(7) == 0);
+  REQUIRE_FALSE(holds.take(h.id, 7));
+
+  // A roda não dispara o timer de uma reserva convertida
+  clock.now += StockHoldService::kDefaultTtl + std::chrono::seconds(1);
+  REQUIRE(holds.activeHolds() == 0);
+}
+
+TEST_CASE("StockHoldService: a baixa do convert roda fora da trava sem liberar as unidades") {
+  FakeClock clock;
+  StockHoldService holds(std::ref(clock));
+  const auto h = holds.hold(7, 4, 10, std::chrono::seconds(30)).hold;
+
+  // Dentro da baixa o serviço responde (antes, a mesma thread travaria no mutex): a reserva está
+  // fora do mapa, mas as 4 unidades seguem contadas e não podem ser reservadas de novo
+  const auto refused = holds.convert(h.id, 7, 4, [&](const StockHold&) {
+    REQUIRE(holds.held(7) == 4);
+    REQUIRE(holds.hold(7, 7, 10).status == HoldStatus::Insufficient);
+    REQUIRE_FALSE(holds.release(h.id, 7));
+    REQUIRE_FALSE(holds.take(h.id, 7));
+    return false;
+  });
+  REQUIRE_FALSE(refused);
+
+  // Recusada, a reserva voltou com o prazo original: ainda vale aos 29s e vence depois dos 30s
+  REQUIRE(holds.activeHolds() == 1);
+  clock.now += std::chrono::seconds(29);
+  REQUIRE(holds.held(7) == 4);
+  clock.now += std::chrono::seconds(1) + StockHoldService::kTick;
+  REQUIRE(holds.held(7) == 0);
+  REQUIRE(holds.activeHolds() == 0);
+}
+
+TEST_CASE("OrderService: reserva vira pedido e, se a baixa é recusada, continua valendo") {
+  namespace memory = ecocin::infra::repositories::memory;
+  memory::MemoryStore store;
+  memory::MemoryClientRepository clients(store);
+  memory::MemoryProductRepository products(store);
+  memory::MemoryAddressRepository addresses(store);
+  memory::MemoryOrderRepository orders(store);
+  ecocin::services::LookupFlights flights;
+  FakeClock clock;
+  StockHoldService holds(std::ref(clock));
+  ecocin::services::OrderService service(orders, clients, products, addresses, flights, &holds);
+
+  const auto client = clients.create(Client("Ana", "ana@example.com", "12345678901"));
+  Address address("Rua A", "1", "Recife", "PE", "50000-000", "HOME");
+  address.setClientId(client.getId());
+  addresses.create(address);
+  const auto product = products.create(Product("Caneca", "", ecocin::core::Uuid::v4(), 20.0, 5, true));
+  const auto sku = product.getSku().str();
+
+  const auto h = holds.hold(product.getId(), 3, product.getStockQuantity());
+  REQUIRE(h.status == HoldStatus::Held);
+
+  // Alguém baixa o estoque por fora: sobram 2, a baixa de 3 é recusada e a reserva fica
+  REQUIRE(products.adjustStock(product.getId(), -3));
+  REQUIRE_FALSE(service.createByCpfSkuAndType("12345678901", sku, "HOME", 0, h.hold.id));
+  REQUIRE(holds.held(product.getId()) == 3);
+  REQUIRE(orders.listAll().empty());
+
+  // Com o estoque de volta, a mesma reserva vira pedido e baixa o estoque
+  REQUIRE(products.adjustStock(product.getId(), 3));
+  const auto order = service.createByCpfSkuAndType("12345678901", sku, "HOME", 0, h.hold.id);
+  REQUIRE(order);
+  REQUIRE(order->getQuantity() == 3);
+  REQUIRE(holds.held(product.getId()) == 0);
+  REQUIRE(products.findById(product.getId())->getStockQuantity() == 2);
+  REQUIRE_FALSE(service.createByCpfSkuAndType("12345678901", sku, "HOME", 0, h.hold.id));
+}
@@ -0,0 +1,38 @@
+#include <catch2/catch_all.hpp>
+#include "domain/core/Uuid.h"
+
+#include <unordered_set>
+
+using ecocin::core::Uuid;
+
+TEST_CASE("Uuid v4 tem formato canônico e é único") {
+  std::unordered_set<Uuid> seen;
+  for (int i = 0; i < 1000; ++i) {
+    const auto u = Uuid::v4();
+    const auto s = u.str();
+    REQUIRE(s.size() == 36);
+    REQUIRE(s[14] == '4');
+    REQUIRE((s[19] == '8' || s[19] == '9' || s[19] == 'a' || s[19] == 'b'));
+    REQUIRE(u.isBinary());
+    REQUIRE(seen.insert(u).second);
+  }
+}
+
+TEST_CASE("Uuid preserva o texto original") {
+  const std::string canonical = "123e4567-e89b-42d3-a456-426614174000";
+  const Uuid a(canonical);
+  REQUIRE(a.isBinary());
+  REQUIRE(a.str() == canonical);
+  REQUIRE(Uuid::fromBytes(a.bytes()) == a);
+
+  // SKUs fora do formato canônico (maiúsculas, texto livre) ficam como vieram
+  const Uuid upper("123E4567-E89B-42D3-A456-426614174000");
+  REQUIRE_FALSE(upper.isBinary());
+  REQUIRE(upper.str() == "123E4567-E89B-42D3-A456-426614174000");
+  REQUIRE(upper != a);
+
+  const Uuid sku("SKU-001");
+  REQUIRE(sku.str() == "SKU-001");
+  REQUIRE(Uuid().empty());
+  REQUIRE_FALSE(sku.empty());
+}
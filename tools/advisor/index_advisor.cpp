@@ -0,0 +1,237 @@
+// Advisor de índices: audita o SQL dos repositórios contra o plano de execução do SQLite.
+//
+// Exercita todos os métodos dos quatro repositórios dentro de uma transação desfeita no final (nada é
+// gravado), capturando cada SQL executado. Depois roda ANALYZE + EXPLAIN QUERY PLAN em cada formato e
+// aponta varreduras completas e ordenações em B-tree temporária, com o índice composto (ou covering) que
+// as elimina — já conferido no planejador, criando e desfazendo o índice.
+//
+// Sem --db, audita uma massa sintética em memória (bench/Dataset.h) com --rows linhas por tabela.
+// Com --db, usa o banco real (as estatísticas do ANALYZE refletem os dados de produção); os listAll
+// leem as tabelas inteiras, então num banco grande a auditoria leva o tempo dessas leituras.
+//
+// Uso:
+//   index_advisor [--db e-cocin.db] [--rows 20000] [--out migracao.sql] [--apply on]
+//     --out    grava a migração sugerida (CREATE INDEX / DROP INDEX redundante / ANALYZE)
+//     --apply  aplica a migração no banco de --db
+
+#include "Dataset.h"
+#include "app/Migrations.h"
+#include "infra/db/IndexAdvisor.h"
+#include "infra/db/SqliteConnection.h"
+#include "infra/repositories/sqlite/AddressRepositorySqlite.h"
+#include "infra/repositories/sqlite/ClientRepositorySqlite.h"
+#include "infra/repositories/sqlite/OrderRepositorySqlite.h"
+#include "infra/repositories/sqlite/ProductRepositorySqlite.h"
+
+#include <fstream>
+#include <iostream>
+#include <string>
+
+using ecocin::infra::db::AdvisorReport;
+using ecocin::infra::db::IndexAdvisor;
+using ecocin::infra::db::SqliteConnection;
+using ecocin::infra::db::Statement;
+using ecocin::infra::db::Transaction;
+
+namespace {
+
+struct Options {
+    std::string db;
+    std::uint64_t rows{20000};
+    std::string out;
+    bool apply{false};
+};
+
+Options parseArgs(int argc, char** argv) {
+    Options o;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        const std::string key = argv[i];
+        const std::string value = argv[i + 1];
+        if (key == "--db") o.db = value;
+        else if (key == "--rows") o.rows = std::stoull(value);
+        else if (key == "--out") o.out = value;
+        else if (key == "--apply") o.apply = value != "off";
+        else throw std::invalid_argument("opção desconhecida: " + key);
+    }
+    if (o.rows == 0) o.rows = 1;
+    if (o.apply && o.db.empty()) throw std::invalid_argument("--apply precisa de --db (a massa em memória é descartada)");
+    return o;
+}
+
+long long firstId(SqliteConnection& cx, const char* table) {
+    Statement st(cx, std::string("SELECT MIN(id) FROM ") + table, "min id");
+    return sqlite3_step(st) == SQLITE_ROW ? static_cast<long long>(sqlite3_column_int64(st, 0)) : 0;
+}
+
+// Chama cada método de cada repositório uma vez, com chaves existentes quando houver.
+// Cria cliente -> endereço -> produto -> pedido e remove na ordem inversa, para que as
+// verificações de chave estrangeira dos DELETE também apareçam nos planos.
+void exerciseRepositories(SqliteConnection& cx, IndexAdvisor& advisor) {
+    using namespace ecocin::infra::repositories::sqlite;
+    ClientRepositorySqlite clients(cx);
+    ProductRepositorySqlite products(cx);
+    AddressRepositorySqlite addresses(cx);
+    OrderRepositorySqlite orders(cx);
+
+    const auto clientId = firstId(cx, "clients");
+    const auto productId = firstId(cx, "products");
+    const auto addressId = firstId(cx, "addresses");
+    const auto orderId = firstId(cx, "orders");
+
+    advisor.startCapture(); // só o SQL dos repositórios entra na auditoria
+    clients.findById(clientId);
+    clients.findByCpf(ecocin::bench::cpfFor(1));
+    clients.findByIds({clientId});
+    clients.findByCpfs({ecocin::bench::cpfFor(1)});
+    clients.listAll();
+
+    products.findById(productId);
+    products.findBySku(ecocin::bench::skuFor(1).str());
+    products.findByIds({productId});
+    products.findBySkus({ecocin::bench::skuFor(1).str()});
+    products.listAll();
+
+    addresses.findById(addressId);
+    addresses.findByIds({addressId});
+    addresses.listByClientId(clientId);
+    addresses.findByClientIdAndType(clientId, "CASA");
+    addresses.listAll();
+
+    orders.findById(orderId);
+    orders.listByClientId(clientId);
+    orders.listAll();
+
+    const auto tag = ecocin::core::Uuid::v4().str(); // CPF/e-mail que não colidem com os dados do banco
+    Client c;
+    c.setName("Cliente do advisor");
+    c.setEmail(tag + "@advisor.invalid");
+    c.setCpf(tag);
+    c = clients.create(c);
+    c.setName("Cliente do advisor (editado)"); // update grava só as colunas alteradas
+    clients.update(c);
+
+    Address a;
+    a.setClientId(c.getId());
+    a.setStreet("Rua do Advisor");
+    a.setNumber("1");
+    a.setCity("Recife");
+    a.setState("PE");
+    a.setZip("50000000");
+    a.setAddressType("CASA");
+    a = addresses.create(a);
+    a.setNumber("2");
+    addresses.update(a);
+
+    Product p;
+    p.setName("Produto do advisor");
+    p.setSku(ecocin::core::Uuid::v4());
+    p.setPrice(1.0);
+    p.setStockQuantity(1);
+    p.setIsActive(true);
+    p = products.create(p);
+    p.setStockQuantity(2);
+    products.update(p);
+    products.adjustStock(p.getId(), 1);
+    products.updatePrice(p.getId(), 2.0);
+
+    Order o;
+    o.setClientId(c.getId());
+    o.setProductId(p.getId());
+    o.setShippingAddressId(a.getId());
+    o.setQuantity(1);
+    o.setUnitPrice(1.0);
+    o.setStatus("PENDING");
+    o = orders.create(o);
+    o.setQuantity(2);
+    orders.update(o);
+    orders.updateStatus(o.getId(), "PAID");
+    orders.updateShippingAddress(o.getId(), a.getId());
+
+    orders.remove(o.getId());
+    products.remove(p.getId());
+    addresses.remove(a.getId());
+    clients.remove(c.getId());
+    advisor.stopCapture();
+}
+
+void printIndented(const std::string& text, const char* prefix) {
+    std::size_t start = 0;
+    while (start <= text.size()) {
+        auto end = text.find('\n', start);
+        if (end == std::string::npos) end = text.size();
+        std::cout << prefix << text.substr(start, end - start) << '\n';
+        start = end + 1;
+    }
+}
+
+void printReport(const AdvisorReport& report) {
+    std::size_t problems = 0;
+    for (const auto& f : report.findings) {
+        if (f.issues.empty()) {
+            std::cout << "[ok]        " << f.sql << '\n';
+            continue;
+        }
+        if (f.expected) {
+            std::cout << "[esperado]  " << f.sql << "  (varredura pedida pela consulta)\n";
+            continue;
+        }
+        ++problems;
+        std::cout << "\n[problema]  " << f.sql << '\n';
+        printIndented(f.plan, "    ");
+        if (f.suggestions.empty()) {
+            std::cout << "  sem sugestão automática (consulta fora do formato que o advisor entende)\n";
+            continue;
+        }
+        for (const auto& s : f.suggestions) {
+            std::cout << "  sugestão: " << s.createSql() << (s.covering ? "  -- covering" : "") << '\n';
+        }
+        std::cout << (f.verified ? "  plano com o índice (verificado):\n" : "  plano com o índice (ainda com problemas):\n");
+        printIndented(f.planAfter, "    ");
+    }
+
+    std::cout << '\n' << report.findings.size() << " formatos de SQL auditados, " << problems << " com problemas\n";
+    const auto migration = report.migrationSql();
+    if (migration.empty()) {
+        std::cout << "nenhum índice a sugerir\n";
+    } else {
+        std::cout << "\nmigração sugerida:\n";
+        printIndented(migration.substr(0, migration.size() - 1), "  ");
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    try {
+        const auto o = parseArgs(argc, argv);
+        SqliteConnection cx(o.db.empty() ? ":memory:" : o.db);
+        if (o.db.empty()) {
+            std::cerr << "gerando massa sintética com " << o.rows << " linhas por tabela...\n";
+            ecocin::bench::seedDataset(cx.raw(), o.rows);
+        } else {
+            ecocin::app::runMigrations(cx.raw());
+        }
+
+        IndexAdvisor advisor(cx);
+        {
+            Transaction tx(cx); // desfeita no fim do escopo: a auditoria não grava nada
+            exerciseRepositories(cx, advisor);
+        }
+
+        const auto report = advisor.audit();
+        printReport(report);
+
+        if (!o.out.empty()) {
+            std::ofstream(o.out) << report.migrationSql();
+            std::cerr << "migração gravada em " << o.out << '\n';
+        }
+        if (o.apply) {
+            IndexAdvisor::apply(cx, report);
+            std::cerr << "migração aplicada em " << o.db << '\n';
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "index_advisor: " << e.what() << '\n';
+        return 1;
+    }
+    return 0;
+}
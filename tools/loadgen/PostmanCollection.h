@@ -0,0 +1,85 @@
+#ifndef ECOCIN_TOOLS_LOADGEN_POSTMANCOLLECTION_H
+#define ECOCIN_TOOLS_LOADGEN_POSTMANCOLLECTION_H
+
+#include <nlohmann/json.hpp>
+
+#include <fstream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Leitura da coleção do Postman (resources/ECOMMERCE-CIN.postman_collection.json).
+// O gerador de carga usa as requisições da coleção como modelo: método, caminho e corpo JSON
+// de exemplo. Os valores que precisam ser únicos (CPF, e-mail, SKU...) são trocados a cada envio.
+namespace ecocin::tools::loadgen {
+
+struct RequestTemplate {
+    std::string name;
+    std::string method;
+    std::string path;            // sem esquema/host, com query string (ex.: /orders?cpf=123)
+    nlohmann::json body;         // objeto vazio quando a requisição não tem corpo
+};
+
+class PostmanCollection {
+private:
+    std::vector<RequestTemplate> requests_;
+
+    // "http://localhost:8000/orders?cpf=1" -> "/orders?cpf=1"
+    static std::string pathOf(const nlohmann::json& url) {
+        std::string raw = url.is_string() ? url.get<std::string>() : url.value("raw", std::string{});
+        const auto scheme = raw.find("://");
+        const auto start = raw.find('/', scheme == std::string::npos ? 0 : scheme + 3);
+        return start == std::string::npos ? "/" : raw.substr(start);
+    }
+
+    void collect(const nlohmann::json& items) {
+        for (const auto& item : items) {
+            if (item.contains("item")) {   // pasta
+                collect(item["item"]);
+                continue;
+            }
+            const auto& req = item.at("request");
+            RequestTemplate t;
+            t.name = item.value("name", std::string{});
+            t.method = req.value("method", std::string("GET"));
+            t.path = pathOf(req.at("url"));
+            t.body = nlohmann::json::object();
+            // Algumas requisições GET da coleção carregam um corpo esquecido; só vale para envio com corpo
+            if (t.method != "GET" && t.method != "DELETE" && req.contains("body")) {
+                const auto raw = req["body"].value("raw", std::string{});
+                if (!raw.empty()) t.body = nlohmann::json::parse(raw);
+            }
+            requests_.push_back(std::move(t));
+        }
+    }
+
+public:
+    explicit PostmanCollection(const std::string& file) {
+        std::ifstream in(file);
+        if (!in) throw std::runtime_error("não foi possível abrir a coleção: " + file);
+        const auto doc = nlohmann::json::parse(in);
+        collect(doc.at("item"));
+    }
+
+    // Primeira requisição com o método e o caminho (sem query string) informados
+    std::optional<RequestTemplate> find(const std::string& method, const std::string& path) const {
+        for (const auto& r : requests_) {
+            if (r.method == method && r.path.substr(0, r.path.find('?')) == path) return r;
+        }
+        return std::nullopt;
+    }
+
+    // Igual a find(), mas a requisição é obrigatória para o cenário
+    RequestTemplate require(const std::string& method, const std::string& path) const {
+        auto r = find(method, path);
+        if (!r) throw std::runtime_error("a coleção não tem a requisição " + method + " " + path);
+        return *r;
+    }
+
+    const std::vector<RequestTemplate>& requests() const { return requests_; }
+};
+
+} // namespace ecocin::tools::loadgen
+
+#endif // ECOCIN_TOOLS_LOADGEN_POSTMANCOLLECTION_H
@@ -0,0 +1,386 @@
+// Gerador de carga HTTP para o e-cocin, em malha aberta (open-loop) com taxa de chegada constante.
+//
+// As requisições são agendadas em instantes fixos (início + k / taxa), independentemente de as
+// anteriores já terem respondido, e a latência de cada uma é medida a partir do instante em que
+// ela DEVERIA ter sido enviada. Se o servidor engasga, as requisições esperam na fila e esse
+// tempo entra na medida — é isso que evita a "omissão coordenada" dos geradores em malha fechada,
+// que simplesmente param de enviar enquanto esperam e escondem a cauda da latência.
+//
+// Os cenários vêm das requisições da coleção do Postman (método, caminho e corpo de exemplo):
+//   create_client   POST /clients      (CPF/e-mail únicos por envio)
+//   add_address     POST /addresses    (para um cliente criado na preparação)
+//   browse_products GET  /products
+//   place_order     POST /orders       (cliente e SKU criados na preparação)
+//   list_orders     GET  /orders?cpf=
+//
+// Uso:
+//   loadgen [--host 127.0.0.1] [--port 8000] [--collection resources/ECOMMERCE-CIN.postman_collection.json]
+//           [--rate 200] [--duration 30] [--warmup 5] [--connections 32]
+//           [--mix create_client=10,add_address=10,browse_products=50,place_order=20,list_orders=10]
+//           [--setup-clients 200] [--setup-products 50] [--wait-ready 0] [--out loadgen.json]
+
+#include "PostmanCollection.h"
+
+#include "domain/core/Uuid.h"
+#include "infra/metrics/Histogram.h"
+
+#include "oatpp/Environment.hpp"
+#include "oatpp/network/tcp/client/ConnectionProvider.hpp"
+#include "oatpp/web/client/HttpRequestExecutor.hpp"
+#include "oatpp/web/protocol/http/outgoing/BufferBody.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using ecocin::infra::metrics::Histogram;
+using ecocin::tools::loadgen::PostmanCollection;
+using ecocin::tools::loadgen::RequestTemplate;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+enum class Scenario : std::size_t { CreateClient, AddAddress, BrowseProducts, PlaceOrder, ListOrders, Count };
+constexpr std::size_t kScenarios = static_cast<std::size_t>(Scenario::Count);
+constexpr std::array<const char*, kScenarios> kScenarioNames{
+    "create_client", "add_address", "browse_products", "place_order", "list_orders"};
+
+struct Options {
+    std::string host{"127.0.0.1"};
+    unsigned short port{8000};
+    std::string collection{"resources/ECOMMERCE-CIN.postman_collection.json"};
+    double rate{200};                 // requisições por segundo
+    double duration{30};              // segundos medidos
+    double warmup{5};                 // segundos iniciais descartados
+    std::size_t connections{32};
+    std::array<double, kScenarios> weights{10, 10, 50, 20, 10};
+    std::size_t setupClients{200};
+    std::size_t setupProducts{50};
+    double waitReady{0};              // segundos esperando o servidor subir antes da preparação
+    std::string out;
+};
+
+Options parseArgs(int argc, char** argv) {
+    Options o;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        const std::string key = argv[i];
+        const std::string value = argv[i + 1];
+        if (key == "--host") o.host = value;
+        else if (key == "--port") o.port = static_cast<unsigned short>(std::stoul(value));
+        else if (key == "--collection") o.collection = value;
+        else if (key == "--rate") o.rate = std::stod(value);
+        else if (key == "--duration") o.duration = std::stod(value);
+        else if (key == "--warmup") o.warmup = std::stod(value);
+        else if (key == "--connections") o.connections = std::stoul(value);
+        else if (key == "--setup-clients") o.setupClients = std::stoul(value);
+        else if (key == "--setup-products") o.setupProducts = std::stoul(value);
+        else if (key == "--wait-ready") o.waitReady = std::stod(value);
+        else if (key == "--out") o.out = value;
+        else if (key == "--mix") {
+            o.weights.fill(0);
+            std::stringstream ss(value);
+            std::string item;
+            while (std::getline(ss, item, ',')) {
+                const auto eq = item.find('=');
+                const auto name = item.substr(0, eq);
+                std::size_t s = 0;
+                while (s < kScenarios && name != kScenarioNames[s]) ++s;
+                if (s == kScenarios || eq == std::string::npos) throw std::invalid_argument("cenário inválido em --mix: " + item);
+                o.weights[s] = std::stod(item.substr(eq + 1));
+            }
+        } else {
+            throw std::invalid_argument("opção desconhecida: " + key);
+        }
+    }
+    if (o.rate <= 0 || o.connections == 0) throw std::invalid_argument("--rate e --connections devem ser positivos");
+    if (o.setupClients == 0 || o.setupProducts == 0) throw std::invalid_argument("a preparação precisa de ao menos um cliente e um produto");
+    return o;
+}
+
+// Uma conexão keep-alive com o servidor. Em caso de falha de rede reconecta uma vez.
+class HttpClient {
+private:
+    std::shared_ptr<oatpp::web::client::HttpRequestExecutor> executor_;
+    std::shared_ptr<oatpp::web::client::RequestExecutor::ConnectionHandle> connection_;
+
+public:
+    HttpClient(const std::string& host, unsigned short port) {
+        auto provider = oatpp::network::tcp::client::ConnectionProvider::createShared({host, port});
+        executor_ = oatpp::web::client::HttpRequestExecutor::createShared(provider);
+    }
+
+    // Envia a requisição e devolve o status HTTP (ou -1 se não houve resposta)
+    int send(const std::string& method, const std::string& path, const nlohmann::json& body) {
+        oatpp::web::client::RequestExecutor::Headers headers;
+        std::shared_ptr<oatpp::web::protocol::http::outgoing::Body> payload;
+        if (!body.empty()) {
+            payload = oatpp::web::protocol::http::outgoing::BufferBody::createShared(
+                oatpp::String(body.dump()), "application/json");
+        }
+        for (int attempt = 0; attempt < 2; ++attempt) {
+            try {
+                if (!connection_) connection_ = executor_->getConnection();
+                auto response = executor_->execute(method, path, headers, payload, connection_);
+                response->readBodyToString(); // consome o corpo para reaproveitar a conexão
+                return response->getStatusCode();
+            } catch (const std::exception&) {
+                connection_.reset();
+            }
+        }
+        return -1;
+    }
+};
+
+// Dados criados na preparação e valores únicos gerados durante a carga
+struct World {
+    RequestTemplate createClient, createProduct, createAddress, createOrder, listProducts, listOrders;
+    std::vector<std::string> cpfs;   // clientes com endereço do tipo de createAddress
+    std::vector<std::string> skus;
+    std::string runTag;              // distingue execuções sobre o mesmo banco
+    std::atomic<std::uint64_t> counter{0};
+
+    std::string uniqueCpf() {
+        char buf[16];
+        std::snprintf(buf, sizeof(buf), "%s%08llu", runTag.c_str(),
+                      static_cast<unsigned long long>(counter.fetch_add(1) % 100000000ull));
+        return buf;
+    }
+};
+
+nlohmann::json clientBody(World& w, const std::string& cpf) {
+    auto body = w.createClient.body;
+    body["name"] = "Cliente Carga " + cpf;
+    body["email"] = "carga+" + cpf + "@ecocin.test";
+    body["cpf"] = cpf;
+    return body;
+}
+
+// Executa um cenário com o cliente HTTP da thread e devolve o status da resposta
+int runScenario(Scenario s, World& w, HttpClient& http, std::mt19937_64& rng) {
+    auto pick = [&](const std::vector<std::string>& v) -> const std::string& { return v[rng() % v.size()]; };
+    switch (s) {
+        case Scenario::CreateClient:
+            return http.send("POST", w.createClient.path, clientBody(w, w.uniqueCpf()));
+        case Scenario::AddAddress: {
+            auto body = w.createAddress.body;
+            body["cpf"] = pick(w.cpfs);
+            body["addressType"] = "extra-" + std::to_string(w.counter.fetch_add(1));
+            return http.send("POST", w.createAddress.path, body);
+        }
+        case Scenario::BrowseProducts:
+            return http.send("GET", w.listProducts.path, {});
+        case Scenario::PlaceOrder: {
+            auto body = w.createOrder.body;
+            body["cpf"] = pick(w.cpfs);
+            body["sku"] = pick(w.skus);
+            body["shippingAddressType"] = w.createAddress.body.value("addressType", std::string("residential"));
+            body["quantity"] = 1;
+            return http.send("POST", w.createOrder.path, body);
+        }
+        case Scenario::ListOrders:
+            return http.send("GET", "/orders?cpf=" + pick(w.cpfs), {});
+        default:
+            return -1;
+    }
+}
+
+// Cria produtos e clientes (com endereço) usados pelos cenários de pedido e consulta
+void setup(const Options& o, World& w, HttpClient& http) {
+    // Com --wait-ready, tenta a listagem de produtos até o servidor responder (ex.: recém-iniciado por um script)
+    const auto readyDeadline = Clock::now() + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(o.waitReady));
+    while (http.send("GET", w.listProducts.path, {}) / 100 != 2) {
+        if (Clock::now() >= readyDeadline) throw std::runtime_error("servidor não respondeu em " + o.host + ":" + std::to_string(o.port));
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    }
+    for (std::size_t i = 0; i < o.setupProducts; ++i) {
+        auto body = w.createProduct.body;
+        const auto sku = ecocin::core::Uuid::v4().str();
+        body["name"] = "Produto Carga " + std::to_string(i);
+        body["sku"] = sku;
+        body["stockQuantity"] = 1000000000; // estoque não acaba durante a carga
+        if (http.send("POST", w.createProduct.path, body) / 100 != 2) throw std::runtime_error("falha ao criar produto");
+        w.skus.push_back(sku);
+    }
+    for (std::size_t i = 0; i < o.setupClients; ++i) {
+        const auto cpf = w.uniqueCpf();
+        if (http.send("POST", w.createClient.path, clientBody(w, cpf)) / 100 != 2) throw std::runtime_error("falha ao criar cliente");
+        auto address = w.createAddress.body;
+        address["cpf"] = cpf;
+        if (http.send("POST", w.createAddress.path, address) / 100 != 2) throw std::runtime_error("falha ao criar endereço");
+        w.cpfs.push_back(cpf);
+    }
+}
+
+struct Job {
+    Scenario scenario;
+    Clock::time_point intended;
+    bool measured;
+};
+
+struct RouteStats {
+    Histogram latencyNs;   // desde o instante agendado (inclui espera na fila)
+    Histogram serviceNs;   // só o tempo da requisição em si
+    std::atomic<std::uint64_t> errors{0};
+};
+
+double ms(std::uint64_t ns) { return static_cast<double>(ns) / 1e6; }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    oatpp::Environment::init();
+    int rc = 0;
+    try {
+        const auto opts = parseArgs(argc, argv);
+        const PostmanCollection collection(opts.collection);
+
+        World world;
+        world.createClient  = collection.require("POST", "/clients");
+        world.createProduct = collection.require("POST", "/products");
+        world.createAddress = collection.require("POST", "/addresses");
+        world.createOrder   = collection.require("POST", "/orders");
+        world.listProducts  = collection.require("GET", "/products");
+        world.listOrders    = collection.require("GET", "/orders");
+        {
+            const auto now = std::chrono::system_clock::now().time_since_epoch();
+            world.runTag = std::to_string(100 + std::chrono::duration_cast<std::chrono::seconds>(now).count() % 900);
+        }
+
+        HttpClient setupClient(opts.host, opts.port);
+        std::cerr << "preparando " << opts.setupProducts << " produtos e " << opts.setupClients << " clientes...\n";
+        setup(opts, world, setupClient);
+
+        std::array<RouteStats, kScenarios> stats;
+        std::deque<Job> queue;
+        std::mutex mutex;
+        std::condition_variable cv;
+        bool done = false;
+        std::size_t maxBacklog = 0;
+
+        std::vector<std::thread> workers;
+        for (std::size_t t = 0; t < opts.connections; ++t) {
+            workers.emplace_back([&, t] {
+                HttpClient http(opts.host, opts.port);
+                std::mt19937_64 rng(1000 + t);
+                for (;;) {
+                    Job job;
+                    {
+                        std::unique_lock<std::mutex> lock(mutex);
+                        cv.wait(lock, [&] { return done || !queue.empty(); });
+                        if (queue.empty()) return;
+                        job = queue.front();
+                        queue.pop_front();
+                    }
+                    const auto started = Clock::now();
+                    const int status = runScenario(job.scenario, world, http, rng);
+                    const auto finished = Clock::now();
+                    if (!job.measured) continue;
+                    auto& s = stats[static_cast<std::size_t>(job.scenario)];
+                    s.latencyNs.record(static_cast<std::uint64_t>(
+                        std::chrono::duration_cast<std::chrono::nanoseconds>(finished - job.intended).count()));
+                    s.serviceNs.record(static_cast<std::uint64_t>(
+                        std::chrono::duration_cast<std::chrono::nanoseconds>(finished - started).count()));
+                    if (status / 100 != 2) s.errors.fetch_add(1, std::memory_order_relaxed);
+                }
+            });
+        }
+
+        // Agendador: taxa constante, sem esperar pelas respostas
+        std::mt19937_64 rng(42);
+        std::discrete_distribution<std::size_t> mix(opts.weights.begin(), opts.weights.end());
+        const auto interval = std::chrono::duration<double>(1.0 / opts.rate);
+        const auto total = static_cast<std::uint64_t>((opts.warmup + opts.duration) * opts.rate);
+        const auto warmupCount = static_cast<std::uint64_t>(opts.warmup * opts.rate);
+        std::cerr << "carga: " << opts.rate << " req/s por " << opts.duration << "s (+" << opts.warmup << "s de aquecimento)\n";
+
+        const auto start = Clock::now() + std::chrono::milliseconds(10);
+        for (std::uint64_t k = 0; k < total; ++k) {
+            const auto intended = start + std::chrono::duration_cast<Clock::duration>(interval * static_cast<double>(k));
+            std::this_thread::sleep_until(intended);
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                queue.push_back({static_cast<Scenario>(mix(rng)), intended, k >= warmupCount});
+                maxBacklog = std::max(maxBacklog, queue.size());
+            }
+            cv.notify_one();
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            done = true;
+        }
+        cv.notify_all();
+        for (auto& w : workers) w.join();
+        const double elapsed = std::chrono::duration<double>(Clock::now() - start).count() - opts.warmup;
+
+        // Relatório por rota
+        nlohmann::ordered_json report;
+        report["targetRate"] = opts.rate;
+        report["durationSeconds"] = opts.duration;
+        report["connections"] = opts.connections;
+        report["maxBacklog"] = maxBacklog;
+        report["routes"] = nlohmann::ordered_json::array();
+        Histogram all;
+        std::uint64_t allErrors = 0;
+        for (std::size_t s = 0; s < kScenarios; ++s) {
+            const auto& st = stats[s];
+            const auto n = st.latencyNs.count();
+            if (n == 0) continue;
+            all.merge(st.latencyNs);
+            allErrors += st.errors.load();
+            const RequestTemplate* t = nullptr;
+            switch (static_cast<Scenario>(s)) {
+                case Scenario::CreateClient:   t = &world.createClient; break;
+                case Scenario::AddAddress:     t = &world.createAddress; break;
+                case Scenario::BrowseProducts: t = &world.listProducts; break;
+                case Scenario::PlaceOrder:     t = &world.createOrder; break;
+                default:                       t = &world.listOrders; break;
+            }
+            report["routes"].push_back({
+                {"scenario", kScenarioNames[s]},
+                {"route", t->method + " " + t->path.substr(0, t->path.find('?'))},
+                {"requests", n},
+                {"errors", st.errors.load()},
+                {"throughputPerSec", static_cast<double>(n) / elapsed},
+                {"p50Ms", ms(st.latencyNs.quantile(0.50))},
+                {"p99Ms", ms(st.latencyNs.quantile(0.99))},
+                {"p999Ms", ms(st.latencyNs.quantile(0.999))},
+                {"maxMs", ms(st.latencyNs.quantile(1.0))},
+                {"serviceP99Ms", ms(st.serviceNs.quantile(0.99))},
+            });
+        }
+        report["total"] = {
+            {"requests", all.count()},
+            {"errors", allErrors},
+            {"throughputPerSec", static_cast<double>(all.count()) / elapsed},
+            {"p50Ms", ms(all.quantile(0.50))},
+            {"p99Ms", ms(all.quantile(0.99))},
+            {"p999Ms", ms(all.quantile(0.999))},
+        };
+
+        const auto text = report.dump(2);
+        if (opts.out.empty()) {
+            std::cout << text << '\n';
+        } else {
+            std::ofstream(opts.out) << text << '\n';
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "loadgen: " << e.what() << '\n';
+        rc = 1;
+    }
+    oatpp::Environment::destroy();
+    return rc;
+}
@@ -0,0 +1,315 @@
+// Carga massiva de dados sintéticos para reproduzir problemas de desempenho em escala de produção.
+//
+// Escreve pela própria camada de repositórios (ClientRepositorySqlite::create etc.), então os dados
+// passam pelo mesmo SQL do servidor, mas com o que torna a carga rápida:
+//   - transações grandes (--batch linhas por COMMIT) e PRAGMAs de carga (synchronous=OFF, journal em memória);
+//   - instruções preparadas reaproveitadas pelo cache da conexão (uma preparação por SQL);
+//   - índices secundários (idx_*) removidos antes e recriados (e ANALYZE) depois da carga;
+//   - geração das entidades em paralelo, em lotes, enquanto a thread principal grava o lote anterior.
+//
+// Os valores são determinísticos pelo índice da linha: o CPF i tem dígitos verificadores válidos e é
+// único, o SKU i é um UUID v4 cujos 8 bytes finais são o próprio i, e cada pedido aponta para
+// cliente/produto/endereço sorteados com uma função de hash fixa. Os ids devolvidos pelos repositórios
+// são usados nas chaves estrangeiras, então a integridade referencial não depende do valor inicial dos ids.
+//
+// Uso:
+//   seed [--db e-cocin.db] [--clients 1000000] [--addresses-per-client 1] [--products 100000]
+//        [--orders 10000000] [--batch 100000] [--threads N] [--seed 42] [--verify on]
+
+#include "app/Migrations.h"
+#include "domain/core/Uuid.h"
+#include "infra/db/SqliteConnection.h"
+#include "infra/repositories/sqlite/AddressRepositorySqlite.h"
+#include "infra/repositories/sqlite/ClientRepositorySqlite.h"
+#include "infra/repositories/sqlite/OrderRepositorySqlite.h"
+#include "infra/repositories/sqlite/ProductRepositorySqlite.h"
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <future>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using ecocin::infra::db::SqliteConnection;
+using ecocin::infra::db::Statement;
+using ecocin::infra::db::Transaction;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+struct Options {
+    std::string db{"e-cocin.db"};
+    std::uint64_t clients{1000000};
+    std::uint64_t addressesPerClient{1};
+    std::uint64_t products{100000};
+    std::uint64_t orders{10000000};
+    std::uint64_t batch{100000};
+    std::size_t threads{std::thread::hardware_concurrency() ? std::thread::hardware_concurrency() : 4};
+    std::uint64_t seed{42};
+    bool verify{true};
+};
+
+Options parseArgs(int argc, char** argv) {
+    Options o;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        const std::string key = argv[i];
+        const std::string value = argv[i + 1];
+        if (key == "--db") o.db = value;
+        else if (key == "--clients") o.clients = std::stoull(value);
+        else if (key == "--addresses-per-client") o.addressesPerClient = std::stoull(value);
+        else if (key == "--products") o.products = std::stoull(value);
+        else if (key == "--orders") o.orders = std::stoull(value);
+        else if (key == "--batch") o.batch = std::stoull(value);
+        else if (key == "--threads") o.threads = std::stoul(value);
+        else if (key == "--seed") o.seed = std::stoull(value);
+        else if (key == "--verify") o.verify = value != "off";
+        else throw std::invalid_argument("opção desconhecida: " + key);
+    }
+    if (o.clients == 0 || o.products == 0 || o.addressesPerClient == 0) {
+        throw std::invalid_argument("--clients, --products e --addresses-per-client devem ser positivos");
+    }
+    if (o.clients >= 1000000000ull) throw std::invalid_argument("--clients deve ser menor que 10^9 (CPF tem 9 dígitos-base)");
+    if (o.batch == 0) o.batch = 1;
+    if (o.threads == 0) o.threads = 1;
+    return o;
+}
+
+// ----------------------------------------------------------------------------
+// Geradores determinísticos
+// ----------------------------------------------------------------------------
+
+std::uint64_t mix(std::uint64_t x) {
+    x += 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+// CPF válido (com os dois dígitos verificadores) cujos 9 dígitos-base são i
+std::string cpfFor(std::uint64_t i) {
+    std::array<int, 11> d{};
+    for (int k = 8; k >= 0; --k) {
+        d[static_cast<std::size_t>(k)] = static_cast<int>(i % 10);
+        i /= 10;
+    }
+    for (int v = 9; v <= 10; ++v) {
+        int sum = 0;
+        for (int k = 0; k < v; ++k) sum += d[static_cast<std::size_t>(k)] * (v + 1 - k);
+        const int r = (sum * 10) % 11;
+        d[static_cast<std::size_t>(v)] = r == 10 ? 0 : r;
+    }
+    std::string out(11, '0');
+    for (std::size_t k = 0; k < 11; ++k) out[k] = static_cast<char>('0' + d[k]);
+    return out;
+}
+
+// UUID v4 cujos 8 bytes finais são i (único por construção) e os 8 iniciais vêm do hash de i
+ecocin::core::Uuid skuFor(std::uint64_t i, std::uint64_t seed) {
+    const std::uint64_t hi = mix(seed ^ i);
+    ecocin::core::Uuid::Bytes b{};
+    for (std::size_t k = 0; k < 8; ++k) {
+        b[k]     = static_cast<std::uint8_t>(hi >> (56 - 8 * k));
+        b[8 + k] = static_cast<std::uint8_t>(i >> (56 - 8 * k));
+    }
+    b[6] = static_cast<std::uint8_t>((b[6] & 0x0F) | 0x40); // versão 4
+    b[8] = static_cast<std::uint8_t>((b[8] & 0x3F) | 0x80); // variante (i < 2^56, o byte 8 de i é zero)
+    return ecocin::core::Uuid::fromBytes(b);
+}
+
+double priceFor(std::uint64_t product, std::uint64_t seed) {
+    return 5.0 + static_cast<double>(mix(seed + product) % 200000) / 100.0;
+}
+
+constexpr std::array<const char*, 8> kFirstNames{"Ana", "Bruno", "Carla", "Diego", "Elisa", "Felipe", "Gabriela", "Heitor"};
+constexpr std::array<const char*, 8> kLastNames{"Silva", "Souza", "Oliveira", "Santos", "Lima", "Costa", "Pereira", "Alves"};
+constexpr std::array<const char*, 5> kCities{"Recife", "Olinda", "Caruaru", "Petrolina", "Jaboatão"};
+constexpr std::array<const char*, 4> kStatuses{"PENDING", "PAID", "SHIPPED", "DELIVERED"};
+
+Client makeClient(std::uint64_t i, std::uint64_t seed) {
+    const auto h = mix(seed ^ (i << 1));
+    Client c;
+    c.setName(std::string(kFirstNames[h % kFirstNames.size()]) + " " + kLastNames[(h >> 8) % kLastNames.size()] + " " + std::to_string(i));
+    c.setEmail("cliente" + std::to_string(i) + "@seed.ecocin");
+    c.setCpf(cpfFor(i));
+    return c;
+}
+
+Product makeProduct(std::uint64_t i, std::uint64_t seed) {
+    Product p;
+    p.setName("Produto " + std::to_string(i));
+    p.setDescription("Produto sintético " + std::to_string(i));
+    p.setSku(skuFor(i, seed));
+    p.setPrice(priceFor(i, seed));
+    p.setStockQuantity(static_cast<int>(mix(seed + i * 3) % 10000));
+    p.setIsActive(mix(seed + i * 7) % 20 != 0);
+    return p;
+}
+
+// Endereço k (0..A-1) do cliente de índice c; client_id é preenchido na gravação
+Address makeAddress(std::uint64_t c, std::uint64_t k, std::uint64_t seed) {
+    const auto h = mix(seed ^ (c * 31 + k));
+    Address a;
+    a.setStreet("Rua " + std::to_string(h % 5000));
+    a.setNumber(std::to_string(1 + (h >> 16) % 3000));
+    a.setCity(kCities[(h >> 32) % kCities.size()]);
+    a.setState("PE");
+    a.setZip(std::to_string(50000000 + (h >> 8) % 6000000));
+    a.setAddressType(k == 0 ? "residential" : "extra-" + std::to_string(k));
+    return a;
+}
+
+// Pedido i; clientId/productId/shippingAddressId guardam ÍNDICES e são trocados pelos ids na gravação
+Order makeOrder(std::uint64_t i, const Options& o) {
+    const auto h = mix(o.seed ^ (i * 0x2545F4914F6CDD1Dull));
+    const auto client = h % o.clients;
+    const auto product = (h >> 20) % o.products;
+    Order ord;
+    ord.setClientId(static_cast<long long>(client));
+    ord.setProductId(static_cast<long long>(product));
+    ord.setShippingAddressId(static_cast<long long>(client * o.addressesPerClient + (h >> 40) % o.addressesPerClient));
+    ord.setQuantity(1 + static_cast<int>((h >> 8) % 5));
+    ord.setUnitPrice(priceFor(product, o.seed));
+    ord.setStatus(kStatuses[(h >> 12) % kStatuses.size()]);
+    return ord;
+}
+
+// ----------------------------------------------------------------------------
+// Carga em lotes: gera em paralelo, grava em ordem, um lote por transação
+// ----------------------------------------------------------------------------
+
+template <class Entity, class Make, class Write>
+void bulkLoad(SqliteConnection& cx, const Options& o, const char* label, std::uint64_t count, Make make, Write write) {
+    const auto start = Clock::now();
+    auto generate = [&make](std::uint64_t begin, std::uint64_t end) {
+        std::vector<Entity> out;
+        out.reserve(end - begin);
+        for (auto i = begin; i < end; ++i) out.push_back(make(i));
+        return out;
+    };
+
+    // Janela de lotes gerados à frente da gravação (uma tarefa por thread)
+    std::deque<std::future<std::vector<Entity>>> ahead;
+    std::uint64_t next = 0;
+    auto refill = [&] {
+        while (ahead.size() < o.threads && next < count) {
+            const auto end = std::min(count, next + o.batch);
+            ahead.push_back(std::async(std::launch::async, generate, next, end));
+            next = end;
+        }
+    };
+
+    std::uint64_t written = 0;
+    refill();
+    while (!ahead.empty()) {
+        auto batch = ahead.front().get();
+        ahead.pop_front();
+        refill();
+
+        Transaction tx(cx);
+        for (auto& e : batch) write(e, written++);
+        tx.commit();
+
+        const double secs = std::chrono::duration<double>(Clock::now() - start).count();
+        std::fprintf(stderr, "\r  %-9s %12llu / %llu  (%.0f linhas/s)", label,
+                     static_cast<unsigned long long>(written), static_cast<unsigned long long>(count),
+                     secs > 0 ? static_cast<double>(written) / secs : 0.0);
+    }
+    const double secs = std::chrono::duration<double>(Clock::now() - start).count();
+    std::fprintf(stderr, "\r  %-9s %12llu linhas em %.1fs%30s\n", label, static_cast<unsigned long long>(count), secs, "");
+}
+
+std::int64_t countRows(SqliteConnection& cx, const char* table) {
+    const std::string sql = std::string("SELECT COUNT(*) FROM ") + table;
+    Statement st(cx, sql, "count rows");
+    return sqlite3_step(st) == SQLITE_ROW ? sqlite3_column_int64(st, 0) : 0;
+}
+
+// Remove os índices secundários (idx_*) do esquema; runMigrations os recria depois da carga
+void dropSecondaryIndexes(SqliteConnection& cx) {
+    std::vector<std::string> names;
+    {
+        Statement st(cx, "SELECT name FROM sqlite_master WHERE type='index' AND name LIKE 'idx\\_%' ESCAPE '\\'", "list indexes");
+        while (sqlite3_step(st) == SQLITE_ROW) names.emplace_back(reinterpret_cast<const char*>(sqlite3_column_text(st, 0)));
+    }
+    for (const auto& n : names) cx.exec(("DROP INDEX IF EXISTS " + n).c_str());
+    std::cerr << "  " << names.size() << " índices secundários removidos para a carga\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    try {
+        const auto o = parseArgs(argc, argv);
+        const auto start = Clock::now();
+
+        SqliteConnection cx(o.db);
+        ecocin::app::runMigrations(cx.raw());
+        for (const char* t : {"clients", "addresses", "products", "orders"}) {
+            if (countRows(cx, t) != 0) {
+                throw std::runtime_error(std::string("a tabela ") + t + " já tem dados; use um banco novo em --db");
+            }
+        }
+
+        // Durabilidade não importa durante a carga: se o processo cair, o banco é gerado de novo
+        cx.exec("PRAGMA synchronous = OFF; PRAGMA journal_mode = MEMORY; "
+                "PRAGMA temp_store = MEMORY; PRAGMA cache_size = -262144;");
+        dropSecondaryIndexes(cx);
+
+        ecocin::infra::repositories::sqlite::ClientRepositorySqlite clients(cx);
+        ecocin::infra::repositories::sqlite::AddressRepositorySqlite addresses(cx);
+        ecocin::infra::repositories::sqlite::ProductRepositorySqlite products(cx);
+        ecocin::infra::repositories::sqlite::OrderRepositorySqlite orders(cx);
+
+        // Ids gerados pelo banco, por índice, para montar as chaves estrangeiras
+        std::vector<long long> clientIds(o.clients), productIds(o.products), addressIds(o.clients * o.addressesPerClient);
+
+        bulkLoad<Client>(cx, o, "clients", o.clients,
+            [&](std::uint64_t i) { return makeClient(i, o.seed); },
+            [&](Client& c, std::uint64_t i) { clientIds[i] = clients.create(c).getId(); });
+
+        bulkLoad<Address>(cx, o, "addresses", o.clients * o.addressesPerClient,
+            [&](std::uint64_t i) { return makeAddress(i / o.addressesPerClient, i % o.addressesPerClient, o.seed); },
+            [&](Address& a, std::uint64_t i) {
+                a.setClientId(clientIds[i / o.addressesPerClient]);
+                addressIds[i] = addresses.create(a).getId();
+            });
+
+        bulkLoad<Product>(cx, o, "products", o.products,
+            [&](std::uint64_t i) { return makeProduct(i, o.seed); },
+            [&](Product& p, std::uint64_t i) { productIds[i] = products.create(p).getId(); });
+
+        bulkLoad<Order>(cx, o, "orders", o.orders,
+            [&](std::uint64_t i) { return makeOrder(i, o); },
+            [&](Order& ord, std::uint64_t) {
+                ord.setClientId(clientIds[static_cast<std::size_t>(ord.getClientId())]);
+                ord.setProductId(productIds[static_cast<std::size_t>(ord.getProductId())]);
+                ord.setShippingAddressId(addressIds[static_cast<std::size_t>(ord.getShippingAddressId())]);
+                orders.create(ord);
+            });
+
+        std::cerr << "recriando índices...\n";
+        const auto indexStart = Clock::now();
+        ecocin::app::runMigrations(cx.raw());
+        cx.exec("ANALYZE;");
+        std::cerr << "  índices e estatísticas em "
+                  << std::chrono::duration<double>(Clock::now() - indexStart).count() << "s\n";
+
+        if (o.verify) {
+            Statement st(cx, "PRAGMA foreign_key_check", "foreign key check");
+            if (sqlite3_step(st) == SQLITE_ROW) throw std::runtime_error("PRAGMA foreign_key_check encontrou referências inválidas");
+            std::cerr << "integridade referencial verificada\n";
+        }
+
+        cx.exec("PRAGMA journal_mode = DELETE; PRAGMA synchronous = FULL;");
+        std::cerr << "concluído em " << std::chrono::duration<double>(Clock::now() - start).count() << "s\n";
+    } catch (const std::exception& e) {
+        std::cerr << "seed: " << e.what() << '\n';
+        return 1;
+    }
+    return 0;
+}